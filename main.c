@@ -49,15 +49,26 @@
 #include "cycfg.h"
 #include "cycfg_qspi_memslot.h"
 #include "cy_retarget_io.h"
+#include "console.h"
+#include "telemetry.h"
+#include "hyperram.h"
+#include "xfer_server.h"
+#include "benchmark.h"
+#include "stress.h"
+#include "march_test.h"
+#include "prbs_test.h"
+#include "hyperram_sections.h"
+#include "dma_buffer.h"
+#include "hyperram_verify.h"
+#include "xip_copy.h"
+#include "perf_counter.h"
 #include <string.h>
 
 /*******************************************************************************
 * Macros
 *******************************************************************************/
 
-#define TIMEOUT_MS              (1000ul)
 #define SIZE_IN_BYTES           (64u)
-#define DUMMY_CYCLE_COUNT       (14u)
 #define BYTES_PER_LINE          (8u)
 
 #define TEST_SECTOR_NO          (0)
@@ -68,6 +79,46 @@
 #define XIP_ADDRESS             CY_SMIF_XIP_BASE
 #define LOOP_VALUE              20u
 
+/* Baud rate used once telemetry is enabled; 0 keeps CY_RETARGET_IO_BAUDRATE */
+#define TELEMETRY_BAUDRATE      (0u)
+
+/* Destructive memory test run with ENABLE_MARCH_TEST over this range. With
+ * HyperRAM sections it defaults to the 8 MB above the section range. */
+#if defined(HYPERRAM_SECTIONS)
+#ifndef MARCH_TEST_OFFSET
+#define MARCH_TEST_OFFSET       (HYPERRAM_SECTIONS_OFFSET + HYPERRAM_SECTIONS_SIZE)
+#endif
+#ifndef MARCH_TEST_SIZE
+#define MARCH_TEST_SIZE         (HYPERRAM_SIZE - MARCH_TEST_OFFSET)
+#endif
+#else
+#ifndef MARCH_TEST_OFFSET
+#define MARCH_TEST_OFFSET       (0x00000000UL)
+#endif
+#ifndef MARCH_TEST_SIZE
+#define MARCH_TEST_SIZE         (HYPERRAM_SIZE)
+#endif
+#endif
+
+#if defined(ENABLE_MARCH_TEST) && defined(HYPERRAM_SECTIONS) && \
+    (MARCH_TEST_OFFSET < (HYPERRAM_SECTIONS_OFFSET + HYPERRAM_SECTIONS_SIZE)) && \
+    ((MARCH_TEST_OFFSET + MARCH_TEST_SIZE) > HYPERRAM_SECTIONS_OFFSET)
+#error "The March test range overwrites the HYPERRAM sections; move MARCH_TEST_OFFSET/MARCH_TEST_SIZE"
+#endif
+
+/* Signal-integrity run with ENABLE_PRBS_TEST: every pattern for this long */
+#ifndef PRBS_TEST_DURATION_MS
+#define PRBS_TEST_DURATION_MS   (10000u)
+#endif
+
+/* Stress test run with ENABLE_STRESS; a duration of 0 soaks until reset */
+#ifndef STRESS_SEED
+#define STRESS_SEED             (0x2545F491UL)
+#endif
+#ifndef STRESS_DURATION_S
+#define STRESS_DURATION_S       (3600u)
+#endif
+
 /*******************************************************************************
 * Global Variables
 *******************************************************************************/
@@ -107,25 +158,42 @@ int main(void)
 {
     cy_rslt_t result;
 
-    uint8_t tx_buf[SIZE_IN_BYTES];
-    uint8_t rx_buf[SIZE_IN_BYTES];
+    /* Line aligned and padded, so the buffers can be DMA targets */
+    uint8_t* tx_buf = (uint8_t*)dma_buffer_alloc(SIZE_IN_BYTES);
+    uint8_t* rx_buf = (uint8_t*)dma_buffer_alloc(SIZE_IN_BYTES);
 
     uint16_t loop_count;
+    uint32_t tx_crc;
+    uint32_t rx_crc;
 
-    cy_stc_smif_context_t smif_context = { 0 };
+    hyperram_status_t hyperram_status = HYPERRAM_ERROR;
+    hyperram_init_timing_t init_timing;
 
-    cy_en_smif_status_t smif_status = CY_SMIF_BAD_PARAM;
+    /* Boot time stamp for the bring-up timing, unless the HyperRAM section
+     * startup already took it before main() */
+    perf_counter_init();
 
-    /* Initialize the device and board peripherals */
-    result = cybsp_init();
+    /* Initialize the device and board peripherals. If HyperRAM sections are
+     * used this already happened before main(), see hyperram_sections.h */
+    result = hyperram_sections_bsp_init();
 
-    /* Board init failed. Stop program execution */
-    if (result != CY_RSLT_SUCCESS)
+    /* Board init failed or no buffers. Stop program execution */
+    if ((result != CY_RSLT_SUCCESS) || (NULL == tx_buf) || (NULL == rx_buf))
     {
         CY_ASSERT(0);
     }
 
-    Cy_GPIO_Pin_FastInit(GPIO_PRT24, 2, CY_GPIO_DM_STRONG, 0, P24_2_SMIF0_SPIHB_RWDS);
+    /* Start the SMIF bring-up here and finish it after the console setup, so
+     * that the HyperRAM power-up overlaps the rest of the board init. With
+     * HyperRAM sections the startup code has already done both halves. */
+    if (hyperram_is_ready())
+    {
+        hyperram_status = HYPERRAM_SUCCESS;
+    }
+    else
+    {
+        hyperram_status = hyperram_init_start();
+    }
 
     /* Initialize retarget-io to use the debug UART port */
     result = cy_retarget_io_init_fc(CYBSP_DEBUG_UART_TX, CYBSP_DEBUG_UART_RX,
@@ -137,65 +205,81 @@ int main(void)
         CY_ASSERT(0);
     }
 
+    /* Drain console output by DMA so that logging does not stall the CPU.
+     * Output stays blocking if the DMA backend is unavailable. */
+    (void)console_init();
+
+#ifdef ENABLE_TELEMETRY
+    /* Buffer dumps are sent as binary frames, decode with tools/telemetry_decode.py */
+    if (!telemetry_init(TELEMETRY_BAUDRATE))
+    {
+        CY_ASSERT(0);
+    }
+#endif
+
     /* \x1b[2J\x1b[;H - ANSI ESC sequence for clear screen */
-    printf("\x1b[2J\x1b[;H");
-    printf("****************** "
+    console_printf("\x1b[2J\x1b[;H");
+    console_printf("****************** "
             "HyperRAM Read and Write "
             "****************** \r\n\n");
 
+    /* Report the startup initialization of HYPERRAM_BSS / HYPERRAM_DATA */
+    if (HYPERRAM_SUCCESS != hyperram_sections_report())
+    {
+        console_flush();
+        CY_ASSERT(0);
+    }
+
     /* Enable global interrupts */
     __enable_irq();
 
-    Cy_SMIF_Disable(SMIF_BASE);
-
-    smif_status = Cy_SMIF_Init(SMIF_BASE, &SMIF_config, TIMEOUT_MS, &smif_context);
+    /* Bring up the HyperRAM memory slot; the SMIF is left in command mode */
+    if ((HYPERRAM_SUCCESS == hyperram_status) && !hyperram_is_ready())
+    {
+        hyperram_status = hyperram_init_finish();
+    }
+    hyperram_enter_command();
 
-    if(smif_status != CY_SMIF_SUCCESS)
+    if (hyperram_status != HYPERRAM_SUCCESS)
     {
-        printf("\r\nCy_SMIF_Init - Fail \n\r");
+        console_printf("\r\nHyperRAM init - Fail \n\r");
+        console_flush();
         CY_ASSERT(0);
     }
 
-    Cy_SMIF_SetMode(SMIF_BASE, CY_SMIF_NORMAL);
-    Cy_SMIF_SetDataSelect(SMIF_BASE, smifMemConfigs[0]->slaveSelect, smifMemConfigs[0]->dataSelect);
-    Cy_SMIF_Enable(SMIF_BASE, &smif_context);
-
-    smifMemConfigs[0]->hbdeviceCfg->dummyCycles = DUMMY_CYCLE_COUNT;
-
-    smif_status = Cy_SMIF_Memslot_Init(SMIF_BASE, (cy_stc_smif_block_config_t*)&smifBlockConfig, &smif_context);
-
-    if(smif_status != CY_SMIF_SUCCESS)
+    hyperram_get_init_timing(&init_timing);
+    console_printf("HyperRAM bring-up: started at %lu us, SMIF %lu us, overlapped %lu us, "
+                   "power-up wait %lu us, first access at %lu us, ready at %lu us after boot "
+                   "(timeout %lu us)\r\n",
+                   (unsigned long)(init_timing.start_at_ns / 1000u), (unsigned long)(init_timing.start_ns / 1000u),
+                   (unsigned long)(init_timing.overlap_ns / 1000u),
+                   (unsigned long)(init_timing.power_wait_ns / 1000u),
+                   (unsigned long)(init_timing.first_access_at_ns / 1000u),
+                   (unsigned long)(init_timing.ready_at_ns / 1000u), (unsigned long)init_timing.timeout_us);
+
+    /* Read-back checks compare CRC-32 digests computed by the CRYPTO block */
+    if (HYPERRAM_SUCCESS != hyperram_verify_init())
     {
-        printf("\r\nCy_SMIF_Memslot_Init - Fail \n\r");
+        console_printf("\r\nVerification init - Fail \n\r");
+        console_flush();
         CY_ASSERT(0);
     }
-    
-    Cy_SMIF_SetMode(SMIF_BASE, CY_SMIF_NORMAL);
 
     memset(rx_buf, 0, SIZE_IN_BYTES);
 
-    smif_status = Cy_SMIF_HyperBus_Read(SMIF_BASE,
-        smifMemConfigs[0],
-        CY_SMIF_HB_COUTINUOUS_BURST,
-        TEST_SECTOR_ADDRESS,
-        32,
-        (uint16_t*)rx_buf,
-        smifMemConfigs[0]->hbdeviceCfg->dummyCycles,
-        false,
-        true,
-        &smif_context
-    );
-
-    if (smif_status != CY_SMIF_SUCCESS)
+    hyperram_status = hyperram_read(TEST_SECTOR_ADDRESS, rx_buf, SIZE_IN_BYTES);
+
+    if (hyperram_status != HYPERRAM_SUCCESS)
     {
-        printf("\r\n1. Reading Data before write - Fail \n\r");
+        console_printf("\r\n1. Reading Data before write - Fail \n\r");
+        console_flush();
         CY_ASSERT(0);
     }
 
-    printf("\r\n1. Reading Data before write - Success \n\r");
+    console_printf("\r\n1. Reading Data before write - Success \n\r");
 
     print_array("Received Data before write", rx_buf, SIZE_IN_BYTES);
-    printf("\r\n=============================================\r\n");
+    console_printf("\r\n=============================================\r\n");
 
     /* Prepare the TX buffer */
     for (uint32_t index = 1; index < SIZE_IN_BYTES; index++)
@@ -203,68 +287,65 @@ int main(void)
         tx_buf[index] = (uint8_t)index;
     }
 
-    smif_status = Cy_SMIF_HyperBus_Write(SMIF_BASE,
-        smifMemConfigs[0],
-        CY_SMIF_HB_COUTINUOUS_BURST,
-        TEST_SECTOR_ADDRESS,
-        32,
-        (uint16_t*)&tx_buf[0],
-        CY_SMIF_HB_SRAM,
-        smifMemConfigs[0]->hbdeviceCfg->dummyCycles,
-        true,
-        &smif_context
-    );
-
-    if (smif_status != CY_SMIF_SUCCESS)
+    /* Write and read back by DMA through the XIP window; the CRC-32 of each
+     * direction is taken while its transfer runs, see hyperram_verify.h */
+    hyperram_enter_xip();
+
+    hyperram_status = hyperram_verify_write(TEST_SECTOR_ADDRESS, tx_buf, SIZE_IN_BYTES, &tx_crc);
+
+    if (hyperram_status != HYPERRAM_SUCCESS)
     {
-        printf("\r\n2. Writing data to memory - Fail \n\r");
+        console_printf("\r\n2. Writing data to memory - Fail \n\r");
+        console_flush();
         CY_ASSERT(0);
     }
 
-    printf("\r\n2. Writing data to memory - Success \n\r");
+    console_printf("\r\n2. Writing data to memory - Success \n\r");
 
     print_array("Written Data", tx_buf, SIZE_IN_BYTES);
-    printf("\r\n=============================================\r\n");
+    console_printf("\r\n=============================================\r\n");
 
     memset(rx_buf, 0, SIZE_IN_BYTES);
 
-    smif_status = Cy_SMIF_HyperBus_Read(SMIF_BASE,
-        smifMemConfigs[0],
-        CY_SMIF_HB_COUTINUOUS_BURST,
-        TEST_SECTOR_ADDRESS,
-        32,
-        (uint16_t*)rx_buf,
-        smifMemConfigs[0]->hbdeviceCfg->dummyCycles,
-        false,
-        true,
-        &smif_context
-    );
-
-    if (smif_status != CY_SMIF_SUCCESS)
+    hyperram_status = hyperram_verify_read(rx_buf, TEST_SECTOR_ADDRESS, SIZE_IN_BYTES, &rx_crc);
+
+    if (hyperram_status != HYPERRAM_SUCCESS)
     {
-        printf("\r\n3. Reading back for verification - Fail \n\r");
+        console_printf("\r\n3. Reading back for verification - Fail \n\r");
+        console_flush();
         CY_ASSERT(0);
     }
 
-    printf("\r\n3. Reading back for verification - Success \n\r");
+    console_printf("\r\n3. Reading back for verification - Success \n\r");
 
     print_array("Received Data", rx_buf, SIZE_IN_BYTES);
 
-    if (0u != memcmp(tx_buf, rx_buf, SIZE_IN_BYTES))
+    console_printf("\r\nCRC-32 written 0x%08lX, read 0x%08lX\r\n", (unsigned long)tx_crc, (unsigned long)rx_crc);
+
+    if (tx_crc != rx_crc)
     {
-        printf("\r\n==========================================================================\r\n");
-        printf("\r\nRead data does not match with written data. Read/Write operation failed. \n\r");
-        printf("\r\n==========================================================================\r\n");
+        uint32_t offset = 0u;
+
+        /* The digests only say that something differs; find where */
+        while ((offset < SIZE_IN_BYTES) && (tx_buf[offset] == rx_buf[offset]))
+        {
+            offset++;
+        }
+
+        console_printf("\r\n==========================================================================\r\n");
+        console_printf("\r\nRead data does not match with written data at offset %lu. "
+                       "Read/Write operation failed. \n\r", (unsigned long)offset);
+        console_printf("\r\n==========================================================================\r\n");
     }
     else
     {
-        printf("\r\n=============================================\r\n");
-        printf("\r\nSUCCESS: Read data matches with written data!\r\n");
-        printf("\r\n=============================================\r\n");
+        console_printf("\r\n=============================================\r\n");
+        console_printf("\r\nSUCCESS: Read data matches with written data!\r\n");
+        console_printf("\r\n=============================================\r\n");
     }
 
     /***** XIP READ  *******/
-    Cy_SMIF_SetMode(SMIF_BASE, CY_SMIF_MEMORY);
+    hyperram_enter_xip();
 
     /* If more than 1 cycle merge time accepted, there will be long CS# low duration when burst reading. */
     /* It may cause error because Low/High ratio of CLK should be around 50/50 during reading because of Memory device restriction. */
@@ -273,7 +354,7 @@ int main(void)
     memset(rx_buf, 0, SIZE_IN_BYTES);
 
     /*Reading 1 Page data at a time*/
-    memcpy(rx_buf, (void*)(pHyperFlashBaseAddr + TEST_SECTOR_ADDRESS), SIZE_IN_BYTES);
+    (void)xip_memcpy(rx_buf, (void*)(pHyperFlashBaseAddr + TEST_SECTOR_ADDRESS), SIZE_IN_BYTES);
 
     print_array("4. XIP READ ", rx_buf, SIZE_IN_BYTES);
 
@@ -283,22 +364,74 @@ int main(void)
     Cy_SMIF_CacheDisable(SMIF_BASE, CY_SMIF_CACHE_BOTH);
 
     /* Put the device in XIP mode */
-    printf("\n\rVerify execution from memory in XIP Mode\n\r");
-    printf("--------------------------------------------\n\r");
-    Cy_SMIF_SetMode(SMIF_BASE, CY_SMIF_MEMORY);
+    console_printf("\n\rVerify execution from memory in XIP Mode\n\r");
+    console_printf("--------------------------------------------\n\r");
+    hyperram_enter_xip();
 
     loop_count = executed_api(LOOP_VALUE);
 
     if (loop_count == LOOP_VALUE + 1)
     {
-        printf("XIP Read Functionality - Success\n\r");
+        console_printf("XIP Read Functionality - Success\n\r");
     }
     else
     {
-        printf("XIP Read Functionality - Fail\n\r");
+        console_printf("XIP Read Functionality - Fail\n\r");
+    }
+
+    console_printf("\n\rCompleted SMIF HyperRAM Test app verification\n\r");
+
+    if (0u != console_get_dropped())
+    {
+        console_printf("\n\rConsole messages dropped: %u\n\r", (unsigned int)console_get_dropped());
+    }
+
+#ifdef ENABLE_MARCH_TEST
+    {
+        /* Production test, the whole device by default; the range must not hold live data */
+        march_test_result_t march_result;
+
+        (void)march_test_run(MARCH_TEST_OFFSET, MARCH_TEST_SIZE, MARCH_TEST_ALL, STRESS_SEED, &march_result);
+    }
+#endif
+
+#ifdef ENABLE_PRBS_TEST
+    {
+        /* Per-line bit-error rates for board margining, see prbs_test.h */
+        prbs_test_config_t prbs_config = { PRBS_TEST_PRBS7, 0x00200000UL, 0x00100000UL, PRBS_TEST_DURATION_MS };
+        prbs_test_result_t prbs_result;
+
+        for (uint32_t pattern = 0; pattern < (uint32_t)PRBS_TEST_PATTERNS; pattern++)
+        {
+            prbs_config.pattern = (prbs_test_pattern_t)pattern;
+            (void)prbs_test_run(&prbs_config, &prbs_result);
+            prbs_test_print(&prbs_config, &prbs_result);
+        }
+    }
+#endif
+
+#ifdef ENABLE_BENCHMARK
+    /* Timing report for the access paths, capture and compare with tools/bench_compare.py */
+    benchmark_run(BENCH_DEFAULT_ITERATIONS);
+#endif
+
+#ifdef ENABLE_STRESS
+    {
+        /* Random mixed traffic with read-back verification, see stress.h */
+        stress_config_t stress_config = { STRESS_SEED, STRESS_DURATION_S, 0u };
+
+        (void)stress_run(&stress_config);
     }
+#endif
 
-    printf("\n\rCompleted SMIF HyperRAM Test app verification\n\r");
+#ifdef ENABLE_XFER_SERVER
+    /* Serve HyperRAM dump/upload requests from tools/hyperram_xfer.py */
+    if (xfer_server_init())
+    {
+        console_printf("\n\rHyperRAM transfer server ready\n\r");
+        xfer_server_run();
+    }
+#endif
 
 
     for (;;)
@@ -310,7 +443,9 @@ int main(void)
 * Function Name: print_array
 ********************************************************************************
 * Summary:
-*  Prints the content of the buffer to the UART console.
+*  Prints the content of the buffer to the UART console. With ENABLE_TELEMETRY
+*  the buffer is sent as raw telemetry frames and formatted on the host;
+*  otherwise each line is formatted locally and written with a single call.
 *
 * Parameters:
 *  message - message to print before array output
@@ -323,18 +458,37 @@ int main(void)
 *******************************************************************************/
 void print_array(char* message, uint8_t* buf, uint32_t size)
 {
-    printf("\n\r%s (%u bytes):\n\r", message, (unsigned int)size);
-    printf("-------------------------\r\n");
+#ifdef ENABLE_TELEMETRY
+    telemetry_send_marker(0u, message);
+    telemetry_send_dump(0u, buf, size);
+#else
+    static const char hex_digits[] = "0123456789ABCDEF";
+    char line[(BYTES_PER_LINE * 5u) + 2u];
+    uint32_t length = 0u;
+
+    console_printf("\n\r%s (%u bytes):\n\r", message, (unsigned int)size);
+    console_printf("-------------------------\r\n");
 
     for (uint32_t index = 0; index < size; index++)
     {
-        printf("0x%02X ", buf[index]);
+        line[length++] = '0';
+        line[length++] = 'x';
+        line[length++] = hex_digits[buf[index] >> 4];
+        line[length++] = hex_digits[buf[index] & 0x0Fu];
+        line[length++] = ' ';
 
-        if (0u == ((index + 1) % BYTES_PER_LINE))
+        if ((0u == ((index + 1) % BYTES_PER_LINE)) || ((index + 1) == size))
         {
-            printf("\r\n");
+            if (0u == ((index + 1) % BYTES_PER_LINE))
+            {
+                line[length++] = '\r';
+                line[length++] = '\n';
+            }
+            (void)console_write(line, length);
+            length = 0u;
         }
     }
+#endif
 }
 
 /* [] END OF FILE */
@@ -0,0 +1,1884 @@
+/*******************************************************************************
+* File Name:   benchmark.c
+*
+* Description: Benchmark runner and JSON reporter. Timing uses perf_counter.h;
+* the same cases run on the hardware build and on the host simulator build.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include "platform.h"
+#include "benchmark.h"
+#include "perf_counter.h"
+#include "hyperram.h"
+#include "hyperram_dma.h"
+#include "hyperram_ring.h"
+#include "kv_store.h"
+#include "hyperram_verify.h"
+#include "hyperram_protect.h"
+#include "xip_copy.h"
+#include "simd_ops.h"
+#include "hyperram_lz.h"
+#include "hyperram_crypt.h"
+#if !defined(HYPERRAM_HOST_SIM)
+#include "code_bench.h"
+#include "mpu_bench.h"
+#endif
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* Build identification, passed in by the Makefile */
+#define BENCH_STR(x)                    BENCH_STR_(x)
+#define BENCH_STR_(x)                   #x
+
+#if defined(BENCH_BUILD_CONFIG)
+#define BENCH_CONFIG_NAME               BENCH_STR(BENCH_BUILD_CONFIG)
+#else
+#define BENCH_CONFIG_NAME               "unknown"
+#endif
+
+#if defined(BENCH_TOOLCHAIN)
+#define BENCH_TOOLCHAIN_NAME            BENCH_STR(BENCH_TOOLCHAIN)
+#else
+#define BENCH_TOOLCHAIN_NAME            "unknown"
+#endif
+
+#if defined(BENCH_TARGET)
+#define BENCH_TARGET_NAME               BENCH_STR(BENCH_TARGET)
+#else
+#define BENCH_TARGET_NAME               "unknown"
+#endif
+
+#define BENCH_SRAM_BUFFERS              (2u)
+
+/* Ring cases: 256 KB of 16-byte samples behind the device region */
+#define BENCH_RING_OFFSET               (0x00180000UL)
+#define BENCH_RING_SIZE                 (0x00040000UL)
+#define BENCH_RING_SAMPLE_SIZE          (16u)
+
+/* Key-value cases: 4 K slots of 60-byte values (256 KB) after the ring,
+ * filled to the load limit */
+#define BENCH_KV_OFFSET                 (0x001C0000UL)
+#define BENCH_KV_CAPACITY               (4096u)
+#define BENCH_KV_VALUE_SIZE             (60u)
+#define BENCH_KV_KEYS                   ((BENCH_KV_CAPACITY * KV_STORE_MAX_LOAD) / 100u)
+
+/* Protected region over the device test region */
+#define BENCH_PROTECT_BLOCK             (1024u)
+#define BENCH_PROTECT_BLOCKS            (BENCH_MAX_SIZE / BENCH_PROTECT_BLOCK)
+
+/* Compressed store over the device test region */
+#define BENCH_LZ_BLOCK                  (4096u)
+#define BENCH_LZ_BLOCKS                 (BENCH_MAX_SIZE / BENCH_LZ_BLOCK)
+
+/* Copy kernel cases: largest size, leaving room for the misalignment */
+#define BENCH_COPY_MAX_SIZE             (32768u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef void (*bench_suite_t)(uint32_t iterations);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void bench_suite_smif(uint32_t iterations);
+static bool bench_prepare_command(uint32_t size);
+static bool bench_prepare_xip(uint32_t size);
+static bool bench_cmd_read(uint32_t size);
+static bool bench_cmd_write(uint32_t size);
+static bool bench_xip_read(uint32_t size);
+static bool bench_xip_write(uint32_t size);
+static bool bench_dma_read(uint32_t size);
+static bool bench_dma_write(uint32_t size);
+static bool bench_dma_fill(uint32_t size);
+static bool bench_dma_pattern_fill(uint32_t size);
+static void bench_suite_copy(uint32_t iterations);
+static bool bench_prepare_copy_aligned(uint32_t size);
+static bool bench_prepare_copy_sram_odd(uint32_t size);
+static bool bench_prepare_copy_xip_odd(uint32_t size);
+static bool bench_copy_libc_read(uint32_t size);
+static bool bench_copy_cpu_read(uint32_t size);
+static bool bench_copy_auto_read(uint32_t size);
+static bool bench_copy_libc_write(uint32_t size);
+static bool bench_copy_cpu_write(uint32_t size);
+static bool bench_copy_auto_write(uint32_t size);
+static void bench_suite_ring(uint32_t iterations);
+static bool bench_prepare_ring(uint32_t size);
+static bool bench_ring_produce(uint32_t size);
+static bool bench_ring_ingest(uint32_t size);
+static void bench_suite_kv(uint32_t iterations);
+static uint32_t bench_kv_next_key(void);
+static bool bench_kv_get(uint32_t size);
+static bool bench_kv_scan(uint32_t size);
+static bool bench_kv_put(uint32_t size);
+static void bench_suite_verify(uint32_t iterations);
+static bool bench_verify_memcmp(uint32_t size);
+static bool bench_verify_read(uint32_t size);
+static bool bench_verify_check(uint32_t size);
+static bool bench_verify_compare(uint32_t size);
+static void bench_suite_simd(uint32_t iterations);
+static bool bench_simd_memcmp(uint32_t size);
+static bool bench_simd_compare(uint32_t size);
+static bool bench_simd_checksum(uint32_t size);
+static bool bench_simd_find(uint32_t size);
+static void bench_suite_lz(uint32_t iterations);
+static bool bench_lz_write(const uint8_t* src, uint32_t size);
+static bool bench_lz_read(uint32_t size);
+static bool bench_lz_write_ramp(uint32_t size);
+static bool bench_lz_write_random(uint32_t size);
+static void bench_suite_protect(uint32_t iterations);
+static bool bench_protect_read(uint32_t size);
+static bool bench_protect_write(uint32_t size);
+static void bench_suite_crypt(uint32_t iterations);
+static bool bench_crypt_dma_read(uint32_t size);
+static bool bench_crypt_dma_write(uint32_t size);
+static bool bench_crypt_xip_read(uint32_t size);
+static bool bench_crypt_xip_write(uint32_t size);
+static bool bench_crypt_cmd_read(uint32_t size);
+static bool bench_crypt_cmd_write(uint32_t size);
+static void bench_sort(uint32_t* samples, uint32_t count);
+static uint32_t bench_percentile(const uint32_t* sorted, uint32_t count, uint32_t percent);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+CY_ALIGN(PLATFORM_CACHE_LINE) static uint8_t bench_sram[BENCH_SRAM_BUFFERS][BENCH_MAX_SIZE];
+static uint32_t bench_samples[BENCH_MAX_ITERATIONS];
+static bool bench_first_result;
+static hyperram_ring_t bench_ring;
+static kv_store_t bench_kv;
+static uint32_t bench_kv_index[BENCH_KV_CAPACITY];
+static uint32_t bench_kv_state;
+static uint32_t bench_verify_crc;
+static hyperram_protect_t bench_protect;
+static uint32_t bench_protect_table[HYPERRAM_PROTECT_TABLE_WORDS(BENCH_PROTECT_BLOCKS)];
+static hyperram_lz_t bench_lz;
+static uint16_t bench_lz_index[BENCH_LZ_BLOCKS];
+static uint32_t bench_copy_sram_offset;
+static uint32_t bench_copy_xip_offset;
+
+static const uint32_t bench_sizes[] = { 64u, 512u, 4096u, 65536u };
+
+static const bench_case_t bench_smif_cases[] =
+{
+    { "cmd_read",  bench_prepare_command, bench_cmd_read  },
+    { "cmd_write", bench_prepare_command, bench_cmd_write },
+    { "xip_read",  bench_prepare_xip,     bench_xip_read  },
+    { "xip_write", bench_prepare_xip,     bench_xip_write },
+    { "dma_read",  bench_prepare_xip,     bench_dma_read  },
+    { "dma_write", bench_prepare_xip,     bench_dma_write },
+    { "dma_fill",  bench_prepare_xip,     bench_dma_fill  },
+    { "dma_lfsr",  bench_prepare_xip,     bench_dma_pattern_fill },
+};
+
+/* Copy kernels: libc memcpy(), the CPU kernel alone and xip_memcpy() with
+ * its DMA hand-off, with both sides aligned (_a0), the SRAM side at an odd
+ * address (_s1) and the XIP side at an odd address (_x3) */
+static const bench_case_t bench_copy_cases[] =
+{
+    { "copy_libc_read_a0",  bench_prepare_copy_aligned,  bench_copy_libc_read  },
+    { "copy_cpu_read_a0",   bench_prepare_copy_aligned,  bench_copy_cpu_read   },
+    { "copy_auto_read_a0",  bench_prepare_copy_aligned,  bench_copy_auto_read  },
+    { "copy_libc_write_a0", bench_prepare_copy_aligned,  bench_copy_libc_write },
+    { "copy_cpu_write_a0",  bench_prepare_copy_aligned,  bench_copy_cpu_write  },
+    { "copy_auto_write_a0", bench_prepare_copy_aligned,  bench_copy_auto_write },
+    { "copy_libc_read_s1",  bench_prepare_copy_sram_odd, bench_copy_libc_read  },
+    { "copy_cpu_read_s1",   bench_prepare_copy_sram_odd, bench_copy_cpu_read   },
+    { "copy_auto_read_s1",  bench_prepare_copy_sram_odd, bench_copy_auto_read  },
+    { "copy_libc_write_s1", bench_prepare_copy_sram_odd, bench_copy_libc_write },
+    { "copy_cpu_write_s1",  bench_prepare_copy_sram_odd, bench_copy_cpu_write  },
+    { "copy_auto_write_s1", bench_prepare_copy_sram_odd, bench_copy_auto_write },
+    { "copy_libc_read_x3",  bench_prepare_copy_xip_odd,  bench_copy_libc_read  },
+    { "copy_cpu_read_x3",   bench_prepare_copy_xip_odd,  bench_copy_cpu_read   },
+    { "copy_auto_read_x3",  bench_prepare_copy_xip_odd,  bench_copy_auto_read  },
+    { "copy_libc_write_x3", bench_prepare_copy_xip_odd,  bench_copy_libc_write },
+    { "copy_cpu_write_x3",  bench_prepare_copy_xip_odd,  bench_copy_cpu_write  },
+    { "copy_auto_write_x3", bench_prepare_copy_xip_odd,  bench_copy_auto_write },
+};
+
+static const uint32_t bench_copy_sizes[] = { 64u, 512u, 4096u, BENCH_COPY_MAX_SIZE };
+
+static const bench_case_t bench_ring_cases[] =
+{
+    { "ring_produce", bench_prepare_ring, bench_ring_produce },
+    { "ring_ingest",  bench_prepare_ring, bench_ring_ingest  },
+};
+
+static const uint32_t bench_ring_sizes[] = { 4096u, 65536u };
+
+static const bench_case_t bench_kv_cases[] =
+{
+    { "kv_get",  NULL, bench_kv_get  },
+    { "kv_scan", NULL, bench_kv_scan },
+    { "kv_put",  NULL, bench_kv_put  },
+};
+
+static const bench_case_t bench_verify_cases[] =
+{
+    { "verify_memcmp", bench_prepare_xip, bench_verify_memcmp },
+    { "verify_read",   bench_prepare_xip, bench_verify_read   },
+    { "verify_check",  bench_prepare_xip, bench_verify_check  },
+    { "verify_stream", bench_prepare_xip, bench_verify_compare },
+};
+
+/* SRAM-only kernels: compare two equal buffers, checksum and search one */
+static const bench_case_t bench_simd_cases[] =
+{
+    { "simd_memcmp",   NULL, bench_simd_memcmp   },
+    { "simd_compare",  NULL, bench_simd_compare  },
+    { "simd_checksum", NULL, bench_simd_checksum },
+    { "simd_find",     NULL, bench_simd_find     },
+};
+
+static const bench_case_t bench_protect_cases[] =
+{
+    { "protect_read",  bench_prepare_xip, bench_protect_read  },
+    { "protect_write", bench_prepare_xip, bench_protect_write },
+};
+
+static const uint32_t bench_protect_sizes[] = { 4096u, 65536u };
+
+/* Compressed store: the ramp in bench_sram[0] compresses well, the random
+ * data in bench_sram[1] does not. Each read follows the write it decodes. */
+static const bench_case_t bench_lz_cases[] =
+{
+    { "lz_write_ramp",   bench_prepare_xip, bench_lz_write_ramp   },
+    { "lz_read_ramp",    bench_prepare_xip, bench_lz_read         },
+    { "lz_write_random", bench_prepare_xip, bench_lz_write_random },
+    { "lz_read_random",  bench_prepare_xip, bench_lz_read         },
+};
+
+static const uint32_t bench_lz_sizes[] = { BENCH_LZ_BLOCK, BENCH_MAX_SIZE };
+
+/* Encrypted region: the smif cases with the SMIF encryption on, to compare
+ * against their plain results */
+static const bench_case_t bench_crypt_cases[] =
+{
+    { "crypt_cmd_read",  bench_prepare_command, bench_crypt_cmd_read  },
+    { "crypt_cmd_write", bench_prepare_command, bench_crypt_cmd_write },
+    { "crypt_xip_read",  bench_prepare_xip,     bench_crypt_xip_read  },
+    { "crypt_xip_write", bench_prepare_xip,     bench_crypt_xip_write },
+    { "crypt_dma_read",  bench_prepare_xip,     bench_crypt_dma_read  },
+    { "crypt_dma_write", bench_prepare_xip,     bench_crypt_dma_write },
+};
+
+/* Suites run by benchmark_run(), in report order */
+static const bench_suite_t bench_suites[] =
+{
+    bench_suite_smif,
+    bench_suite_copy,
+    bench_suite_ring,
+    bench_suite_kv,
+    bench_suite_verify,
+    bench_suite_simd,
+    bench_suite_protect,
+    bench_suite_lz,
+    bench_suite_crypt,
+#if !defined(HYPERRAM_HOST_SIM)
+    code_bench_suite,
+    mpu_bench_suite,
+#endif
+};
+
+/*******************************************************************************
+* Function Name: benchmark_run
+********************************************************************************
+* Summary:
+*  Runs every benchmark suite and prints one JSON report. The HYPERRAM must be
+*  initialized.
+*
+* Parameters:
+*  iterations - timed iterations per case and size, at most
+*               BENCH_MAX_ITERATIONS
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void benchmark_run(uint32_t iterations)
+{
+    perf_counter_init();
+    (void)hyperram_dma_init();
+
+    for (uint32_t index = 0; index < BENCH_MAX_SIZE; index++)
+    {
+        bench_sram[0][index] = (uint8_t)(index * 7u);
+    }
+
+    benchmark_report_begin();
+
+    for (uint32_t suite = 0; suite < (sizeof(bench_suites) / sizeof(bench_suites[0])); suite++)
+    {
+        bench_suites[suite](iterations);
+    }
+
+    benchmark_report_end();
+}
+
+/*******************************************************************************
+* Function Name: benchmark_measure
+********************************************************************************
+* Summary:
+*  Times one case at one size. One untimed warm-up iteration runs first.
+*  Failed iterations are counted and left out of the statistics.
+*
+* Parameters:
+*  bench_case - case to run
+*  size - bytes per iteration
+*  iterations - timed iterations, clipped to BENCH_MAX_ITERATIONS
+*  result - filled with the statistics
+*
+* Return:
+*  bool - true if at least one iteration succeeded
+*
+*******************************************************************************/
+bool benchmark_measure(const bench_case_t* bench_case, uint32_t size, uint32_t iterations,
+                       bench_result_t* result)
+{
+    uint32_t count = 0u;
+
+    if (iterations > BENCH_MAX_ITERATIONS)
+    {
+        iterations = BENCH_MAX_ITERATIONS;
+    }
+
+    memset(result, 0, sizeof(*result));
+    result->name = bench_case->name;
+    result->size = size;
+
+    if ((NULL != bench_case->prepare) && !bench_case->prepare(size))
+    {
+        result->errors = iterations;
+        return false;
+    }
+    (void)bench_case->op(size);
+
+    for (uint32_t iteration = 0; iteration < iterations; iteration++)
+    {
+        uint32_t start;
+        bool success;
+
+        if ((NULL != bench_case->prepare) && !bench_case->prepare(size))
+        {
+            result->errors++;
+            continue;
+        }
+
+        start = perf_counter_now();
+        success = bench_case->op(size);
+        bench_samples[count] = perf_counter_to_ns(perf_counter_now() - start);
+
+        if (success)
+        {
+            count++;
+        }
+        else
+        {
+            result->errors++;
+        }
+    }
+
+    result->iterations = count;
+
+    if (0u == count)
+    {
+        return false;
+    }
+
+    bench_sort(bench_samples, count);
+
+    result->min_ns = bench_samples[0];
+    result->p50_ns = bench_percentile(bench_samples, count, 50u);
+    result->p90_ns = bench_percentile(bench_samples, count, 90u);
+    result->p99_ns = bench_percentile(bench_samples, count, 99u);
+    result->max_ns = bench_samples[count - 1u];
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: benchmark_report_begin
+********************************************************************************
+* Summary:
+*  Prints the report header with the build and memory configuration.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void benchmark_report_begin(void)
+{
+    bench_first_result = true;
+
+    PLATFORM_PRINTF("\r\nBENCH-JSON-BEGIN\r\n");
+    PLATFORM_PRINTF("{\"schema\":1,\"build\":{\"config\":\"%s\",\"toolchain\":\"%s\",\"target\":\"%s\","
+                    "\"platform\":\"%s\",\"timer_hz\":%lu},\r\n",
+                    BENCH_CONFIG_NAME, BENCH_TOOLCHAIN_NAME, BENCH_TARGET_NAME, PLATFORM_NAME,
+                    (unsigned long)perf_counter_hz());
+    PLATFORM_PRINTF("\"memory\":{\"size\":%lu,\"dummy_cycles\":%u,\"cmd_chunk\":%u,\"dma_segment\":%u},\r\n",
+                    (unsigned long)HYPERRAM_SIZE, (unsigned int)HYPERRAM_DUMMY_CYCLES,
+                    (unsigned int)HYPERRAM_CMD_CHUNK, (unsigned int)HYPERRAM_DMA_MAX_SEGMENT);
+    PLATFORM_PRINTF("\"results\":[\r\n");
+    PLATFORM_FLUSH();
+}
+
+/*******************************************************************************
+* Function Name: benchmark_report_result
+********************************************************************************
+* Summary:
+*  Prints one result object. Throughput is computed from the median.
+*
+* Parameters:
+*  result - result to print
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void benchmark_report_result(const bench_result_t* result)
+{
+    uint64_t bytes_per_s = 0u;
+
+    if (0u != result->p50_ns)
+    {
+        bytes_per_s = ((uint64_t)result->size * 1000000000ULL) / result->p50_ns;
+    }
+
+    PLATFORM_PRINTF("%s{\"name\":\"%s\",\"size\":%lu,\"iterations\":%lu,\"errors\":%lu,"
+                    "\"min_ns\":%lu,\"p50_ns\":%lu,\"p90_ns\":%lu,\"p99_ns\":%lu,\"max_ns\":%lu,"
+                    "\"mbps\":%lu.%03lu}\r\n",
+                    bench_first_result ? "" : ",",
+                    result->name, (unsigned long)result->size, (unsigned long)result->iterations,
+                    (unsigned long)result->errors, (unsigned long)result->min_ns,
+                    (unsigned long)result->p50_ns, (unsigned long)result->p90_ns,
+                    (unsigned long)result->p99_ns, (unsigned long)result->max_ns,
+                    (unsigned long)(bytes_per_s / 1000000u), (unsigned long)((bytes_per_s / 1000u) % 1000u));
+    PLATFORM_FLUSH();
+
+    bench_first_result = false;
+}
+
+/*******************************************************************************
+* Function Name: benchmark_report_end
+********************************************************************************
+* Summary:
+*  Closes the JSON report.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void benchmark_report_end(void)
+{
+    PLATFORM_PRINTF("]}\r\nBENCH-JSON-END\r\n");
+    PLATFORM_FLUSH();
+}
+
+/*******************************************************************************
+* Function Name: benchmark_sram_buffer
+********************************************************************************
+* Summary:
+*  Returns one of the cache line aligned BENCH_MAX_SIZE byte SRAM buffers
+*  used by the benchmark cases. Buffer 0 holds the source pattern.
+*
+* Parameters:
+*  index - buffer index, 0 or 1
+*
+* Return:
+*  uint8_t* - buffer address
+*
+*******************************************************************************/
+uint8_t* benchmark_sram_buffer(uint32_t index)
+{
+    return bench_sram[index % BENCH_SRAM_BUFFERS];
+}
+
+/*******************************************************************************
+* Function Name: bench_suite_smif
+********************************************************************************
+* Summary:
+*  Command-mode, XIP memcpy and DMA transfers over all benchmark sizes.
+*
+* Parameters:
+*  iterations - timed iterations per case and size
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_suite_smif(uint32_t iterations)
+{
+    bench_result_t result;
+
+    for (uint32_t index = 0; index < (sizeof(bench_smif_cases) / sizeof(bench_smif_cases[0])); index++)
+    {
+        for (uint32_t size = 0; size < (sizeof(bench_sizes) / sizeof(bench_sizes[0])); size++)
+        {
+            (void)benchmark_measure(&bench_smif_cases[index], bench_sizes[size], iterations, &result);
+            benchmark_report_result(&result);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: bench_prepare_command
+********************************************************************************
+* Summary:
+*  Selects command mode so that mode switches are not timed.
+*
+* Parameters:
+*  size - unused
+*
+* Return:
+*  bool - true
+*
+*******************************************************************************/
+static bool bench_prepare_command(uint32_t size)
+{
+    (void)size;
+    hyperram_enter_command();
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: bench_prepare_xip
+********************************************************************************
+* Summary:
+*  Selects memory mode and drops the test region from the CM7 D-cache so
+*  every timed access reaches the device.
+*
+* Parameters:
+*  size - bytes the next iteration touches
+*
+* Return:
+*  bool - true
+*
+*******************************************************************************/
+static bool bench_prepare_xip(uint32_t size)
+{
+    hyperram_enter_xip();
+
+    platform_dcache_clean_invalidate(hyperram_xip_ptr(BENCH_DEVICE_OFFSET), size);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: bench_cmd_read
+********************************************************************************
+* Summary:
+*  Command-mode read into SRAM.
+*
+* Parameters:
+*  size - bytes to transfer
+*
+* Return:
+*  bool - true on success
+*
+*******************************************************************************/
+static bool bench_cmd_read(uint32_t size)
+{
+    return (HYPERRAM_SUCCESS == hyperram_read(BENCH_DEVICE_OFFSET, bench_sram[1], size));
+}
+
+/*******************************************************************************
+* Function Name: bench_cmd_write
+********************************************************************************
+* Summary:
+*  Command-mode write from SRAM.
+*
+* Parameters:
+*  size - bytes to transfer
+*
+* Return:
+*  bool - true on success
+*
+*******************************************************************************/
+static bool bench_cmd_write(uint32_t size)
+{
+    return (HYPERRAM_SUCCESS == hyperram_write(BENCH_DEVICE_OFFSET, bench_sram[0], size));
+}
+
+/*******************************************************************************
+* Function Name: bench_xip_read
+********************************************************************************
+* Summary:
+*  CPU copy from the XIP window with libc memcpy.
+*
+* Parameters:
+*  size - bytes to transfer
+*
+* Return:
+*  bool - true
+*
+*******************************************************************************/
+static bool bench_xip_read(uint32_t size)
+{
+    memcpy(bench_sram[1], hyperram_xip_ptr(BENCH_DEVICE_OFFSET), size);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: bench_xip_write
+********************************************************************************
+* Summary:
+*  CPU copy into the XIP window with libc memcpy. The D-cache is cleaned so
+*  the data reaches the device inside the timed region.
+*
+* Parameters:
+*  size - bytes to transfer
+*
+* Return:
+*  bool - true
+*
+*******************************************************************************/
+static bool bench_xip_write(uint32_t size)
+{
+    memcpy(hyperram_xip_ptr(BENCH_DEVICE_OFFSET), bench_sram[0], size);
+
+    platform_dcache_clean(hyperram_xip_ptr(BENCH_DEVICE_OFFSET), size);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: bench_dma_read
+********************************************************************************
+* Summary:
+*  DMA copy from the XIP window into SRAM.
+*
+* Parameters:
+*  size - bytes to transfer
+*
+* Return:
+*  bool - true on success
+*
+*******************************************************************************/
+static bool bench_dma_read(uint32_t size)
+{
+    return (HYPERRAM_SUCCESS == hyperram_dma_copy(bench_sram[1], hyperram_xip_ptr(BENCH_DEVICE_OFFSET), size));
+}
+
+/*******************************************************************************
+* Function Name: bench_dma_write
+********************************************************************************
+* Summary:
+*  DMA copy from SRAM into the XIP window.
+*
+* Parameters:
+*  size - bytes to transfer
+*
+* Return:
+*  bool - true on success
+*
+*******************************************************************************/
+static bool bench_dma_write(uint32_t size)
+{
+    return (HYPERRAM_SUCCESS == hyperram_dma_copy(hyperram_xip_ptr(BENCH_DEVICE_OFFSET), bench_sram[0], size));
+}
+
+/*******************************************************************************
+* Function Name: bench_dma_fill
+********************************************************************************
+* Summary:
+*  Fills the region with a constant word by DMA, with no SRAM source.
+*
+* Parameters:
+*  size - bytes to fill
+*
+* Return:
+*  bool - true on success
+*
+*******************************************************************************/
+static bool bench_dma_fill(uint32_t size)
+{
+    return (HYPERRAM_SUCCESS == hyperram_dma_fill(hyperram_xip_ptr(BENCH_DEVICE_OFFSET), 0u, size));
+}
+
+/*******************************************************************************
+* Function Name: bench_dma_pattern_fill
+********************************************************************************
+* Summary:
+*  Fills the region with the LFSR pattern, generated while the DMA runs.
+*
+* Parameters:
+*  size - bytes to fill
+*
+* Return:
+*  bool - true on success
+*
+*******************************************************************************/
+static bool bench_dma_pattern_fill(uint32_t size)
+{
+    return (HYPERRAM_SUCCESS == hyperram_dma_pattern_fill(hyperram_xip_ptr(BENCH_DEVICE_OFFSET),
+                                                          HYPERRAM_DMA_PATTERN_LFSR, 1u, size));
+}
+
+/*******************************************************************************
+* Function Name: bench_suite_copy
+********************************************************************************
+* Summary:
+*  Compares the XIP copy kernels with libc memcpy() over sizes and
+*  alignments.
+*
+* Parameters:
+*  iterations - timed iterations per case and size
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_suite_copy(uint32_t iterations)
+{
+    bench_result_t result;
+
+    for (uint32_t index = 0; index < (sizeof(bench_copy_cases) / sizeof(bench_copy_cases[0])); index++)
+    {
+        for (uint32_t size = 0; size < (sizeof(bench_copy_sizes) / sizeof(bench_copy_sizes[0])); size++)
+        {
+            (void)benchmark_measure(&bench_copy_cases[index], bench_copy_sizes[size], iterations, &result);
+            benchmark_report_result(&result);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: bench_prepare_copy_aligned
+********************************************************************************
+* Summary:
+*  Places both sides of the next copy on cache line boundaries.
+*
+* Parameters:
+*  size - bytes the next iteration touches
+*
+* Return:
+*  bool - true
+*
+*******************************************************************************/
+static bool bench_prepare_copy_aligned(uint32_t size)
+{
+    bench_copy_sram_offset = 0u;
+    bench_copy_xip_offset = 0u;
+
+    return bench_prepare_xip(size + PLATFORM_CACHE_LINE);
+}
+
+/*******************************************************************************
+* Function Name: bench_prepare_copy_sram_odd
+********************************************************************************
+* Summary:
+*  Places the SRAM side of the next copy at an odd address.
+*
+* Parameters:
+*  size - bytes the next iteration touches
+*
+* Return:
+*  bool - true
+*
+*******************************************************************************/
+static bool bench_prepare_copy_sram_odd(uint32_t size)
+{
+    bench_copy_sram_offset = 1u;
+    bench_copy_xip_offset = 0u;
+
+    return bench_prepare_xip(size + PLATFORM_CACHE_LINE);
+}
+
+/*******************************************************************************
+* Function Name: bench_prepare_copy_xip_odd
+********************************************************************************
+* Summary:
+*  Places the XIP side of the next copy at an odd address.
+*
+* Parameters:
+*  size - bytes the next iteration touches
+*
+* Return:
+*  bool - true
+*
+*******************************************************************************/
+static bool bench_prepare_copy_xip_odd(uint32_t size)
+{
+    bench_copy_sram_offset = 0u;
+    bench_copy_xip_offset = 3u;
+
+    return bench_prepare_xip(size + PLATFORM_CACHE_LINE);
+}
+
+/*******************************************************************************
+* Function Name: bench_copy_libc_read
+********************************************************************************
+* Summary:
+*  libc memcpy() from the XIP window.
+*
+* Parameters:
+*  size - bytes to transfer
+*
+* Return:
+*  bool - true
+*
+*******************************************************************************/
+static bool bench_copy_libc_read(uint32_t size)
+{
+    memcpy(&bench_sram[1][bench_copy_sram_offset],
+           hyperram_xip_ptr(BENCH_DEVICE_OFFSET + bench_copy_xip_offset), size);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: bench_copy_cpu_read
+********************************************************************************
+* Summary:
+*  CPU copy kernel from the XIP window.
+*
+* Parameters:
+*  size - bytes to transfer
+*
+* Return:
+*  bool - true
+*
+*******************************************************************************/
+static bool bench_copy_cpu_read(uint32_t size)
+{
+    xip_memcpy_cpu(&bench_sram[1][bench_copy_sram_offset],
+                   hyperram_xip_ptr(BENCH_DEVICE_OFFSET + bench_copy_xip_offset), size);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: bench_copy_auto_read
+********************************************************************************
+* Summary:
+*  xip_memcpy() from the XIP window, using the DMA above its threshold.
+*
+* Parameters:
+*  size - bytes to transfer
+*
+* Return:
+*  bool - true
+*
+*******************************************************************************/
+static bool bench_copy_auto_read(uint32_t size)
+{
+    (void)xip_memcpy(&bench_sram[1][bench_copy_sram_offset],
+                     hyperram_xip_ptr(BENCH_DEVICE_OFFSET + bench_copy_xip_offset), size);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: bench_copy_libc_write
+********************************************************************************
+* Summary:
+*  libc memcpy() into the XIP window. The D-cache is cleaned so the data
+*  reaches the device inside the timed region.
+*
+* Parameters:
+*  size - bytes to transfer
+*
+* Return:
+*  bool - true
+*
+*******************************************************************************/
+static bool bench_copy_libc_write(uint32_t size)
+{
+    void* dst = hyperram_xip_ptr(BENCH_DEVICE_OFFSET + bench_copy_xip_offset);
+
+    memcpy(dst, &bench_sram[0][bench_copy_sram_offset], size);
+
+    platform_dcache_clean(dst, size);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: bench_copy_cpu_write
+********************************************************************************
+* Summary:
+*  CPU copy kernel into the XIP window, with the D-cache cleaned as in
+*  bench_copy_libc_write().
+*
+* Parameters:
+*  size - bytes to transfer
+*
+* Return:
+*  bool - true
+*
+*******************************************************************************/
+static bool bench_copy_cpu_write(uint32_t size)
+{
+    void* dst = hyperram_xip_ptr(BENCH_DEVICE_OFFSET + bench_copy_xip_offset);
+
+    xip_memcpy_cpu(dst, &bench_sram[0][bench_copy_sram_offset], size);
+
+    platform_dcache_clean(dst, size);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: bench_copy_auto_write
+********************************************************************************
+* Summary:
+*  xip_memcpy() into the XIP window. The clean after a DMA copy finds no
+*  dirty lines but is kept so that both paths are timed alike.
+*
+* Parameters:
+*  size - bytes to transfer
+*
+* Return:
+*  bool - true
+*
+*******************************************************************************/
+static bool bench_copy_auto_write(uint32_t size)
+{
+    void* dst = hyperram_xip_ptr(BENCH_DEVICE_OFFSET + bench_copy_xip_offset);
+
+    (void)xip_memcpy(dst, &bench_sram[0][bench_copy_sram_offset], size);
+
+    platform_dcache_clean(dst, size);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: bench_suite_ring
+********************************************************************************
+* Summary:
+*  Times the HYPERRAM ring with 16-byte samples. ring_produce covers the
+*  producer calls only, with the DMA still draining afterwards. ring_ingest
+*  also waits until every sample is on the device, which gives the
+*  sustained ingest rate.
+*
+* Parameters:
+*  iterations - timed iterations per case and size
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_suite_ring(uint32_t iterations)
+{
+    bench_result_t result;
+
+    hyperram_enter_xip();
+
+    if (HYPERRAM_SUCCESS != hyperram_ring_init(&bench_ring, BENCH_RING_OFFSET, BENCH_RING_SIZE))
+    {
+        return;
+    }
+
+    for (uint32_t index = 0; index < (sizeof(bench_ring_cases) / sizeof(bench_ring_cases[0])); index++)
+    {
+        for (uint32_t size = 0; size < (sizeof(bench_ring_sizes) / sizeof(bench_ring_sizes[0])); size++)
+        {
+            (void)benchmark_measure(&bench_ring_cases[index], bench_ring_sizes[size], iterations, &result);
+            benchmark_report_result(&result);
+        }
+    }
+
+    hyperram_ring_deinit(&bench_ring);
+}
+
+/*******************************************************************************
+* Function Name: bench_prepare_ring
+********************************************************************************
+* Summary:
+*  Starts every iteration with an empty ring, so nothing is dropped.
+*
+* Parameters:
+*  size - unused
+*
+* Return:
+*  bool - true if the ring was set up again
+*
+*******************************************************************************/
+static bool bench_prepare_ring(uint32_t size)
+{
+    (void)size;
+
+    hyperram_ring_deinit(&bench_ring);
+
+    return (HYPERRAM_SUCCESS == hyperram_ring_init(&bench_ring, BENCH_RING_OFFSET, BENCH_RING_SIZE));
+}
+
+/*******************************************************************************
+* Function Name: bench_ring_produce
+********************************************************************************
+* Summary:
+*  Logs size bytes as 16-byte samples.
+*
+* Parameters:
+*  size - bytes to log
+*
+* Return:
+*  bool - true if no sample was dropped
+*
+*******************************************************************************/
+static bool bench_ring_produce(uint32_t size)
+{
+    bool accepted = true;
+
+    for (uint32_t offset = 0; offset < size; offset += BENCH_RING_SAMPLE_SIZE)
+    {
+        accepted = (0u != hyperram_ring_write(&bench_ring, &bench_sram[0][offset], BENCH_RING_SAMPLE_SIZE)) &&
+                   accepted;
+    }
+
+    return accepted;
+}
+
+/*******************************************************************************
+* Function Name: bench_ring_ingest
+********************************************************************************
+* Summary:
+*  Logs size bytes as 16-byte samples and waits until they are on the
+*  device.
+*
+* Parameters:
+*  size - bytes to log
+*
+* Return:
+*  bool - true if no sample was dropped
+*
+*******************************************************************************/
+static bool bench_ring_ingest(uint32_t size)
+{
+    bool accepted = bench_ring_produce(size);
+
+    return (HYPERRAM_SUCCESS == hyperram_ring_flush(&bench_ring, 0u)) && accepted;
+}
+
+/*******************************************************************************
+* Function Name: bench_suite_kv
+********************************************************************************
+* Summary:
+*  Times single key-value operations on a store filled to its load limit:
+*  an indexed lookup (one burst), a linear scan of the records for the same
+*  kind of key, and a batched put. Operations per second are 1e9 / p50_ns.
+*
+* Parameters:
+*  iterations - timed iterations per case
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_suite_kv(uint32_t iterations)
+{
+    bench_result_t result;
+
+    hyperram_enter_xip();
+
+    if (HYPERRAM_SUCCESS != kv_store_init(&bench_kv, BENCH_KV_OFFSET, BENCH_KV_CAPACITY,
+                                          BENCH_KV_VALUE_SIZE, bench_kv_index, true))
+    {
+        return;
+    }
+
+    for (uint32_t key = 0; key < BENCH_KV_KEYS; key++)
+    {
+        (void)kv_store_put(&bench_kv, (key * 2654435761UL) | 1u, &bench_sram[0][key % 256u]);
+    }
+    (void)kv_store_flush(&bench_kv);
+
+    bench_kv_state = 1u;
+    for (uint32_t index = 0; index < (sizeof(bench_kv_cases) / sizeof(bench_kv_cases[0])); index++)
+    {
+        (void)benchmark_measure(&bench_kv_cases[index], BENCH_KV_VALUE_SIZE, iterations, &result);
+        benchmark_report_result(&result);
+    }
+
+    kv_store_deinit(&bench_kv);
+}
+
+/*******************************************************************************
+* Function Name: bench_kv_next_key
+********************************************************************************
+* Summary:
+*  Returns a pseudo-random key of the preloaded set.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t - key
+*
+*******************************************************************************/
+static uint32_t bench_kv_next_key(void)
+{
+    bench_kv_state = (bench_kv_state * 1664525UL) + 1013904223UL;
+
+    return (((bench_kv_state >> 8) % BENCH_KV_KEYS) * 2654435761UL) | 1u;
+}
+
+/*******************************************************************************
+* Function Name: bench_kv_get
+********************************************************************************
+* Summary:
+*  Indexed lookup of one key.
+*
+* Parameters:
+*  size - unused, always the value size
+*
+* Return:
+*  bool - true if the key was found
+*
+*******************************************************************************/
+static bool bench_kv_get(uint32_t size)
+{
+    (void)size;
+
+    return kv_store_get(&bench_kv, bench_kv_next_key(), bench_sram[1]);
+}
+
+/*******************************************************************************
+* Function Name: bench_kv_scan
+********************************************************************************
+* Summary:
+*  Lookup of one key by scanning the records, the no-index baseline.
+*
+* Parameters:
+*  size - unused, always the value size
+*
+* Return:
+*  bool - true if the key was found
+*
+*******************************************************************************/
+static bool bench_kv_scan(uint32_t size)
+{
+    (void)size;
+
+    return kv_store_scan(&bench_kv, bench_kv_next_key(), bench_sram[1]);
+}
+
+/*******************************************************************************
+* Function Name: bench_kv_put
+********************************************************************************
+* Summary:
+*  Replaces the value of one key. Most calls only fill the write batch;
+*  every batch-full call also pays for the write-back.
+*
+* Parameters:
+*  size - unused, always the value size
+*
+* Return:
+*  bool - true on success
+*
+*******************************************************************************/
+static bool bench_kv_put(uint32_t size)
+{
+    (void)size;
+
+    return (HYPERRAM_SUCCESS == kv_store_put(&bench_kv, bench_kv_next_key(), bench_sram[0]));
+}
+
+/*******************************************************************************
+* Function Name: bench_suite_verify
+********************************************************************************
+* Summary:
+*  Compares ways of checking a written block: a DMA read-back followed by
+*  memcmp() against the source, a read-back whose CRC-32 is computed while
+*  the DMA runs, a CRC-32 computed straight over the XIP window, and a
+*  streamed read-back compared word-parallel against the source. The
+*  reference digest of each size is taken while the block is written.
+*
+* Parameters:
+*  iterations - timed iterations per case and size
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_suite_verify(uint32_t iterations)
+{
+    bench_result_t result;
+
+    hyperram_enter_xip();
+
+    if (HYPERRAM_SUCCESS != hyperram_verify_init())
+    {
+        return;
+    }
+
+    for (uint32_t size = 0; size < (sizeof(bench_sizes) / sizeof(bench_sizes[0])); size++)
+    {
+        if (HYPERRAM_SUCCESS != hyperram_verify_write(BENCH_DEVICE_OFFSET, bench_sram[0], bench_sizes[size],
+                                                      &bench_verify_crc))
+        {
+            return;
+        }
+
+        for (uint32_t index = 0; index < (sizeof(bench_verify_cases) / sizeof(bench_verify_cases[0])); index++)
+        {
+            (void)benchmark_measure(&bench_verify_cases[index], bench_sizes[size], iterations, &result);
+            benchmark_report_result(&result);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: bench_verify_memcmp
+********************************************************************************
+* Summary:
+*  Reads the block back by DMA and compares it byte by byte.
+*
+* Parameters:
+*  size - bytes to check
+*
+* Return:
+*  bool - true if the block matches the source
+*
+*******************************************************************************/
+static bool bench_verify_memcmp(uint32_t size)
+{
+    return (HYPERRAM_SUCCESS == hyperram_dma_copy(bench_sram[1], hyperram_xip_ptr(BENCH_DEVICE_OFFSET), size)) &&
+           (0 == memcmp(bench_sram[0], bench_sram[1], size));
+}
+
+/*******************************************************************************
+* Function Name: bench_verify_read
+********************************************************************************
+* Summary:
+*  Reads the block back by DMA with the digest computed on the way.
+*
+* Parameters:
+*  size - bytes to check
+*
+* Return:
+*  bool - true if the digest matches the reference
+*
+*******************************************************************************/
+static bool bench_verify_read(uint32_t size)
+{
+    uint32_t crc;
+
+    return (HYPERRAM_SUCCESS == hyperram_verify_read(bench_sram[1], BENCH_DEVICE_OFFSET, size, &crc)) &&
+           (crc == bench_verify_crc);
+}
+
+/*******************************************************************************
+* Function Name: bench_verify_check
+********************************************************************************
+* Summary:
+*  Checks the block in place against the reference digest.
+*
+* Parameters:
+*  size - bytes to check
+*
+* Return:
+*  bool - true if the digest matches the reference
+*
+*******************************************************************************/
+static bool bench_verify_check(uint32_t size)
+{
+    return (HYPERRAM_SUCCESS == hyperram_verify_check(BENCH_DEVICE_OFFSET, size, bench_verify_crc));
+}
+
+/*******************************************************************************
+* Function Name: bench_verify_compare
+********************************************************************************
+* Summary:
+*  Streams the block back by DMA and compares each chunk with the source
+*  while the next one is in flight.
+*
+* Parameters:
+*  size - bytes to check
+*
+* Return:
+*  bool - true if the block matches the source
+*
+*******************************************************************************/
+static bool bench_verify_compare(uint32_t size)
+{
+    return (HYPERRAM_SUCCESS == hyperram_verify_compare(BENCH_DEVICE_OFFSET, bench_sram[0], size, NULL));
+}
+
+/*******************************************************************************
+* Function Name: bench_suite_simd
+********************************************************************************
+* Summary:
+*  Times the word-parallel kernels against memcmp() on SRAM buffers, so the
+*  CPU cost is seen without the transfer.
+*
+* Parameters:
+*  iterations - timed iterations per case and size
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_suite_simd(uint32_t iterations)
+{
+    bench_result_t result;
+
+    memcpy(bench_sram[1], bench_sram[0], BENCH_MAX_SIZE);
+
+    for (uint32_t index = 0; index < (sizeof(bench_simd_cases) / sizeof(bench_simd_cases[0])); index++)
+    {
+        for (uint32_t size = 0; size < (sizeof(bench_sizes) / sizeof(bench_sizes[0])); size++)
+        {
+            (void)benchmark_measure(&bench_simd_cases[index], bench_sizes[size], iterations, &result);
+            benchmark_report_result(&result);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: bench_simd_memcmp
+********************************************************************************
+* Summary:
+*  libc memcmp() of two equal buffers.
+*
+* Parameters:
+*  size - bytes to compare
+*
+* Return:
+*  bool - true if the buffers match
+*
+*******************************************************************************/
+static bool bench_simd_memcmp(uint32_t size)
+{
+    return (0 == memcmp(bench_sram[0], bench_sram[1], size));
+}
+
+/*******************************************************************************
+* Function Name: bench_simd_compare
+********************************************************************************
+* Summary:
+*  simd_first_diff() of two equal buffers.
+*
+* Parameters:
+*  size - bytes to compare
+*
+* Return:
+*  bool - true if the buffers match
+*
+*******************************************************************************/
+static bool bench_simd_compare(uint32_t size)
+{
+    return (size == simd_first_diff(bench_sram[0], bench_sram[1], size));
+}
+
+/*******************************************************************************
+* Function Name: bench_simd_checksum
+********************************************************************************
+* Summary:
+*  Byte sum and XOR checksum of a buffer.
+*
+* Parameters:
+*  size - bytes to checksum
+*
+* Return:
+*  bool - true
+*
+*******************************************************************************/
+static bool bench_simd_checksum(uint32_t size)
+{
+    simd_checksum_t checksum;
+
+    simd_checksum_init(&checksum);
+    simd_checksum_update(&checksum, bench_sram[0], size);
+
+    return (checksum.position == size);
+}
+
+/*******************************************************************************
+* Function Name: bench_simd_find
+********************************************************************************
+* Summary:
+*  Searches a buffer for a word it does not contain, so the whole buffer is
+*  scanned.
+*
+* Parameters:
+*  size - bytes to search
+*
+* Return:
+*  bool - true if the word was not found
+*
+*******************************************************************************/
+static bool bench_simd_find(uint32_t size)
+{
+    return (size == simd_find_word(bench_sram[0], size, 0xFFFFFFFFUL));
+}
+
+/*******************************************************************************
+* Function Name: bench_suite_protect
+********************************************************************************
+* Summary:
+*  Times reads and writes of a CRC protected region with 1 KB blocks. The
+*  overhead of the protection is the difference to dma_read and dma_write
+*  of the same size.
+*
+* Parameters:
+*  iterations - timed iterations per case and size
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_suite_protect(uint32_t iterations)
+{
+    bench_result_t result;
+
+    hyperram_enter_xip();
+
+    if (HYPERRAM_SUCCESS != hyperram_protect_init(&bench_protect, BENCH_DEVICE_OFFSET, BENCH_MAX_SIZE,
+                                                  BENCH_PROTECT_BLOCK, bench_protect_table, true))
+    {
+        return;
+    }
+
+    for (uint32_t index = 0; index < (sizeof(bench_protect_cases) / sizeof(bench_protect_cases[0])); index++)
+    {
+        for (uint32_t size = 0; size < (sizeof(bench_protect_sizes) / sizeof(bench_protect_sizes[0])); size++)
+        {
+            (void)benchmark_measure(&bench_protect_cases[index], bench_protect_sizes[size], iterations, &result);
+            benchmark_report_result(&result);
+        }
+    }
+
+    hyperram_protect_deinit(&bench_protect);
+}
+
+/*******************************************************************************
+* Function Name: bench_protect_read
+********************************************************************************
+* Summary:
+*  Reads whole blocks from the protected region, checking each CRC.
+*
+* Parameters:
+*  size - bytes to read
+*
+* Return:
+*  bool - true if every block was intact
+*
+*******************************************************************************/
+static bool bench_protect_read(uint32_t size)
+{
+    return (HYPERRAM_SUCCESS == hyperram_protect_read(&bench_protect, bench_sram[1], 0u, size));
+}
+
+/*******************************************************************************
+* Function Name: bench_protect_write
+********************************************************************************
+* Summary:
+*  Writes whole blocks to the protected region, updating their CRCs.
+*
+* Parameters:
+*  size - bytes to write
+*
+* Return:
+*  bool - true on success
+*
+*******************************************************************************/
+static bool bench_protect_write(uint32_t size)
+{
+    return (HYPERRAM_SUCCESS == hyperram_protect_write(&bench_protect, 0u, bench_sram[0], size));
+}
+
+/*******************************************************************************
+* Function Name: bench_suite_lz
+********************************************************************************
+* Summary:
+*  Times whole-block writes and reads through a compressed store with 4 KB
+*  blocks. Throughput counts block bytes, so it is the effective bandwidth
+*  to compare with dma_write and dma_read.
+*
+* Parameters:
+*  iterations - timed iterations per case and size
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_suite_lz(uint32_t iterations)
+{
+    bench_result_t result;
+    uint32_t state = 1u;
+
+    hyperram_enter_xip();
+
+    if (HYPERRAM_SUCCESS != hyperram_lz_init(&bench_lz, BENCH_DEVICE_OFFSET, BENCH_MAX_SIZE,
+                                             BENCH_LZ_BLOCK, bench_lz_index))
+    {
+        return;
+    }
+
+    for (uint32_t index = 0; index < (sizeof(bench_lz_cases) / sizeof(bench_lz_cases[0])); index++)
+    {
+        /* The ramp reads overwrite bench_sram[1], so the random data is
+         * generated just before it is written */
+        if (bench_lz_write_random == bench_lz_cases[index].op)
+        {
+            for (uint32_t offset = 0; offset < BENCH_MAX_SIZE; offset++)
+            {
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                bench_sram[1][offset] = (uint8_t)state;
+            }
+        }
+
+        for (uint32_t size = 0; size < (sizeof(bench_lz_sizes) / sizeof(bench_lz_sizes[0])); size++)
+        {
+            (void)benchmark_measure(&bench_lz_cases[index], bench_lz_sizes[size], iterations, &result);
+            benchmark_report_result(&result);
+        }
+    }
+
+    hyperram_lz_deinit(&bench_lz);
+}
+
+/*******************************************************************************
+* Function Name: bench_lz_write
+********************************************************************************
+* Summary:
+*  Writes whole blocks to the compressed store and waits for the last one
+*  to reach the device.
+*
+* Parameters:
+*  src - block data
+*  size - bytes to write, whole blocks
+*
+* Return:
+*  bool - true on success
+*
+*******************************************************************************/
+static bool bench_lz_write(const uint8_t* src, uint32_t size)
+{
+    bool ok = true;
+
+    for (uint32_t block = 0; block < (size / BENCH_LZ_BLOCK); block++)
+    {
+        ok = (HYPERRAM_SUCCESS == hyperram_lz_write(&bench_lz, block, &src[block * BENCH_LZ_BLOCK])) && ok;
+    }
+
+    return (HYPERRAM_SUCCESS == hyperram_lz_flush(&bench_lz)) && ok;
+}
+
+/*******************************************************************************
+* Function Name: bench_lz_read
+********************************************************************************
+* Summary:
+*  Reads whole blocks from the compressed store into bench_sram[1].
+*
+* Parameters:
+*  size - bytes to read, whole blocks
+*
+* Return:
+*  bool - true on success
+*
+*******************************************************************************/
+static bool bench_lz_read(uint32_t size)
+{
+    bool ok = true;
+
+    for (uint32_t block = 0; block < (size / BENCH_LZ_BLOCK); block++)
+    {
+        ok = (HYPERRAM_SUCCESS == hyperram_lz_read(&bench_lz, block, &bench_sram[1][block * BENCH_LZ_BLOCK])) && ok;
+    }
+
+    return ok;
+}
+
+/*******************************************************************************
+* Function Name: bench_lz_write_ramp
+********************************************************************************
+* Summary:
+*  Writes the compressible ramp from bench_sram[0].
+*
+* Parameters:
+*  size - bytes to write
+*
+* Return:
+*  bool - true on success
+*
+*******************************************************************************/
+static bool bench_lz_write_ramp(uint32_t size)
+{
+    return bench_lz_write(bench_sram[0], size);
+}
+
+/*******************************************************************************
+* Function Name: bench_lz_write_random
+********************************************************************************
+* Summary:
+*  Writes the random data from bench_sram[1]; every block is stored raw.
+*
+* Parameters:
+*  size - bytes to write
+*
+* Return:
+*  bool - true on success
+*
+*******************************************************************************/
+static bool bench_lz_write_random(uint32_t size)
+{
+    return bench_lz_write(bench_sram[1], size);
+}
+
+/*******************************************************************************
+* Function Name: bench_suite_crypt
+********************************************************************************
+* Summary:
+*  Runs the encrypted counterparts of the smif cases over an encrypted
+*  region at the test offset. The timed operations include the cache
+*  maintenance and the switching of the encryption that each one needs.
+*
+* Parameters:
+*  iterations - repetitions per case and size
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_suite_crypt(uint32_t iterations)
+{
+    static const uint32_t key[HYPERRAM_CRYPTO_KEY_WORDS] =
+        { 0x2B7E1516UL, 0x28AED2A6UL, 0xABF71588UL, 0x09CF4F3CUL };
+    static const uint32_t nonce[HYPERRAM_CRYPTO_NONCE_WORDS] = { 0xF0F1F2F3UL, 0xF4F5F6F7UL, 0xF8F9FAFBUL };
+    bench_result_t result;
+
+    if ((HYPERRAM_SUCCESS != hyperram_crypt_init(key, nonce)) ||
+        (HYPERRAM_SUCCESS != hyperram_crypt_add_region(BENCH_DEVICE_OFFSET, BENCH_MAX_SIZE)))
+    {
+        return;
+    }
+
+    for (uint32_t index = 0; index < (sizeof(bench_crypt_cases) / sizeof(bench_crypt_cases[0])); index++)
+    {
+        for (uint32_t size = 0; size < (sizeof(bench_sizes) / sizeof(bench_sizes[0])); size++)
+        {
+            (void)benchmark_measure(&bench_crypt_cases[index], bench_sizes[size], iterations, &result);
+            benchmark_report_result(&result);
+        }
+    }
+
+    hyperram_crypt_deinit();
+}
+
+/*******************************************************************************
+* Function Name: bench_crypt_dma_read
+********************************************************************************
+* Summary:
+*  DMA copy from the XIP window into SRAM, decrypted by the SMIF.
+*
+* Parameters:
+*  size - bytes to transfer
+*
+* Return:
+*  bool - true on success
+*
+*******************************************************************************/
+static bool bench_crypt_dma_read(uint32_t size)
+{
+    return (HYPERRAM_SUCCESS == hyperram_crypt_read(bench_sram[1], BENCH_DEVICE_OFFSET, size));
+}
+
+/*******************************************************************************
+* Function Name: bench_crypt_dma_write
+********************************************************************************
+* Summary:
+*  DMA copy from SRAM into the XIP window, encrypted by the SMIF.
+*
+* Parameters:
+*  size - bytes to transfer
+*
+* Return:
+*  bool - true on success
+*
+*******************************************************************************/
+static bool bench_crypt_dma_write(uint32_t size)
+{
+    return (HYPERRAM_SUCCESS == hyperram_crypt_write(BENCH_DEVICE_OFFSET, bench_sram[0], size));
+}
+
+/*******************************************************************************
+* Function Name: bench_crypt_xip_read
+********************************************************************************
+* Summary:
+*  CPU copy from the XIP window with libc memcpy, inside an encryption
+*  bracket.
+*
+* Parameters:
+*  size - bytes to transfer
+*
+* Return:
+*  bool - true
+*
+*******************************************************************************/
+static bool bench_crypt_xip_read(uint32_t size)
+{
+    hyperram_crypt_begin(BENCH_DEVICE_OFFSET, size);
+    memcpy(bench_sram[1], hyperram_xip_ptr(BENCH_DEVICE_OFFSET), size);
+    hyperram_crypt_end(BENCH_DEVICE_OFFSET, size);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: bench_crypt_xip_write
+********************************************************************************
+* Summary:
+*  CPU copy into the XIP window with libc memcpy, inside an encryption
+*  bracket. Ending the bracket writes the data back to the device.
+*
+* Parameters:
+*  size - bytes to transfer
+*
+* Return:
+*  bool - true
+*
+*******************************************************************************/
+static bool bench_crypt_xip_write(uint32_t size)
+{
+    hyperram_crypt_begin(BENCH_DEVICE_OFFSET, size);
+    memcpy(hyperram_xip_ptr(BENCH_DEVICE_OFFSET), bench_sram[0], size);
+    hyperram_crypt_end(BENCH_DEVICE_OFFSET, size);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: bench_crypt_cmd_read
+********************************************************************************
+* Summary:
+*  Command-mode read into SRAM, decrypted with the SMIF crypto engine.
+*
+* Parameters:
+*  size - bytes to transfer
+*
+* Return:
+*  bool - true on success
+*
+*******************************************************************************/
+static bool bench_crypt_cmd_read(uint32_t size)
+{
+    return (HYPERRAM_SUCCESS == hyperram_crypt_read_command(bench_sram[1], BENCH_DEVICE_OFFSET, size));
+}
+
+/*******************************************************************************
+* Function Name: bench_crypt_cmd_write
+********************************************************************************
+* Summary:
+*  Command-mode write from SRAM, encrypted with the SMIF crypto engine.
+*
+* Parameters:
+*  size - bytes to transfer
+*
+* Return:
+*  bool - true on success
+*
+*******************************************************************************/
+static bool bench_crypt_cmd_write(uint32_t size)
+{
+    return (HYPERRAM_SUCCESS == hyperram_crypt_write_command(BENCH_DEVICE_OFFSET, bench_sram[0], size));
+}
+
+/*******************************************************************************
+* Function Name: bench_sort
+********************************************************************************
+* Summary:
+*  Sorts samples in ascending order (insertion sort; sample counts are small).
+*
+* Parameters:
+*  samples - samples to sort
+*  count - number of samples
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_sort(uint32_t* samples, uint32_t count)
+{
+    for (uint32_t index = 1; index < count; index++)
+    {
+        uint32_t value = samples[index];
+        uint32_t position = index;
+
+        while ((position > 0u) && (samples[position - 1u] > value))
+        {
+            samples[position] = samples[position - 1u];
+            position--;
+        }
+
+        samples[position] = value;
+    }
+}
+
+/*******************************************************************************
+* Function Name: bench_percentile
+********************************************************************************
+* Summary:
+*  Nearest-rank percentile of sorted samples.
+*
+* Parameters:
+*  sorted - samples in ascending order
+*  count - number of samples, at least 1
+*  percent - percentile, 0 to 100
+*
+* Return:
+*  uint32_t - sample at the percentile
+*
+*******************************************************************************/
+static uint32_t bench_percentile(const uint32_t* sorted, uint32_t count, uint32_t percent)
+{
+    uint32_t rank = ((percent * count) + 99u) / 100u;
+
+    return sorted[(rank > 0u) ? (rank - 1u) : 0u];
+}
+
+/* [] END OF FILE */
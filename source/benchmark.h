@@ -0,0 +1,109 @@
+/*******************************************************************************
+* File Name:   benchmark.h
+*
+* Description: Benchmark runner for the HYPERRAM access paths. Each case is timed
+* per iteration with the cycle counter and reported as a JSON document
+* between BENCH-JSON-BEGIN and BENCH-JSON-END lines, which
+* tools/bench_compare.py extracts and compares against a baseline.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+#define BENCH_MAX_SIZE                  (65536u)
+#define BENCH_MAX_ITERATIONS            (256u)
+#define BENCH_DEFAULT_ITERATIONS        (64u)
+
+/* Device region used by the built-in cases */
+#define BENCH_DEVICE_OFFSET             (0x00100000UL)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+/* One timed (op) or untimed (prepare) step; returns false on failure */
+typedef bool (*bench_op_t)(uint32_t size);
+
+typedef struct
+{
+    const char* name;
+    bench_op_t prepare;         /* runs before every iteration, may be NULL */
+    bench_op_t op;
+} bench_case_t;
+
+typedef struct
+{
+    const char* name;
+    uint32_t size;              /* bytes moved per iteration */
+    uint32_t iterations;
+    uint32_t errors;
+    uint32_t min_ns;
+    uint32_t p50_ns;
+    uint32_t p90_ns;
+    uint32_t p99_ns;
+    uint32_t max_ns;
+} bench_result_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void benchmark_run(uint32_t iterations);
+bool benchmark_measure(const bench_case_t* bench_case, uint32_t size, uint32_t iterations,
+                       bench_result_t* result);
+void benchmark_report_begin(void);
+void benchmark_report_result(const bench_result_t* result);
+void benchmark_report_end(void);
+uint8_t* benchmark_sram_buffer(uint32_t index);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* BENCHMARK_H */
+
+/* [] END OF FILE */
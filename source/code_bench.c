@@ -0,0 +1,386 @@
+/*******************************************************************************
+* File Name:   code_bench.c
+*
+* Description: Code placement benchmark, see code_bench.h. Every kernel body is a forced
+* inline function wrapped by one entry point per location, so the copies
+* are identical apart from where they are linked.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+/* Long calls out of the overlay kernels */
+#define OVERLAY_SOURCE_FILE
+#include "overlay.h"
+#include "cy_pdl.h"
+#include "cycfg.h"
+#include "platform.h"
+#include "code_bench.h"
+#include "code_placement.h"
+#include "benchmark.h"
+#include "hyperram.h"
+#include <stdio.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+#define CODE_BENCH_WORDS                (256u)
+#define CODE_BENCH_FIR_TAPS             (16u)
+#define CODE_BENCH_FIR_OUTPUTS          (CODE_BENCH_WORDS - CODE_BENCH_FIR_TAPS)
+#define CODE_BENCH_PROGRAM_SIZE         (512u)
+#define CODE_BENCH_NAME_SIZE            (48u)
+#define CODE_BENCH_LOCATIONS            (4u)
+
+/* One entry point per location around a kernel body, plus an overlay stub */
+#define CODE_BENCH_VARIANTS(kernel)                                                     \
+    CODE_IN_FLASH static uint32_t kernel##_flash(void) { return kernel##_body(); }      \
+    CODE_IN_ITCM static uint32_t kernel##_itcm(void) { return kernel##_body(); }        \
+    CODE_IN_HYPERRAM static uint32_t kernel##_hyperram(void) { return kernel##_body(); } \
+    OVERLAY_CODE(code_bench) static uint32_t kernel##_paged_overlay(void) { return kernel##_body(); } \
+    static OVERLAY_STUB(code_bench, uint32_t, kernel##_paged, (void), ())
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef uint32_t (*code_bench_fn_t)(void);
+
+typedef struct
+{
+    const char* name;
+    uint32_t bytes;             /* input bytes processed per call */
+    code_bench_fn_t variants[CODE_BENCH_LOCATIONS]; /* flash, ITCM, HYPERRAM, overlay */
+} code_bench_kernel_t;
+
+typedef struct
+{
+    const char* name;
+    bool smif_cache;
+    bool cold;                  /* invalidate the CM7 I-cache before every call */
+} code_bench_config_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void code_bench_setup(void);
+static bool code_bench_prepare(uint32_t size);
+static bool code_bench_call(uint32_t size);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+static uint32_t code_bench_input[CODE_BENCH_WORDS];
+static uint32_t code_bench_output[CODE_BENCH_WORDS];
+static int16_t code_bench_samples[CODE_BENCH_WORDS];
+static uint8_t code_bench_program[CODE_BENCH_PROGRAM_SIZE];
+
+static const int16_t code_bench_taps[CODE_BENCH_FIR_TAPS] =
+{
+    -12, 35, -81, 160, -290, 520, -1030, 4800, 4800, -1030, 520, -290, 160, -81, 35, -12,
+};
+
+OVERLAY_GROUP(code_bench);
+
+static const code_bench_config_t* code_bench_config;
+static code_bench_fn_t code_bench_function;
+static uint32_t code_bench_expected;
+
+/*******************************************************************************
+* Kernel Bodies
+*******************************************************************************/
+
+/* Bitwise CRC-32: short loop, branch free, compute bound */
+__STATIC_FORCEINLINE uint32_t code_bench_crc32_body(void)
+{
+    const uint8_t* bytes = (const uint8_t*)code_bench_input;
+    uint32_t crc = 0xFFFFFFFFUL;
+
+    for (uint32_t index = 0; index < sizeof(code_bench_input); index++)
+    {
+        crc ^= bytes[index];
+        for (uint32_t bit = 0; bit < 8u; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0u - (crc & 1u)));
+        }
+    }
+
+    return ~crc;
+}
+
+/* 16-tap integer FIR: multiply-accumulate over a sliding window */
+__STATIC_FORCEINLINE uint32_t code_bench_fir_body(void)
+{
+    uint32_t checksum = 0u;
+
+    for (uint32_t output = 0; output < CODE_BENCH_FIR_OUTPUTS; output++)
+    {
+        int32_t acc = 0;
+
+        for (uint32_t tap = 0; tap < CODE_BENCH_FIR_TAPS; tap++)
+        {
+            acc += (int32_t)code_bench_samples[output + tap] * code_bench_taps[tap];
+        }
+        checksum += (uint32_t)acc;
+    }
+
+    return checksum;
+}
+
+/* Word copy with a transform: load/store bound */
+__STATIC_FORCEINLINE uint32_t code_bench_copy_body(void)
+{
+    for (uint32_t index = 0; index < CODE_BENCH_WORDS; index++)
+    {
+        code_bench_output[index] = code_bench_input[index] ^ 0x5A5A5A5AUL;
+    }
+
+    return code_bench_output[CODE_BENCH_WORDS - 1u];
+}
+
+/* Byte code interpreter: large switch, poor code locality */
+__STATIC_FORCEINLINE uint32_t code_bench_interp_body(void)
+{
+    uint32_t acc = 1u;
+    uint32_t aux = 0x12345678UL;
+
+    for (uint32_t pc = 0; pc < CODE_BENCH_PROGRAM_SIZE; pc++)
+    {
+        uint8_t op = code_bench_program[pc];
+
+        switch (op & 15u)
+        {
+            case 0u:  acc += op;                         break;
+            case 1u:  acc -= aux;                        break;
+            case 2u:  acc ^= aux << 3;                   break;
+            case 3u:  acc = (acc << 5) | (acc >> 27);    break;
+            case 4u:  aux += acc * 3u;                   break;
+            case 5u:  aux ^= acc >> 7;                   break;
+            case 6u:  acc *= 2654435761UL;               break;
+            case 7u:  acc = (acc & 1u) ? (acc >> 1) : (acc * 3u + 1u); break;
+            case 8u:  aux = (aux >> 11) | (aux << 21);   break;
+            case 9u:  acc += code_bench_input[op];       break;
+            case 10u: acc ^= code_bench_input[aux & 0xFFu]; break;
+            case 11u: aux -= op * 17u;                   break;
+            case 12u: acc = ~acc + aux;                  break;
+            case 13u: aux = (aux * 5u) ^ acc;            break;
+            case 14u: if (acc > aux) { acc -= aux; } else { aux -= acc; } break;
+            default:  acc ^= pc;                         break;
+        }
+    }
+
+    return acc ^ aux;
+}
+
+CODE_BENCH_VARIANTS(code_bench_crc32)
+CODE_BENCH_VARIANTS(code_bench_fir)
+CODE_BENCH_VARIANTS(code_bench_copy)
+CODE_BENCH_VARIANTS(code_bench_interp)
+
+static const code_bench_kernel_t code_bench_kernels[] =
+{
+    { "crc32",  sizeof(code_bench_input),
+      { code_bench_crc32_flash, code_bench_crc32_itcm, code_bench_crc32_hyperram, code_bench_crc32_paged } },
+    { "fir16",  sizeof(code_bench_samples),
+      { code_bench_fir_flash, code_bench_fir_itcm, code_bench_fir_hyperram, code_bench_fir_paged } },
+    { "copy",   sizeof(code_bench_input),
+      { code_bench_copy_flash, code_bench_copy_itcm, code_bench_copy_hyperram, code_bench_copy_paged } },
+    { "interp", sizeof(code_bench_program),
+      { code_bench_interp_flash, code_bench_interp_itcm, code_bench_interp_hyperram,
+        code_bench_interp_paged } },
+};
+
+static const code_bench_config_t code_bench_configs[] =
+{
+    { "smif_on/warm",  true,  false },
+    { "smif_on/cold",  true,  true  },
+    { "smif_off/warm", false, false },
+    { "smif_off/cold", false, true  },
+};
+
+static const bench_case_t code_bench_case = { NULL, code_bench_prepare, code_bench_call };
+
+/*******************************************************************************
+* Function Name: code_bench_suite
+********************************************************************************
+* Summary:
+*  Times every kernel from every location under every cache configuration.
+*  Results are named "code:<kernel>/<location>/<config>". Apart from the
+*  overlay, the location is taken from the function address, so a section
+*  that the linker did not place as intended shows up in the report. Iterations whose result differs
+*  from the flash copy are counted as errors. The SMIF cache is left disabled.
+*
+* Parameters:
+*  iterations - timed iterations per result
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void code_bench_suite(uint32_t iterations)
+{
+    char name[CODE_BENCH_NAME_SIZE];
+    bench_result_t result;
+    bench_case_t bench_case = code_bench_case;
+
+    code_bench_setup();
+    hyperram_enter_xip();
+    (void)overlay_init();
+
+    for (uint32_t config = 0; config < (sizeof(code_bench_configs) / sizeof(code_bench_configs[0])); config++)
+    {
+        code_bench_config = &code_bench_configs[config];
+
+        Cy_SMIF_CacheInvalidate(SMIF_HW, CY_SMIF_CACHE_BOTH);
+        if (code_bench_config->smif_cache)
+        {
+            Cy_SMIF_CacheEnable(SMIF_HW, CY_SMIF_CACHE_BOTH);
+        }
+        else
+        {
+            Cy_SMIF_CacheDisable(SMIF_HW, CY_SMIF_CACHE_BOTH);
+        }
+
+        for (uint32_t kernel = 0; kernel < (sizeof(code_bench_kernels) / sizeof(code_bench_kernels[0])); kernel++)
+        {
+            const code_bench_kernel_t* entry = &code_bench_kernels[kernel];
+
+            code_bench_expected = entry->variants[0]();
+
+            for (uint32_t location = 0; location < CODE_BENCH_LOCATIONS; location++)
+            {
+                code_bench_function = entry->variants[location];
+
+                /* The overlay stub itself is in flash */
+                (void)snprintf(name, sizeof(name), "code:%s/%s/%s", entry->name,
+                               (location == (CODE_BENCH_LOCATIONS - 1u)) ? "overlay" :
+                               code_placement_region_name((const void*)code_bench_function),
+                               code_bench_config->name);
+                bench_case.name = name;
+
+                (void)benchmark_measure(&bench_case, entry->bytes, iterations, &result);
+                benchmark_report_result(&result);
+            }
+        }
+    }
+
+    Cy_SMIF_CacheInvalidate(SMIF_HW, CY_SMIF_CACHE_BOTH);
+    Cy_SMIF_CacheDisable(SMIF_HW, CY_SMIF_CACHE_BOTH);
+}
+
+/*******************************************************************************
+* Function Name: code_bench_setup
+********************************************************************************
+* Summary:
+*  Fills the kernel inputs with a fixed pseudo-random sequence.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void code_bench_setup(void)
+{
+    uint32_t state = 0x9E3779B9UL;
+
+    for (uint32_t index = 0; index < CODE_BENCH_WORDS; index++)
+    {
+        state = (state * 1664525UL) + 1013904223UL;
+        code_bench_input[index] = state;
+        code_bench_samples[index] = (int16_t)(state >> 16);
+    }
+
+    for (uint32_t index = 0; index < CODE_BENCH_PROGRAM_SIZE; index++)
+    {
+        state = (state * 1664525UL) + 1013904223UL;
+        code_bench_program[index] = (uint8_t)(state >> 24);
+    }
+}
+
+/*******************************************************************************
+* Function Name: code_bench_prepare
+********************************************************************************
+* Summary:
+*  For the cold configurations, drops the CM7 I-cache and the loaded
+*  overlays so that the call fetches its code from the memory it is placed
+*  in, and the overlay variants include the load.
+*
+* Parameters:
+*  size - unused
+*
+* Return:
+*  bool - true
+*
+*******************************************************************************/
+static bool code_bench_prepare(uint32_t size)
+{
+    (void)size;
+
+    if (code_bench_config->cold)
+    {
+        SCB_InvalidateICache();
+        overlay_flush();
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: code_bench_call
+********************************************************************************
+* Summary:
+*  Calls the kernel under test and checks its result against the flash copy.
+*
+* Parameters:
+*  size - unused
+*
+* Return:
+*  bool - true if the result matched
+*
+*******************************************************************************/
+static bool code_bench_call(uint32_t size)
+{
+    (void)size;
+
+    return (code_bench_function() == code_bench_expected);
+}
+
+/* [] END OF FILE */
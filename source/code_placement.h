@@ -0,0 +1,126 @@
+/*******************************************************************************
+* File Name:   code_placement.h
+*
+* Description: Attributes that choose where a function executes from. CODE_IN_FLASH keeps
+* the default code flash placement, CODE_IN_ITCM uses the BSP .cy_itcm
+* section that the startup code copies into the CM7 ITCM, and
+* CODE_IN_HYPERRAM links the function into the HYPERRAM section that
+* hyperram_sections.c loads before main(). All three prevent inlining, so
+* the placement holds for every call.
+*
+* Functions moved to ITCM or HYPERRAM should not call code in other regions
+* through a direct branch; the branch range of BL is +/-16 MB.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CODE_PLACEMENT_H
+#define CODE_PLACEMENT_H
+
+#include <stdint.h>
+#if !defined(HYPERRAM_HOST_SIM)
+#include "cy_pdl.h"
+#endif
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+#if defined(HYPERRAM_HOST_SIM)
+#define CODE_IN_FLASH                   __attribute__((noinline))
+#define CODE_IN_ITCM                    __attribute__((noinline))
+#define CODE_IN_HYPERRAM                __attribute__((noinline))
+#else
+#define CODE_IN_FLASH                   CY_NOINLINE
+#define CODE_IN_ITCM                    CY_SECTION(".cy_itcm") CY_NOINLINE
+#if defined(HYPERRAM_SECTIONS)
+#define CODE_IN_HYPERRAM                CY_SECTION(".hyperram_text") CY_NOINLINE
+#else
+#define CODE_IN_HYPERRAM                CY_NOINLINE
+#endif
+#endif
+
+/* CM7 address map used to tell where a function actually ended up */
+#define CODE_ITCM_BASE                  (0x00000000UL)
+#define CODE_ITCM_SIZE                  (0x00010000UL)
+#define CODE_FLASH_BASE                 (0x10000000UL)
+#define CODE_FLASH_SIZE                 (0x00830000UL)
+#define CODE_XIP_BASE                   (0x60000000UL)
+#define CODE_XIP_SIZE                   (0x01000000UL)
+
+/*******************************************************************************
+* Function Name: code_placement_region_name
+********************************************************************************
+* Summary:
+*  Names the memory a function or object is located in.
+*
+* Parameters:
+*  address - function or object address
+*
+* Return:
+*  const char* - "itcm", "flash", "hyperram" or "sram"
+*
+*******************************************************************************/
+static inline const char* code_placement_region_name(const void* address)
+{
+    uintptr_t value = (uintptr_t)address & ~(uintptr_t)1u;  /* drop the Thumb bit */
+
+    if ((value - CODE_ITCM_BASE) < CODE_ITCM_SIZE)
+    {
+        return "itcm";
+    }
+    if ((value - CODE_FLASH_BASE) < CODE_FLASH_SIZE)
+    {
+        return "flash";
+    }
+    if ((value - CODE_XIP_BASE) < CODE_XIP_SIZE)
+    {
+        return "hyperram";
+    }
+
+    return "sram";
+}
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CODE_PLACEMENT_H */
+
+/* [] END OF FILE */
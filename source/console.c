@@ -0,0 +1,421 @@
+/*******************************************************************************
+* File Name:   console.c
+*
+* Description: Non-blocking console backend. A single producer (thread context)
+* appends to an SRAM ring without locks; the UART TX_DONE interrupt retires
+* the bytes DMA has sent and starts the next contiguous block.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include "cyhal.h"
+#include "cy_retarget_io.h"
+#include "platform.h"
+#include "console.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+#define CONSOLE_RING_MASK               (CONSOLE_RING_SIZE - 1u)
+
+#if (0u != (CONSOLE_RING_SIZE & CONSOLE_RING_MASK))
+#error "CONSOLE_RING_SIZE must be a power of two"
+#endif
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+CY_ALIGN(PLATFORM_CACHE_LINE) static uint8_t console_ring[CONSOLE_RING_SIZE];
+
+/* Free running indexes: head is only written by the producer, tail only by
+ * the UART interrupt. */
+static volatile uint32_t console_head;
+static volatile uint32_t console_tail;
+
+/* Bytes currently owned by the DMA, 0 when the UART is idle */
+static volatile uint32_t console_in_flight;
+
+static volatile uint32_t console_dropped;
+static bool console_active;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void console_start_transfer(void);
+static void console_uart_callback(void* callback_arg, cyhal_uart_event_t event);
+
+/*******************************************************************************
+* Function Name: console_init
+********************************************************************************
+* Summary:
+*  Switches the retarget-io UART to DMA driven asynchronous transmission and
+*  routes console output through the ring. Must be called after
+*  cy_retarget_io_init*(). Until then, console output blocks like printf.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true if the DMA backend is active
+*
+*******************************************************************************/
+bool console_init(void)
+{
+    cy_rslt_t result;
+
+    console_head = 0u;
+    console_tail = 0u;
+    console_in_flight = 0u;
+    console_dropped = 0u;
+
+    result = cyhal_uart_set_async_mode(&cy_retarget_io_uart_obj, CYHAL_ASYNC_DMA,
+                                       CYHAL_DMA_PRIORITY_DEFAULT);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        cyhal_uart_register_callback(&cy_retarget_io_uart_obj, console_uart_callback, NULL);
+        cyhal_uart_enable_event(&cy_retarget_io_uart_obj, CYHAL_UART_IRQ_TX_DONE,
+                                CYHAL_ISR_PRIORITY_DEFAULT, true);
+        console_active = true;
+    }
+
+    return console_active;
+}
+
+/*******************************************************************************
+* Function Name: console_is_active
+********************************************************************************
+* Summary:
+*  Reports whether output goes through the DMA ring.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true once console_init() has succeeded
+*
+*******************************************************************************/
+bool console_is_active(void)
+{
+    return console_active;
+}
+
+/*******************************************************************************
+* Function Name: console_printf
+********************************************************************************
+* Summary:
+*  Formats a message and queues it for transmission. Messages longer than
+*  CONSOLE_LINE_MAX - 1 characters are truncated. If the ring cannot hold the
+*  whole message it is dropped and counted.
+*
+* Parameters:
+*  format - printf style format string
+*  ... - format arguments
+*
+* Return:
+*  int - number of characters queued, or -1 if the message was dropped
+*
+*******************************************************************************/
+int console_printf(const char* format, ...)
+{
+    char line[CONSOLE_LINE_MAX];
+    va_list args;
+    int length;
+
+    va_start(args, format);
+    length = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+
+    if (length < 0)
+    {
+        return length;
+    }
+
+    if ((uint32_t)length >= sizeof(line))
+    {
+        length = (int)(sizeof(line) - 1u);
+    }
+
+    return console_write(line, (uint32_t)length) ? length : -1;
+}
+
+/*******************************************************************************
+* Function Name: console_write
+********************************************************************************
+* Summary:
+*  Queues raw bytes. The write is all-or-nothing so that binary frames are
+*  never truncated. Before console_init() the bytes are written blocking.
+*
+* Parameters:
+*  data - bytes to send
+*  size - number of bytes
+*
+* Return:
+*  bool - true if the bytes were queued, false if they were dropped
+*
+*******************************************************************************/
+bool console_write(const void* data, uint32_t size)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint32_t head;
+    uint32_t offset;
+    uint32_t first;
+
+    if (0u == size)
+    {
+        return true;
+    }
+
+    if (!console_active)
+    {
+        size_t length = size;
+        return (CY_RSLT_SUCCESS == cyhal_uart_write(&cy_retarget_io_uart_obj, (void*)data, &length));
+    }
+
+    if (size > console_free())
+    {
+        console_dropped++;
+        return false;
+    }
+
+    head   = console_head;
+    offset = head & CONSOLE_RING_MASK;
+    first  = CONSOLE_RING_SIZE - offset;
+
+    if (first > size)
+    {
+        first = size;
+    }
+
+    memcpy(&console_ring[offset], bytes, first);
+    memcpy(&console_ring[0], &bytes[first], size - first);
+
+    /* Publish the data before the index that makes it visible to the ISR */
+    __DMB();
+    console_head = head + size;
+
+    if (0u == console_in_flight)
+    {
+        uint32_t saved_intr = cyhal_system_critical_section_enter();
+
+        if (0u == console_in_flight)
+        {
+            console_start_transfer();
+        }
+
+        cyhal_system_critical_section_exit(saved_intr);
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: console_reserve
+********************************************************************************
+* Summary:
+*  Checks that a message made of several console_write() calls fits in the
+*  ring. Space only grows between calls from the single producer, so the
+*  following writes are guaranteed to succeed. A failed reservation counts as
+*  one dropped message.
+*
+* Parameters:
+*  size - total number of bytes about to be written
+*
+* Return:
+*  bool - true if the message fits
+*
+*******************************************************************************/
+bool console_reserve(uint32_t size)
+{
+    if (console_active && (size > console_free()))
+    {
+        console_dropped++;
+        return false;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: console_free
+********************************************************************************
+* Summary:
+*  Returns the free space in the ring.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t - number of bytes that can be queued without dropping
+*
+*******************************************************************************/
+uint32_t console_free(void)
+{
+    return CONSOLE_RING_SIZE - (console_head - console_tail);
+}
+
+/*******************************************************************************
+* Function Name: console_flush
+********************************************************************************
+* Summary:
+*  Waits until every queued byte has been handed to the UART. Interrupts must
+*  be enabled. A transfer that failed to start is retried here, so the wait
+*  does not depend on a later console_write().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void console_flush(void)
+{
+    while (console_active && (console_head != console_tail))
+    {
+        if (0u == console_in_flight)
+        {
+            uint32_t saved_intr = cyhal_system_critical_section_enter();
+
+            if (0u == console_in_flight)
+            {
+                console_start_transfer();
+            }
+
+            cyhal_system_critical_section_exit(saved_intr);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: console_get_dropped
+********************************************************************************
+* Summary:
+*  Returns the number of messages dropped because the ring was full.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t - dropped message count
+*
+*******************************************************************************/
+uint32_t console_get_dropped(void)
+{
+    return console_dropped;
+}
+
+/*******************************************************************************
+* Function Name: console_start_transfer
+********************************************************************************
+* Summary:
+*  Hands the next contiguous block of the ring to the UART DMA. Called from
+*  the TX_DONE interrupt or from a critical section while the UART is idle.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void console_start_transfer(void)
+{
+    uint32_t tail = console_tail;
+    uint32_t pending = console_head - tail;
+    uint32_t offset = tail & CONSOLE_RING_MASK;
+    uint32_t length = CONSOLE_RING_SIZE - offset;
+
+    if (0u == pending)
+    {
+        return;
+    }
+
+    if (length > pending)
+    {
+        length = pending;
+    }
+
+    /* The DMA reads SRAM directly; push the CPU's view of the block out of
+     * the D-cache first. */
+    platform_dcache_clean(&console_ring[offset], length);
+
+    console_in_flight = length;
+
+    if (CY_RSLT_SUCCESS != cyhal_uart_write_async(&cy_retarget_io_uart_obj,
+                                                  &console_ring[offset], length))
+    {
+        /* Leave the data queued; the next write or flush retries the transfer */
+        console_in_flight = 0u;
+    }
+}
+
+/*******************************************************************************
+* Function Name: console_uart_callback
+********************************************************************************
+* Summary:
+*  UART event handler. Retires the block that just completed and chains the
+*  next one.
+*
+* Parameters:
+*  callback_arg - unused
+*  event - UART events that occurred
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void console_uart_callback(void* callback_arg, cyhal_uart_event_t event)
+{
+    (void)callback_arg;
+
+    if (0u != (event & CYHAL_UART_IRQ_TX_DONE))
+    {
+        console_tail = console_tail + console_in_flight;
+        console_in_flight = 0u;
+        console_start_transfer();
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,83 @@
+/*******************************************************************************
+* File Name:   console.h
+*
+* Description: Buffered, non-blocking console output. Text is formatted into a
+* lock-free SRAM ring and drained to the debug UART by DMA, so logging from
+* timing-sensitive code costs a vsnprintf and a copy instead of a UART wait.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* Ring size in bytes, must be a power of two */
+#ifndef CONSOLE_RING_SIZE
+#define CONSOLE_RING_SIZE               (4096u)
+#endif
+
+/* Longest message produced by a single console_printf call */
+#define CONSOLE_LINE_MAX                (256u)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool console_init(void);
+bool console_is_active(void);
+int console_printf(const char* format, ...);
+bool console_write(const void* data, uint32_t size);
+bool console_reserve(uint32_t size);
+uint32_t console_free(void);
+void console_flush(void);
+uint32_t console_get_dropped(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CONSOLE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,75 @@
+/*******************************************************************************
+* File Name:   crc.h
+*
+* Description: Table driven software CRC routines shared by the telemetry
+* framing and the host tools.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CRC_H
+#define CRC_H
+
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* CRC-16/CCITT-FALSE: poly 0x1021, init 0xFFFF, no reflection, no final XOR */
+#define CRC16_CCITT_INIT        (0xFFFFu)
+
+/* CRC-32 (IEEE 802.3): poly 0x04C11DB7 reflected, init and final XOR 0xFFFFFFFF */
+#define CRC32_INIT              (0xFFFFFFFFUL)
+#define CRC32_FINAL_XOR         (0xFFFFFFFFUL)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+uint16_t crc16_ccitt_update(uint16_t crc, const void* data, uint32_t size);
+uint32_t crc32_update(uint32_t crc, const void* data, uint32_t size);
+uint32_t crc32_compute(const void* data, uint32_t size);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CRC_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,319 @@
+/*******************************************************************************
+* File Name:   dma_buffer.c
+*
+* Description: Cache line aligned DMA buffer pool, see dma_buffer.h. The pool is a
+* bitmap of 32-byte units; the length of each allocation is recorded at
+* its first unit.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include "platform.h"
+#include "dma_buffer.h"
+#include "hyperram_dma.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+#define DMA_BUFFER_UNITS                (DMA_BUFFER_POOL_SIZE / DMA_BUFFER_ALIGN)
+#define DMA_BUFFER_BITMAP_WORDS         ((DMA_BUFFER_UNITS + 31u) / 32u)
+
+#define DMA_BUFFER_UNIT_USED(unit)      (0u != (dma_buffer_bitmap[(unit) / 32u] & (1UL << ((unit) % 32u))))
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void dma_buffer_mark(uint32_t first, uint32_t count, bool used);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+CY_ALIGN(DMA_BUFFER_ALIGN) static uint8_t dma_buffer_pool[DMA_BUFFER_POOL_SIZE];
+static uint32_t dma_buffer_bitmap[DMA_BUFFER_BITMAP_WORDS];     /* set bit = unit in use */
+static uint16_t dma_buffer_length[DMA_BUFFER_UNITS];            /* units, at the first unit */
+static dma_buffer_stats_t dma_buffer_stats;
+
+/*******************************************************************************
+* Function Name: dma_buffer_alloc
+********************************************************************************
+* Summary:
+*  Returns a buffer that starts on a D-cache line and owns every line it
+*  touches. First fit over the pool.
+*
+* Parameters:
+*  size - requested bytes
+*
+* Return:
+*  void* - buffer, or NULL if size is 0 or no run of free lines is long
+*          enough
+*
+*******************************************************************************/
+void* dma_buffer_alloc(uint32_t size)
+{
+    uint32_t count = (size + (DMA_BUFFER_ALIGN - 1u)) / DMA_BUFFER_ALIGN;
+    uint32_t run = 0u;
+
+    if ((0u == size) || (count > DMA_BUFFER_UNITS))
+    {
+        dma_buffer_stats.failed_count++;
+        return NULL;
+    }
+
+    for (uint32_t unit = 0; unit < DMA_BUFFER_UNITS; unit++)
+    {
+        /* Skip fully used words */
+        if ((0u == (unit % 32u)) && (0xFFFFFFFFUL == dma_buffer_bitmap[unit / 32u]))
+        {
+            run = 0u;
+            unit += 31u;
+            continue;
+        }
+
+        run = DMA_BUFFER_UNIT_USED(unit) ? 0u : (run + 1u);
+
+        if (run == count)
+        {
+            uint32_t first = unit + 1u - count;
+
+            dma_buffer_mark(first, count, true);
+            dma_buffer_length[first] = (uint16_t)count;
+
+            dma_buffer_stats.alloc_count++;
+            dma_buffer_stats.used_bytes += count * DMA_BUFFER_ALIGN;
+            if (dma_buffer_stats.used_bytes > dma_buffer_stats.peak_used_bytes)
+            {
+                dma_buffer_stats.peak_used_bytes = dma_buffer_stats.used_bytes;
+            }
+
+            return &dma_buffer_pool[first * DMA_BUFFER_ALIGN];
+        }
+    }
+
+    dma_buffer_stats.failed_count++;
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: dma_buffer_free
+********************************************************************************
+* Summary:
+*  Returns a buffer to the pool. NULL is ignored; pointers that were not
+*  returned by dma_buffer_alloc(), or were already freed, are counted and
+*  otherwise ignored.
+*
+* Parameters:
+*  buffer - buffer to release
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void dma_buffer_free(void* buffer)
+{
+    uint32_t offset;
+    uint32_t first;
+
+    if (NULL == buffer)
+    {
+        return;
+    }
+
+    if (((uintptr_t)buffer < (uintptr_t)dma_buffer_pool) ||
+        ((uintptr_t)buffer >= ((uintptr_t)dma_buffer_pool + DMA_BUFFER_POOL_SIZE)))
+    {
+        dma_buffer_stats.invalid_free_count++;
+        return;
+    }
+
+    offset = (uint32_t)((uint8_t*)buffer - dma_buffer_pool);
+    first = offset / DMA_BUFFER_ALIGN;
+
+    if ((0u != (offset % DMA_BUFFER_ALIGN)) || (0u == dma_buffer_length[first]))
+    {
+        dma_buffer_stats.invalid_free_count++;
+        return;
+    }
+
+    dma_buffer_stats.used_bytes -= (uint32_t)dma_buffer_length[first] * DMA_BUFFER_ALIGN;
+    dma_buffer_mark(first, dma_buffer_length[first], false);
+    dma_buffer_length[first] = 0u;
+}
+
+/*******************************************************************************
+* Function Name: dma_buffer_is_aligned
+********************************************************************************
+* Summary:
+*  Checks that a range starts and ends on D-cache line boundaries, so that
+*  a DMA transfer into it cannot disturb other data.
+*
+* Parameters:
+*  buffer - start of the range
+*  size - length of the range in bytes
+*
+* Return:
+*  bool - true if both ends are line aligned
+*
+*******************************************************************************/
+bool dma_buffer_is_aligned(const void* buffer, uint32_t size)
+{
+    return (0u == ((((uintptr_t)buffer) | size) & (PLATFORM_CACHE_LINE - 1u)));
+}
+
+/*******************************************************************************
+* Function Name: dma_buffer_read
+********************************************************************************
+* Summary:
+*  Reads a HYPERRAM range straight into a buffer by DMA. The SMIF must be
+*  in memory mode. The buffer lines are invalidated before and after the
+*  transfer; nothing outside the buffer is touched.
+*
+* Parameters:
+*  buffer - line aligned destination, such as one from dma_buffer_alloc()
+*  address - device offset
+*  size - number of bytes
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM for a buffer that
+*                      shares a line with other data or a range outside the
+*                      device, or HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t dma_buffer_read(void* buffer, uint32_t address, uint32_t size)
+{
+    if ((0u != ((uintptr_t)buffer & (PLATFORM_CACHE_LINE - 1u))) || (address > HYPERRAM_SIZE) ||
+        (size > (HYPERRAM_SIZE - address)))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    return hyperram_dma_copy(buffer, hyperram_xip_ptr(address), size);
+}
+
+/*******************************************************************************
+* Function Name: dma_buffer_write
+********************************************************************************
+* Summary:
+*  Writes a buffer straight to the HYPERRAM by DMA. The SMIF must be in
+*  memory mode. Only the buffer lines are cleaned before the transfer.
+*
+* Parameters:
+*  address - device offset
+*  buffer - source
+*  size - number of bytes
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM for a range
+*                      outside the device, or HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t dma_buffer_write(uint32_t address, const void* buffer, uint32_t size)
+{
+    if ((address > HYPERRAM_SIZE) || (size > (HYPERRAM_SIZE - address)))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    return hyperram_dma_copy(hyperram_xip_ptr(address), buffer, size);
+}
+
+/*******************************************************************************
+* Function Name: dma_buffer_get_stats
+********************************************************************************
+* Summary:
+*  Returns the pool usage counters.
+*
+* Parameters:
+*  stats - filled with the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void dma_buffer_get_stats(dma_buffer_stats_t* stats)
+{
+    uint32_t run = 0u;
+
+    *stats = dma_buffer_stats;
+    stats->pool_size = DMA_BUFFER_POOL_SIZE;
+    stats->largest_free = 0u;
+
+    for (uint32_t unit = 0; unit < DMA_BUFFER_UNITS; unit++)
+    {
+        run = DMA_BUFFER_UNIT_USED(unit) ? 0u : (run + 1u);
+        if ((run * DMA_BUFFER_ALIGN) > stats->largest_free)
+        {
+            stats->largest_free = run * DMA_BUFFER_ALIGN;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: dma_buffer_mark
+********************************************************************************
+* Summary:
+*  Sets or clears a run of units in the bitmap.
+*
+* Parameters:
+*  first - first unit
+*  count - number of units
+*  used - true to mark in use
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void dma_buffer_mark(uint32_t first, uint32_t count, bool used)
+{
+    for (uint32_t unit = first; unit < (first + count); unit++)
+    {
+        if (used)
+        {
+            dma_buffer_bitmap[unit / 32u] |= (1UL << (unit % 32u));
+        }
+        else
+        {
+            dma_buffer_bitmap[unit / 32u] &= ~(1UL << (unit % 32u));
+        }
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,98 @@
+/*******************************************************************************
+* File Name:   dma_buffer.h
+*
+* Description: DMA buffers in SRAM. Every buffer starts on a D-cache line and is padded
+* to whole lines, so it never shares a line with other data and the cache
+* maintenance around a transfer can be limited to the buffer itself.
+* dma_buffer_read() and dma_buffer_write() move data between a buffer and
+* the HYPERRAM by DMA with no intermediate copy. Not reentrant.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef DMA_BUFFER_H
+#define DMA_BUFFER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hyperram.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+#ifndef DMA_BUFFER_POOL_SIZE
+#define DMA_BUFFER_POOL_SIZE            (16384u)
+#endif
+
+/* Allocation unit, one D-cache line */
+#define DMA_BUFFER_ALIGN                (32u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef struct
+{
+    uint32_t pool_size;
+    uint32_t used_bytes;
+    uint32_t peak_used_bytes;
+    uint32_t largest_free;
+    uint32_t alloc_count;
+    uint32_t failed_count;
+    uint32_t invalid_free_count;
+} dma_buffer_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void* dma_buffer_alloc(uint32_t size);
+void dma_buffer_free(void* buffer);
+bool dma_buffer_is_aligned(const void* buffer, uint32_t size);
+hyperram_status_t dma_buffer_read(void* buffer, uint32_t address, uint32_t size);
+hyperram_status_t dma_buffer_write(uint32_t address, const void* buffer, uint32_t size);
+void dma_buffer_get_stats(dma_buffer_stats_t* stats);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* DMA_BUFFER_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,619 @@
+/*******************************************************************************
+* File Name:   far_array.c
+*
+* Description: Far arrays with an SRAM page cache, see far_array.h. Pages are found
+* through a small hash table keyed by device offset; each array also keeps
+* the page it used last, which catches most sequential accesses before the
+* lookup.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include "platform.h"
+#include "far_array.h"
+#include "hyperram_dma.h"
+#include "perf_counter.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+#define FAR_PAGE_NONE                   (0xFFu)
+#define FAR_TAG_NONE                    (0xFFFFFFFFUL)
+#define FAR_PAGE_MASK                   (FAR_ARRAY_PAGE_SIZE - 1u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef struct
+{
+    uint32_t tag;               /* device offset of the page, FAR_TAG_NONE when free */
+    uint32_t last_use;          /* LRU stamp */
+    uint8_t next;               /* next page in the same bucket */
+    bool dirty;
+} far_page_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint32_t far_hash(uint32_t tag);
+static uint32_t far_lookup(uint32_t tag);
+static void far_unlink(uint32_t page);
+static uint32_t far_fault(uint32_t tag);
+static hyperram_status_t far_writeback(uint32_t page);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+CY_ALIGN(PLATFORM_CACHE_LINE) static uint8_t far_pool[FAR_ARRAY_PAGES][FAR_ARRAY_PAGE_SIZE];
+static far_page_t far_pages[FAR_ARRAY_PAGES];
+static uint8_t far_buckets[FAR_ARRAY_HASH_BUCKETS];
+static uint32_t far_clock;
+
+static far_array_stats_t far_stats;
+static uint64_t far_fill_total_ns;
+static uint64_t far_writeback_total_ns;
+
+/*******************************************************************************
+* Function Name: far_array_pool_init
+********************************************************************************
+* Summary:
+*  Empties the page pool without writing anything back and sets up the DMA
+*  channel. Call it once before using any far array.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM if the pool
+*                      configuration is invalid, or HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t far_array_pool_init(void)
+{
+    if ((0u != (FAR_ARRAY_PAGE_SIZE & FAR_PAGE_MASK)) || (0u != (FAR_ARRAY_PAGE_SIZE % PLATFORM_CACHE_LINE)) ||
+        (0u == FAR_ARRAY_PAGES) || (FAR_ARRAY_PAGES >= FAR_PAGE_NONE))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    for (uint32_t page = 0; page < FAR_ARRAY_PAGES; page++)
+    {
+        far_pages[page].tag = FAR_TAG_NONE;
+        far_pages[page].last_use = 0u;
+        far_pages[page].next = FAR_PAGE_NONE;
+        far_pages[page].dirty = false;
+    }
+    memset(far_buckets, FAR_PAGE_NONE, sizeof(far_buckets));
+
+    memset(&far_stats, 0, sizeof(far_stats));
+    far_fill_total_ns = 0u;
+    far_writeback_total_ns = 0u;
+    far_clock = 0u;
+
+    perf_counter_init();
+
+    return hyperram_dma_init();
+}
+
+/*******************************************************************************
+* Function Name: far_array_init
+********************************************************************************
+* Summary:
+*  Describes an array stored in the HYPERRAM. The contents are not touched.
+*  Elements never straddle a page, so the element size must be a power of
+*  two no larger than a page and the offset a multiple of it.
+*
+* Parameters:
+*  array - array descriptor to fill
+*  offset - device offset of element 0
+*  elem_size - element size in bytes
+*  count - number of elements
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS or HYPERRAM_BAD_PARAM
+*
+*******************************************************************************/
+hyperram_status_t far_array_init(far_array_t* array, uint32_t offset, uint32_t elem_size, uint32_t count)
+{
+    uint32_t shift = 0u;
+
+    if ((0u == elem_size) || (0u != (elem_size & (elem_size - 1u))) || (elem_size > FAR_ARRAY_PAGE_SIZE) ||
+        (0u != (offset & (elem_size - 1u))))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    while ((1UL << shift) < elem_size)
+    {
+        shift++;
+    }
+
+    if ((offset > HYPERRAM_SIZE) || (count > ((HYPERRAM_SIZE - offset) >> shift)))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    array->offset = offset;
+    array->count = count;
+    array->elem_size = elem_size;
+    array->elem_shift = shift;
+    array->page = 0u;
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: far_array_ref
+********************************************************************************
+* Summary:
+*  Returns a pointer to an element in the page pool, loading its page if
+*  needed. A write reference marks the page dirty, so the page is written
+*  back before it is replaced. The pointer is valid until the next far
+*  array call that misses.
+*
+* Parameters:
+*  array - array descriptor
+*  index - element index
+*  write - true if the element will be modified
+*
+* Return:
+*  void* - element in SRAM, or NULL if the index is out of range or the
+*          page could not be loaded
+*
+*******************************************************************************/
+void* far_array_ref(far_array_t* array, uint32_t index, bool write)
+{
+    uint32_t address;
+    uint32_t tag;
+    uint32_t page = array->page;
+
+    if (index >= array->count)
+    {
+        return NULL;
+    }
+
+    address = array->offset + (index << array->elem_shift);
+    tag = address & ~FAR_PAGE_MASK;
+
+    if ((page >= FAR_ARRAY_PAGES) || (far_pages[page].tag != tag))
+    {
+        page = far_lookup(tag);
+
+        if (FAR_PAGE_NONE == page)
+        {
+            page = far_fault(tag);
+
+            if (FAR_PAGE_NONE == page)
+            {
+                return NULL;
+            }
+        }
+        else
+        {
+            far_stats.hits++;
+        }
+        array->page = page;
+    }
+    else
+    {
+        far_stats.hits++;
+    }
+
+    far_pages[page].last_use = ++far_clock;
+    if (write)
+    {
+        far_pages[page].dirty = true;
+    }
+
+    return &far_pool[page][address & FAR_PAGE_MASK];
+}
+
+/*******************************************************************************
+* Function Name: far_array_read
+********************************************************************************
+* Summary:
+*  Copies one element out of the array.
+*
+* Parameters:
+*  array - array descriptor
+*  index - element index
+*  value - receives elem_size bytes
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM for an index out
+*                      of range, or HYPERRAM_ERROR if the page fill failed
+*
+*******************************************************************************/
+hyperram_status_t far_array_read(far_array_t* array, uint32_t index, void* value)
+{
+    const void* element;
+
+    if (index >= array->count)
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    element = far_array_ref(array, index, false);
+    if (NULL == element)
+    {
+        return HYPERRAM_ERROR;
+    }
+
+    memcpy(value, element, array->elem_size);
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: far_array_write
+********************************************************************************
+* Summary:
+*  Copies one element into the array. The HYPERRAM is updated when the page
+*  is replaced or flushed.
+*
+* Parameters:
+*  array - array descriptor
+*  index - element index
+*  value - elem_size bytes to store
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM for an index out
+*                      of range, or HYPERRAM_ERROR if the page fill failed
+*
+*******************************************************************************/
+hyperram_status_t far_array_write(far_array_t* array, uint32_t index, const void* value)
+{
+    void* element;
+
+    if (index >= array->count)
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    element = far_array_ref(array, index, true);
+    if (NULL == element)
+    {
+        return HYPERRAM_ERROR;
+    }
+
+    memcpy(element, value, array->elem_size);
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: far_array_flush
+********************************************************************************
+* Summary:
+*  Writes every dirty page back to the HYPERRAM. The pages stay in the pool.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS or HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t far_array_flush(void)
+{
+    hyperram_status_t status = HYPERRAM_SUCCESS;
+
+    for (uint32_t page = 0; page < FAR_ARRAY_PAGES; page++)
+    {
+        if (far_pages[page].dirty && (HYPERRAM_SUCCESS != far_writeback(page)))
+        {
+            status = HYPERRAM_ERROR;
+        }
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: far_array_invalidate
+********************************************************************************
+* Summary:
+*  Writes back the dirty pages and empties the pool, so that later accesses
+*  see data written to the HYPERRAM by other means.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, or HYPERRAM_ERROR if a write-back
+*                      failed; such pages stay in the pool
+*
+*******************************************************************************/
+hyperram_status_t far_array_invalidate(void)
+{
+    hyperram_status_t status = far_array_flush();
+
+    for (uint32_t page = 0; page < FAR_ARRAY_PAGES; page++)
+    {
+        if ((FAR_TAG_NONE != far_pages[page].tag) && !far_pages[page].dirty)
+        {
+            far_unlink(page);
+        }
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: far_array_get_stats
+********************************************************************************
+* Summary:
+*  Returns the page pool counters and timings.
+*
+* Parameters:
+*  stats - filled with the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void far_array_get_stats(far_array_stats_t* stats)
+{
+    *stats = far_stats;
+    stats->fill_avg_ns = (0u != far_stats.misses) ? (uint32_t)(far_fill_total_ns / far_stats.misses) : 0u;
+    stats->writeback_avg_ns = (0u != far_stats.writebacks) ?
+        (uint32_t)(far_writeback_total_ns / far_stats.writebacks) : 0u;
+    stats->dirty_pages = 0u;
+    stats->used_pages = 0u;
+
+    for (uint32_t page = 0; page < FAR_ARRAY_PAGES; page++)
+    {
+        if (FAR_TAG_NONE != far_pages[page].tag)
+        {
+            stats->used_pages++;
+            stats->dirty_pages += far_pages[page].dirty ? 1u : 0u;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: far_array_print_stats
+********************************************************************************
+* Summary:
+*  Prints the page pool statistics on the console.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void far_array_print_stats(void)
+{
+    far_array_stats_t stats;
+    uint32_t accesses;
+
+    far_array_get_stats(&stats);
+    accesses = stats.hits + stats.misses;
+
+    PLATFORM_PRINTF("FAR pages=%lu/%u x %u bytes dirty=%lu hits=%lu misses=%lu hit rate=%lu.%lu%% writebacks=%lu\r\n",
+                    (unsigned long)stats.used_pages, (unsigned int)FAR_ARRAY_PAGES,
+                    (unsigned int)FAR_ARRAY_PAGE_SIZE, (unsigned long)stats.dirty_pages,
+                    (unsigned long)stats.hits, (unsigned long)stats.misses,
+                    (unsigned long)((0u != accesses) ? (((uint64_t)stats.hits * 100u) / accesses) : 0u),
+                    (unsigned long)((0u != accesses) ? ((((uint64_t)stats.hits * 1000u) / accesses) % 10u) : 0u),
+                    (unsigned long)stats.writebacks);
+    PLATFORM_PRINTF("FAR fill avg=%luns max=%luns writeback avg=%luns\r\n",
+                    (unsigned long)stats.fill_avg_ns, (unsigned long)stats.fill_max_ns,
+                    (unsigned long)stats.writeback_avg_ns);
+    PLATFORM_FLUSH();
+}
+
+/*******************************************************************************
+* Function Name: far_hash
+********************************************************************************
+* Summary:
+*  Maps a page tag to a bucket.
+*
+* Parameters:
+*  tag - device offset of the page
+*
+* Return:
+*  uint32_t - bucket index
+*
+*******************************************************************************/
+static uint32_t far_hash(uint32_t tag)
+{
+    uint32_t number = tag / FAR_ARRAY_PAGE_SIZE;
+
+    return (number ^ (number >> 6) ^ (number >> 12)) & (FAR_ARRAY_HASH_BUCKETS - 1u);
+}
+
+/*******************************************************************************
+* Function Name: far_lookup
+********************************************************************************
+* Summary:
+*  Finds the pool page holding a tag.
+*
+* Parameters:
+*  tag - device offset of the page
+*
+* Return:
+*  uint32_t - page index, or FAR_PAGE_NONE
+*
+*******************************************************************************/
+static uint32_t far_lookup(uint32_t tag)
+{
+    uint32_t page = far_buckets[far_hash(tag)];
+
+    while ((FAR_PAGE_NONE != page) && (far_pages[page].tag != tag))
+    {
+        page = far_pages[page].next;
+    }
+
+    return page;
+}
+
+/*******************************************************************************
+* Function Name: far_unlink
+********************************************************************************
+* Summary:
+*  Removes a page from its bucket and marks it free.
+*
+* Parameters:
+*  page - page index, must hold a tag
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void far_unlink(uint32_t page)
+{
+    uint8_t* link = &far_buckets[far_hash(far_pages[page].tag)];
+
+    while (*link != page)
+    {
+        link = &far_pages[*link].next;
+    }
+    *link = far_pages[page].next;
+
+    far_pages[page].tag = FAR_TAG_NONE;
+    far_pages[page].next = FAR_PAGE_NONE;
+    far_pages[page].dirty = false;
+}
+
+/*******************************************************************************
+* Function Name: far_fault
+********************************************************************************
+* Summary:
+*  Loads a page into the pool. Takes a free page or the least recently used
+*  one, writing it back first if it is dirty.
+*
+* Parameters:
+*  tag - device offset of the page to load
+*
+* Return:
+*  uint32_t - page index, or FAR_PAGE_NONE if the write-back or fill failed
+*
+*******************************************************************************/
+static uint32_t far_fault(uint32_t tag)
+{
+    uint32_t victim = 0u;
+    uint32_t oldest = 0u;
+    uint32_t start;
+    uint32_t elapsed;
+
+    for (uint32_t page = 0; page < FAR_ARRAY_PAGES; page++)
+    {
+        if (FAR_TAG_NONE == far_pages[page].tag)
+        {
+            victim = page;
+            break;
+        }
+
+        /* Stamps wrap, so compare ages rather than stamps */
+        if ((far_clock - far_pages[page].last_use) >= oldest)
+        {
+            victim = page;
+            oldest = far_clock - far_pages[page].last_use;
+        }
+    }
+
+    if (FAR_TAG_NONE != far_pages[victim].tag)
+    {
+        if (far_pages[victim].dirty && (HYPERRAM_SUCCESS != far_writeback(victim)))
+        {
+            return FAR_PAGE_NONE;
+        }
+        far_unlink(victim);
+    }
+
+    start = perf_counter_now();
+    if (HYPERRAM_SUCCESS != hyperram_dma_copy(far_pool[victim], hyperram_xip_ptr(tag), FAR_ARRAY_PAGE_SIZE))
+    {
+        return FAR_PAGE_NONE;
+    }
+    elapsed = perf_counter_to_ns(perf_counter_now() - start);
+
+    far_fill_total_ns += elapsed;
+    if (elapsed > far_stats.fill_max_ns)
+    {
+        far_stats.fill_max_ns = elapsed;
+    }
+    far_stats.misses++;
+
+    far_pages[victim].tag = tag;
+    far_pages[victim].dirty = false;
+    far_pages[victim].next = far_buckets[far_hash(tag)];
+    far_buckets[far_hash(tag)] = (uint8_t)victim;
+
+    return victim;
+}
+
+/*******************************************************************************
+* Function Name: far_writeback
+********************************************************************************
+* Summary:
+*  Copies a dirty page back to the HYPERRAM by DMA.
+*
+* Parameters:
+*  page - page index
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS or HYPERRAM_ERROR
+*
+*******************************************************************************/
+static hyperram_status_t far_writeback(uint32_t page)
+{
+    uint32_t start = perf_counter_now();
+
+    if (HYPERRAM_SUCCESS != hyperram_dma_copy(hyperram_xip_ptr(far_pages[page].tag), far_pool[page],
+                                              FAR_ARRAY_PAGE_SIZE))
+    {
+        return HYPERRAM_ERROR;
+    }
+
+    far_writeback_total_ns += perf_counter_to_ns(perf_counter_now() - start);
+    far_stats.writebacks++;
+    far_pages[page].dirty = false;
+
+    return HYPERRAM_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,120 @@
+/*******************************************************************************
+* File Name:   far_array.h
+*
+* Description: Far arrays: large arrays in the HYPERRAM accessed by index through a
+* shared pool of SRAM pages. A miss fills the page by DMA from the XIP
+* window; the least recently used page is replaced and written back first
+* if it was modified. Accesses to pages already in the pool cost a tag
+* check, so working sets that fit in the pool run at close to SRAM speed.
+*
+* Pointers returned by far_array_ref() stay valid until the next call that
+* may miss, so take one reference per page rather than per element, or
+* copy values out with far_array_read(). The SMIF must be in memory mode.
+* Nothing here is reentrant.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef FAR_ARRAY_H
+#define FAR_ARRAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hyperram.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* Page pool: FAR_ARRAY_PAGES pages of FAR_ARRAY_PAGE_SIZE bytes in SRAM */
+#ifndef FAR_ARRAY_PAGE_SIZE
+#define FAR_ARRAY_PAGE_SIZE             (1024u)
+#endif
+#ifndef FAR_ARRAY_PAGES
+#define FAR_ARRAY_PAGES                 (32u)
+#endif
+
+/* Buckets of the page lookup table, a power of two */
+#define FAR_ARRAY_HASH_BUCKETS          (64u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef struct
+{
+    uint32_t offset;            /* device offset of element 0 */
+    uint32_t count;
+    uint32_t elem_size;
+    uint32_t elem_shift;        /* log2(elem_size) */
+    uint32_t page;              /* most recently used page, checked before the lookup */
+} far_array_t;
+
+typedef struct
+{
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t writebacks;
+    uint32_t fill_avg_ns;
+    uint32_t fill_max_ns;
+    uint32_t writeback_avg_ns;
+    uint32_t dirty_pages;
+    uint32_t used_pages;
+} far_array_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+hyperram_status_t far_array_pool_init(void);
+hyperram_status_t far_array_init(far_array_t* array, uint32_t offset, uint32_t elem_size, uint32_t count);
+void* far_array_ref(far_array_t* array, uint32_t index, bool write);
+hyperram_status_t far_array_read(far_array_t* array, uint32_t index, void* value);
+hyperram_status_t far_array_write(far_array_t* array, uint32_t index, const void* value);
+hyperram_status_t far_array_flush(void);
+hyperram_status_t far_array_invalidate(void);
+void far_array_get_stats(far_array_stats_t* stats);
+void far_array_print_stats(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* FAR_ARRAY_H */
+
+/* [] END OF FILE */
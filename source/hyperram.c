@@ -0,0 +1,676 @@
+/*******************************************************************************
+* File Name:   hyperram.c
+*
+* Description: SMIF bring-up and command/XIP mode handling for the HYPERRAM.
+* Addresses used by this module are byte offsets into the device; the
+* HyperBus commands themselves take 16-bit word addresses.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include <string.h>
+#include "cy_pdl.h"
+#include "cycfg.h"
+#include "cycfg_qspi_memslot.h"
+#include "hyperram.h"
+#include "perf_counter.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* Timeout of the blocking PDL transfers, in microseconds: the longest burst
+ * (command-address, worst-case double latency and a full chunk at two bytes
+ * per clock) at the slowest bus clock, with a safety margin. A dead device
+ * is reported after this long instead of after a fixed millisecond. */
+#define HYPERRAM_BUS_CLOCKS_MAX         (3u + (2u * HYPERRAM_DUMMY_CYCLES) + (HYPERRAM_CMD_CHUNK / 2u))
+#define HYPERRAM_TIMEOUT_MARGIN         (4u)
+#define HYPERRAM_TIMEOUT_US             ((uint32_t)((((uint64_t)HYPERRAM_BUS_CLOCKS_MAX * HYPERRAM_TIMEOUT_MARGIN * \
+                                                      1000000u) / HYPERRAM_BUS_MIN_HZ) + 1u))
+#define HYPERRAM_SMIF_BASE              SMIF_HW
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+static cy_stc_smif_context_t hyperram_context;
+static bool hyperram_xip_mode;
+static bool hyperram_crypto_mode;
+static bool hyperram_started;
+static bool hyperram_ready;
+static uint32_t hyperram_start_cycles;
+static uint32_t hyperram_started_cycles;
+static hyperram_init_timing_t hyperram_timing;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static bool hyperram_range_valid(uint32_t address, uint32_t size);
+static uint32_t hyperram_chunk_size(uint32_t address, uint32_t size);
+
+/*******************************************************************************
+* Function Name: hyperram_init
+********************************************************************************
+* Summary:
+*  Runs hyperram_init_start() and hyperram_init_finish() back to back. Use
+*  the two halves directly to overlap the bring-up with other board init.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, or HYPERRAM_ERROR if the SMIF or
+*                      memory slot failed to initialize
+*
+*******************************************************************************/
+hyperram_status_t hyperram_init(void)
+{
+    hyperram_status_t status = hyperram_init_start();
+
+    if (HYPERRAM_SUCCESS == status)
+    {
+        status = hyperram_init_finish();
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_init_start
+********************************************************************************
+* Summary:
+*  First half of the bring-up, register writes only: routes RWDS to the SMIF
+*  and initializes and enables the SMIF block in command (normal) mode. The
+*  device is not accessed, so the caller can go on with other init while
+*  the HYPERRAM finishes powering up. The block is disabled first only if
+*  something, such as the HYPERRAM section startup, already enabled it.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, or HYPERRAM_ERROR if the SMIF
+*                      failed to initialize
+*
+*******************************************************************************/
+hyperram_status_t hyperram_init_start(void)
+{
+    cy_en_smif_status_t smif_status;
+    uint32_t begin;
+
+    perf_counter_init();
+    begin = perf_counter_now();
+    memset(&hyperram_timing, 0, sizeof(hyperram_timing));
+    hyperram_timing.start_at_ns = perf_counter_to_ns(perf_counter_since_init());
+    hyperram_started = false;
+    hyperram_ready = false;
+
+    Cy_GPIO_Pin_FastInit(GPIO_PRT24, 2, CY_GPIO_DM_STRONG, 0, P24_2_SMIF0_SPIHB_RWDS);
+
+    if (0u != (SMIF_CTL(HYPERRAM_SMIF_BASE) & SMIF_CTL_ENABLED_Msk))
+    {
+        Cy_SMIF_Disable(HYPERRAM_SMIF_BASE);
+    }
+
+    smif_status = Cy_SMIF_Init(HYPERRAM_SMIF_BASE, &SMIF_config, HYPERRAM_TIMEOUT_US, &hyperram_context);
+
+    if (CY_SMIF_SUCCESS != smif_status)
+    {
+        return HYPERRAM_ERROR;
+    }
+
+    Cy_SMIF_SetMode(HYPERRAM_SMIF_BASE, CY_SMIF_NORMAL);
+    Cy_SMIF_SetDataSelect(HYPERRAM_SMIF_BASE, smifMemConfigs[0]->slaveSelect, smifMemConfigs[0]->dataSelect);
+    Cy_SMIF_Enable(HYPERRAM_SMIF_BASE, &hyperram_context);
+
+    hyperram_xip_mode = false;
+    hyperram_crypto_mode = false;
+    hyperram_start_cycles = begin;
+    hyperram_started_cycles = perf_counter_now();
+    hyperram_timing.start_ns = perf_counter_to_ns(hyperram_started_cycles - begin);
+    hyperram_timing.timeout_us = HYPERRAM_TIMEOUT_US;
+    hyperram_started = true;
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_init_finish
+********************************************************************************
+* Summary:
+*  Second half of the bring-up: waits out what is left of
+*  HYPERRAM_POWER_UP_US since hyperram_init_start(), then initializes the
+*  memory slot, which writes the latency setting to the device. The SMIF is
+*  left in command mode; the memory slot init does not change the mode, so
+*  it is not set again.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, or HYPERRAM_ERROR if
+*                      hyperram_init_start() did not succeed or the memory
+*                      slot failed to initialize
+*
+*******************************************************************************/
+hyperram_status_t hyperram_init_finish(void)
+{
+    cy_en_smif_status_t smif_status;
+    uint32_t arrived;
+
+    if (!hyperram_started)
+    {
+        return HYPERRAM_ERROR;
+    }
+
+    arrived = perf_counter_now();
+    hyperram_timing.overlap_ns = perf_counter_to_ns(arrived - hyperram_started_cycles);
+
+#if (HYPERRAM_POWER_UP_US > 0u)
+    while (perf_counter_to_ns(perf_counter_now() - hyperram_start_cycles) < (HYPERRAM_POWER_UP_US * 1000u))
+    {
+    }
+#endif
+    hyperram_timing.power_wait_ns = perf_counter_to_ns(perf_counter_now() - arrived);
+
+    smifMemConfigs[0]->hbdeviceCfg->dummyCycles = HYPERRAM_DUMMY_CYCLES;
+
+    smif_status = Cy_SMIF_Memslot_Init(HYPERRAM_SMIF_BASE, (cy_stc_smif_block_config_t*)&smifBlockConfig,
+                                       &hyperram_context);
+    hyperram_timing.first_access_at_ns = perf_counter_to_ns(perf_counter_since_init());
+
+    if (CY_SMIF_SUCCESS != smif_status)
+    {
+        return HYPERRAM_ERROR;
+    }
+
+    hyperram_started = false;
+    hyperram_ready = true;
+    hyperram_timing.ready_at_ns = perf_counter_to_ns(perf_counter_since_init());
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_is_ready
+********************************************************************************
+* Summary:
+*  Reports whether the bring-up has completed, for example in the HYPERRAM
+*  section startup before main().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true after a successful hyperram_init_finish()
+*
+*******************************************************************************/
+bool hyperram_is_ready(void)
+{
+    return hyperram_ready;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_get_init_timing
+********************************************************************************
+* Summary:
+*  Copies the timing of the last bring-up.
+*
+* Parameters:
+*  timing - destination
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_get_init_timing(hyperram_init_timing_t* timing)
+{
+    *timing = hyperram_timing;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_read
+********************************************************************************
+* Summary:
+*  Reads from the HYPERRAM with blocking command-mode continuous bursts. The
+*  previous SMIF mode is restored on return.
+*
+* Parameters:
+*  address - byte offset in the device, must be even
+*  buf - destination buffer
+*  size - number of bytes to read, must be even
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM or HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t hyperram_read(uint32_t address, void* buf, uint32_t size)
+{
+    uint8_t* bytes = (uint8_t*)buf;
+    bool restore_xip = hyperram_xip_mode;
+    cy_en_smif_status_t smif_status = CY_SMIF_SUCCESS;
+
+    if (!hyperram_range_valid(address, size))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    hyperram_enter_command();
+
+    while ((size > 0u) && (CY_SMIF_SUCCESS == smif_status))
+    {
+        uint32_t chunk = hyperram_chunk_size(address, size);
+
+        smif_status = Cy_SMIF_HyperBus_Read(HYPERRAM_SMIF_BASE,
+            smifMemConfigs[0],
+            CY_SMIF_HB_COUTINUOUS_BURST,
+            address >> 1u,
+            chunk >> 1u,
+            (uint16_t*)bytes,
+            smifMemConfigs[0]->hbdeviceCfg->dummyCycles,
+            false,
+            true,
+            &hyperram_context
+        );
+
+        address += chunk;
+        bytes   += chunk;
+        size    -= chunk;
+    }
+
+    if (restore_xip)
+    {
+        hyperram_enter_xip();
+    }
+
+    return (CY_SMIF_SUCCESS == smif_status) ? HYPERRAM_SUCCESS : HYPERRAM_ERROR;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_read_wrapped
+********************************************************************************
+* Summary:
+*  Reads with one blocking command-mode wrapped burst. The burst starts at
+*  the address and wraps at the end of its HYPERRAM_WRAP_SIZE aligned group,
+*  the way a critical-word-first line fill does. The previous SMIF mode is
+*  restored on return.
+*
+* Parameters:
+*  address - byte offset in the device, must be even
+*  buf - destination buffer
+*  size - number of bytes to read, even, 2 to HYPERRAM_WRAP_SIZE
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM or HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t hyperram_read_wrapped(uint32_t address, void* buf, uint32_t size)
+{
+    bool restore_xip = hyperram_xip_mode;
+    cy_en_smif_status_t smif_status;
+
+    if ((0u == size) || (size > HYPERRAM_WRAP_SIZE) || !hyperram_range_valid(address, size))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    hyperram_enter_command();
+
+    smif_status = Cy_SMIF_HyperBus_Read(HYPERRAM_SMIF_BASE,
+        smifMemConfigs[0],
+        CY_SMIF_HB_WRAPPED_BURST,
+        address >> 1u,
+        size >> 1u,
+        (uint16_t*)buf,
+        smifMemConfigs[0]->hbdeviceCfg->dummyCycles,
+        false,
+        true,
+        &hyperram_context
+    );
+
+    if (restore_xip)
+    {
+        hyperram_enter_xip();
+    }
+
+    return (CY_SMIF_SUCCESS == smif_status) ? HYPERRAM_SUCCESS : HYPERRAM_ERROR;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_write
+********************************************************************************
+* Summary:
+*  Writes to the HYPERRAM with blocking command-mode continuous bursts. The
+*  previous SMIF mode is restored on return.
+*
+* Parameters:
+*  address - byte offset in the device, must be even
+*  buf - source buffer
+*  size - number of bytes to write, must be even
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM or HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t hyperram_write(uint32_t address, const void* buf, uint32_t size)
+{
+    const uint8_t* bytes = (const uint8_t*)buf;
+    bool restore_xip = hyperram_xip_mode;
+    cy_en_smif_status_t smif_status = CY_SMIF_SUCCESS;
+
+    if (!hyperram_range_valid(address, size))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    hyperram_enter_command();
+
+    while ((size > 0u) && (CY_SMIF_SUCCESS == smif_status))
+    {
+        uint32_t chunk = hyperram_chunk_size(address, size);
+
+        smif_status = Cy_SMIF_HyperBus_Write(HYPERRAM_SMIF_BASE,
+            smifMemConfigs[0],
+            CY_SMIF_HB_COUTINUOUS_BURST,
+            address >> 1u,
+            chunk >> 1u,
+            (uint16_t*)bytes,
+            CY_SMIF_HB_SRAM,
+            smifMemConfigs[0]->hbdeviceCfg->dummyCycles,
+            true,
+            &hyperram_context
+        );
+
+        address += chunk;
+        bytes   += chunk;
+        size    -= chunk;
+    }
+
+    if (restore_xip)
+    {
+        hyperram_enter_xip();
+    }
+
+    return (CY_SMIF_SUCCESS == smif_status) ? HYPERRAM_SUCCESS : HYPERRAM_ERROR;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_enter_xip
+********************************************************************************
+* Summary:
+*  Switches the SMIF to memory mode so the device is accessible through the
+*  XIP window at CY_SMIF_XIP_BASE.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_enter_xip(void)
+{
+    if (!hyperram_xip_mode)
+    {
+        Cy_SMIF_SetMode(HYPERRAM_SMIF_BASE, CY_SMIF_MEMORY);
+        hyperram_xip_mode = true;
+    }
+}
+
+/*******************************************************************************
+* Function Name: hyperram_enter_command
+********************************************************************************
+* Summary:
+*  Switches the SMIF to normal (command) mode.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_enter_command(void)
+{
+    if (hyperram_xip_mode)
+    {
+        Cy_SMIF_SetMode(HYPERRAM_SMIF_BASE, CY_SMIF_NORMAL);
+        hyperram_xip_mode = false;
+    }
+}
+
+/*******************************************************************************
+* Function Name: hyperram_is_xip
+********************************************************************************
+* Summary:
+*  Reports whether the SMIF is in memory (XIP) mode.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true in memory mode
+*
+*******************************************************************************/
+bool hyperram_is_xip(void)
+{
+    return hyperram_xip_mode;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_xip_ptr
+********************************************************************************
+* Summary:
+*  Returns the memory-mapped address of a device offset. The pointer is only
+*  usable while the SMIF is in memory mode.
+*
+* Parameters:
+*  address - byte offset in the device
+*
+* Return:
+*  void* - address inside the XIP window
+*
+*******************************************************************************/
+void* hyperram_xip_ptr(uint32_t address)
+{
+    return (void*)(CY_SMIF_XIP_BASE + address);
+}
+
+/*******************************************************************************
+* Function Name: hyperram_set_crypto_key
+********************************************************************************
+* Summary:
+*  Loads the key and nonce of the SMIF on-the-fly encryption. Each 16-byte
+*  block is XORed with AES-128(key, nonce | block address), so the same key
+*  must be loaded to read back what was written with it.
+*
+* Parameters:
+*  key - HYPERRAM_CRYPTO_KEY_WORDS words
+*  nonce - HYPERRAM_CRYPTO_NONCE_WORDS words
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_set_crypto_key(const uint32_t* key, const uint32_t* nonce)
+{
+    uint32_t words[HYPERRAM_CRYPTO_KEY_WORDS];
+
+    /* The PDL takes non-const arrays */
+    memcpy(words, key, sizeof(words));
+    Cy_SMIF_SetCryptoKey(HYPERRAM_SMIF_BASE, words);
+    memcpy(words, nonce, HYPERRAM_CRYPTO_NONCE_WORDS * sizeof(uint32_t));
+    Cy_SMIF_SetCryptoIV(HYPERRAM_SMIF_BASE, words);
+    memset(words, 0, sizeof(words));
+}
+
+/*******************************************************************************
+* Function Name: hyperram_set_crypto
+********************************************************************************
+* Summary:
+*  Turns on-the-fly encryption of the HYPERRAM slot on or off. While it is on,
+*  every XIP access to the device, from the CPU or a DMA, is encrypted on
+*  writes and decrypted on reads. Command-mode transfers are never encrypted.
+*
+* Parameters:
+*  enable - true to encrypt XIP accesses
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_set_crypto(bool enable)
+{
+    if (enable == hyperram_crypto_mode)
+    {
+        return;
+    }
+
+    if (enable)
+    {
+        (void)Cy_SMIF_SetCryptoEnable(HYPERRAM_SMIF_BASE, smifMemConfigs[0]->slaveSelect);
+    }
+    else
+    {
+        (void)Cy_SMIF_SetCryptoDisable(HYPERRAM_SMIF_BASE, smifMemConfigs[0]->slaveSelect);
+    }
+    hyperram_crypto_mode = enable;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_is_crypto
+********************************************************************************
+* Summary:
+*  Reports whether on-the-fly encryption is on.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true while XIP accesses are encrypted
+*
+*******************************************************************************/
+bool hyperram_is_crypto(void)
+{
+    return hyperram_crypto_mode;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_encrypt
+********************************************************************************
+* Summary:
+*  Applies the keystream of a device range to a buffer in place, with the
+*  SMIF crypto engine. The keystream is the one XIP accesses use for the
+*  same range, so encrypting a buffer before a command-mode write stores
+*  what an encrypted XIP write would, and the same call decrypts data read
+*  in command mode.
+*
+* Parameters:
+*  address - byte offset in the device, multiple of HYPERRAM_CRYPTO_BLOCK
+*  data - buffer to transform
+*  size - number of bytes, multiple of HYPERRAM_CRYPTO_BLOCK
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM or HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t hyperram_encrypt(uint32_t address, void* data, uint32_t size)
+{
+    cy_en_smif_status_t smif_status;
+
+    if ((0u != ((address | size) & (HYPERRAM_CRYPTO_BLOCK - 1u))) || !hyperram_range_valid(address, size))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    /* The XIP path encrypts with the bus address, not the device offset */
+    smif_status = Cy_SMIF_Encrypt(HYPERRAM_SMIF_BASE, CY_SMIF_XIP_BASE + address, (uint8_t*)data, size,
+                                  &hyperram_context);
+
+    return (CY_SMIF_SUCCESS == smif_status) ? HYPERRAM_SUCCESS : HYPERRAM_ERROR;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_range_valid
+********************************************************************************
+* Summary:
+*  Checks that a byte range is word aligned and inside the device.
+*
+* Parameters:
+*  address - byte offset in the device
+*  size - number of bytes
+*
+* Return:
+*  bool - true if the range can be accessed with HyperBus commands
+*
+*******************************************************************************/
+static bool hyperram_range_valid(uint32_t address, uint32_t size)
+{
+    return (0u == ((address | size) & 1u)) &&
+           (address <= HYPERRAM_SIZE) && (size <= (HYPERRAM_SIZE - address));
+}
+
+/*******************************************************************************
+* Function Name: hyperram_chunk_size
+********************************************************************************
+* Summary:
+*  Returns the length of the next burst: at most HYPERRAM_CMD_CHUNK bytes and
+*  never crossing a die boundary.
+*
+* Parameters:
+*  address - byte offset of the burst
+*  size - bytes remaining
+*
+* Return:
+*  uint32_t - burst length in bytes
+*
+*******************************************************************************/
+static uint32_t hyperram_chunk_size(uint32_t address, uint32_t size)
+{
+    uint32_t chunk = HYPERRAM_DIE_SIZE - (address & (HYPERRAM_DIE_SIZE - 1u));
+
+    if (chunk > HYPERRAM_CMD_CHUNK)
+    {
+        chunk = HYPERRAM_CMD_CHUNK;
+    }
+
+    return (chunk < size) ? chunk : size;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,141 @@
+/*******************************************************************************
+* File Name:   hyperram.h
+*
+* Description: Access layer for the S70KS1282 HYPERRAM on SMIF slot 0. Owns the
+* SMIF context, brings the interface up and provides command-mode reads and
+* writes plus the memory-mapped (XIP) view of the device.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HYPERRAM_H
+#define HYPERRAM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* S70KS1282: 128 Mbit, two 64 Mbit dies */
+#define HYPERRAM_SIZE                   (0x01000000UL)
+#define HYPERRAM_DIE_SIZE               (0x00800000UL)
+
+#define HYPERRAM_DUMMY_CYCLES           (14u)
+
+/* Slowest HyperBus clock the transfer timeouts are calibrated for */
+#ifndef HYPERRAM_BUS_MIN_HZ
+#define HYPERRAM_BUS_MIN_HZ             (50000000UL)
+#endif
+
+/* Device power-up time (tVCS, 150 us on the S70KS1282) that
+ * hyperram_init_finish() waits out, counted from hyperram_init_start().
+ * 0 when board power sequencing already covers it, as on the kit. */
+#ifndef HYPERRAM_POWER_UP_US
+#define HYPERRAM_POWER_UP_US            (0u)
+#endif
+
+/* Largest command-mode burst; bursts never cross a die boundary */
+#define HYPERRAM_CMD_CHUNK              (1024u)
+
+/* Wrapped burst group, the device default (CR0 burst length 32 bytes) */
+#define HYPERRAM_WRAP_SIZE              (32u)
+
+/* On-the-fly encryption works on 16-byte blocks: 128-bit key, 96-bit nonce */
+#define HYPERRAM_CRYPTO_BLOCK           (16u)
+#define HYPERRAM_CRYPTO_KEY_WORDS       (4u)
+#define HYPERRAM_CRYPTO_NONCE_WORDS     (3u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef enum
+{
+    HYPERRAM_SUCCESS = 0,
+    HYPERRAM_BAD_PARAM,
+    HYPERRAM_ERROR,
+} hyperram_status_t;
+
+/* Bring-up timing. The *_at_ns times are measured from boot, that is the
+ * first perf_counter_init() call; the others are phase durations. */
+typedef struct
+{
+    uint32_t start_at_ns;        /* call of hyperram_init_start() */
+    uint32_t start_ns;           /* hyperram_init_start(), SMIF registers only */
+    uint32_t overlap_ns;         /* caller's work between start and finish */
+    uint32_t power_wait_ns;      /* finish waiting out HYPERRAM_POWER_UP_US */
+    uint32_t first_access_at_ns; /* end of the first device access */
+    uint32_t ready_at_ns;        /* end of hyperram_init_finish() */
+    uint32_t timeout_us;         /* blocking transfer timeout in use */
+} hyperram_init_timing_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+hyperram_status_t hyperram_init(void);
+hyperram_status_t hyperram_init_start(void);
+hyperram_status_t hyperram_init_finish(void);
+bool hyperram_is_ready(void);
+void hyperram_get_init_timing(hyperram_init_timing_t* timing);
+hyperram_status_t hyperram_read(uint32_t address, void* buf, uint32_t size);
+hyperram_status_t hyperram_read_wrapped(uint32_t address, void* buf, uint32_t size);
+hyperram_status_t hyperram_write(uint32_t address, const void* buf, uint32_t size);
+void hyperram_enter_xip(void);
+void hyperram_enter_command(void);
+bool hyperram_is_xip(void);
+void* hyperram_xip_ptr(uint32_t address);
+void hyperram_set_crypto_key(const uint32_t* key, const uint32_t* nonce);
+void hyperram_set_crypto(bool enable);
+bool hyperram_is_crypto(void);
+hyperram_status_t hyperram_encrypt(uint32_t address, void* data, uint32_t size);
+
+#if defined(HYPERRAM_HOST_SIM)
+/* Host model only: flip one bit in about one of every one_in transfers, 0 disables */
+void hyperram_sim_set_fault_rate(uint32_t one_in, uint32_t seed);
+#endif
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* HYPERRAM_H */
+
+/* [] END OF FILE */
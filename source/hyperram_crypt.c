@@ -0,0 +1,764 @@
+/*******************************************************************************
+* File Name:   hyperram_crypt.c
+*
+* Description: Region encryption for the HYPERRAM. See hyperram_crypt.h.
+*
+* The encryption setting applies to every XIP access of the slot, whoever
+* makes it. While a transfer into a region runs with the encryption on, no
+* other code may touch the HYPERRAM through the XIP window: not an interrupt
+* handler, not code or data placed in the device, and not a D-cache
+* eviction, which is why every dirty line is written back first.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "platform.h"
+#include "hyperram_crypt.h"
+#include "hyperram_dma.h"
+#include "perf_counter.h"
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef struct
+{
+    uint32_t offset;
+    uint32_t size;
+} crypt_region_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+static bool crypt_ready;
+static crypt_region_t crypt_regions[HYPERRAM_CRYPT_MAX_REGIONS];
+static uint32_t crypt_region_count;
+static hyperram_crypt_stats_t crypt_stats;
+
+/* Command-mode writes are encrypted here so the caller's buffer is kept */
+static uint8_t crypt_staging[HYPERRAM_CMD_CHUNK] CY_ALIGN(4);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static hyperram_status_t crypt_random(uint32_t* words, uint32_t count);
+static uint32_t crypt_span(uint32_t address, uint32_t size, bool* encrypted);
+static bool crypt_command_ok(uint32_t address, uint32_t size);
+static void crypt_on(void);
+static void crypt_off(void);
+
+/*******************************************************************************
+* Function Name: hyperram_crypt_init
+********************************************************************************
+* Summary:
+*  Loads the key and nonce and clears the region table. With a NULL key or
+*  nonce both are drawn from the TRNG: the HYPERRAM loses its contents at
+*  power-down, so a fresh key at every boot only costs the data that is lost
+*  anyway, and no key is stored anywhere.
+*
+* Parameters:
+*  key - HYPERRAM_CRYPTO_KEY_WORDS words, or NULL
+*  nonce - HYPERRAM_CRYPTO_NONCE_WORDS words, or NULL
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM if no key was
+*                      given and there is no TRNG, or HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t hyperram_crypt_init(const uint32_t* key, const uint32_t* nonce)
+{
+    uint32_t words[HYPERRAM_CRYPTO_KEY_WORDS + HYPERRAM_CRYPTO_NONCE_WORDS];
+    hyperram_status_t status = HYPERRAM_SUCCESS;
+
+    crypt_ready = false;
+
+    if ((NULL == key) || (NULL == nonce))
+    {
+        status = crypt_random(words, HYPERRAM_CRYPTO_KEY_WORDS + HYPERRAM_CRYPTO_NONCE_WORDS);
+    }
+    else
+    {
+        memcpy(words, key, HYPERRAM_CRYPTO_KEY_WORDS * sizeof(uint32_t));
+        memcpy(&words[HYPERRAM_CRYPTO_KEY_WORDS], nonce, HYPERRAM_CRYPTO_NONCE_WORDS * sizeof(uint32_t));
+    }
+
+    if ((HYPERRAM_SUCCESS == status) && (HYPERRAM_SUCCESS != hyperram_dma_init()))
+    {
+        status = HYPERRAM_ERROR;
+    }
+
+    if (HYPERRAM_SUCCESS == status)
+    {
+        hyperram_set_crypto(false);
+        hyperram_set_crypto_key(words, &words[HYPERRAM_CRYPTO_KEY_WORDS]);
+        crypt_region_count = 0u;
+        memset(&crypt_stats, 0, sizeof(crypt_stats));
+        crypt_ready = true;
+    }
+
+    memset(words, 0, sizeof(words));
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_crypt_deinit
+********************************************************************************
+* Summary:
+*  Turns the encryption off, replaces the key with zeros and clears the
+*  region table. Encrypted regions are unreadable afterwards.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_crypt_deinit(void)
+{
+    static const uint32_t zero[HYPERRAM_CRYPTO_KEY_WORDS];
+
+    hyperram_set_crypto(false);
+    hyperram_set_crypto_key(zero, zero);
+    memset(crypt_staging, 0, sizeof(crypt_staging));
+    crypt_region_count = 0u;
+    crypt_ready = false;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_crypt_add_region
+********************************************************************************
+* Summary:
+*  Registers a device range to be kept encrypted. Data already in the range
+*  is not converted; it reads back as garbage through this module.
+*
+* Parameters:
+*  offset - device offset, multiple of HYPERRAM_CRYPTO_BLOCK
+*  size - range size, multiple of HYPERRAM_CRYPTO_BLOCK
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM if the range is
+*                      misaligned, outside the device or overlaps a region,
+*                      or HYPERRAM_ERROR if the table is full or the module
+*                      is not initialized
+*
+*******************************************************************************/
+hyperram_status_t hyperram_crypt_add_region(uint32_t offset, uint32_t size)
+{
+    if ((0u == size) || (0u != ((offset | size) & (HYPERRAM_CRYPTO_BLOCK - 1u))) ||
+        (offset > HYPERRAM_SIZE) || (size > (HYPERRAM_SIZE - offset)))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    for (uint32_t index = 0; index < crypt_region_count; index++)
+    {
+        if ((offset < (crypt_regions[index].offset + crypt_regions[index].size)) &&
+            (crypt_regions[index].offset < (offset + size)))
+        {
+            return HYPERRAM_BAD_PARAM;
+        }
+    }
+
+    if (!crypt_ready || (crypt_region_count >= HYPERRAM_CRYPT_MAX_REGIONS))
+    {
+        return HYPERRAM_ERROR;
+    }
+
+    crypt_regions[crypt_region_count].offset = offset;
+    crypt_regions[crypt_region_count].size = size;
+    crypt_region_count++;
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_crypt_clear_regions
+********************************************************************************
+* Summary:
+*  Removes every region; the whole device is accessed in plain text again.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_crypt_clear_regions(void)
+{
+    crypt_region_count = 0u;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_crypt_is_encrypted
+********************************************************************************
+* Summary:
+*  Reports whether a device offset lies in a region.
+*
+* Parameters:
+*  address - byte offset in the device
+*
+* Return:
+*  bool - true if the byte is stored encrypted
+*
+*******************************************************************************/
+bool hyperram_crypt_is_encrypted(uint32_t address)
+{
+    bool encrypted;
+
+    (void)crypt_span(address, 1u, &encrypted);
+
+    return encrypted;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_crypt_read
+********************************************************************************
+* Summary:
+*  Reads through the XIP window by DMA. The parts inside a region are read
+*  with the encryption on, so the SMIF decrypts them on the way. The SMIF
+*  must be in memory mode.
+*
+* Parameters:
+*  dst - destination buffer
+*  address - byte offset in the device
+*  size - number of bytes
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM or HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t hyperram_crypt_read(void* dst, uint32_t address, uint32_t size)
+{
+    uint8_t* out = (uint8_t*)dst;
+
+    if ((address > HYPERRAM_SIZE) || (size > (HYPERRAM_SIZE - address)))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    while (0u != size)
+    {
+        bool encrypted;
+        uint32_t run = crypt_span(address, size, &encrypted);
+        hyperram_status_t status;
+
+        if (encrypted)
+        {
+            crypt_on();
+            status = hyperram_dma_copy(out, hyperram_xip_ptr(address), run);
+            crypt_off();
+            crypt_stats.xip_bytes += run;
+        }
+        else
+        {
+            status = hyperram_dma_copy(out, hyperram_xip_ptr(address), run);
+            crypt_stats.plain_bytes += run;
+        }
+
+        if (HYPERRAM_SUCCESS != status)
+        {
+            crypt_stats.errors++;
+            return status;
+        }
+
+        out += run;
+        address += run;
+        size -= run;
+    }
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_crypt_write
+********************************************************************************
+* Summary:
+*  Writes through the XIP window by DMA, encrypting the parts that fall
+*  inside a region. The SMIF must be in memory mode.
+*
+* Parameters:
+*  address - byte offset in the device
+*  src - source buffer
+*  size - number of bytes
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM or HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t hyperram_crypt_write(uint32_t address, const void* src, uint32_t size)
+{
+    const uint8_t* in = (const uint8_t*)src;
+
+    if ((address > HYPERRAM_SIZE) || (size > (HYPERRAM_SIZE - address)))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    while (0u != size)
+    {
+        bool encrypted;
+        uint32_t run = crypt_span(address, size, &encrypted);
+        hyperram_status_t status;
+
+        if (encrypted)
+        {
+            crypt_on();
+            status = hyperram_dma_copy(hyperram_xip_ptr(address), in, run);
+            crypt_off();
+            crypt_stats.xip_bytes += run;
+        }
+        else
+        {
+            status = hyperram_dma_copy(hyperram_xip_ptr(address), in, run);
+            crypt_stats.plain_bytes += run;
+        }
+
+        if (HYPERRAM_SUCCESS != status)
+        {
+            crypt_stats.errors++;
+            return status;
+        }
+
+        in += run;
+        address += run;
+        size -= run;
+    }
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_crypt_read_command
+********************************************************************************
+* Summary:
+*  Reads with command-mode bursts and decrypts the parts inside a region in
+*  software, with the keystream of the SMIF crypto engine. Command mode
+*  bypasses the on-the-fly encryption, so this path never changes its
+*  setting and is safe to mix with XIP traffic.
+*
+* Parameters:
+*  dst - destination buffer
+*  address - byte offset in the device, even, and a multiple of
+*            HYPERRAM_CRYPTO_BLOCK if the range touches a region
+*  size - number of bytes, with the same rule as the address
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM or HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t hyperram_crypt_read_command(void* dst, uint32_t address, uint32_t size)
+{
+    uint8_t* out = (uint8_t*)dst;
+
+    if (!crypt_command_ok(address, size))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    while (0u != size)
+    {
+        bool encrypted;
+        uint32_t run = crypt_span(address, size, &encrypted);
+        hyperram_status_t status = hyperram_read(address, out, run);
+
+        if ((HYPERRAM_SUCCESS == status) && encrypted)
+        {
+            status = hyperram_encrypt(address, out, run);
+            crypt_stats.command_bytes += run;
+        }
+        else
+        {
+            crypt_stats.plain_bytes += run;
+        }
+
+        if (HYPERRAM_SUCCESS != status)
+        {
+            crypt_stats.errors++;
+            return status;
+        }
+
+        out += run;
+        address += run;
+        size -= run;
+    }
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_crypt_write_command
+********************************************************************************
+* Summary:
+*  Writes with command-mode bursts. The parts inside a region are encrypted
+*  in software, one burst at a time in a staging buffer.
+*
+* Parameters:
+*  address - byte offset in the device, even, and a multiple of
+*            HYPERRAM_CRYPTO_BLOCK if the range touches a region
+*  src - source buffer
+*  size - number of bytes, with the same rule as the address
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM or HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t hyperram_crypt_write_command(uint32_t address, const void* src, uint32_t size)
+{
+    const uint8_t* in = (const uint8_t*)src;
+
+    if (!crypt_command_ok(address, size))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    while (0u != size)
+    {
+        bool encrypted;
+        uint32_t run = crypt_span(address, size, &encrypted);
+        hyperram_status_t status;
+
+        if (encrypted)
+        {
+            if (run > sizeof(crypt_staging))
+            {
+                run = sizeof(crypt_staging);
+            }
+
+            memcpy(crypt_staging, in, run);
+            status = hyperram_encrypt(address, crypt_staging, run);
+
+            if (HYPERRAM_SUCCESS == status)
+            {
+                status = hyperram_write(address, crypt_staging, run);
+            }
+            crypt_stats.command_bytes += run;
+        }
+        else
+        {
+            status = hyperram_write(address, in, run);
+            crypt_stats.plain_bytes += run;
+        }
+
+        if (HYPERRAM_SUCCESS != status)
+        {
+            crypt_stats.errors++;
+            return status;
+        }
+
+        in += run;
+        address += run;
+        size -= run;
+    }
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_crypt_begin
+********************************************************************************
+* Summary:
+*  Turns the encryption on for direct CPU access to a region through
+*  hyperram_xip_ptr(). Dirty lines are written back first, and cached lines
+*  of the range, read while the encryption was off, are dropped. Between
+*  this call and hyperram_crypt_end() the CPU may access only encrypted
+*  regions of the device.
+*
+* Parameters:
+*  address - byte offset in the device of the range to be accessed
+*  size - number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_crypt_begin(uint32_t address, uint32_t size)
+{
+    crypt_on();
+    platform_dcache_invalidate(hyperram_xip_ptr(address), size);
+}
+
+/*******************************************************************************
+* Function Name: hyperram_crypt_end
+********************************************************************************
+* Summary:
+*  Ends direct CPU access: the lines of the range are written back and
+*  dropped while the encryption is still on, then it is turned off.
+*
+* Parameters:
+*  address - byte offset in the device of the range passed to
+*            hyperram_crypt_begin()
+*  size - number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_crypt_end(uint32_t address, uint32_t size)
+{
+    platform_dcache_clean_invalidate(hyperram_xip_ptr(address), size);
+    crypt_off();
+}
+
+/*******************************************************************************
+* Function Name: hyperram_crypt_get_stats
+********************************************************************************
+* Summary:
+*  Copies the transfer statistics.
+*
+* Parameters:
+*  stats - destination
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_crypt_get_stats(hyperram_crypt_stats_t* stats)
+{
+    *stats = crypt_stats;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_crypt_print_stats
+********************************************************************************
+* Summary:
+*  Prints the regions and the transfer statistics.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_crypt_print_stats(void)
+{
+    for (uint32_t index = 0; index < crypt_region_count; index++)
+    {
+        PLATFORM_PRINTF("CRYPT region %lu: 0x%06lX + 0x%lX\r\n", (unsigned long)index,
+                        (unsigned long)crypt_regions[index].offset, (unsigned long)crypt_regions[index].size);
+    }
+    PLATFORM_PRINTF("CRYPT xip=%lu command=%lu plain=%lu switches=%lu errors=%lu\r\n",
+                    (unsigned long)crypt_stats.xip_bytes, (unsigned long)crypt_stats.command_bytes,
+                    (unsigned long)crypt_stats.plain_bytes, (unsigned long)crypt_stats.switches,
+                    (unsigned long)crypt_stats.errors);
+    PLATFORM_FLUSH();
+}
+
+/*******************************************************************************
+* Function Name: crypt_random
+********************************************************************************
+* Summary:
+*  Draws key material from the TRNG. The host model has no entropy source
+*  and takes a generator seeded from the cycle counter.
+*
+* Parameters:
+*  words - destination
+*  count - number of words
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM if there is no
+*                      TRNG, or HYPERRAM_ERROR
+*
+*******************************************************************************/
+static hyperram_status_t crypt_random(uint32_t* words, uint32_t count)
+{
+#if HYPERRAM_CRYPT_TRNG
+    if (CY_CRYPTO_SUCCESS != Cy_Crypto_Core_Enable(CRYPTO))
+    {
+        return HYPERRAM_ERROR;
+    }
+
+    for (uint32_t index = 0; index < count; index++)
+    {
+        if (CY_CRYPTO_SUCCESS != Cy_Crypto_Core_Trng(CRYPTO, CY_CRYPTO_DEF_TRNG_GARO, CY_CRYPTO_DEF_TRNG_FIRO,
+                                                     32u, &words[index]))
+        {
+            return HYPERRAM_ERROR;
+        }
+    }
+
+    return HYPERRAM_SUCCESS;
+#elif defined(HYPERRAM_HOST_SIM)
+    uint32_t x = perf_counter_now() | 1u;
+
+    for (uint32_t index = 0; index < count; index++)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        words[index] = x;
+    }
+
+    return HYPERRAM_SUCCESS;
+#else
+    (void)words;
+    (void)count;
+
+    return HYPERRAM_BAD_PARAM;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: crypt_span
+********************************************************************************
+* Summary:
+*  Returns the length of the leading part of a range that is either wholly
+*  inside one region or wholly outside all of them.
+*
+* Parameters:
+*  address - byte offset in the device
+*  size - number of bytes, not 0
+*  encrypted - set to whether the leading part is inside a region
+*
+* Return:
+*  uint32_t - length of the leading part in bytes
+*
+*******************************************************************************/
+static uint32_t crypt_span(uint32_t address, uint32_t size, bool* encrypted)
+{
+    uint32_t run = size;
+
+    *encrypted = false;
+
+    for (uint32_t index = 0; index < crypt_region_count; index++)
+    {
+        uint32_t start = crypt_regions[index].offset;
+        uint32_t end = start + crypt_regions[index].size;
+
+        if ((address >= start) && (address < end))
+        {
+            *encrypted = true;
+            return ((end - address) < size) ? (end - address) : size;
+        }
+
+        if ((start > address) && ((start - address) < run))
+        {
+            run = start - address;
+        }
+    }
+
+    return run;
+}
+
+/*******************************************************************************
+* Function Name: crypt_command_ok
+********************************************************************************
+* Summary:
+*  Checks a command-mode range before any of it is transferred: the keystream
+*  is applied in whole 16-byte blocks, so the parts inside regions must be
+*  block aligned.
+*
+* Parameters:
+*  address - byte offset in the device
+*  size - number of bytes
+*
+* Return:
+*  bool - true if the range can be transferred
+*
+*******************************************************************************/
+static bool crypt_command_ok(uint32_t address, uint32_t size)
+{
+    if ((0u != ((address | size) & 1u)) || (address > HYPERRAM_SIZE) || (size > (HYPERRAM_SIZE - address)))
+    {
+        return false;
+    }
+
+    while (0u != size)
+    {
+        bool encrypted;
+        uint32_t run = crypt_span(address, size, &encrypted);
+
+        if (encrypted && (0u != ((address | run) & (HYPERRAM_CRYPTO_BLOCK - 1u))))
+        {
+            return false;
+        }
+
+        address += run;
+        size -= run;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: crypt_on
+********************************************************************************
+* Summary:
+*  Writes back every dirty D-cache line, so that no plain-text line is
+*  evicted through the encryption, and turns the encryption on.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void crypt_on(void)
+{
+    platform_dcache_clean_all();
+    hyperram_set_crypto(true);
+    crypt_stats.switches++;
+}
+
+/*******************************************************************************
+* Function Name: crypt_off
+********************************************************************************
+* Summary:
+*  Turns the encryption off.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void crypt_off(void)
+{
+    hyperram_set_crypto(false);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,107 @@
+/*******************************************************************************
+* File Name:   hyperram_crypt.h
+*
+* Description: Encryption of chosen HYPERRAM regions at rest, with the AES
+* on-the-fly encryption of the SMIF. The SMIF encrypts a whole memory slot
+* or nothing, so this module turns the encryption on only for the transfers
+* that fall inside a registered region and leaves the rest of the device
+* in plain text.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HYPERRAM_CRYPT_H
+#define HYPERRAM_CRYPT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hyperram.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* Keys drawn at run time come from the TRNG of the CRYPTO block */
+#if !defined(HYPERRAM_HOST_SIM) && defined(CY_IP_MXCRYPTO)
+#define HYPERRAM_CRYPT_TRNG             (1)
+#else
+#define HYPERRAM_CRYPT_TRNG             (0)
+#endif
+
+#ifndef HYPERRAM_CRYPT_MAX_REGIONS
+#define HYPERRAM_CRYPT_MAX_REGIONS      (4u)
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef struct
+{
+    uint32_t xip_bytes;         /* moved by DMA with the encryption on */
+    uint32_t command_bytes;     /* encrypted in software for command mode */
+    uint32_t plain_bytes;       /* outside every region */
+    uint32_t switches;          /* times the encryption was turned on */
+    uint32_t errors;            /* failed transfers */
+} hyperram_crypt_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+hyperram_status_t hyperram_crypt_init(const uint32_t* key, const uint32_t* nonce);
+void hyperram_crypt_deinit(void);
+hyperram_status_t hyperram_crypt_add_region(uint32_t offset, uint32_t size);
+void hyperram_crypt_clear_regions(void);
+bool hyperram_crypt_is_encrypted(uint32_t address);
+hyperram_status_t hyperram_crypt_read(void* dst, uint32_t address, uint32_t size);
+hyperram_status_t hyperram_crypt_write(uint32_t address, const void* src, uint32_t size);
+hyperram_status_t hyperram_crypt_read_command(void* dst, uint32_t address, uint32_t size);
+hyperram_status_t hyperram_crypt_write_command(uint32_t address, const void* src, uint32_t size);
+void hyperram_crypt_begin(uint32_t address, uint32_t size);
+void hyperram_crypt_end(uint32_t address, uint32_t size);
+void hyperram_crypt_get_stats(hyperram_crypt_stats_t* stats);
+void hyperram_crypt_print_stats(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* HYPERRAM_CRYPT_H */
+
+/* [] END OF FILE */
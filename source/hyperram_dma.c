@@ -0,0 +1,648 @@
+/*******************************************************************************
+* File Name:   hyperram_dma.c
+*
+* Description: HAL DMA based block copies for the HYPERRAM XIP window. The
+* caller puts the SMIF in memory mode before copying to or from the window.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include "cyhal.h"
+#include "platform.h"
+#include "hyperram_dma.h"
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef enum
+{
+    HYPERRAM_DMA_JOB_COPY,
+    HYPERRAM_DMA_JOB_FILL,      /* src is a single word repeated over dst */
+    HYPERRAM_DMA_JOB_PATTERN,   /* src alternates between the pattern buffers */
+} hyperram_dma_job_kind_t;
+
+typedef struct
+{
+    uint32_t dst;
+    uint32_t src;
+    uint32_t remaining;
+    uint32_t segment;
+    hyperram_dma_job_kind_t kind;
+    hyperram_dma_pattern_t pattern;
+    uint32_t next;              /* generator state of the pattern */
+    uint32_t buffer;            /* pattern buffer of the running segment */
+    hyperram_dma_callback_t callback;
+    void* arg;
+} hyperram_dma_job_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+static cyhal_dma_t hyperram_dma_obj;
+static hyperram_dma_job_t hyperram_dma_job;
+static volatile bool hyperram_dma_busy;
+static volatile bool hyperram_dma_failed;
+static bool hyperram_dma_ready;
+CY_ALIGN(PLATFORM_CACHE_LINE) static uint32_t hyperram_dma_fill_word;
+CY_ALIGN(PLATFORM_CACHE_LINE) static uint32_t hyperram_dma_pattern_buf[2][HYPERRAM_DMA_PATTERN_SIZE / sizeof(uint32_t)];
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static bool hyperram_dma_start_segment(void);
+static void hyperram_dma_pattern_generate(uint32_t* words);
+static void hyperram_dma_event_handler(void* callback_arg, cyhal_dma_event_t event);
+
+/*******************************************************************************
+* Function Name: hyperram_dma_init
+********************************************************************************
+* Summary:
+*  Allocates a memory-to-memory DMA channel and enables its completion
+*  interrupt. Later calls return immediately, so every user of the channel
+*  may call this.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS or HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t hyperram_dma_init(void)
+{
+    cy_rslt_t result;
+
+    if (hyperram_dma_ready)
+    {
+        return HYPERRAM_SUCCESS;
+    }
+
+    result = cyhal_dma_init(&hyperram_dma_obj, CYHAL_DMA_PRIORITY_DEFAULT, CYHAL_DMA_DIRECTION_MEM2MEM);
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        return HYPERRAM_ERROR;
+    }
+
+    cyhal_dma_register_callback(&hyperram_dma_obj, hyperram_dma_event_handler, NULL);
+    cyhal_dma_enable_event(&hyperram_dma_obj, CYHAL_DMA_TRANSFER_COMPLETE,
+                           HYPERRAM_DMA_ISR_PRIORITY, true);
+
+    hyperram_dma_busy = false;
+    hyperram_dma_ready = true;
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_dma_copy
+********************************************************************************
+* Summary:
+*  Copies a block by DMA and waits for completion.
+*
+* Parameters:
+*  dst - destination address
+*  src - source address
+*  size - number of bytes
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS or HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t hyperram_dma_copy(void* dst, const void* src, uint32_t size)
+{
+    hyperram_status_t status = hyperram_dma_copy_async(dst, src, size, NULL, NULL);
+
+    if (HYPERRAM_SUCCESS == status)
+    {
+        hyperram_dma_wait();
+        status = hyperram_dma_failed ? HYPERRAM_ERROR : HYPERRAM_SUCCESS;
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_dma_copy_async
+********************************************************************************
+* Summary:
+*  Starts a DMA copy and returns immediately. The callback runs in interrupt
+*  context once the last segment has completed. Word transfers are used when
+*  both addresses and the size are word aligned, byte transfers otherwise.
+*
+* Parameters:
+*  dst - destination address
+*  src - source address
+*  size - number of bytes
+*  callback - completion callback, may be NULL
+*  arg - argument passed to the callback
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, or HYPERRAM_ERROR if a transfer is
+*                      already running or the DMA rejected the configuration
+*
+*******************************************************************************/
+hyperram_status_t hyperram_dma_copy_async(void* dst, const void* src, uint32_t size,
+                                          hyperram_dma_callback_t callback, void* arg)
+{
+    if (hyperram_dma_busy)
+    {
+        return HYPERRAM_ERROR;
+    }
+
+    hyperram_dma_job.dst = (uint32_t)dst;
+    hyperram_dma_job.src = (uint32_t)src;
+    hyperram_dma_job.remaining = size;
+    hyperram_dma_job.kind = HYPERRAM_DMA_JOB_COPY;
+    hyperram_dma_job.callback = callback;
+    hyperram_dma_job.arg = arg;
+
+    hyperram_dma_failed = false;
+
+    if (0u == size)
+    {
+        if (NULL != callback)
+        {
+            callback(arg);
+        }
+        return HYPERRAM_SUCCESS;
+    }
+
+    hyperram_dma_busy = true;
+
+    if (!hyperram_dma_start_segment())
+    {
+        hyperram_dma_busy = false;
+        return HYPERRAM_ERROR;
+    }
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_dma_fill
+********************************************************************************
+* Summary:
+*  Fills a block with a repeated 32-bit value by DMA and waits for
+*  completion. The source address does not advance, so no SRAM pattern
+*  buffer is needed.
+*
+* Parameters:
+*  dst - destination address, word aligned
+*  value - word written to every position
+*  size - number of bytes, multiple of 4
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM for unaligned
+*                      arguments, or HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t hyperram_dma_fill(void* dst, uint32_t value, uint32_t size)
+{
+    hyperram_status_t status = hyperram_dma_fill_async(dst, value, size, NULL, NULL);
+
+    if (HYPERRAM_SUCCESS == status)
+    {
+        hyperram_dma_wait();
+        status = hyperram_dma_failed ? HYPERRAM_ERROR : HYPERRAM_SUCCESS;
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_dma_fill_async
+********************************************************************************
+* Summary:
+*  Starts a DMA fill with a repeated 32-bit value and returns immediately.
+*  The callback runs in interrupt context once the fill has completed.
+*
+* Parameters:
+*  dst - destination address, word aligned
+*  value - word written to every position
+*  size - number of bytes, multiple of 4
+*  callback - completion callback, may be NULL
+*  arg - argument passed to the callback
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM for unaligned
+*                      arguments, or HYPERRAM_ERROR if a transfer is already
+*                      running or the DMA rejected the configuration
+*
+*******************************************************************************/
+hyperram_status_t hyperram_dma_fill_async(void* dst, uint32_t value, uint32_t size,
+                                          hyperram_dma_callback_t callback, void* arg)
+{
+    if (0u != (((uint32_t)dst | size) & 3u))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    if (hyperram_dma_busy)
+    {
+        return HYPERRAM_ERROR;
+    }
+
+    hyperram_dma_failed = false;
+
+    if (0u == size)
+    {
+        if (NULL != callback)
+        {
+            callback(arg);
+        }
+        return HYPERRAM_SUCCESS;
+    }
+
+    hyperram_dma_fill_word = value;
+
+    hyperram_dma_job.dst = (uint32_t)dst;
+    hyperram_dma_job.src = (uint32_t)&hyperram_dma_fill_word;
+    hyperram_dma_job.remaining = size;
+    hyperram_dma_job.kind = HYPERRAM_DMA_JOB_FILL;
+    hyperram_dma_job.callback = callback;
+    hyperram_dma_job.arg = arg;
+
+    hyperram_dma_busy = true;
+
+    if (!hyperram_dma_start_segment())
+    {
+        hyperram_dma_busy = false;
+        return HYPERRAM_ERROR;
+    }
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_dma_pattern_fill
+********************************************************************************
+* Summary:
+*  Fills a block with a generated pattern by DMA and waits for completion.
+*
+* Parameters:
+*  dst - destination address, word aligned
+*  pattern - pattern type
+*  seed - first value or generator seed
+*  size - number of bytes, multiple of 4
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM, or
+*                      HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t hyperram_dma_pattern_fill(void* dst, hyperram_dma_pattern_t pattern, uint32_t seed, uint32_t size)
+{
+    hyperram_status_t status = hyperram_dma_pattern_fill_async(dst, pattern, seed, size, NULL, NULL);
+
+    if (HYPERRAM_SUCCESS == status)
+    {
+        hyperram_dma_wait();
+        status = hyperram_dma_failed ? HYPERRAM_ERROR : HYPERRAM_SUCCESS;
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_dma_pattern_fill_async
+********************************************************************************
+* Summary:
+*  Starts a DMA fill with a generated pattern and returns immediately. A
+*  constant pattern is a plain fill. The other patterns are produced in two
+*  SRAM buffers of HYPERRAM_DMA_PATTERN_SIZE bytes: each completion
+*  interrupt starts the next segment from one buffer and then generates the
+*  following part of the pattern into the other, so the fill runs at bus
+*  speed for any size. The LFSR pattern is the xorshift32 sequence: word n
+*  is the generator output after n + 1 steps from the seed (0 counts as 1).
+*
+* Parameters:
+*  dst - destination address, word aligned
+*  pattern - pattern type
+*  seed - first value or generator seed
+*  size - number of bytes, multiple of 4
+*  callback - completion callback, may be NULL
+*  arg - argument passed to the callback
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM for unaligned
+*                      arguments or an unknown pattern, or HYPERRAM_ERROR if
+*                      a transfer is already running or the DMA rejected the
+*                      configuration
+*
+*******************************************************************************/
+hyperram_status_t hyperram_dma_pattern_fill_async(void* dst, hyperram_dma_pattern_t pattern, uint32_t seed,
+                                                  uint32_t size, hyperram_dma_callback_t callback, void* arg)
+{
+    if (HYPERRAM_DMA_PATTERN_CONSTANT == pattern)
+    {
+        return hyperram_dma_fill_async(dst, seed, size, callback, arg);
+    }
+
+    if ((0u != (((uint32_t)dst | size) & 3u)) ||
+        ((HYPERRAM_DMA_PATTERN_INCREMENT != pattern) && (HYPERRAM_DMA_PATTERN_LFSR != pattern)))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    if (hyperram_dma_busy)
+    {
+        return HYPERRAM_ERROR;
+    }
+
+    hyperram_dma_failed = false;
+
+    if (0u == size)
+    {
+        if (NULL != callback)
+        {
+            callback(arg);
+        }
+        return HYPERRAM_SUCCESS;
+    }
+
+    hyperram_dma_job.dst = (uint32_t)dst;
+    hyperram_dma_job.src = (uint32_t)hyperram_dma_pattern_buf[0];
+    hyperram_dma_job.remaining = size;
+    hyperram_dma_job.kind = HYPERRAM_DMA_JOB_PATTERN;
+    hyperram_dma_job.pattern = pattern;
+    hyperram_dma_job.next = ((HYPERRAM_DMA_PATTERN_LFSR == pattern) && (0u == seed)) ? 1u : seed;
+    hyperram_dma_job.buffer = 0u;
+    hyperram_dma_job.callback = callback;
+    hyperram_dma_job.arg = arg;
+
+    hyperram_dma_pattern_generate(hyperram_dma_pattern_buf[0]);
+    if (size > HYPERRAM_DMA_PATTERN_SIZE)
+    {
+        hyperram_dma_pattern_generate(hyperram_dma_pattern_buf[1]);
+    }
+
+    hyperram_dma_busy = true;
+
+    if (!hyperram_dma_start_segment())
+    {
+        hyperram_dma_busy = false;
+        return HYPERRAM_ERROR;
+    }
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_dma_is_busy
+********************************************************************************
+* Summary:
+*  Reports whether a DMA copy is in progress.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true while a copy is running
+*
+*******************************************************************************/
+bool hyperram_dma_is_busy(void)
+{
+    return hyperram_dma_busy;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_dma_wait
+********************************************************************************
+* Summary:
+*  Waits for the running DMA copy to complete. Interrupts must be enabled.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_dma_wait(void)
+{
+    while (hyperram_dma_busy)
+    {
+    }
+}
+
+/*******************************************************************************
+* Function Name: hyperram_dma_get_result
+********************************************************************************
+* Summary:
+*  Reports the outcome of the last transfer, for callers of
+*  hyperram_dma_copy_async() that wait with hyperram_dma_wait().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, or HYPERRAM_ERROR if the last
+*                      transfer stopped before its end
+*
+*******************************************************************************/
+hyperram_status_t hyperram_dma_get_result(void)
+{
+    return hyperram_dma_failed ? HYPERRAM_ERROR : HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_dma_start_segment
+********************************************************************************
+* Summary:
+*  Configures and triggers the next segment of the current job.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true if the segment was started
+*
+*******************************************************************************/
+static bool hyperram_dma_start_segment(void)
+{
+    hyperram_dma_job_t* job = &hyperram_dma_job;
+    cyhal_dma_cfg_t dma_cfg;
+    uint32_t segment = job->remaining;
+    uint8_t width = 8u;
+
+    if (segment > HYPERRAM_DMA_MAX_SEGMENT)
+    {
+        segment = HYPERRAM_DMA_MAX_SEGMENT;
+    }
+
+    if ((HYPERRAM_DMA_JOB_PATTERN == job->kind) && (segment > HYPERRAM_DMA_PATTERN_SIZE))
+    {
+        segment = HYPERRAM_DMA_PATTERN_SIZE;
+    }
+
+    if (0u == ((job->dst | job->src | segment) & 3u))
+    {
+        width = 32u;
+    }
+
+    job->segment = segment;
+
+    platform_dcache_clean((void*)job->src, (HYPERRAM_DMA_JOB_FILL == job->kind) ? sizeof(uint32_t) : segment);
+    platform_dcache_discard((void*)job->dst, segment);
+
+    dma_cfg.src_addr       = job->src;
+    dma_cfg.src_increment  = (HYPERRAM_DMA_JOB_FILL == job->kind) ? 0 : 1;
+    dma_cfg.dst_addr       = job->dst;
+    dma_cfg.dst_increment  = 1;
+    dma_cfg.transfer_width = width;
+    dma_cfg.length         = segment / (width / 8u);
+    dma_cfg.burst_size     = 0u;
+    dma_cfg.action         = CYHAL_DMA_TRANSFER_FULL;
+
+    if (CY_RSLT_SUCCESS != cyhal_dma_configure(&hyperram_dma_obj, &dma_cfg))
+    {
+        return false;
+    }
+
+    if (CY_RSLT_SUCCESS != cyhal_dma_enable(&hyperram_dma_obj))
+    {
+        return false;
+    }
+
+    return (CY_RSLT_SUCCESS == cyhal_dma_start_transfer(&hyperram_dma_obj));
+}
+
+/*******************************************************************************
+* Function Name: hyperram_dma_event_handler
+********************************************************************************
+* Summary:
+*  DMA completion interrupt. Makes the destination visible to the CPU and
+*  chains the next segment or completes the job. Lines inside the segment
+*  are invalidated; partly covered lines at its edges are cleaned and
+*  invalidated so neighbouring data in them survives.
+*
+* Parameters:
+*  callback_arg - unused
+*  event - DMA events that occurred
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void hyperram_dma_event_handler(void* callback_arg, cyhal_dma_event_t event)
+{
+    hyperram_dma_job_t* job = &hyperram_dma_job;
+
+    (void)callback_arg;
+
+    if (0u == (event & CYHAL_DMA_TRANSFER_COMPLETE))
+    {
+        return;
+    }
+
+    /* Partial edge lines also hold other data; clean them, do not drop them */
+    platform_dcache_discard((void*)job->dst, job->segment);
+
+    job->src       += (HYPERRAM_DMA_JOB_COPY == job->kind) ? job->segment : 0u;
+    job->dst       += job->segment;
+    job->remaining -= job->segment;
+
+    if (HYPERRAM_DMA_JOB_PATTERN == job->kind)
+    {
+        job->buffer ^= 1u;
+        job->src = (uint32_t)hyperram_dma_pattern_buf[job->buffer];
+    }
+
+    if ((0u != job->remaining) && hyperram_dma_start_segment())
+    {
+        /* The buffer just written out holds the segment after this one */
+        if ((HYPERRAM_DMA_JOB_PATTERN == job->kind) && (job->remaining > job->segment))
+        {
+            hyperram_dma_pattern_generate(hyperram_dma_pattern_buf[job->buffer ^ 1u]);
+        }
+        return;
+    }
+
+    hyperram_dma_failed = (0u != job->remaining);
+    hyperram_dma_busy = false;
+
+    if (NULL != job->callback)
+    {
+        job->callback(job->arg);
+    }
+}
+
+/*******************************************************************************
+* Function Name: hyperram_dma_pattern_generate
+********************************************************************************
+* Summary:
+*  Generates the next HYPERRAM_DMA_PATTERN_SIZE bytes of the running
+*  pattern job.
+*
+* Parameters:
+*  words - pattern buffer to fill
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void hyperram_dma_pattern_generate(uint32_t* words)
+{
+    uint32_t value = hyperram_dma_job.next;
+
+    if (HYPERRAM_DMA_PATTERN_INCREMENT == hyperram_dma_job.pattern)
+    {
+        for (uint32_t index = 0; index < (HYPERRAM_DMA_PATTERN_SIZE / sizeof(uint32_t)); index++)
+        {
+            words[index] = value++;
+        }
+    }
+    else
+    {
+        for (uint32_t index = 0; index < (HYPERRAM_DMA_PATTERN_SIZE / sizeof(uint32_t)); index++)
+        {
+            value ^= value << 13;
+            value ^= value >> 17;
+            value ^= value << 5;
+            words[index] = value;
+        }
+    }
+
+    hyperram_dma_job.next = value;
+}
+
+/* [] END OF FILE */
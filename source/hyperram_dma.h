@@ -0,0 +1,113 @@
+/*******************************************************************************
+* File Name:   hyperram_dma.h
+*
+* Description: Memory-to-memory DMA between SRAM and the HYPERRAM XIP window.
+* Transfers longer than one DMA descriptor are split and chained from the
+* completion interrupt; D-cache maintenance is done around every segment.
+* A destination that shares cache lines with other data can still lose CPU
+* writes made to those lines during the transfer, so DMA buffers in SRAM
+* should come from dma_buffer_alloc().
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HYPERRAM_DMA_H
+#define HYPERRAM_DMA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hyperram.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* Largest segment handed to a single DMA configuration */
+#define HYPERRAM_DMA_MAX_SEGMENT        (16384u)
+
+/* Completion interrupt priority. Kept above the lowest level so that a
+ * handler running at the lowest level, such as the hyperram_vm fault
+ * handler, can wait for a transfer. */
+#ifndef HYPERRAM_DMA_ISR_PRIORITY
+#define HYPERRAM_DMA_ISR_PRIORITY       (3u)
+#endif
+
+/* Generated fills: size of each of the two SRAM pattern buffers. The DMA
+ * writes one while the completion interrupt generates the other. */
+#ifndef HYPERRAM_DMA_PATTERN_SIZE
+#define HYPERRAM_DMA_PATTERN_SIZE       (2048u)
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef void (*hyperram_dma_callback_t)(void* arg);
+
+typedef enum
+{
+    HYPERRAM_DMA_PATTERN_CONSTANT,      /* every word is the seed */
+    HYPERRAM_DMA_PATTERN_INCREMENT,     /* word n is seed + n */
+    HYPERRAM_DMA_PATTERN_LFSR,          /* xorshift32 sequence from the seed */
+} hyperram_dma_pattern_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+hyperram_status_t hyperram_dma_init(void);
+hyperram_status_t hyperram_dma_copy(void* dst, const void* src, uint32_t size);
+hyperram_status_t hyperram_dma_copy_async(void* dst, const void* src, uint32_t size,
+                                          hyperram_dma_callback_t callback, void* arg);
+hyperram_status_t hyperram_dma_fill(void* dst, uint32_t value, uint32_t size);
+hyperram_status_t hyperram_dma_fill_async(void* dst, uint32_t value, uint32_t size,
+                                          hyperram_dma_callback_t callback, void* arg);
+hyperram_status_t hyperram_dma_pattern_fill(void* dst, hyperram_dma_pattern_t pattern, uint32_t seed, uint32_t size);
+hyperram_status_t hyperram_dma_pattern_fill_async(void* dst, hyperram_dma_pattern_t pattern, uint32_t seed,
+                                                  uint32_t size, hyperram_dma_callback_t callback, void* arg);
+bool hyperram_dma_is_busy(void);
+void hyperram_dma_wait(void);
+hyperram_status_t hyperram_dma_get_result(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* HYPERRAM_DMA_H */
+
+/* [] END OF FILE */
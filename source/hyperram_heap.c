@@ -0,0 +1,835 @@
+/*******************************************************************************
+* File Name:   hyperram_heap.c
+*
+* Description: HYPERRAM heap allocator, see hyperram_heap.h.
+*
+* The arena is described by a table of blocks kept sorted by address in
+* SRAM. Allocation is a best-fit scan of the free blocks. Freeing finds the
+* block by binary search and merges it with free neighbours. A slab is
+* one arena block cut into equal objects, with the free objects tracked
+* in an SRAM bitmap.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include "platform.h"
+#include "hyperram_heap.h"
+#include "perf_counter.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+#define HEAP_BLOCK_FREE                 (0u)
+#define HEAP_BLOCK_USED                 (1u)
+#define HEAP_BLOCK_SLAB                 (2u)
+
+#define HEAP_SLAB_NONE                  (0xFFu)
+#define HEAP_SLAB_MAX_OBJECTS           (HYPERRAM_HEAP_SLAB_SIZE / HYPERRAM_HEAP_ALIGN)
+#define HEAP_SLAB_BITMAP_WORDS          (HEAP_SLAB_MAX_OBJECTS / 32u)
+
+#define HEAP_ROUND_UP(value, align)     (((value) + ((align) - 1u)) & ~((align) - 1u))
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef struct
+{
+    uint32_t offset;            /* from HYPERRAM_HEAP_OFFSET */
+    uint32_t size;
+    uint8_t state;              /* HEAP_BLOCK_* */
+    uint8_t slab;               /* slab index for HEAP_BLOCK_SLAB */
+} heap_block_t;
+
+typedef struct
+{
+    uint32_t offset;
+    uint32_t free_bitmap[HEAP_SLAB_BITMAP_WORDS];   /* set bit = free object */
+    uint16_t free_objects;
+    uint8_t size_class;
+    uint8_t next;               /* next slab of the class with free objects */
+    bool in_use;
+} heap_slab_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint32_t heap_size_class(uint32_t size);
+static int32_t heap_arena_alloc(uint32_t size, uint8_t state, uint8_t slab);
+static int32_t heap_arena_find(uint32_t offset);
+static void heap_arena_release(int32_t index);
+static bool heap_insert_block(uint32_t index, uint32_t offset, uint32_t size);
+static void heap_remove_block(uint32_t index);
+static int32_t heap_slab_alloc(uint32_t size_class);
+static bool heap_slab_free(heap_slab_t* slab, uint32_t offset);
+static uint8_t heap_slab_create(uint32_t size_class);
+static void heap_slab_unlink(heap_slab_t* slab);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+static heap_block_t heap_blocks[HYPERRAM_HEAP_MAX_BLOCKS];
+static uint32_t heap_block_count;
+
+static heap_slab_t heap_slabs[HYPERRAM_HEAP_MAX_SLABS];
+static uint8_t heap_partial[HYPERRAM_HEAP_SLAB_CLASSES];   /* slabs with free objects */
+
+static hyperram_heap_stats_t heap_stats;
+static uint64_t heap_alloc_total_ns;
+static uint64_t heap_free_total_ns;
+static uint8_t* heap_base;
+
+/*******************************************************************************
+* Function Name: hyperram_heap_init
+********************************************************************************
+* Summary:
+*  Resets the heap to a single free block. The HYPERRAM itself is not
+*  accessed, so this can run before the memory is initialized. Any pointer
+*  returned before the call becomes invalid.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, or HYPERRAM_BAD_PARAM if the heap
+*                      range does not fit in the device
+*
+*******************************************************************************/
+hyperram_status_t hyperram_heap_init(void)
+{
+    if ((0u != (HYPERRAM_HEAP_OFFSET % HYPERRAM_HEAP_ALIGN)) ||
+        (HYPERRAM_HEAP_SIZE < HYPERRAM_HEAP_SLAB_SIZE) ||
+        (HYPERRAM_HEAP_SIZE > (HYPERRAM_SIZE - HYPERRAM_HEAP_OFFSET)))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    perf_counter_init();
+
+    memset(heap_slabs, 0, sizeof(heap_slabs));
+    memset(heap_partial, HEAP_SLAB_NONE, sizeof(heap_partial));
+    memset(&heap_stats, 0, sizeof(heap_stats));
+    heap_alloc_total_ns = 0u;
+    heap_free_total_ns = 0u;
+    heap_base = (uint8_t*)hyperram_xip_ptr(HYPERRAM_HEAP_OFFSET);
+
+    heap_blocks[0].offset = 0u;
+    heap_blocks[0].size = HYPERRAM_HEAP_SIZE & ~(HYPERRAM_HEAP_ALIGN - 1u);
+    heap_blocks[0].state = HEAP_BLOCK_FREE;
+    heap_blocks[0].slab = HEAP_SLAB_NONE;
+    heap_block_count = 1u;
+
+    heap_stats.heap_size = heap_blocks[0].size;
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_heap_alloc
+********************************************************************************
+* Summary:
+*  Allocates a cache line aligned buffer in the HYPERRAM. The contents are
+*  not initialized. Not reentrant; do not call from interrupt handlers.
+*
+* Parameters:
+*  size - number of bytes
+*
+* Return:
+*  void* - XIP address of the buffer, or NULL if size is 0 or no space or
+*          descriptor is left
+*
+*******************************************************************************/
+void* hyperram_heap_alloc(uint32_t size)
+{
+    uint32_t start = perf_counter_now();
+    uint32_t granted;
+    int32_t offset;
+    uint32_t elapsed;
+
+    if ((0u == size) || (NULL == heap_base) || (size > heap_stats.heap_size))
+    {
+        heap_stats.failed_count++;
+        return NULL;
+    }
+
+    if (size <= HYPERRAM_HEAP_SLAB_MAX_OBJECT)
+    {
+        uint32_t size_class = heap_size_class(size);
+
+        granted = HYPERRAM_HEAP_ALIGN << size_class;
+        offset = heap_slab_alloc(size_class);
+    }
+    else
+    {
+        int32_t index;
+
+        granted = HEAP_ROUND_UP(size, HYPERRAM_HEAP_ALIGN);
+        index = heap_arena_alloc(granted, HEAP_BLOCK_USED, HEAP_SLAB_NONE);
+        offset = -1;
+        if (index >= 0)
+        {
+            /* The block is not split when the table is full; count what free releases */
+            granted = heap_blocks[index].size;
+            offset = (int32_t)heap_blocks[index].offset;
+        }
+    }
+
+    elapsed = perf_counter_to_ns(perf_counter_now() - start);
+
+    if (offset < 0)
+    {
+        heap_stats.failed_count++;
+        return NULL;
+    }
+
+    heap_stats.alloc_count++;
+    heap_stats.used_bytes += granted;
+    if (heap_stats.used_bytes > heap_stats.peak_used_bytes)
+    {
+        heap_stats.peak_used_bytes = heap_stats.used_bytes;
+    }
+
+    heap_alloc_total_ns += elapsed;
+    if (elapsed > heap_stats.alloc_max_ns)
+    {
+        heap_stats.alloc_max_ns = elapsed;
+    }
+
+    return &heap_base[offset];
+}
+
+/*******************************************************************************
+* Function Name: hyperram_heap_free
+********************************************************************************
+* Summary:
+*  Returns a buffer to the heap. NULL is ignored. Pointers that were not
+*  returned by hyperram_heap_alloc(), or were already freed, are counted
+*  in invalid_free_count and otherwise ignored.
+*
+* Parameters:
+*  ptr - buffer to free
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_heap_free(void* ptr)
+{
+    uint32_t start = perf_counter_now();
+    uint32_t offset;
+    uint32_t released = 0u;
+    uint32_t elapsed;
+    int32_t index;
+
+    if (NULL == ptr)
+    {
+        return;
+    }
+
+    if ((NULL == heap_base) || ((uint8_t*)ptr < heap_base) ||
+        ((uint32_t)((uint8_t*)ptr - heap_base) >= heap_stats.heap_size))
+    {
+        heap_stats.invalid_free_count++;
+        return;
+    }
+
+    offset = (uint32_t)((uint8_t*)ptr - heap_base);
+
+    /* Last block starting at or below the offset */
+    index = heap_arena_find(offset);
+
+    if ((index >= 0) && (HEAP_BLOCK_SLAB == heap_blocks[index].state))
+    {
+        heap_slab_t* slab = &heap_slabs[heap_blocks[index].slab];
+
+        released = HYPERRAM_HEAP_ALIGN << slab->size_class;
+        if (!heap_slab_free(slab, offset))
+        {
+            released = 0u;
+        }
+    }
+    else if ((index >= 0) && (HEAP_BLOCK_USED == heap_blocks[index].state) &&
+             (heap_blocks[index].offset == offset))
+    {
+        released = heap_blocks[index].size;
+        heap_arena_release(index);
+    }
+
+    elapsed = perf_counter_to_ns(perf_counter_now() - start);
+
+    if (0u == released)
+    {
+        heap_stats.invalid_free_count++;
+        return;
+    }
+
+    heap_stats.free_count++;
+    heap_stats.used_bytes -= released;
+
+    heap_free_total_ns += elapsed;
+    if (elapsed > heap_stats.free_max_ns)
+    {
+        heap_stats.free_max_ns = elapsed;
+    }
+}
+
+/*******************************************************************************
+* Function Name: hyperram_heap_get_stats
+********************************************************************************
+* Summary:
+*  Returns the usage, fragmentation and latency statistics. The free block
+*  figures are computed by walking the block table.
+*
+* Parameters:
+*  stats - filled with the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_heap_get_stats(hyperram_heap_stats_t* stats)
+{
+    *stats = heap_stats;
+
+    stats->free_bytes = 0u;
+    stats->largest_free = 0u;
+    stats->free_blocks = 0u;
+    stats->slab_count = 0u;
+    stats->slab_free_bytes = 0u;
+    stats->block_count = heap_block_count;
+
+    for (uint32_t index = 0; index < heap_block_count; index++)
+    {
+        if (HEAP_BLOCK_FREE == heap_blocks[index].state)
+        {
+            stats->free_bytes += heap_blocks[index].size;
+            stats->free_blocks++;
+            if (heap_blocks[index].size > stats->largest_free)
+            {
+                stats->largest_free = heap_blocks[index].size;
+            }
+        }
+    }
+
+    for (uint32_t index = 0; index < HYPERRAM_HEAP_MAX_SLABS; index++)
+    {
+        if (heap_slabs[index].in_use)
+        {
+            stats->slab_count++;
+            stats->slab_free_bytes += (uint32_t)heap_slabs[index].free_objects *
+                                      (HYPERRAM_HEAP_ALIGN << heap_slabs[index].size_class);
+        }
+    }
+
+    stats->fragmentation_pct = (0u != stats->free_bytes) ?
+        (100u - (uint32_t)(((uint64_t)stats->largest_free * 100u) / stats->free_bytes)) : 0u;
+    stats->alloc_avg_ns = (0u != heap_stats.alloc_count) ?
+        (uint32_t)(heap_alloc_total_ns / heap_stats.alloc_count) : 0u;
+    stats->free_avg_ns = (0u != heap_stats.free_count) ?
+        (uint32_t)(heap_free_total_ns / heap_stats.free_count) : 0u;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_heap_print_stats
+********************************************************************************
+* Summary:
+*  Prints the heap statistics on the console.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_heap_print_stats(void)
+{
+    hyperram_heap_stats_t stats;
+
+    hyperram_heap_get_stats(&stats);
+
+    PLATFORM_PRINTF("HEAP size=%lu used=%lu peak=%lu free=%lu largest=%lu holes=%lu frag=%lu%%\r\n",
+                    (unsigned long)stats.heap_size, (unsigned long)stats.used_bytes,
+                    (unsigned long)stats.peak_used_bytes, (unsigned long)stats.free_bytes,
+                    (unsigned long)stats.largest_free, (unsigned long)stats.free_blocks,
+                    (unsigned long)stats.fragmentation_pct);
+    PLATFORM_PRINTF("HEAP slabs=%lu slab_free=%lu blocks=%lu/%u allocs=%lu frees=%lu failed=%lu invalid=%lu\r\n",
+                    (unsigned long)stats.slab_count, (unsigned long)stats.slab_free_bytes,
+                    (unsigned long)stats.block_count, (unsigned int)HYPERRAM_HEAP_MAX_BLOCKS,
+                    (unsigned long)stats.alloc_count, (unsigned long)stats.free_count,
+                    (unsigned long)stats.failed_count, (unsigned long)stats.invalid_free_count);
+    PLATFORM_PRINTF("HEAP alloc avg=%luns max=%luns free avg=%luns max=%luns\r\n",
+                    (unsigned long)stats.alloc_avg_ns, (unsigned long)stats.alloc_max_ns,
+                    (unsigned long)stats.free_avg_ns, (unsigned long)stats.free_max_ns);
+    PLATFORM_FLUSH();
+}
+
+/*******************************************************************************
+* Function Name: heap_size_class
+********************************************************************************
+* Summary:
+*  Returns the smallest slab class that holds a request.
+*
+* Parameters:
+*  size - requested bytes, 1 to HYPERRAM_HEAP_SLAB_MAX_OBJECT
+*
+* Return:
+*  uint32_t - class index; objects are HYPERRAM_HEAP_ALIGN << index bytes
+*
+*******************************************************************************/
+static uint32_t heap_size_class(uint32_t size)
+{
+    uint32_t size_class = 0u;
+
+    while ((HYPERRAM_HEAP_ALIGN << size_class) < size)
+    {
+        size_class++;
+    }
+
+    return size_class;
+}
+
+/*******************************************************************************
+* Function Name: heap_arena_alloc
+********************************************************************************
+* Summary:
+*  Takes the smallest free block that fits and splits off the remainder.
+*  Slabs are instead cut from the end of the highest free block that fits,
+*  so that long-lived slabs collect at the top of the arena and do not split
+*  the space left for large buffers. If the block table is full the whole
+*  block is used.
+*
+* Parameters:
+*  size - bytes, multiple of HYPERRAM_HEAP_ALIGN
+*  state - HEAP_BLOCK_USED or HEAP_BLOCK_SLAB
+*  slab - slab index for HEAP_BLOCK_SLAB
+*
+* Return:
+*  int32_t - block index, or -1 if no free block is large enough
+*
+*******************************************************************************/
+static int32_t heap_arena_alloc(uint32_t size, uint8_t state, uint8_t slab)
+{
+    int32_t best = -1;
+
+    if (HEAP_BLOCK_SLAB == state)
+    {
+        for (int32_t index = (int32_t)heap_block_count - 1; index >= 0; index--)
+        {
+            if ((HEAP_BLOCK_FREE == heap_blocks[index].state) && (heap_blocks[index].size >= size))
+            {
+                best = index;
+                break;
+            }
+        }
+
+        if ((best >= 0) && (heap_blocks[best].size > size) &&
+            heap_insert_block((uint32_t)best, heap_blocks[best].offset, heap_blocks[best].size - size))
+        {
+            /* The remainder now sits in front of the slab */
+            best++;
+            heap_blocks[best].offset += heap_blocks[best - 1].size;
+            heap_blocks[best].size = size;
+        }
+    }
+    else
+    {
+        for (uint32_t index = 0; index < heap_block_count; index++)
+        {
+            if ((HEAP_BLOCK_FREE == heap_blocks[index].state) && (heap_blocks[index].size >= size) &&
+                ((best < 0) || (heap_blocks[index].size < heap_blocks[best].size)))
+            {
+                best = (int32_t)index;
+
+                if (heap_blocks[index].size == size)
+                {
+                    break;
+                }
+            }
+        }
+
+        if ((best >= 0) && (heap_blocks[best].size > size) &&
+            heap_insert_block((uint32_t)best + 1u, heap_blocks[best].offset + size,
+                              heap_blocks[best].size - size))
+        {
+            heap_blocks[best].size = size;
+        }
+    }
+
+    if (best < 0)
+    {
+        return -1;
+    }
+
+    heap_blocks[best].state = state;
+    heap_blocks[best].slab = slab;
+
+    return best;
+}
+
+/*******************************************************************************
+* Function Name: heap_arena_find
+********************************************************************************
+* Summary:
+*  Binary search for the block containing an offset.
+*
+* Parameters:
+*  offset - heap offset
+*
+* Return:
+*  int32_t - block index, or -1 if the offset is below the first block
+*
+*******************************************************************************/
+static int32_t heap_arena_find(uint32_t offset)
+{
+    int32_t low = 0;
+    int32_t high = (int32_t)heap_block_count - 1;
+    int32_t found = -1;
+
+    while (low <= high)
+    {
+        int32_t middle = (low + high) / 2;
+
+        if (heap_blocks[middle].offset <= offset)
+        {
+            found = middle;
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+
+    return found;
+}
+
+/*******************************************************************************
+* Function Name: heap_arena_release
+********************************************************************************
+* Summary:
+*  Marks a block free and merges it with free neighbours.
+*
+* Parameters:
+*  index - block index
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void heap_arena_release(int32_t index)
+{
+    heap_blocks[index].state = HEAP_BLOCK_FREE;
+    heap_blocks[index].slab = HEAP_SLAB_NONE;
+
+    if (((uint32_t)index + 1u < heap_block_count) && (HEAP_BLOCK_FREE == heap_blocks[index + 1].state))
+    {
+        heap_blocks[index].size += heap_blocks[index + 1].size;
+        heap_remove_block((uint32_t)index + 1u);
+    }
+
+    if ((index > 0) && (HEAP_BLOCK_FREE == heap_blocks[index - 1].state))
+    {
+        heap_blocks[index - 1].size += heap_blocks[index].size;
+        heap_remove_block((uint32_t)index);
+    }
+}
+
+/*******************************************************************************
+* Function Name: heap_insert_block
+********************************************************************************
+* Summary:
+*  Inserts a free block descriptor, keeping the table sorted by address.
+*
+* Parameters:
+*  index - position of the new descriptor
+*  offset - heap offset of the block
+*  size - block size
+*
+* Return:
+*  bool - false if the table is full
+*
+*******************************************************************************/
+static bool heap_insert_block(uint32_t index, uint32_t offset, uint32_t size)
+{
+    if (heap_block_count >= HYPERRAM_HEAP_MAX_BLOCKS)
+    {
+        return false;
+    }
+
+    memmove(&heap_blocks[index + 1u], &heap_blocks[index],
+            (heap_block_count - index) * sizeof(heap_blocks[0]));
+    heap_block_count++;
+
+    heap_blocks[index].offset = offset;
+    heap_blocks[index].size = size;
+    heap_blocks[index].state = HEAP_BLOCK_FREE;
+    heap_blocks[index].slab = HEAP_SLAB_NONE;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: heap_remove_block
+********************************************************************************
+* Summary:
+*  Removes a descriptor from the table.
+*
+* Parameters:
+*  index - descriptor to remove
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void heap_remove_block(uint32_t index)
+{
+    heap_block_count--;
+    memmove(&heap_blocks[index], &heap_blocks[index + 1u],
+            (heap_block_count - index) * sizeof(heap_blocks[0]));
+}
+
+/*******************************************************************************
+* Function Name: heap_slab_alloc
+********************************************************************************
+* Summary:
+*  Takes an object from the first slab of a class that has one free,
+*  creating a slab if none has.
+*
+* Parameters:
+*  size_class - slab class
+*
+* Return:
+*  int32_t - heap offset of the object, or -1 if no slab can be created
+*
+*******************************************************************************/
+static int32_t heap_slab_alloc(uint32_t size_class)
+{
+    uint8_t index = heap_partial[size_class];
+    heap_slab_t* slab;
+    uint32_t object;
+
+    if (HEAP_SLAB_NONE == index)
+    {
+        index = heap_slab_create(size_class);
+
+        if (HEAP_SLAB_NONE == index)
+        {
+            return -1;
+        }
+    }
+
+    slab = &heap_slabs[index];
+
+    for (uint32_t word = 0; ; word++)
+    {
+        if (0u != slab->free_bitmap[word])
+        {
+            uint32_t bit = platform_ctz(slab->free_bitmap[word]);
+
+            slab->free_bitmap[word] &= ~(1UL << bit);
+            object = (word * 32u) + bit;
+            break;
+        }
+    }
+
+    slab->free_objects--;
+
+    if (0u == slab->free_objects)
+    {
+        heap_partial[size_class] = slab->next;
+        slab->next = HEAP_SLAB_NONE;
+    }
+
+    return (int32_t)(slab->offset + (object * (HYPERRAM_HEAP_ALIGN << size_class)));
+}
+
+/*******************************************************************************
+* Function Name: heap_slab_free
+********************************************************************************
+* Summary:
+*  Returns an object to its slab. A slab that becomes empty is given back to
+*  the arena unless it is the only slab of its class with free objects.
+*
+* Parameters:
+*  slab - slab holding the offset
+*  offset - heap offset of the object
+*
+* Return:
+*  bool - false if the offset is not the start of an allocated object
+*
+*******************************************************************************/
+static bool heap_slab_free(heap_slab_t* slab, uint32_t offset)
+{
+    uint32_t object_size = HYPERRAM_HEAP_ALIGN << slab->size_class;
+    uint32_t object;
+    uint32_t mask;
+
+    if (0u != ((offset - slab->offset) % object_size))
+    {
+        return false;
+    }
+
+    object = (offset - slab->offset) / object_size;
+    mask = 1UL << (object % 32u);
+
+    if (0u != (slab->free_bitmap[object / 32u] & mask))
+    {
+        return false;
+    }
+
+    slab->free_bitmap[object / 32u] |= mask;
+
+    if (0u == slab->free_objects++)
+    {
+        slab->next = heap_partial[slab->size_class];
+        heap_partial[slab->size_class] = (uint8_t)(slab - heap_slabs);
+    }
+
+    if ((slab->free_objects == (HYPERRAM_HEAP_SLAB_SIZE / object_size)) &&
+        ((heap_partial[slab->size_class] != (uint8_t)(slab - heap_slabs)) ||
+         (HEAP_SLAB_NONE != slab->next)))
+    {
+        heap_slab_unlink(slab);
+        heap_arena_release(heap_arena_find(slab->offset));
+        slab->in_use = false;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: heap_slab_create
+********************************************************************************
+* Summary:
+*  Carves a new slab out of the arena and makes it the first slab of its
+*  class with free objects.
+*
+* Parameters:
+*  size_class - slab class
+*
+* Return:
+*  uint8_t - slab index, or HEAP_SLAB_NONE if no slab descriptor or arena
+*            space is left
+*
+*******************************************************************************/
+static uint8_t heap_slab_create(uint32_t size_class)
+{
+    uint32_t objects = HYPERRAM_HEAP_SLAB_SIZE / (HYPERRAM_HEAP_ALIGN << size_class);
+    heap_slab_t* slab = NULL;
+    int32_t block;
+    uint8_t index;
+
+    for (index = 0u; index < HYPERRAM_HEAP_MAX_SLABS; index++)
+    {
+        if (!heap_slabs[index].in_use)
+        {
+            slab = &heap_slabs[index];
+            break;
+        }
+    }
+
+    if (NULL == slab)
+    {
+        return HEAP_SLAB_NONE;
+    }
+
+    block = heap_arena_alloc(HYPERRAM_HEAP_SLAB_SIZE, HEAP_BLOCK_SLAB, index);
+
+    if ((block < 0) || (heap_blocks[block].size != HYPERRAM_HEAP_SLAB_SIZE))
+    {
+        /* A slab must be exactly one slab long for heap_slab_free() */
+        if (block >= 0)
+        {
+            heap_arena_release(block);
+        }
+        return HEAP_SLAB_NONE;
+    }
+
+    memset(slab->free_bitmap, 0, sizeof(slab->free_bitmap));
+    for (uint32_t object = 0; object < objects; object++)
+    {
+        slab->free_bitmap[object / 32u] |= 1UL << (object % 32u);
+    }
+
+    slab->offset = heap_blocks[block].offset;
+    slab->free_objects = (uint16_t)objects;
+    slab->size_class = (uint8_t)size_class;
+    slab->in_use = true;
+    slab->next = heap_partial[size_class];
+    heap_partial[size_class] = index;
+
+    return index;
+}
+
+/*******************************************************************************
+* Function Name: heap_slab_unlink
+********************************************************************************
+* Summary:
+*  Removes a slab from the list of slabs with free objects.
+*
+* Parameters:
+*  slab - slab to remove
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void heap_slab_unlink(heap_slab_t* slab)
+{
+    uint8_t index = (uint8_t)(slab - heap_slabs);
+    uint8_t* link = &heap_partial[slab->size_class];
+
+    while (HEAP_SLAB_NONE != *link)
+    {
+        if (*link == index)
+        {
+            *link = slab->next;
+            break;
+        }
+        link = &heap_slabs[*link].next;
+    }
+
+    slab->next = HEAP_SLAB_NONE;
+}
+
+/* [] END OF FILE */
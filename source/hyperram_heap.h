@@ -0,0 +1,126 @@
+/*******************************************************************************
+* File Name:   hyperram_heap.h
+*
+* Description: Heap allocator for the memory mapped HYPERRAM. All allocator state lives
+* in SRAM, so allocating and freeing never access the HYPERRAM.
+* Requests up to HYPERRAM_HEAP_SLAB_MAX_OBJECT bytes are served from
+* per-size-class slabs; larger ones get a best-fit block from the arena.
+* Returned pointers are XIP addresses and are only usable in memory mode.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HYPERRAM_HEAP_H
+#define HYPERRAM_HEAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hyperram.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* Device range managed by the heap; the default is the upper die */
+#ifndef HYPERRAM_HEAP_OFFSET
+#define HYPERRAM_HEAP_OFFSET            (0x00800000UL)
+#endif
+#ifndef HYPERRAM_HEAP_SIZE
+#if defined(HYPERRAM_VM)
+#define HYPERRAM_HEAP_SIZE              (0x00400000UL)  /* upper 4 MB belong to hyperram_vm */
+#else
+#define HYPERRAM_HEAP_SIZE              (0x00800000UL)
+#endif
+#endif
+
+/* Every allocation starts on a D-cache line, so heap buffers are DMA safe */
+#define HYPERRAM_HEAP_ALIGN             (32u)
+
+/* Arena block descriptors, bounds the number of live large allocations
+ * plus free holes plus slabs */
+#define HYPERRAM_HEAP_MAX_BLOCKS        (512u)
+
+/* Slabs: HYPERRAM_HEAP_SLAB_CLASSES power-of-two classes from 32 bytes */
+#define HYPERRAM_HEAP_SLAB_SIZE         (16384u)
+#define HYPERRAM_HEAP_MAX_SLABS         (64u)
+#define HYPERRAM_HEAP_SLAB_CLASSES      (7u)
+#define HYPERRAM_HEAP_SLAB_MAX_OBJECT   (HYPERRAM_HEAP_ALIGN << (HYPERRAM_HEAP_SLAB_CLASSES - 1u))
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef struct
+{
+    uint32_t heap_size;
+    uint32_t used_bytes;            /* bytes handed out, after rounding */
+    uint32_t peak_used_bytes;
+    uint32_t free_bytes;            /* arena bytes not in use or in a slab */
+    uint32_t largest_free;
+    uint32_t free_blocks;
+    uint32_t fragmentation_pct;     /* 100 - largest_free * 100 / free_bytes */
+    uint32_t slab_count;
+    uint32_t slab_free_bytes;       /* unused objects inside slabs */
+    uint32_t block_count;           /* descriptors in use */
+    uint32_t alloc_count;
+    uint32_t free_count;
+    uint32_t failed_count;          /* allocations that returned NULL */
+    uint32_t invalid_free_count;    /* pointers not owned by the heap, or freed twice */
+    uint32_t alloc_avg_ns;
+    uint32_t alloc_max_ns;
+    uint32_t free_avg_ns;
+    uint32_t free_max_ns;
+} hyperram_heap_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+hyperram_status_t hyperram_heap_init(void);
+void* hyperram_heap_alloc(uint32_t size);
+void hyperram_heap_free(void* ptr);
+void hyperram_heap_get_stats(hyperram_heap_stats_t* stats);
+void hyperram_heap_print_stats(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* HYPERRAM_HEAP_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,831 @@
+/*******************************************************************************
+* File Name:   hyperram_lz.c
+*
+* Description: Block compression for data kept in the HYPERRAM. See hyperram_lz.h.
+*
+* The coder writes the LZ4 block format: each sequence is a token (literal
+* length, match length - 4), the literals, a 16-bit match offset and length
+* extension bytes. The last sequence holds literals only.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "platform.h"
+#include "hyperram_lz.h"
+#include "hyperram_dma.h"
+#include "dma_buffer.h"
+#include "perf_counter.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* LZ4 block format limits */
+#define LZ_MIN_MATCH                    (4u)
+#define LZ_LAST_LITERALS                (5u)    /* the block ends with literals */
+#define LZ_MFLIMIT                      (12u)   /* no match starts this close to the end */
+#define LZ_MAX_OFFSET                   (65535u)
+#define LZ_RUN_MASK                     (15u)
+
+/* Search step grows by one every 2^LZ_SKIP_SHIFT bytes without a match, so
+ * incompressible data is passed over quickly */
+#define LZ_SKIP_SHIFT                   (6u)
+
+#define LZ_HASH_SIZE                    (1u << HYPERRAM_LZ_HASH_BITS)
+
+/* Index entries besides the compressed size */
+#define LZ_BLOCK_EMPTY                  (0u)
+#define LZ_BLOCK_BAD                    (0xFFFFu)
+
+#define LZ_NO_BLOCK                     (0xFFFFFFFFUL)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+/* Last position of each hashed 4-byte sequence; positions fit 16 bits
+ * because blocks are at most HYPERRAM_LZ_MAX_BLOCK bytes */
+static uint16_t lz_hash[LZ_HASH_SIZE];
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static hyperram_status_t lz_wait(hyperram_lz_t* store);
+static void* lz_block_ptr(const hyperram_lz_t* store, uint32_t block);
+static uint32_t lz_bus_size(uint32_t size);
+static uint32_t lz_put_length(uint8_t* dst, uint32_t capacity, uint32_t out, uint32_t length);
+static bool lz_get_length(const uint8_t* src, uint32_t size, uint32_t* in, uint32_t* length);
+static inline uint32_t lz_load32(const uint8_t* address);
+static inline uint32_t lz_hash_of(uint32_t sequence);
+static uint32_t lz_ns_per_mb(uint64_t ns, uint64_t bytes);
+
+/*******************************************************************************
+* Function Name: hyperram_lz_init
+********************************************************************************
+* Summary:
+*  Sets up a compressed store over a device range. Each block owns a slot of
+*  block_size bytes in the range, so the store saves bus bandwidth, not
+*  capacity. The index lives in SRAM: the contents do not survive a reset,
+*  and every block reads as zeros until it is written.
+*
+* Parameters:
+*  store - store to set up
+*  offset - device offset of the range, word aligned
+*  size - range size, a multiple of block_size
+*  block_size - power of two from HYPERRAM_LZ_MIN_BLOCK to
+*               HYPERRAM_LZ_MAX_BLOCK
+*  index - size / block_size entries, owned by the caller
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM, or
+*                      HYPERRAM_ERROR if the staging buffers could not be
+*                      allocated
+*
+*******************************************************************************/
+hyperram_status_t hyperram_lz_init(hyperram_lz_t* store, uint32_t offset, uint32_t size,
+                                   uint32_t block_size, uint16_t* index)
+{
+    memset(store, 0, sizeof(*store));
+
+    if ((NULL == index) || (block_size < HYPERRAM_LZ_MIN_BLOCK) || (block_size > HYPERRAM_LZ_MAX_BLOCK) ||
+        (0u != (block_size & (block_size - 1u))) || (0u == size) || (0u != (size & (block_size - 1u))) ||
+        (0u != (offset & 3u)) || (offset > HYPERRAM_SIZE) || (size > (HYPERRAM_SIZE - offset)))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    if (HYPERRAM_SUCCESS != hyperram_dma_init())
+    {
+        return HYPERRAM_ERROR;
+    }
+
+    store->staging[0] = (uint8_t*)dma_buffer_alloc(block_size);
+    store->staging[1] = (uint8_t*)dma_buffer_alloc(block_size);
+    if ((NULL == store->staging[0]) || (NULL == store->staging[1]))
+    {
+        hyperram_lz_deinit(store);
+        return HYPERRAM_ERROR;
+    }
+
+    store->offset = offset;
+    store->block_size = block_size;
+    store->blocks = size / block_size;
+    store->index = index;
+    store->pending = LZ_NO_BLOCK;
+    memset(index, 0, store->blocks * sizeof(uint16_t));
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_lz_deinit
+********************************************************************************
+* Summary:
+*  Waits for a background write and releases the staging buffers.
+*
+* Parameters:
+*  store - store to release
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_lz_deinit(hyperram_lz_t* store)
+{
+    (void)lz_wait(store);
+
+    for (uint32_t slot = 0; slot < 2u; slot++)
+    {
+        if (NULL != store->staging[slot])
+        {
+            dma_buffer_free(store->staging[slot]);
+            store->staging[slot] = NULL;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: hyperram_lz_write
+********************************************************************************
+* Summary:
+*  Compresses a block into a staging buffer and starts writing it in the
+*  background, so the next block is compressed while this one is on the
+*  bus. A block that does not shrink is written as it is, synchronously.
+*  The SMIF must be in memory mode.
+*
+* Parameters:
+*  store - store to write
+*  block - block number
+*  data - block_size bytes
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM, or
+*                      HYPERRAM_ERROR if this or the previous background
+*                      write failed
+*
+*******************************************************************************/
+hyperram_status_t hyperram_lz_write(hyperram_lz_t* store, uint32_t block, const void* data)
+{
+    uint8_t* staging = store->staging[store->slot];
+    uint32_t size = store->block_size;
+    uint32_t packed;
+    uint32_t start;
+    hyperram_status_t status;
+
+    if ((block >= store->blocks) || (NULL == data))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    start = perf_counter_now();
+    packed = hyperram_lz_compress(data, size, staging, size - 1u);
+    store->compress_ns += perf_counter_to_ns(perf_counter_now() - start);
+    store->compressed_bytes += size;
+
+    /* The previous block was written from the other staging buffer */
+    status = lz_wait(store);
+
+    store->stats.writes++;
+    store->stats.bytes_written += size;
+
+    if (0u == packed)
+    {
+        store->stats.raw_blocks++;
+        store->stats.bus_written += size;
+        store->index[block] = (uint16_t)size;
+
+        if (HYPERRAM_SUCCESS != hyperram_dma_copy(lz_block_ptr(store, block), data, size))
+        {
+            store->index[block] = LZ_BLOCK_BAD;
+            store->stats.errors++;
+            status = HYPERRAM_ERROR;
+        }
+
+        return status;
+    }
+
+    store->stats.bus_written += lz_bus_size(packed);
+    store->index[block] = (uint16_t)packed;
+
+    if (HYPERRAM_SUCCESS != hyperram_dma_copy_async(lz_block_ptr(store, block), staging,
+                                                    lz_bus_size(packed), NULL, NULL))
+    {
+        store->index[block] = LZ_BLOCK_BAD;
+        store->stats.errors++;
+        return HYPERRAM_ERROR;
+    }
+
+    store->pending = block;
+    store->slot ^= 1u;
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_lz_read
+********************************************************************************
+* Summary:
+*  Reads the compressed bytes of a block by DMA and decompresses them. A
+*  background write is completed first. The SMIF must be in memory mode.
+*
+* Parameters:
+*  store - store to read
+*  block - block number
+*  data - receives block_size bytes
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM, or
+*                      HYPERRAM_ERROR if a transfer failed or the block
+*                      does not decompress
+*
+*******************************************************************************/
+hyperram_status_t hyperram_lz_read(hyperram_lz_t* store, uint32_t block, void* data)
+{
+    uint8_t* staging = store->staging[store->slot];
+    uint32_t size = store->block_size;
+    uint32_t packed;
+    uint32_t start;
+
+    if ((block >= store->blocks) || (NULL == data))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    (void)lz_wait(store);
+
+    store->stats.reads++;
+    store->stats.bytes_read += size;
+    packed = store->index[block];
+
+    if (LZ_BLOCK_EMPTY == packed)
+    {
+        store->stats.empty_reads++;
+        memset(data, 0, size);
+        return HYPERRAM_SUCCESS;
+    }
+
+    if (LZ_BLOCK_BAD == packed)
+    {
+        store->stats.errors++;
+        return HYPERRAM_ERROR;
+    }
+
+    if (packed == size)
+    {
+        store->stats.bus_read += size;
+        if (HYPERRAM_SUCCESS != hyperram_dma_copy(data, lz_block_ptr(store, block), size))
+        {
+            store->stats.errors++;
+            return HYPERRAM_ERROR;
+        }
+        return HYPERRAM_SUCCESS;
+    }
+
+    store->stats.bus_read += lz_bus_size(packed);
+    if (HYPERRAM_SUCCESS != hyperram_dma_copy(staging, lz_block_ptr(store, block), lz_bus_size(packed)))
+    {
+        store->stats.errors++;
+        return HYPERRAM_ERROR;
+    }
+
+    start = perf_counter_now();
+    if (size != hyperram_lz_decompress(staging, packed, data, size))
+    {
+        store->stats.errors++;
+        return HYPERRAM_ERROR;
+    }
+    store->decompress_ns += perf_counter_to_ns(perf_counter_now() - start);
+    store->decompressed_bytes += size;
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_lz_flush
+********************************************************************************
+* Summary:
+*  Waits until the last written block has reached the device.
+*
+* Parameters:
+*  store - store to flush
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, or HYPERRAM_ERROR if the background
+*                      write failed
+*
+*******************************************************************************/
+hyperram_status_t hyperram_lz_flush(hyperram_lz_t* store)
+{
+    return lz_wait(store);
+}
+
+/*******************************************************************************
+* Function Name: hyperram_lz_compress
+********************************************************************************
+* Summary:
+*  Compresses a buffer into the LZ4 block format with a greedy, single
+*  probe hash match finder. Not reentrant: the hash table is shared.
+*
+* Parameters:
+*  src - data to compress, at most HYPERRAM_LZ_MAX_BLOCK bytes
+*  size - number of bytes in src
+*  dst - output buffer
+*  capacity - size of dst
+*
+* Return:
+*  uint32_t - compressed size, or 0 if the result does not fit capacity
+*
+*******************************************************************************/
+uint32_t hyperram_lz_compress(const void* src, uint32_t size, void* dst, uint32_t capacity)
+{
+    const uint8_t* in = (const uint8_t*)src;
+    uint8_t* out = (uint8_t*)dst;
+    uint32_t anchor = 0u;
+    uint32_t pos = 0u;
+    uint32_t length = 0u;
+    uint32_t literals;
+
+    if ((0u == size) || (size > HYPERRAM_LZ_MAX_BLOCK))
+    {
+        return 0u;
+    }
+
+    memset(lz_hash, 0, sizeof(lz_hash));
+
+    while ((pos + LZ_MFLIMIT) <= size)
+    {
+        uint32_t sequence = lz_load32(&in[pos]);
+        uint32_t hash = lz_hash_of(sequence);
+        uint32_t candidate = lz_hash[hash];
+        uint32_t match;
+        uint32_t token;
+
+        lz_hash[hash] = (uint16_t)pos;
+
+        if ((candidate >= pos) || ((pos - candidate) > LZ_MAX_OFFSET) || (lz_load32(&in[candidate]) != sequence))
+        {
+            pos += 1u + ((pos - anchor) >> LZ_SKIP_SHIFT);
+            continue;
+        }
+
+        /* Extend backwards over pending literals, then forwards up to the
+         * final literals */
+        while ((pos > anchor) && (candidate > 0u) && (in[pos - 1u] == in[candidate - 1u]))
+        {
+            pos--;
+            candidate--;
+        }
+
+        match = LZ_MIN_MATCH;
+        while (((pos + match) < (size - LZ_LAST_LITERALS)) && (in[pos + match] == in[candidate + match]))
+        {
+            match++;
+        }
+
+        literals = pos - anchor;
+        if ((length + 1u + literals + 2u) > capacity)
+        {
+            return 0u;
+        }
+
+        token = length++;
+        out[token] = (uint8_t)(((literals < LZ_RUN_MASK) ? literals : LZ_RUN_MASK) << 4);
+        if (literals >= LZ_RUN_MASK)
+        {
+            length = lz_put_length(out, capacity, length, literals - LZ_RUN_MASK);
+        }
+        if ((0u == length) || ((length + literals + 2u) > capacity))
+        {
+            return 0u;
+        }
+        memcpy(&out[length], &in[anchor], literals);
+        length += literals;
+
+        out[length++] = (uint8_t)(pos - candidate);
+        out[length++] = (uint8_t)((pos - candidate) >> 8);
+
+        out[token] |= (uint8_t)(((match - LZ_MIN_MATCH) < LZ_RUN_MASK) ? (match - LZ_MIN_MATCH) : LZ_RUN_MASK);
+        if ((match - LZ_MIN_MATCH) >= LZ_RUN_MASK)
+        {
+            length = lz_put_length(out, capacity, length, match - LZ_MIN_MATCH - LZ_RUN_MASK);
+            if (0u == length)
+            {
+                return 0u;
+            }
+        }
+
+        pos += match;
+        anchor = pos;
+
+        /* Seed the table inside the match so that the next one is found */
+        if ((pos + LZ_MFLIMIT) <= size)
+        {
+            lz_hash[lz_hash_of(lz_load32(&in[pos - 2u]))] = (uint16_t)(pos - 2u);
+        }
+    }
+
+    literals = size - anchor;
+    if ((length + 1u) > capacity)
+    {
+        return 0u;
+    }
+
+    out[length++] = (uint8_t)(((literals < LZ_RUN_MASK) ? literals : LZ_RUN_MASK) << 4);
+    if (literals >= LZ_RUN_MASK)
+    {
+        length = lz_put_length(out, capacity, length, literals - LZ_RUN_MASK);
+    }
+    if ((0u == length) || ((length + literals) > capacity))
+    {
+        return 0u;
+    }
+    memcpy(&out[length], &in[anchor], literals);
+
+    return length + literals;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_lz_decompress
+********************************************************************************
+* Summary:
+*  Decompresses an LZ4 block. Every length and offset is checked, so a
+*  corrupted block cannot write outside dst.
+*
+* Parameters:
+*  src - compressed data
+*  size - number of bytes in src
+*  dst - output buffer
+*  capacity - size of dst
+*
+* Return:
+*  uint32_t - decompressed size, or 0 if the block is malformed or does
+*             not fit capacity
+*
+*******************************************************************************/
+uint32_t hyperram_lz_decompress(const void* src, uint32_t size, void* dst, uint32_t capacity)
+{
+    const uint8_t* in = (const uint8_t*)src;
+    uint8_t* out = (uint8_t*)dst;
+    uint32_t pos = 0u;
+    uint32_t length = 0u;
+
+    while (pos < size)
+    {
+        uint32_t token = in[pos++];
+        uint32_t literals = token >> 4;
+        uint32_t match = token & LZ_RUN_MASK;
+        uint32_t offset;
+
+        if ((LZ_RUN_MASK == literals) && !lz_get_length(in, size, &pos, &literals))
+        {
+            return 0u;
+        }
+
+        if ((literals > (size - pos)) || (literals > (capacity - length)))
+        {
+            return 0u;
+        }
+        memcpy(&out[length], &in[pos], literals);
+        pos += literals;
+        length += literals;
+
+        if (pos == size)
+        {
+            break;
+        }
+
+        if ((size - pos) < 2u)
+        {
+            return 0u;
+        }
+        offset = (uint32_t)in[pos] | ((uint32_t)in[pos + 1u] << 8);
+        pos += 2u;
+
+        if ((LZ_RUN_MASK == match) && !lz_get_length(in, size, &pos, &match))
+        {
+            return 0u;
+        }
+        match += LZ_MIN_MATCH;
+
+        if ((0u == offset) || (offset > length) || (match > (capacity - length)))
+        {
+            return 0u;
+        }
+
+        /* A match longer than its offset repeats the last offset bytes.
+         * Everything from the match source on is periodic, so each copy
+         * can take all of it, doubling the step. */
+        for (uint32_t from = length - offset; 0u != match; )
+        {
+            uint32_t chunk = ((length - from) < match) ? (length - from) : match;
+
+            memcpy(&out[length], &out[from], chunk);
+            length += chunk;
+            match -= chunk;
+        }
+    }
+
+    return length;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_lz_get_stats
+********************************************************************************
+* Summary:
+*  Returns the store statistics, with the CPU cost per MB computed.
+*
+* Parameters:
+*  store - store to query
+*  stats - receives the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_lz_get_stats(const hyperram_lz_t* store, hyperram_lz_stats_t* stats)
+{
+    *stats = store->stats;
+    stats->compress_ns_per_mb = lz_ns_per_mb(store->compress_ns, store->compressed_bytes);
+    stats->decompress_ns_per_mb = lz_ns_per_mb(store->decompress_ns, store->decompressed_bytes);
+}
+
+/*******************************************************************************
+* Function Name: hyperram_lz_print_stats
+********************************************************************************
+* Summary:
+*  Prints the store statistics: bus bytes as a share of block bytes, which
+*  is the bandwidth gain, and the CPU time spent per MB.
+*
+* Parameters:
+*  store - store to report
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_lz_print_stats(const hyperram_lz_t* store)
+{
+    hyperram_lz_stats_t stats;
+
+    hyperram_lz_get_stats(store, &stats);
+
+    PLATFORM_PRINTF("LZ blocks=%lu x %lu writes=%lu raw=%lu reads=%lu empty=%lu errors=%lu\r\n",
+                    (unsigned long)store->blocks, (unsigned long)store->block_size,
+                    (unsigned long)stats.writes, (unsigned long)stats.raw_blocks,
+                    (unsigned long)stats.reads, (unsigned long)stats.empty_reads,
+                    (unsigned long)stats.errors);
+    PLATFORM_PRINTF("LZ bus write %lu%% read %lu%% of block bytes, compress %lu us/MB, decompress %lu us/MB\r\n",
+                    (unsigned long)((0u != stats.bytes_written) ? ((stats.bus_written * 100u) / stats.bytes_written) : 0u),
+                    (unsigned long)((0u != stats.bytes_read) ? ((stats.bus_read * 100u) / stats.bytes_read) : 0u),
+                    (unsigned long)(stats.compress_ns_per_mb / 1000u),
+                    (unsigned long)(stats.decompress_ns_per_mb / 1000u));
+    PLATFORM_FLUSH();
+}
+
+/*******************************************************************************
+* Function Name: lz_wait
+********************************************************************************
+* Summary:
+*  Waits for the background write, if any. A failed block is marked so that
+*  reading it reports the error.
+*
+* Parameters:
+*  store - store to wait for
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, or HYPERRAM_ERROR if the write
+*                      failed
+*
+*******************************************************************************/
+static hyperram_status_t lz_wait(hyperram_lz_t* store)
+{
+    hyperram_status_t status;
+
+    if (LZ_NO_BLOCK == store->pending)
+    {
+        return HYPERRAM_SUCCESS;
+    }
+
+    hyperram_dma_wait();
+    status = hyperram_dma_get_result();
+
+    if (HYPERRAM_SUCCESS != status)
+    {
+        store->index[store->pending] = LZ_BLOCK_BAD;
+        store->stats.errors++;
+    }
+
+    store->pending = LZ_NO_BLOCK;
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: lz_block_ptr
+********************************************************************************
+* Summary:
+*  Returns the XIP address of a block's slot.
+*
+* Parameters:
+*  store - store
+*  block - block number
+*
+* Return:
+*  void* - address in the XIP window
+*
+*******************************************************************************/
+static void* lz_block_ptr(const hyperram_lz_t* store, uint32_t block)
+{
+    return hyperram_xip_ptr(store->offset + (block * store->block_size));
+}
+
+/*******************************************************************************
+* Function Name: lz_bus_size
+********************************************************************************
+* Summary:
+*  Rounds a compressed size up to whole words, so the DMA moves words.
+*
+* Parameters:
+*  size - compressed size
+*
+* Return:
+*  uint32_t - bytes transferred
+*
+*******************************************************************************/
+static uint32_t lz_bus_size(uint32_t size)
+{
+    return (size + 3u) & ~3u;
+}
+
+/*******************************************************************************
+* Function Name: lz_put_length
+********************************************************************************
+* Summary:
+*  Writes a length extension: bytes of 255 followed by the remainder.
+*
+* Parameters:
+*  dst - output buffer
+*  capacity - size of dst
+*  out - write position
+*  length - value to encode
+*
+* Return:
+*  uint32_t - new write position, or 0 if dst is full
+*
+*******************************************************************************/
+static uint32_t lz_put_length(uint8_t* dst, uint32_t capacity, uint32_t out, uint32_t length)
+{
+    if ((out + (length / 255u) + 1u) > capacity)
+    {
+        return 0u;
+    }
+
+    for (; length >= 255u; length -= 255u)
+    {
+        dst[out++] = 255u;
+    }
+    dst[out++] = (uint8_t)length;
+
+    return out;
+}
+
+/*******************************************************************************
+* Function Name: lz_get_length
+********************************************************************************
+* Summary:
+*  Reads a length extension and adds it to a length.
+*
+* Parameters:
+*  src - compressed data
+*  size - number of bytes in src
+*  in - read position, advanced
+*  length - length to extend
+*
+* Return:
+*  bool - false if the data ends inside the extension
+*
+*******************************************************************************/
+static bool lz_get_length(const uint8_t* src, uint32_t size, uint32_t* in, uint32_t* length)
+{
+    uint32_t value;
+
+    do
+    {
+        if (*in >= size)
+        {
+            return false;
+        }
+        value = src[(*in)++];
+        *length += value;
+    } while (255u == value);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: lz_load32
+********************************************************************************
+* Summary:
+*  32-bit load from an address of any alignment.
+*
+* Parameters:
+*  address - address to load from
+*
+* Return:
+*  uint32_t - value
+*
+*******************************************************************************/
+static inline uint32_t lz_load32(const uint8_t* address)
+{
+    uint32_t value;
+
+    memcpy(&value, address, sizeof(value));
+
+    return value;
+}
+
+/*******************************************************************************
+* Function Name: lz_hash_of
+********************************************************************************
+* Summary:
+*  Multiplicative hash of a 4-byte sequence.
+*
+* Parameters:
+*  sequence - four bytes
+*
+* Return:
+*  uint32_t - hash table index
+*
+*******************************************************************************/
+static inline uint32_t lz_hash_of(uint32_t sequence)
+{
+    return (uint32_t)(sequence * 2654435761u) >> (32u - HYPERRAM_LZ_HASH_BITS);
+}
+
+/*******************************************************************************
+* Function Name: lz_ns_per_mb
+********************************************************************************
+* Summary:
+*  Scales a time to one MB of data.
+*
+* Parameters:
+*  ns - time spent
+*  bytes - data processed in that time
+*
+* Return:
+*  uint32_t - nanoseconds per MB, saturated
+*
+*******************************************************************************/
+static uint32_t lz_ns_per_mb(uint64_t ns, uint64_t bytes)
+{
+    uint64_t scaled;
+
+    if (0u == bytes)
+    {
+        return 0u;
+    }
+
+    scaled = (ns * 1048576u) / bytes;
+
+    return (scaled > UINT32_MAX) ? UINT32_MAX : (uint32_t)scaled;
+}
+
+/* [] END OF FILE */
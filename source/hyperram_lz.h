@@ -0,0 +1,125 @@
+/*******************************************************************************
+* File Name:   hyperram_lz.h
+*
+* Description: Block compression for data kept in the HYPERRAM. Fixed-size blocks are
+* compressed with an LZ4-compatible block coder on write, so only the
+* compressed bytes cross the bus, and decompressed on read. The block
+* index (compressed sizes) is kept in SRAM.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HYPERRAM_LZ_H
+#define HYPERRAM_LZ_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hyperram.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* Block sizes are powers of two in this range */
+#define HYPERRAM_LZ_MIN_BLOCK           (256u)
+#define HYPERRAM_LZ_MAX_BLOCK           (16384u)
+
+/* Match finder hash table entries, a power of two. The table is shared by
+ * all stores. */
+#ifndef HYPERRAM_LZ_HASH_BITS
+#define HYPERRAM_LZ_HASH_BITS           (12u)
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef struct
+{
+    uint32_t writes;
+    uint32_t reads;
+    uint32_t raw_blocks;        /* written uncompressed: no gain possible */
+    uint32_t empty_reads;       /* never-written blocks, read without a transfer */
+    uint32_t errors;            /* failed DMA transfers and corrupt blocks */
+    uint64_t bytes_written;     /* block bytes handed to hyperram_lz_write() */
+    uint64_t bytes_read;
+    uint64_t bus_written;       /* bytes actually moved to the device */
+    uint64_t bus_read;
+    uint32_t compress_ns_per_mb;    /* CPU time, per MB of block data */
+    uint32_t decompress_ns_per_mb;
+} hyperram_lz_stats_t;
+
+/* All fields are private */
+typedef struct
+{
+    uint32_t offset;
+    uint32_t block_size;
+    uint32_t blocks;
+    uint16_t* index;            /* compressed size per block, in the caller's table */
+    uint8_t* staging[2];        /* compressed blocks, one filled while the other is written */
+    uint32_t slot;              /* staging buffer the next write fills */
+    uint32_t pending;           /* block being written in the background, or blocks */
+    uint64_t compress_ns;
+    uint64_t compressed_bytes;
+    uint64_t decompress_ns;
+    uint64_t decompressed_bytes;
+    hyperram_lz_stats_t stats;
+} hyperram_lz_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+hyperram_status_t hyperram_lz_init(hyperram_lz_t* store, uint32_t offset, uint32_t size,
+                                   uint32_t block_size, uint16_t* index);
+void hyperram_lz_deinit(hyperram_lz_t* store);
+hyperram_status_t hyperram_lz_write(hyperram_lz_t* store, uint32_t block, const void* data);
+hyperram_status_t hyperram_lz_read(hyperram_lz_t* store, uint32_t block, void* data);
+hyperram_status_t hyperram_lz_flush(hyperram_lz_t* store);
+uint32_t hyperram_lz_compress(const void* src, uint32_t size, void* dst, uint32_t capacity);
+uint32_t hyperram_lz_decompress(const void* src, uint32_t size, void* dst, uint32_t capacity);
+void hyperram_lz_get_stats(const hyperram_lz_t* store, hyperram_lz_stats_t* stats);
+void hyperram_lz_print_stats(const hyperram_lz_t* store);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* HYPERRAM_LZ_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,337 @@
+/*******************************************************************************
+* File Name:   hyperram_mpu.c
+*
+* Description: CM7 MPU regions that select the cache policy of HYPERRAM ranges, see
+* hyperram_mpu.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "platform.h"
+#include "hyperram_mpu.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* Ranges larger than the D-cache are cleaned with one set/way pass */
+#define HYPERRAM_MPU_DCACHE_SIZE        (16384u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef struct
+{
+    uint32_t offset;
+    uint32_t size;
+    hyperram_mpu_policy_t policy;
+    bool active;
+} hyperram_mpu_slot_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void hyperram_mpu_update(uint32_t slot, uint32_t rbar, uint32_t rasr, bool enable);
+static void hyperram_mpu_clean_range(uint32_t offset, uint32_t size);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+static hyperram_mpu_slot_t hyperram_mpu_slots[HYPERRAM_MPU_REGIONS];
+
+static const char* const hyperram_mpu_policy_names[HYPERRAM_MPU_POLICIES] =
+{
+    "write-back", "write-through", "non-cacheable", "device",
+};
+
+/*******************************************************************************
+* Function Name: hyperram_mpu_set_region
+********************************************************************************
+* Summary:
+*  Applies a cache policy to a HYPERRAM range. The range is cleaned and
+*  invalidated in the D-cache first, so no line cached under the old policy
+*  survives the change. Interrupts are masked while the MPU is updated.
+*  Device ranges only allow aligned accesses and no code.
+*
+* Parameters:
+*  slot - region slot, 0 to HYPERRAM_MPU_REGIONS - 1; setting a used slot
+*         replaces its range
+*  offset - byte offset in the device, a multiple of size
+*  size - power of two from 32 bytes to HYPERRAM_SIZE
+*  policy - attributes for the range
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS or HYPERRAM_BAD_PARAM
+*
+*******************************************************************************/
+hyperram_status_t hyperram_mpu_set_region(uint32_t slot, uint32_t offset, uint32_t size,
+                                          hyperram_mpu_policy_t policy)
+{
+    uint32_t size_field = 4u;
+    uint32_t tex = 0u;
+    uint32_t cacheable = 0u;
+    uint32_t bufferable = 0u;
+    uint32_t shareable = 0u;
+    uint32_t no_exec = 0u;
+
+    if ((slot >= HYPERRAM_MPU_REGIONS) || ((uint32_t)policy >= (uint32_t)HYPERRAM_MPU_POLICIES) ||
+        (size < 32u) || (size > HYPERRAM_SIZE) || (0u != (size & (size - 1u))) ||
+        (0u != (offset & (size - 1u))) || (offset > (HYPERRAM_SIZE - size)))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    /* RASR size field: region size is 2^(SIZE + 1) bytes */
+    while ((2UL << size_field) < size)
+    {
+        size_field++;
+    }
+
+    switch (policy)
+    {
+        case HYPERRAM_MPU_WRITE_BACK:
+            tex = 1u;
+            cacheable = 1u;
+            bufferable = 1u;
+            break;
+
+        case HYPERRAM_MPU_WRITE_THROUGH:
+            cacheable = 1u;
+            break;
+
+        case HYPERRAM_MPU_NON_CACHEABLE:
+            tex = 1u;
+            break;
+
+        default:
+            bufferable = 1u;
+            shareable = 1u;
+            no_exec = 1u;
+            break;
+    }
+
+    /* The old range loses its region too, so clean it under its old policy */
+    if (hyperram_mpu_slots[slot].active)
+    {
+        hyperram_mpu_clean_range(hyperram_mpu_slots[slot].offset, hyperram_mpu_slots[slot].size);
+    }
+
+    hyperram_mpu_slots[slot].offset = offset;
+    hyperram_mpu_slots[slot].size = size;
+    hyperram_mpu_slots[slot].policy = policy;
+    hyperram_mpu_slots[slot].active = true;
+
+    hyperram_mpu_clean_range(offset, size);
+    hyperram_mpu_update(slot,
+                        ARM_MPU_RBAR(HYPERRAM_MPU_FIRST_REGION + slot, CY_SMIF_XIP_BASE + offset),
+                        ARM_MPU_RASR(no_exec, ARM_MPU_AP_FULL, tex, shareable, cacheable, bufferable,
+                                     0u, size_field),
+                        true);
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_mpu_clear_region
+********************************************************************************
+* Summary:
+*  Returns the range of a slot to the default memory map.
+*
+* Parameters:
+*  slot - region slot
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_mpu_clear_region(uint32_t slot)
+{
+    if ((slot >= HYPERRAM_MPU_REGIONS) || !hyperram_mpu_slots[slot].active)
+    {
+        return;
+    }
+
+    hyperram_mpu_clean_range(hyperram_mpu_slots[slot].offset, hyperram_mpu_slots[slot].size);
+    hyperram_mpu_slots[slot].active = false;
+    hyperram_mpu_update(slot, 0u, 0u, false);
+}
+
+/*******************************************************************************
+* Function Name: hyperram_mpu_clear_all
+********************************************************************************
+* Summary:
+*  Returns every range to the default memory map.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_mpu_clear_all(void)
+{
+    for (uint32_t slot = 0; slot < HYPERRAM_MPU_REGIONS; slot++)
+    {
+        hyperram_mpu_clear_region(slot);
+    }
+}
+
+/*******************************************************************************
+* Function Name: hyperram_mpu_policy_name
+********************************************************************************
+* Summary:
+*  Returns a printable name for a policy.
+*
+* Parameters:
+*  policy - cache policy
+*
+* Return:
+*  const char* - name, "unknown" for values out of range
+*
+*******************************************************************************/
+const char* hyperram_mpu_policy_name(hyperram_mpu_policy_t policy)
+{
+    if ((uint32_t)policy >= (uint32_t)HYPERRAM_MPU_POLICIES)
+    {
+        return "unknown";
+    }
+
+    return hyperram_mpu_policy_names[policy];
+}
+
+/*******************************************************************************
+* Function Name: hyperram_mpu_print
+********************************************************************************
+* Summary:
+*  Prints the configured ranges.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_mpu_print(void)
+{
+    PLATFORM_PRINTF("HYPERRAM MPU ranges (others use the default map, write-back):\r\n");
+
+    for (uint32_t slot = 0; slot < HYPERRAM_MPU_REGIONS; slot++)
+    {
+        const hyperram_mpu_slot_t* entry = &hyperram_mpu_slots[slot];
+
+        if (entry->active)
+        {
+            PLATFORM_PRINTF("  region %lu: 0x%08lX-0x%08lX %s\r\n",
+                            (unsigned long)(HYPERRAM_MPU_FIRST_REGION + slot),
+                            (unsigned long)entry->offset,
+                            (unsigned long)(entry->offset + entry->size - 1u),
+                            hyperram_mpu_policy_name(entry->policy));
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: hyperram_mpu_update
+********************************************************************************
+* Summary:
+*  Writes or clears one MPU region with interrupts masked. The BSP control
+*  bits are kept and the default map stays enabled for everything else.
+*
+* Parameters:
+*  slot - region slot
+*  rbar - base address register value
+*  rasr - attribute and size register value
+*  enable - false clears the region
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void hyperram_mpu_update(uint32_t slot, uint32_t rbar, uint32_t rasr, bool enable)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+    uint32_t mpu_ctrl = MPU->CTRL & ~MPU_CTRL_ENABLE_Msk;
+
+    ARM_MPU_Disable();
+    if (enable)
+    {
+        ARM_MPU_SetRegion(rbar, rasr);
+    }
+    else
+    {
+        ARM_MPU_ClrRegion(HYPERRAM_MPU_FIRST_REGION + slot);
+    }
+    ARM_MPU_Enable(mpu_ctrl | MPU_CTRL_PRIVDEFENA_Msk);
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/*******************************************************************************
+* Function Name: hyperram_mpu_clean_range
+********************************************************************************
+* Summary:
+*  Writes back and drops every cached line of a HYPERRAM range.
+*
+* Parameters:
+*  offset - byte offset in the device
+*  size - number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void hyperram_mpu_clean_range(uint32_t offset, uint32_t size)
+{
+#if (PLATFORM_HAS_DCACHE)
+    if (size > HYPERRAM_MPU_DCACHE_SIZE)
+    {
+        SCB_CleanInvalidateDCache();
+        return;
+    }
+#endif
+
+    platform_dcache_clean_invalidate((void*)(CY_SMIF_XIP_BASE + offset), size);
+}
+
+/* [] END OF FILE */
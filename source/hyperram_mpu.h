@@ -0,0 +1,99 @@
+/*******************************************************************************
+* File Name:   hyperram_mpu.h
+*
+* Description: Per-range CM7 memory attributes for the HYPERRAM XIP window. Each
+* range gets one MPU region, so its size is a power of two from 32 bytes
+* up to the device size, and its offset is a multiple of the size.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HYPERRAM_MPU_H
+#define HYPERRAM_MPU_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hyperram.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* MPU regions available to hyperram_mpu_set_region(). They sit above the
+ * BSP regions and below HYPERRAM_VM_MPU_REGION, so the fault-driven range
+ * keeps precedence where they overlap. */
+#ifndef HYPERRAM_MPU_FIRST_REGION
+#define HYPERRAM_MPU_FIRST_REGION       (11u)
+#endif
+#ifndef HYPERRAM_MPU_REGIONS
+#define HYPERRAM_MPU_REGIONS            (4u)
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+/* Without a region the window uses the default memory map, which makes
+ * external RAM normal memory, write-back with write-allocate */
+typedef enum
+{
+    HYPERRAM_MPU_WRITE_BACK = 0,    /* normal, write-back, read and write allocate */
+    HYPERRAM_MPU_WRITE_THROUGH,     /* normal, write-through, no write allocate */
+    HYPERRAM_MPU_NON_CACHEABLE,     /* normal, not cached */
+    HYPERRAM_MPU_DEVICE,            /* shareable device, not executable */
+    HYPERRAM_MPU_POLICIES
+} hyperram_mpu_policy_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+hyperram_status_t hyperram_mpu_set_region(uint32_t slot, uint32_t offset, uint32_t size,
+                                          hyperram_mpu_policy_t policy);
+void hyperram_mpu_clear_region(uint32_t slot);
+void hyperram_mpu_clear_all(void);
+const char* hyperram_mpu_policy_name(hyperram_mpu_policy_t policy);
+void hyperram_mpu_print(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* HYPERRAM_MPU_H */
+
+/* [] END OF FILE */
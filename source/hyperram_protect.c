@@ -0,0 +1,571 @@
+/*******************************************************************************
+* File Name:   hyperram_protect.c
+*
+* Description: Protected HYPERRAM regions with a CRC-32 per block. Runs of whole blocks
+* are moved by DMA while the CRC of the previous block is computed, so
+* the check adds little to the transfer; partial blocks go through an
+* SRAM staging block. The CRCs come from hyperram_verify.c and thus from
+* the CRYPTO block where there is one.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include "platform.h"
+#include "hyperram_protect.h"
+#include "hyperram_verify.h"
+#include "hyperram_dma.h"
+#include "dma_buffer.h"
+#include <string.h>
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static hyperram_status_t protect_read_blocks(hyperram_protect_t* region, uint8_t* dst,
+                                             uint32_t first, uint32_t count);
+static hyperram_status_t protect_write_blocks(hyperram_protect_t* region, uint32_t first,
+                                              const uint8_t* src, uint32_t count);
+static void protect_report_bad(hyperram_protect_t* region, uint32_t block);
+static void* protect_block_ptr(const hyperram_protect_t* region, uint32_t block);
+
+/*******************************************************************************
+* Function Name: hyperram_protect_init
+********************************************************************************
+* Summary:
+*  Sets up a protected region. Formatting clears the range and records the
+*  CRC of an empty block; otherwise the current contents are taken as
+*  correct and their CRCs are computed. The device must be in memory mode.
+*
+* Parameters:
+*  region - region to set up
+*  offset - device offset of the region, word aligned
+*  size - region size, a multiple of block_size
+*  block_size - bytes per CRC, a power of two from HYPERRAM_PROTECT_MIN_BLOCK
+*               to HYPERRAM_PROTECT_MAX_BLOCK
+*  table - SRAM array of HYPERRAM_PROTECT_TABLE_WORDS(size / block_size)
+*          words, kept by the caller
+*  format - true to clear the range, false to keep its contents
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM, or
+*                      HYPERRAM_ERROR if the staging block or DMA failed
+*
+*******************************************************************************/
+hyperram_status_t hyperram_protect_init(hyperram_protect_t* region, uint32_t offset, uint32_t size,
+                                        uint32_t block_size, uint32_t* table, bool format)
+{
+    hyperram_status_t status = HYPERRAM_SUCCESS;
+
+    memset(region, 0, sizeof(*region));
+
+    if ((NULL == table) || (block_size < HYPERRAM_PROTECT_MIN_BLOCK) ||
+        (block_size > HYPERRAM_PROTECT_MAX_BLOCK) || (0u != (block_size & (block_size - 1u))) ||
+        (0u == size) || (0u != (size & (block_size - 1u))) || (0u != (offset & 3u)) ||
+        (offset > HYPERRAM_SIZE) || (size > (HYPERRAM_SIZE - offset)))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    if (HYPERRAM_SUCCESS != hyperram_verify_init())
+    {
+        return HYPERRAM_ERROR;
+    }
+
+    region->staging = (uint8_t*)dma_buffer_alloc(block_size);
+    if (NULL == region->staging)
+    {
+        return HYPERRAM_ERROR;
+    }
+
+    region->offset = offset;
+    region->block_size = block_size;
+    region->block_shift = platform_ctz(block_size);
+    region->blocks = size >> region->block_shift;
+    region->crcs = table;
+    region->recent = &table[region->blocks];
+    region->stats.bad_block = HYPERRAM_PROTECT_NO_BLOCK;
+    memset(region->recent, 0, ((region->blocks + 31u) / 32u) * sizeof(uint32_t));
+
+    if (format)
+    {
+        uint32_t empty_crc;
+
+        memset(region->staging, 0, block_size);
+        empty_crc = hyperram_verify_crc32(region->staging, block_size);
+
+        for (uint32_t block = 0; block < region->blocks; block++)
+        {
+            table[block] = empty_crc;
+        }
+
+        status = hyperram_dma_fill(hyperram_xip_ptr(offset), 0u, size);
+    }
+    else
+    {
+        for (uint32_t block = 0; block < region->blocks; block++)
+        {
+            void* xip = protect_block_ptr(region, block);
+
+            platform_dcache_clean_invalidate(xip, block_size);
+            table[block] = hyperram_verify_crc32(xip, block_size);
+        }
+    }
+
+    if (HYPERRAM_SUCCESS != status)
+    {
+        hyperram_protect_deinit(region);
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_protect_deinit
+********************************************************************************
+* Summary:
+*  Returns the staging block to the pool. The device contents and the CRC
+*  table stay as they are.
+*
+* Parameters:
+*  region - region to release
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_protect_deinit(hyperram_protect_t* region)
+{
+    dma_buffer_free(region->staging);
+    region->staging = NULL;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_protect_write
+********************************************************************************
+* Summary:
+*  Writes data into the region and updates the CRCs of the blocks it
+*  covers. Whole blocks are written straight from src; a partially covered
+*  block is read and checked first, so that corruption in its untouched
+*  part is reported instead of being sealed under a new CRC. Such a block
+*  is left unchanged; rewriting it whole repairs it.
+*
+* Parameters:
+*  region - region to write
+*  address - offset in the region
+*  src - data to write
+*  size - number of bytes
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM for a range
+*                      outside the region, or HYPERRAM_ERROR if a merged
+*                      block was corrupted or a DMA transfer failed
+*
+*******************************************************************************/
+hyperram_status_t hyperram_protect_write(hyperram_protect_t* region, uint32_t address,
+                                         const void* src, uint32_t size)
+{
+    const uint8_t* in = (const uint8_t*)src;
+    uint32_t region_size = region->blocks << region->block_shift;
+    hyperram_status_t status = HYPERRAM_SUCCESS;
+
+    if ((address > region_size) || (size > (region_size - address)))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    region->stats.writes++;
+
+    while (0u != size)
+    {
+        uint32_t block = address >> region->block_shift;
+        uint32_t in_block = address & (region->block_size - 1u);
+        uint32_t done = region->block_size - in_block;
+        hyperram_status_t result;
+
+        if ((0u == in_block) && (size >= region->block_size))
+        {
+            done = size & ~(region->block_size - 1u);
+            result = protect_write_blocks(region, block, in, done >> region->block_shift);
+        }
+        else
+        {
+            done = (size < done) ? size : done;
+            region->stats.merges++;
+
+            result = protect_read_blocks(region, region->staging, block, 1u);
+            if (HYPERRAM_SUCCESS == result)
+            {
+                memcpy(&region->staging[in_block], in, done);
+                result = protect_write_blocks(region, block, region->staging, 1u);
+            }
+        }
+
+        if (HYPERRAM_SUCCESS != result)
+        {
+            status = HYPERRAM_ERROR;
+        }
+
+        in += done;
+        address += done;
+        size -= done;
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_protect_read
+********************************************************************************
+* Summary:
+*  Reads data from the region and checks the CRC of every block it
+*  touches. The whole range is always read; a corrupted block is counted,
+*  reported in the statistics, and makes the call fail.
+*
+* Parameters:
+*  region - region to read
+*  dst - destination buffer
+*  address - offset in the region
+*  size - number of bytes
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM for a range
+*                      outside the region, or HYPERRAM_ERROR if a block was
+*                      corrupted or a DMA transfer failed
+*
+*******************************************************************************/
+hyperram_status_t hyperram_protect_read(hyperram_protect_t* region, void* dst,
+                                        uint32_t address, uint32_t size)
+{
+    uint8_t* out = (uint8_t*)dst;
+    uint32_t region_size = region->blocks << region->block_shift;
+    hyperram_status_t status = HYPERRAM_SUCCESS;
+
+    if ((address > region_size) || (size > (region_size - address)))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    region->stats.reads++;
+
+    while (0u != size)
+    {
+        uint32_t block = address >> region->block_shift;
+        uint32_t in_block = address & (region->block_size - 1u);
+        uint32_t done = region->block_size - in_block;
+        hyperram_status_t result;
+
+        if ((0u == in_block) && (size >= region->block_size))
+        {
+            done = size & ~(region->block_size - 1u);
+            result = protect_read_blocks(region, out, block, done >> region->block_shift);
+        }
+        else
+        {
+            done = (size < done) ? size : done;
+            result = protect_read_blocks(region, region->staging, block, 1u);
+            memcpy(out, &region->staging[in_block], done);
+        }
+
+        if (HYPERRAM_SUCCESS != result)
+        {
+            status = HYPERRAM_ERROR;
+        }
+
+        out += done;
+        address += done;
+        size -= done;
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_protect_scrub
+********************************************************************************
+* Summary:
+*  Re-checks up to max_blocks blocks in place, continuing where the last
+*  call stopped and wrapping at the end of the region. Blocks that a read
+*  has checked since the scrubber's last visit are skipped, so idle-time
+*  work goes to the cold data. Call it from the idle loop with a budget
+*  that fits the available time.
+*
+* Parameters:
+*  region - region to scrub
+*  max_blocks - blocks to visit in this call
+*
+* Return:
+*  uint32_t - number of corrupted blocks found
+*
+*******************************************************************************/
+uint32_t hyperram_protect_scrub(hyperram_protect_t* region, uint32_t max_blocks)
+{
+    uint32_t found = 0u;
+
+    for (uint32_t visit = 0; (visit < max_blocks) && (0u != region->blocks); visit++)
+    {
+        uint32_t block = region->scrub_next;
+        uint32_t bit = 1UL << (block & 31u);
+
+        if (0u != (region->recent[block >> 5] & bit))
+        {
+            region->recent[block >> 5] &= ~bit;
+            region->stats.scrub_skipped++;
+        }
+        else
+        {
+            uint32_t address = region->offset + (block << region->block_shift);
+
+            /* Read the device, not lines the cache may still hold */
+            platform_dcache_clean_invalidate(hyperram_xip_ptr(address), region->block_size);
+
+            if (HYPERRAM_SUCCESS != hyperram_verify_check(address, region->block_size, region->crcs[block]))
+            {
+                protect_report_bad(region, block);
+                found++;
+            }
+            region->stats.scrubbed++;
+        }
+
+        region->scrub_next++;
+        if (region->scrub_next == region->blocks)
+        {
+            region->scrub_next = 0u;
+            region->stats.scrub_passes++;
+        }
+    }
+
+    return found;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_protect_get_stats
+********************************************************************************
+* Summary:
+*  Copies the region statistics.
+*
+* Parameters:
+*  region - region to query
+*  stats - receives the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_protect_get_stats(const hyperram_protect_t* region, hyperram_protect_stats_t* stats)
+{
+    *stats = region->stats;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_protect_print_stats
+********************************************************************************
+* Summary:
+*  Prints the region statistics.
+*
+* Parameters:
+*  region - region to report
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_protect_print_stats(const hyperram_protect_t* region)
+{
+    const hyperram_protect_stats_t* stats = &region->stats;
+
+    PLATFORM_PRINTF("PROTECT blocks=%lu x %lu reads=%lu (%lu blocks) writes=%lu (%lu blocks) merges=%lu\r\n",
+                    (unsigned long)region->blocks, (unsigned long)region->block_size,
+                    (unsigned long)stats->reads, (unsigned long)stats->blocks_read,
+                    (unsigned long)stats->writes, (unsigned long)stats->blocks_written,
+                    (unsigned long)stats->merges);
+    PLATFORM_PRINTF("PROTECT crc_errors=%lu dma_errors=%lu scrubbed=%lu skipped=%lu passes=%lu bad_block=%ld\r\n",
+                    (unsigned long)stats->crc_errors, (unsigned long)stats->dma_errors,
+                    (unsigned long)stats->scrubbed, (unsigned long)stats->scrub_skipped,
+                    (unsigned long)stats->scrub_passes,
+                    (HYPERRAM_PROTECT_NO_BLOCK == stats->bad_block) ? -1L : (long)stats->bad_block);
+    PLATFORM_FLUSH();
+}
+
+/*******************************************************************************
+* Function Name: protect_read_blocks
+********************************************************************************
+* Summary:
+*  Reads whole blocks by DMA and checks each one. While block k is being
+*  checked, block k+1 is already in flight.
+*
+* Parameters:
+*  region - region to read
+*  dst - destination, count blocks
+*  first - first block
+*  count - number of blocks
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, or HYPERRAM_ERROR if a block was
+*                      corrupted or a DMA transfer failed
+*
+*******************************************************************************/
+static hyperram_status_t protect_read_blocks(hyperram_protect_t* region, uint8_t* dst,
+                                             uint32_t first, uint32_t count)
+{
+    uint32_t size = region->block_size;
+    bool corrupted = false;
+    hyperram_status_t status = hyperram_dma_copy(dst, protect_block_ptr(region, first), size);
+
+    for (uint32_t index = 0; (index < count) && (HYPERRAM_SUCCESS == status); index++)
+    {
+        uint32_t block = first + index;
+        bool more = ((index + 1u) < count);
+
+        if (more && (HYPERRAM_SUCCESS != hyperram_dma_copy_async(&dst[(index + 1u) * size],
+                                                                 protect_block_ptr(region, block + 1u),
+                                                                 size, NULL, NULL)))
+        {
+            status = HYPERRAM_ERROR;
+        }
+
+        if (hyperram_verify_crc32(&dst[index * size], size) != region->crcs[block])
+        {
+            protect_report_bad(region, block);
+            corrupted = true;
+        }
+
+        region->recent[block >> 5] |= 1UL << (block & 31u);
+        region->stats.blocks_read++;
+
+        if (more && (HYPERRAM_SUCCESS == status))
+        {
+            hyperram_dma_wait();
+            status = hyperram_dma_get_result();
+        }
+    }
+
+    if (HYPERRAM_SUCCESS != status)
+    {
+        region->stats.dma_errors++;
+    }
+
+    return corrupted ? HYPERRAM_ERROR : status;
+}
+
+/*******************************************************************************
+* Function Name: protect_write_blocks
+********************************************************************************
+* Summary:
+*  Writes whole blocks by DMA and records their CRCs, computed from the
+*  source while the transfer runs.
+*
+* Parameters:
+*  region - region to write
+*  first - first block
+*  src - source, count blocks
+*  count - number of blocks
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS or HYPERRAM_ERROR
+*
+*******************************************************************************/
+static hyperram_status_t protect_write_blocks(hyperram_protect_t* region, uint32_t first,
+                                              const uint8_t* src, uint32_t count)
+{
+    uint32_t size = region->block_size;
+    hyperram_status_t status;
+
+    if (HYPERRAM_SUCCESS != hyperram_dma_copy_async(protect_block_ptr(region, first), src,
+                                                    count << region->block_shift, NULL, NULL))
+    {
+        region->stats.dma_errors++;
+        return HYPERRAM_ERROR;
+    }
+
+    for (uint32_t index = 0; index < count; index++)
+    {
+        region->crcs[first + index] = hyperram_verify_crc32(&src[index * size], size);
+    }
+
+    hyperram_dma_wait();
+    status = hyperram_dma_get_result();
+
+    if (HYPERRAM_SUCCESS != status)
+    {
+        region->stats.dma_errors++;
+    }
+    region->stats.blocks_written += count;
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: protect_report_bad
+********************************************************************************
+* Summary:
+*  Counts a corrupted block and remembers it.
+*
+* Parameters:
+*  region - region the block belongs to
+*  block - corrupted block
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void protect_report_bad(hyperram_protect_t* region, uint32_t block)
+{
+    region->stats.crc_errors++;
+    region->stats.bad_block = block;
+}
+
+/*******************************************************************************
+* Function Name: protect_block_ptr
+********************************************************************************
+* Summary:
+*  Returns the XIP address of a block.
+*
+* Parameters:
+*  region - region
+*  block - block number
+*
+* Return:
+*  void* - block address
+*
+*******************************************************************************/
+static void* protect_block_ptr(const hyperram_protect_t* region, uint32_t block)
+{
+    return hyperram_xip_ptr(region->offset + (block << region->block_shift));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,122 @@
+/*******************************************************************************
+* File Name:   hyperram_protect.h
+*
+* Description: Protected HYPERRAM regions. The device has no ECC, so each fixed-size
+* block of a region carries a CRC-32 in an SRAM side table: it is updated
+* by every write, checked by every read, and a scrubber re-checks the
+* blocks nobody has read lately.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HYPERRAM_PROTECT_H
+#define HYPERRAM_PROTECT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hyperram.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* Block sizes are powers of two in this range */
+#define HYPERRAM_PROTECT_MIN_BLOCK      (32u)
+#define HYPERRAM_PROTECT_MAX_BLOCK      (4096u)
+
+/* Side table size in words: one CRC per block plus a bit per block that
+ * tells the scrubber the block was read since its last visit */
+#define HYPERRAM_PROTECT_TABLE_WORDS(blocks)    ((blocks) + (((blocks) + 31u) / 32u))
+
+#define HYPERRAM_PROTECT_NO_BLOCK       (0xFFFFFFFFUL)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef struct
+{
+    uint32_t reads;
+    uint32_t writes;
+    uint32_t blocks_read;       /* blocks checked by reads */
+    uint32_t blocks_written;
+    uint32_t merges;            /* partial block writes (read-modify-write) */
+    uint32_t crc_errors;        /* blocks found corrupted, reads and scrubs */
+    uint32_t dma_errors;
+    uint32_t scrubbed;          /* blocks checked by the scrubber */
+    uint32_t scrub_skipped;     /* blocks skipped because a read checked them */
+    uint32_t scrub_passes;      /* complete scrubber passes over the region */
+    uint32_t bad_block;         /* last corrupted block, or HYPERRAM_PROTECT_NO_BLOCK */
+} hyperram_protect_stats_t;
+
+/* All fields are private */
+typedef struct
+{
+    uint32_t offset;
+    uint32_t block_size;
+    uint32_t block_shift;
+    uint32_t blocks;
+    uint32_t* crcs;             /* per block, in the caller's table */
+    uint32_t* recent;           /* read since the scrubber's last visit */
+    uint8_t* staging;           /* one block, for partial block accesses */
+    uint32_t scrub_next;
+    hyperram_protect_stats_t stats;
+} hyperram_protect_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+hyperram_status_t hyperram_protect_init(hyperram_protect_t* region, uint32_t offset, uint32_t size,
+                                        uint32_t block_size, uint32_t* table, bool format);
+void hyperram_protect_deinit(hyperram_protect_t* region);
+hyperram_status_t hyperram_protect_write(hyperram_protect_t* region, uint32_t address,
+                                         const void* src, uint32_t size);
+hyperram_status_t hyperram_protect_read(hyperram_protect_t* region, void* dst,
+                                        uint32_t address, uint32_t size);
+uint32_t hyperram_protect_scrub(hyperram_protect_t* region, uint32_t max_blocks);
+void hyperram_protect_get_stats(const hyperram_protect_t* region, hyperram_protect_stats_t* stats);
+void hyperram_protect_print_stats(const hyperram_protect_t* region);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* HYPERRAM_PROTECT_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,604 @@
+/*******************************************************************************
+* File Name:   hyperram_ring.c
+*
+* Description: Single-producer, single-consumer HYPERRAM ring with SRAM staging, see
+* hyperram_ring.h. The producer and the consumer never take a lock; the
+* block counters each have one writer, and the only shared resource, the
+* DMA channel, is claimed with interrupts masked.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include "platform.h"
+#include "hyperram_ring.h"
+#include "hyperram_dma.h"
+#include "dma_buffer.h"
+#include "perf_counter.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+#define RING_NONE                       (UINT32_MAX)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void ring_kick(hyperram_ring_t* ring);
+static void ring_flush_done(void* arg);
+static bool ring_start_prefetch(hyperram_ring_t* ring, uint32_t block, uint32_t slot);
+static void ring_prefetch_done(void* arg);
+static void ring_load(hyperram_ring_t* ring);
+static uint32_t ring_next_slot(const hyperram_ring_t* ring, uint32_t slot);
+
+/*******************************************************************************
+* Function Name: hyperram_ring_init
+********************************************************************************
+* Summary:
+*  Sets up an empty ring over a device range and takes its staging and
+*  prefetch blocks from the DMA buffer pool. The SMIF must be in memory mode
+*  while the ring is used.
+*
+* Parameters:
+*  ring - ring to initialize
+*  offset - device offset of the storage, a multiple of the block size
+*  size - storage size in bytes, at least two blocks
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM for a bad range,
+*                      or HYPERRAM_ERROR if the DMA buffer pool is exhausted
+*
+*******************************************************************************/
+hyperram_status_t hyperram_ring_init(hyperram_ring_t* ring, uint32_t offset, uint32_t size)
+{
+    bool allocated = true;
+
+    memset(ring, 0, sizeof(*ring));
+
+    if ((0u != (offset % HYPERRAM_RING_BLOCK_SIZE)) || (0u != (size % HYPERRAM_RING_BLOCK_SIZE)) ||
+        (size < (2u * HYPERRAM_RING_BLOCK_SIZE)) || (offset > HYPERRAM_SIZE) ||
+        (size > (HYPERRAM_SIZE - offset)))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    if (HYPERRAM_SUCCESS != hyperram_dma_init())
+    {
+        return HYPERRAM_ERROR;
+    }
+
+    ring->offset = offset;
+    ring->blocks = size / HYPERRAM_RING_BLOCK_SIZE;
+    ring->loading = RING_NONE;
+
+    for (uint32_t index = 0; index < HYPERRAM_RING_STAGING_BLOCKS; index++)
+    {
+        ring->staging[index] = (uint8_t*)dma_buffer_alloc(HYPERRAM_RING_BLOCK_SIZE);
+        allocated = allocated && (NULL != ring->staging[index]);
+    }
+    for (uint32_t index = 0; index < HYPERRAM_RING_PREFETCH_BLOCKS; index++)
+    {
+        ring->prefetch[index] = (uint8_t*)dma_buffer_alloc(HYPERRAM_RING_BLOCK_SIZE);
+        ring->loaded[index] = RING_NONE;
+        allocated = allocated && (NULL != ring->prefetch[index]);
+    }
+
+    if (!allocated)
+    {
+        hyperram_ring_deinit(ring);
+        return HYPERRAM_ERROR;
+    }
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_ring_deinit
+********************************************************************************
+* Summary:
+*  Waits for the ring's DMA transfers and returns its blocks to the pool.
+*  Data still in the staging block is lost; call hyperram_ring_flush()
+*  first to keep it.
+*
+* Parameters:
+*  ring - ring to release
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_ring_deinit(hyperram_ring_t* ring)
+{
+    while ((ring->started != ring->committed) || (RING_NONE != ring->loading))
+    {
+    }
+
+    for (uint32_t index = 0; index < HYPERRAM_RING_STAGING_BLOCKS; index++)
+    {
+        dma_buffer_free(ring->staging[index]);
+        ring->staging[index] = NULL;
+    }
+    for (uint32_t index = 0; index < HYPERRAM_RING_PREFETCH_BLOCKS; index++)
+    {
+        dma_buffer_free(ring->prefetch[index]);
+        ring->prefetch[index] = NULL;
+    }
+}
+
+/*******************************************************************************
+* Function Name: hyperram_ring_write
+********************************************************************************
+* Summary:
+*  Producer side. Copies data into the SRAM staging block and hands every
+*  block that fills up to the DMA. Only waits when all staging blocks are
+*  still queued for the DMA. If the consumer has fallen so far behind that
+*  the data does not fit, the whole call is dropped and counted.
+*
+* Parameters:
+*  ring - ring to write to
+*  data - bytes to append
+*  size - number of bytes
+*
+* Return:
+*  uint32_t - size, or 0 if the data was dropped
+*
+*******************************************************************************/
+uint32_t hyperram_ring_write(hyperram_ring_t* ring, const void* data, uint32_t size)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint32_t start = perf_counter_now();
+    uint32_t free_blocks = ring->blocks - (ring->produced - ring->read_block);
+    uint32_t accepted = 0u;
+    uint32_t elapsed;
+
+    /* All or nothing, so that records are never cut */
+    if ((0u == free_blocks) || (size > ((free_blocks * HYPERRAM_RING_BLOCK_SIZE) - ring->fill)))
+    {
+        ring->stats.bytes_dropped += size;
+        size = 0u;
+    }
+
+    while (accepted < size)
+    {
+        uint32_t chunk = HYPERRAM_RING_BLOCK_SIZE - ring->fill;
+
+        if (0u == ring->fill)
+        {
+            if ((ring->produced - ring->committed) >= HYPERRAM_RING_STAGING_BLOCKS)
+            {
+                ring->stats.stalls++;
+                while ((ring->produced - ring->committed) >= HYPERRAM_RING_STAGING_BLOCKS)
+                {
+                    ring_kick(ring);
+                }
+            }
+        }
+
+        if (chunk > (size - accepted))
+        {
+            chunk = size - accepted;
+        }
+
+        memcpy(&ring->staging[ring->produced % HYPERRAM_RING_STAGING_BLOCKS][ring->fill],
+               &bytes[accepted], chunk);
+        ring->fill += chunk;
+        accepted += chunk;
+
+        if (HYPERRAM_RING_BLOCK_SIZE == ring->fill)
+        {
+            ring->fill = 0u;
+            ring->produced++;
+            ring_kick(ring);
+
+            if ((ring->produced - ring->read_block) > ring->stats.max_used_blocks)
+            {
+                ring->stats.max_used_blocks = ring->produced - ring->read_block;
+            }
+        }
+    }
+
+    elapsed = perf_counter_to_ns(perf_counter_now() - start);
+    ring->producer_total_ns += elapsed;
+    if (elapsed > ring->stats.producer_max_ns)
+    {
+        ring->stats.producer_max_ns = elapsed;
+    }
+    ring->stats.writes++;
+    ring->stats.bytes_written += accepted;
+
+    return accepted;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_ring_flush
+********************************************************************************
+* Summary:
+*  Producer side. Pads a partly filled staging block to a whole block and
+*  waits until every block has been written to the device, for example at
+*  the end of a log. The consumer reads the padding like any other data,
+*  so use a pad byte that the record format can recognise.
+*
+* Parameters:
+*  ring - ring to flush
+*  pad - value of the padding bytes
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS
+*
+*******************************************************************************/
+hyperram_status_t hyperram_ring_flush(hyperram_ring_t* ring, uint8_t pad)
+{
+    if (0u != ring->fill)
+    {
+        uint8_t* block = ring->staging[ring->produced % HYPERRAM_RING_STAGING_BLOCKS];
+
+        memset(&block[ring->fill], pad, HYPERRAM_RING_BLOCK_SIZE - ring->fill);
+        ring->fill = 0u;
+        ring->produced++;
+    }
+
+    while (ring->committed != ring->produced)
+    {
+        ring_kick(ring);
+    }
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_ring_read
+********************************************************************************
+* Summary:
+*  Consumer side. Copies data that has reached the device into a buffer.
+*  While a block is being read, the next one is prefetched by DMA, so a
+*  steady consumer rarely waits for the device.
+*
+* Parameters:
+*  ring - ring to read from
+*  data - destination buffer
+*  size - maximum number of bytes
+*
+* Return:
+*  uint32_t - number of bytes copied, 0 if the ring is empty
+*
+*******************************************************************************/
+uint32_t hyperram_ring_read(hyperram_ring_t* ring, void* data, uint32_t size)
+{
+    uint8_t* bytes = (uint8_t*)data;
+    uint32_t copied = 0u;
+
+    while ((copied < size) && (ring->read_block != ring->committed))
+    {
+        uint32_t block = ring->read_block;
+        uint32_t index = block % HYPERRAM_RING_PREFETCH_BLOCKS;
+        uint32_t chunk = HYPERRAM_RING_BLOCK_SIZE - ring->read_offset;
+
+        ring_load(ring);
+
+        if ((block + 1u) != ring->committed)
+        {
+            (void)ring_start_prefetch(ring, block + 1u, ring_next_slot(ring, ring->read_slot));
+        }
+
+        if (chunk > (size - copied))
+        {
+            chunk = size - copied;
+        }
+
+        memcpy(&bytes[copied], &ring->prefetch[index][ring->read_offset], chunk);
+        copied += chunk;
+        ring->read_offset += chunk;
+
+        if (HYPERRAM_RING_BLOCK_SIZE == ring->read_offset)
+        {
+            ring->read_offset = 0u;
+            ring->read_slot = ring_next_slot(ring, ring->read_slot);
+            ring->read_block = block + 1u;
+        }
+    }
+
+    ring->stats.bytes_read += copied;
+
+    return copied;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_ring_available
+********************************************************************************
+* Summary:
+*  Consumer side. Returns how many bytes hyperram_ring_read() can return.
+*  Data still in the producer's staging blocks is not counted.
+*
+* Parameters:
+*  ring - ring to query
+*
+* Return:
+*  uint32_t - readable bytes
+*
+*******************************************************************************/
+uint32_t hyperram_ring_available(const hyperram_ring_t* ring)
+{
+    return ((ring->committed - ring->read_block) * HYPERRAM_RING_BLOCK_SIZE) - ring->read_offset;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_ring_get_stats
+********************************************************************************
+* Summary:
+*  Returns the ring counters.
+*
+* Parameters:
+*  ring - ring to query
+*  stats - filled with the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_ring_get_stats(const hyperram_ring_t* ring, hyperram_ring_stats_t* stats)
+{
+    *stats = ring->stats;
+    stats->producer_avg_ns = (0u != stats->writes) ?
+                             (uint32_t)(ring->producer_total_ns / stats->writes) : 0u;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_ring_print_stats
+********************************************************************************
+* Summary:
+*  Prints the ring counters.
+*
+* Parameters:
+*  ring - ring to report
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_ring_print_stats(const hyperram_ring_t* ring)
+{
+    hyperram_ring_stats_t stats;
+
+    hyperram_ring_get_stats(ring, &stats);
+
+    PLATFORM_PRINTF("Ring: %lu writes, %lu bytes in, %lu dropped, %lu read, %lu stalls\r\n",
+                    (unsigned long)stats.writes, (unsigned long)stats.bytes_written,
+                    (unsigned long)stats.bytes_dropped, (unsigned long)stats.bytes_read,
+                    (unsigned long)stats.stalls);
+    PLATFORM_PRINTF("Ring: %lu blocks flushed, prefetch %lu hits / %lu misses, peak %lu of %lu blocks\r\n",
+                    (unsigned long)stats.flushes, (unsigned long)stats.prefetch_hits,
+                    (unsigned long)stats.prefetch_misses, (unsigned long)stats.max_used_blocks,
+                    (unsigned long)ring->blocks);
+    PLATFORM_PRINTF("Ring: producer %lu ns avg, %lu ns max per write\r\n",
+                    (unsigned long)stats.producer_avg_ns, (unsigned long)stats.producer_max_ns);
+}
+
+/*******************************************************************************
+* Function Name: ring_kick
+********************************************************************************
+* Summary:
+*  Starts the DMA for the oldest full staging block if the channel is
+*  free. Called by the producer and by every DMA completion of the ring, so
+*  queued blocks drain in the background.
+*
+* Parameters:
+*  ring - ring to service
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void ring_kick(hyperram_ring_t* ring)
+{
+    uint32_t state = platform_enter_critical();
+
+    if ((ring->started != ring->produced) && !hyperram_dma_is_busy())
+    {
+        uint32_t block = ring->started;
+
+        ring->started = block + 1u;
+        if (HYPERRAM_SUCCESS != hyperram_dma_copy_async(
+                hyperram_xip_ptr(ring->offset + (ring->flush_slot * HYPERRAM_RING_BLOCK_SIZE)),
+                ring->staging[block % HYPERRAM_RING_STAGING_BLOCKS], HYPERRAM_RING_BLOCK_SIZE,
+                ring_flush_done, ring))
+        {
+            ring->started = block;
+        }
+    }
+
+    platform_exit_critical(state);
+}
+
+/*******************************************************************************
+* Function Name: ring_flush_done
+********************************************************************************
+* Summary:
+*  DMA completion of a staging block. Publishes the block to the consumer
+*  and starts the next one.
+*
+* Parameters:
+*  arg - the ring
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void ring_flush_done(void* arg)
+{
+    hyperram_ring_t* ring = (hyperram_ring_t*)arg;
+
+    ring->flush_slot = ring_next_slot(ring, ring->flush_slot);
+    ring->stats.flushes++;
+    ring->committed = ring->committed + 1u;
+
+    ring_kick(ring);
+}
+
+/*******************************************************************************
+* Function Name: ring_start_prefetch
+********************************************************************************
+* Summary:
+*  Starts loading a committed block into its prefetch buffer unless it is
+*  already there or the DMA channel is in use.
+*
+* Parameters:
+*  ring - ring to service
+*  block - block number
+*  slot - device block that holds it
+*
+* Return:
+*  bool - true if the block is loaded or being loaded
+*
+*******************************************************************************/
+static bool ring_start_prefetch(hyperram_ring_t* ring, uint32_t block, uint32_t slot)
+{
+    uint32_t index = block % HYPERRAM_RING_PREFETCH_BLOCKS;
+    uint32_t state;
+    bool started = false;
+
+    if ((ring->loaded[index] == block) || (ring->loading == block))
+    {
+        return true;
+    }
+
+    state = platform_enter_critical();
+
+    if ((RING_NONE == ring->loading) && !hyperram_dma_is_busy())
+    {
+        ring->loading = block;
+        ring->loaded[index] = RING_NONE;
+        started = (HYPERRAM_SUCCESS == hyperram_dma_copy_async(
+                       ring->prefetch[index],
+                       hyperram_xip_ptr(ring->offset + (slot * HYPERRAM_RING_BLOCK_SIZE)),
+                       HYPERRAM_RING_BLOCK_SIZE, ring_prefetch_done, ring));
+        if (!started)
+        {
+            ring->loading = RING_NONE;
+        }
+    }
+
+    platform_exit_critical(state);
+
+    return started;
+}
+
+/*******************************************************************************
+* Function Name: ring_prefetch_done
+********************************************************************************
+* Summary:
+*  DMA completion of a prefetch. Marks the block loaded and lets queued
+*  producer blocks use the channel.
+*
+* Parameters:
+*  arg - the ring
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void ring_prefetch_done(void* arg)
+{
+    hyperram_ring_t* ring = (hyperram_ring_t*)arg;
+    uint32_t block = ring->loading;
+
+    ring->loaded[block % HYPERRAM_RING_PREFETCH_BLOCKS] = block;
+    ring->loading = RING_NONE;
+
+    ring_kick(ring);
+}
+
+/*******************************************************************************
+* Function Name: ring_load
+********************************************************************************
+* Summary:
+*  Makes sure the block being consumed is in its prefetch buffer, loading
+*  it now if the prefetch did not.
+*
+* Parameters:
+*  ring - ring to service
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void ring_load(hyperram_ring_t* ring)
+{
+    uint32_t block = ring->read_block;
+    uint32_t index = block % HYPERRAM_RING_PREFETCH_BLOCKS;
+
+    if (ring->loaded[index] == block)
+    {
+        if (0u == ring->read_offset)
+        {
+            ring->stats.prefetch_hits++;
+        }
+        return;
+    }
+
+    ring->stats.prefetch_misses++;
+
+    while (ring->loaded[index] != block)
+    {
+        (void)ring_start_prefetch(ring, block, ring->read_slot);
+    }
+}
+
+/*******************************************************************************
+* Function Name: ring_next_slot
+********************************************************************************
+* Summary:
+*  Advances a device block index with wrap-around.
+*
+* Parameters:
+*  ring - ring
+*  slot - device block index
+*
+* Return:
+*  uint32_t - following index
+*
+*******************************************************************************/
+static uint32_t ring_next_slot(const hyperram_ring_t* ring, uint32_t slot)
+{
+    slot++;
+
+    return (slot == ring->blocks) ? 0u : slot;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,131 @@
+/*******************************************************************************
+* File Name:   hyperram_ring.h
+*
+* Description: Single-producer, single-consumer byte ring in the HYPERRAM for data
+* logging. The producer writes into SRAM staging blocks; full blocks are
+* written to the device by DMA in the background. The consumer reads
+* through two SRAM blocks, the next of which is prefetched by DMA.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HYPERRAM_RING_H
+#define HYPERRAM_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hyperram.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* Unit of every DMA transfer; the device range is a multiple of it */
+#ifndef HYPERRAM_RING_BLOCK_SIZE
+#define HYPERRAM_RING_BLOCK_SIZE        (1024u)
+#endif
+
+/* Full blocks the producer may have waiting for DMA before it stalls */
+#ifndef HYPERRAM_RING_STAGING_BLOCKS
+#define HYPERRAM_RING_STAGING_BLOCKS    (4u)
+#endif
+
+#define HYPERRAM_RING_PREFETCH_BLOCKS   (2u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef struct
+{
+    uint32_t writes;            /* hyperram_ring_write() calls */
+    uint32_t bytes_written;     /* accepted by the producer */
+    uint32_t bytes_dropped;     /* rejected because the ring was full */
+    uint32_t bytes_read;
+    uint32_t stalls;            /* producer waits for a free staging block */
+    uint32_t flushes;           /* blocks written to the device */
+    uint32_t prefetch_hits;     /* blocks the consumer found already loaded */
+    uint32_t prefetch_misses;
+    uint32_t producer_avg_ns;   /* per hyperram_ring_write() call */
+    uint32_t producer_max_ns;
+    uint32_t max_used_blocks;   /* device blocks holding unread data */
+} hyperram_ring_stats_t;
+
+/* All fields are private. The producer side owns fill and produced, the
+ * consumer side owns read_pos and the prefetch state, and the DMA
+ * completion callbacks own started and committed. */
+typedef struct
+{
+    uint32_t offset;
+    uint32_t blocks;            /* device capacity in blocks */
+    uint8_t* staging[HYPERRAM_RING_STAGING_BLOCKS];
+    uint8_t* prefetch[HYPERRAM_RING_PREFETCH_BLOCKS];
+    uint32_t fill;              /* bytes in the staging block being filled */
+    volatile uint32_t produced; /* full blocks, free running */
+    volatile uint32_t started;  /* blocks handed to the DMA */
+    volatile uint32_t committed;/* blocks written to the device */
+    uint32_t flush_slot;        /* device block of the next flush */
+    volatile uint32_t read_block; /* block being consumed, free running */
+    uint32_t read_offset;       /* bytes consumed in read_block */
+    uint32_t read_slot;         /* device block of read_block */
+    volatile uint32_t loaded[HYPERRAM_RING_PREFETCH_BLOCKS];
+    volatile uint32_t loading;  /* block being prefetched, or UINT32_MAX */
+    uint64_t producer_total_ns;
+    hyperram_ring_stats_t stats;
+} hyperram_ring_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+hyperram_status_t hyperram_ring_init(hyperram_ring_t* ring, uint32_t offset, uint32_t size);
+void hyperram_ring_deinit(hyperram_ring_t* ring);
+uint32_t hyperram_ring_write(hyperram_ring_t* ring, const void* data, uint32_t size);
+hyperram_status_t hyperram_ring_flush(hyperram_ring_t* ring, uint8_t pad);
+uint32_t hyperram_ring_read(hyperram_ring_t* ring, void* data, uint32_t size);
+uint32_t hyperram_ring_available(const hyperram_ring_t* ring);
+void hyperram_ring_get_stats(const hyperram_ring_t* ring, hyperram_ring_stats_t* stats);
+void hyperram_ring_print_stats(const hyperram_ring_t* ring);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* HYPERRAM_RING_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,270 @@
+/*******************************************************************************
+* File Name:   hyperram_sections.c
+*
+* Description: Startup initialization of the HYPERRAM .bss and .data sections, see
+* hyperram_sections.h. It runs as a high priority constructor. The C
+* runtime has already set up SRAM at that point, and main() has not
+* started yet.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "platform.h"
+#include "hyperram_sections.h"
+#include "hyperram_dma.h"
+#include "perf_counter.h"
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef struct
+{
+    bool bsp_done;
+    cy_rslt_t bsp_result;
+    hyperram_status_t status;
+    uint32_t bsp_cycles;        /* clocks change during cybsp_init(), so cycles only */
+    uint32_t smif_ns;
+    uint32_t bss_ns;
+    uint32_t data_ns;
+    uint32_t text_ns;
+} hyperram_sections_startup_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+#if defined(HYPERRAM_SECTIONS)
+/* Defined by linker/hyperram_sections.ld */
+extern uint8_t __hyperram_text_start__[];
+extern uint8_t __hyperram_text_end__[];
+extern uint8_t __hyperram_text_load__[];
+extern uint8_t __hyperram_overlay_start__[];
+extern uint8_t __hyperram_overlay_end__[];
+extern uint8_t __hyperram_overlay_load__[];
+extern uint8_t __hyperram_data_start__[];
+extern uint8_t __hyperram_data_end__[];
+extern uint8_t __hyperram_data_load__[];
+extern uint8_t __hyperram_bss_start__[];
+extern uint8_t __hyperram_bss_end__[];
+#endif
+
+/* Zero initialized: CY_RSLT_SUCCESS and HYPERRAM_SUCCESS are both 0 */
+static hyperram_sections_startup_t hyperram_sections_startup_info;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+#if defined(HYPERRAM_SECTIONS)
+static void hyperram_sections_startup(void) __attribute__((constructor(101)));
+#endif
+
+/*******************************************************************************
+* Function Name: hyperram_sections_bsp_init
+********************************************************************************
+* Summary:
+*  Returns the result of the cybsp_init() call made by the startup code, or
+*  calls cybsp_init() if the startup code did not need to run.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t - result of cybsp_init()
+*
+*******************************************************************************/
+cy_rslt_t hyperram_sections_bsp_init(void)
+{
+    if (!hyperram_sections_startup_info.bsp_done)
+    {
+        hyperram_sections_startup_info.bsp_result = cybsp_init();
+        hyperram_sections_startup_info.bsp_done = true;
+    }
+
+    return hyperram_sections_startup_info.bsp_result;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_sections_report
+********************************************************************************
+* Summary:
+*  Prints the section sizes and the time taken by each startup step. Prints
+*  nothing if the sections are not used.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  hyperram_status_t - result of the section initialization; on failure the
+*                      contents of HYPERRAM variables are undefined
+*
+*******************************************************************************/
+hyperram_status_t hyperram_sections_report(void)
+{
+#if defined(HYPERRAM_SECTIONS)
+    const hyperram_sections_startup_t* info = &hyperram_sections_startup_info;
+    uint32_t text_size = (uint32_t)(__hyperram_text_end__ - __hyperram_text_start__);
+    uint32_t overlay_size = (uint32_t)(__hyperram_overlay_end__ - __hyperram_overlay_start__);
+    uint32_t data_size = (uint32_t)(__hyperram_data_end__ - __hyperram_data_start__);
+    uint32_t bss_size = (uint32_t)(__hyperram_bss_end__ - __hyperram_bss_start__);
+
+    if ((0u != text_size) || (0u != overlay_size) || (0u != data_size) || (0u != bss_size))
+    {
+        PLATFORM_PRINTF("HyperRAM sections: .text %lu bytes, overlays %lu bytes, .data %lu bytes, "
+                        ".bss %lu bytes - %s\r\n",
+                        (unsigned long)text_size, (unsigned long)overlay_size,
+                        (unsigned long)data_size, (unsigned long)bss_size,
+                        (HYPERRAM_SUCCESS == info->status) ? "Success" : "Fail");
+        PLATFORM_PRINTF("Startup: BSP %lu cycles, SMIF %lu us, .text copy %lu us, .bss fill %lu us, "
+                        ".data copy %lu us\r\n",
+                        (unsigned long)info->bsp_cycles, (unsigned long)(info->smif_ns / 1000u),
+                        (unsigned long)(info->text_ns / 1000u), (unsigned long)(info->bss_ns / 1000u),
+                        (unsigned long)(info->data_ns / 1000u));
+    }
+#endif
+
+    return hyperram_sections_startup_info.status;
+}
+
+#if defined(HYPERRAM_SECTIONS)
+/*******************************************************************************
+* Function Name: hyperram_sections_startup
+********************************************************************************
+* Summary:
+*  Brings up the BSP, the SMIF in memory mode and the DMA channel. The DMA
+*  setup runs between hyperram_init_start() and hyperram_init_finish(), so
+*  it overlaps the HYPERRAM power-up. Then copies the .hyperram_text and
+*  overlay images from flash and drops any stale I-cache lines, zeroes
+*  .hyperram_bss with a DMA fill and copies the .hyperram_data image from
+*  flash. Does nothing if all sections are empty. Each step is timed with
+*  the cycle counter.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void hyperram_sections_startup(void)
+{
+    hyperram_sections_startup_t* info = &hyperram_sections_startup_info;
+    uint32_t text_size = (uint32_t)(__hyperram_text_end__ - __hyperram_text_start__);
+    uint32_t overlay_size = (uint32_t)(__hyperram_overlay_end__ - __hyperram_overlay_start__);
+    uint32_t data_size = (uint32_t)(__hyperram_data_end__ - __hyperram_data_start__);
+    uint32_t bss_size = (uint32_t)(__hyperram_bss_end__ - __hyperram_bss_start__);
+    uint32_t start;
+
+    if ((0u == text_size) && (0u == overlay_size) && (0u == data_size) && (0u == bss_size))
+    {
+        return;
+    }
+
+    perf_counter_init();
+
+    start = perf_counter_now();
+    info->bsp_result = cybsp_init();
+    info->bsp_done = true;
+    info->bsp_cycles = perf_counter_now() - start;
+
+    if (CY_RSLT_SUCCESS != info->bsp_result)
+    {
+        info->status = HYPERRAM_ERROR;
+        return;
+    }
+
+    start = perf_counter_now();
+    info->status = hyperram_init_start();
+
+    /* Set up the DMA channel, whose completion interrupt is needed below,
+     * while the HYPERRAM powers up */
+    __enable_irq();
+    if (HYPERRAM_SUCCESS == info->status)
+    {
+        info->status = hyperram_dma_init();
+    }
+    if (HYPERRAM_SUCCESS == info->status)
+    {
+        info->status = hyperram_init_finish();
+    }
+    if (HYPERRAM_SUCCESS == info->status)
+    {
+        hyperram_enter_xip();
+    }
+    info->smif_ns = perf_counter_to_ns(perf_counter_now() - start);
+
+    if (HYPERRAM_SUCCESS != info->status)
+    {
+        return;
+    }
+
+    start = perf_counter_now();
+    info->status = hyperram_dma_copy(__hyperram_text_start__, __hyperram_text_load__, text_size);
+    if (HYPERRAM_SUCCESS == info->status)
+    {
+        info->status = hyperram_dma_copy(__hyperram_overlay_start__, __hyperram_overlay_load__,
+                                         overlay_size);
+    }
+    __DSB();
+    SCB_InvalidateICache();
+    __ISB();
+    info->text_ns = perf_counter_to_ns(perf_counter_now() - start);
+
+    if (HYPERRAM_SUCCESS != info->status)
+    {
+        return;
+    }
+
+    start = perf_counter_now();
+    info->status = hyperram_dma_fill(__hyperram_bss_start__, 0u, bss_size);
+    info->bss_ns = perf_counter_to_ns(perf_counter_now() - start);
+
+    if (HYPERRAM_SUCCESS != info->status)
+    {
+        return;
+    }
+
+    start = perf_counter_now();
+    info->status = hyperram_dma_copy(__hyperram_data_start__, __hyperram_data_load__, data_size);
+    info->data_ns = perf_counter_to_ns(perf_counter_now() - start);
+}
+#endif /* HYPERRAM_SECTIONS */
+
+/* [] END OF FILE */
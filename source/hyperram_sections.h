@@ -0,0 +1,90 @@
+/*******************************************************************************
+* File Name:   hyperram_sections.h
+*
+* Description: Places variables in the HYPERRAM through dedicated linker sections.
+* Variables marked HYPERRAM_BSS are zeroed and variables marked
+* HYPERRAM_DATA are copied from their flash load image by DMA before
+* main() runs. That startup code brings up the BSP and the SMIF itself,
+* so main() gets the BSP init result from hyperram_sections_bsp_init()
+* instead of calling cybsp_init() again. Functions marked CODE_IN_HYPERRAM
+* (code_placement.h) are copied the same way into .hyperram_text.
+*
+* The sections are enabled for GCC_ARM with "make HYPERRAM_SECTIONS=1",
+* which defines HYPERRAM_SECTIONS and adds linker/hyperram_sections.ld.
+* Otherwise the macros are empty and the variables stay in SRAM.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HYPERRAM_SECTIONS_H
+#define HYPERRAM_SECTIONS_H
+
+#include <stdint.h>
+#include "cy_result.h"
+#include "hyperram.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* Device range of the sections; must match linker/hyperram_sections.ld */
+#define HYPERRAM_SECTIONS_OFFSET        (0x00400000UL)
+#define HYPERRAM_SECTIONS_SIZE          (0x00400000UL)
+
+#if defined(HYPERRAM_SECTIONS)
+#define HYPERRAM_BSS                    __attribute__((section(".hyperram_bss")))
+#define HYPERRAM_DATA                   __attribute__((section(".hyperram_data")))
+#else
+#define HYPERRAM_BSS
+#define HYPERRAM_DATA
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t hyperram_sections_bsp_init(void);
+hyperram_status_t hyperram_sections_report(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* HYPERRAM_SECTIONS_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,887 @@
+/*******************************************************************************
+* File Name:   hyperram_sim.c
+*
+* Description: Host simulator backend for hyperram.h and hyperram_dma.h. The
+* device is modelled as a 16 MB array so that benchmarks, stress tests and
+* data structures can be exercised on a PC. Only built with HYPERRAM_HOST_SIM;
+* see "Host simulator build" in README.md.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#if defined(HYPERRAM_HOST_SIM)
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include "hyperram.h"
+#include "hyperram_dma.h"
+#include "perf_counter.h"
+#include <string.h>
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+static uint8_t hyperram_sim_memory[HYPERRAM_SIZE];
+static bool hyperram_sim_xip_mode;
+static uint32_t hyperram_sim_fault_one_in;
+static uint32_t hyperram_sim_fault_state;
+static bool hyperram_sim_crypto_mode;
+static uint32_t hyperram_sim_crypto_key[HYPERRAM_CRYPTO_KEY_WORDS];
+static uint32_t hyperram_sim_crypto_nonce[HYPERRAM_CRYPTO_NONCE_WORDS];
+static bool hyperram_sim_started;
+static bool hyperram_sim_ready;
+static uint32_t hyperram_sim_start_time;
+static uint32_t hyperram_sim_started_time;
+static hyperram_init_timing_t hyperram_sim_timing;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static bool hyperram_sim_range_valid(uint32_t address, uint32_t size);
+static void hyperram_sim_keystream(uint32_t address, uint8_t* data, uint32_t size);
+static void hyperram_sim_crypto_transfer(void* dst, const void* src, uint32_t size);
+static void hyperram_sim_inject_fault(void* data, uint32_t size);
+
+/*******************************************************************************
+* Function Name: hyperram_init
+********************************************************************************
+* Summary:
+*  Runs hyperram_init_start() and hyperram_init_finish() back to back.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS
+*
+*******************************************************************************/
+hyperram_status_t hyperram_init(void)
+{
+    (void)hyperram_init_start();
+
+    return hyperram_init_finish();
+}
+
+/*******************************************************************************
+* Function Name: hyperram_init_start
+********************************************************************************
+* Summary:
+*  Selects command mode and starts the bring-up timing.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS
+*
+*******************************************************************************/
+hyperram_status_t hyperram_init_start(void)
+{
+    perf_counter_init();
+    hyperram_sim_start_time = perf_counter_now();
+    memset(&hyperram_sim_timing, 0, sizeof(hyperram_sim_timing));
+    hyperram_sim_timing.start_at_ns = perf_counter_to_ns(perf_counter_since_init());
+    hyperram_sim_ready = false;
+    hyperram_sim_xip_mode = false;
+    hyperram_sim_crypto_mode = false;
+    hyperram_sim_started = true;
+    hyperram_sim_started_time = perf_counter_now();
+    hyperram_sim_timing.start_ns = perf_counter_to_ns(hyperram_sim_started_time - hyperram_sim_start_time);
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_init_finish
+********************************************************************************
+* Summary:
+*  Clears the simulated device, which stands in for the first device access,
+*  and records the bring-up timing.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, or HYPERRAM_ERROR if
+*                      hyperram_init_start() was not called
+*
+*******************************************************************************/
+hyperram_status_t hyperram_init_finish(void)
+{
+    if (!hyperram_sim_started)
+    {
+        return HYPERRAM_ERROR;
+    }
+
+    hyperram_sim_timing.overlap_ns = perf_counter_to_ns(perf_counter_now() - hyperram_sim_started_time);
+    memset(hyperram_sim_memory, 0, sizeof(hyperram_sim_memory));
+    hyperram_sim_timing.first_access_at_ns = perf_counter_to_ns(perf_counter_since_init());
+    hyperram_sim_timing.ready_at_ns = hyperram_sim_timing.first_access_at_ns;
+    hyperram_sim_started = false;
+    hyperram_sim_ready = true;
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_is_ready
+********************************************************************************
+* Summary:
+*  Reports whether the bring-up has completed.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true after a successful hyperram_init_finish()
+*
+*******************************************************************************/
+bool hyperram_is_ready(void)
+{
+    return hyperram_sim_ready;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_get_init_timing
+********************************************************************************
+* Summary:
+*  Copies the timing of the last bring-up.
+*
+* Parameters:
+*  timing - destination
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_get_init_timing(hyperram_init_timing_t* timing)
+{
+    *timing = hyperram_sim_timing;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_read
+********************************************************************************
+* Summary:
+*  Copies from the simulated device with the same argument checks as the
+*  command-mode driver.
+*
+* Parameters:
+*  address - byte offset in the device, must be even
+*  buf - destination buffer
+*  size - number of bytes to read, must be even
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS or HYPERRAM_BAD_PARAM
+*
+*******************************************************************************/
+hyperram_status_t hyperram_read(uint32_t address, void* buf, uint32_t size)
+{
+    if (!hyperram_sim_range_valid(address, size))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    memcpy(buf, &hyperram_sim_memory[address], size);
+    hyperram_sim_inject_fault(buf, size);
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_read_wrapped
+********************************************************************************
+* Summary:
+*  Models a wrapped burst: the bytes after the end of the HYPERRAM_WRAP_SIZE
+*  aligned group come from its start.
+*
+* Parameters:
+*  address - byte offset in the device, must be even
+*  buf - destination buffer
+*  size - number of bytes to read, even, 2 to HYPERRAM_WRAP_SIZE
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS or HYPERRAM_BAD_PARAM
+*
+*******************************************************************************/
+hyperram_status_t hyperram_read_wrapped(uint32_t address, void* buf, uint32_t size)
+{
+    uint32_t group = address & ~(HYPERRAM_WRAP_SIZE - 1u);
+    uint8_t* bytes = (uint8_t*)buf;
+
+    if ((0u == size) || (size > HYPERRAM_WRAP_SIZE) || !hyperram_sim_range_valid(address, size))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    for (uint32_t index = 0; index < size; index++)
+    {
+        bytes[index] = hyperram_sim_memory[group + ((address - group + index) & (HYPERRAM_WRAP_SIZE - 1u))];
+    }
+    hyperram_sim_inject_fault(buf, size);
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_write
+********************************************************************************
+* Summary:
+*  Copies to the simulated device with the same argument checks as the
+*  command-mode driver.
+*
+* Parameters:
+*  address - byte offset in the device, must be even
+*  buf - source buffer
+*  size - number of bytes to write, must be even
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS or HYPERRAM_BAD_PARAM
+*
+*******************************************************************************/
+hyperram_status_t hyperram_write(uint32_t address, const void* buf, uint32_t size)
+{
+    if (!hyperram_sim_range_valid(address, size))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    memcpy(&hyperram_sim_memory[address], buf, size);
+    hyperram_sim_inject_fault(&hyperram_sim_memory[address], size);
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_enter_xip
+********************************************************************************
+* Summary:
+*  Records memory mode.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_enter_xip(void)
+{
+    hyperram_sim_xip_mode = true;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_enter_command
+********************************************************************************
+* Summary:
+*  Records command mode.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_enter_command(void)
+{
+    hyperram_sim_xip_mode = false;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_is_xip
+********************************************************************************
+* Summary:
+*  Reports the recorded mode.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true in memory mode
+*
+*******************************************************************************/
+bool hyperram_is_xip(void)
+{
+    return hyperram_sim_xip_mode;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_xip_ptr
+********************************************************************************
+* Summary:
+*  Returns the host address standing in for a device offset.
+*
+* Parameters:
+*  address - byte offset in the device
+*
+* Return:
+*  void* - pointer into the simulated device
+*
+*******************************************************************************/
+void* hyperram_xip_ptr(uint32_t address)
+{
+    return &hyperram_sim_memory[address];
+}
+
+/*******************************************************************************
+* Function Name: hyperram_set_crypto_key
+********************************************************************************
+* Summary:
+*  Loads the key and nonce of the keystream model.
+*
+* Parameters:
+*  key - HYPERRAM_CRYPTO_KEY_WORDS words
+*  nonce - HYPERRAM_CRYPTO_NONCE_WORDS words
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_set_crypto_key(const uint32_t* key, const uint32_t* nonce)
+{
+    memcpy(hyperram_sim_crypto_key, key, sizeof(hyperram_sim_crypto_key));
+    memcpy(hyperram_sim_crypto_nonce, nonce, sizeof(hyperram_sim_crypto_nonce));
+}
+
+/*******************************************************************************
+* Function Name: hyperram_set_crypto
+********************************************************************************
+* Summary:
+*  Turns the keystream on DMA transfers to and from the device on or off.
+*  CPU accesses through hyperram_xip_ptr() are never transformed.
+*
+* Parameters:
+*  enable - true to encrypt DMA transfers
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_set_crypto(bool enable)
+{
+    hyperram_sim_crypto_mode = enable;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_is_crypto
+********************************************************************************
+* Summary:
+*  Reports the recorded encryption state.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true while DMA transfers are encrypted
+*
+*******************************************************************************/
+bool hyperram_is_crypto(void)
+{
+    return hyperram_sim_crypto_mode;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_encrypt
+********************************************************************************
+* Summary:
+*  Applies the keystream of a device range to a buffer in place, with the
+*  same argument checks as the driver.
+*
+* Parameters:
+*  address - byte offset in the device, multiple of HYPERRAM_CRYPTO_BLOCK
+*  data - buffer to transform
+*  size - number of bytes, multiple of HYPERRAM_CRYPTO_BLOCK
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS or HYPERRAM_BAD_PARAM
+*
+*******************************************************************************/
+hyperram_status_t hyperram_encrypt(uint32_t address, void* data, uint32_t size)
+{
+    if ((0u != ((address | size) & (HYPERRAM_CRYPTO_BLOCK - 1u))) || !hyperram_sim_range_valid(address, size))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    hyperram_sim_keystream(address, (uint8_t*)data, size);
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_sim_set_fault_rate
+********************************************************************************
+* Summary:
+*  Enables random single-bit faults on command-mode and DMA transfers, so
+*  that the error paths of the tests can be exercised on the host. A fault
+*  hits the data stored by a write or the data returned by a read. CPU
+*  accesses through hyperram_xip_ptr() are never corrupted.
+*
+* Parameters:
+*  one_in - average number of transfers per fault, 0 disables faults
+*  seed - seed for the fault positions
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_sim_set_fault_rate(uint32_t one_in, uint32_t seed)
+{
+    hyperram_sim_fault_one_in = one_in;
+    hyperram_sim_fault_state = (0u != seed) ? seed : 1u;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_dma_init
+********************************************************************************
+* Summary:
+*  Nothing to allocate on the host.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS
+*
+*******************************************************************************/
+hyperram_status_t hyperram_dma_init(void)
+{
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_dma_copy
+********************************************************************************
+* Summary:
+*  Performs the copy synchronously.
+*
+* Parameters:
+*  dst - destination address
+*  src - source address
+*  size - number of bytes
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS
+*
+*******************************************************************************/
+hyperram_status_t hyperram_dma_copy(void* dst, const void* src, uint32_t size)
+{
+    memmove(dst, src, size);
+    hyperram_sim_crypto_transfer(dst, src, size);
+    hyperram_sim_inject_fault(dst, size);
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_dma_copy_async
+********************************************************************************
+* Summary:
+*  Performs the copy synchronously and then runs the callback, so callers
+*  see the same completion order as on the target.
+*
+* Parameters:
+*  dst - destination address
+*  src - source address
+*  size - number of bytes
+*  callback - completion callback, may be NULL
+*  arg - argument passed to the callback
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS
+*
+*******************************************************************************/
+hyperram_status_t hyperram_dma_copy_async(void* dst, const void* src, uint32_t size,
+                                          hyperram_dma_callback_t callback, void* arg)
+{
+    memmove(dst, src, size);
+    hyperram_sim_crypto_transfer(dst, src, size);
+    hyperram_sim_inject_fault(dst, size);
+
+    if (NULL != callback)
+    {
+        callback(arg);
+    }
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_dma_fill
+********************************************************************************
+* Summary:
+*  Fills the block synchronously with the same argument checks as the DMA
+*  driver.
+*
+* Parameters:
+*  dst - destination address, word aligned
+*  value - word written to every position
+*  size - number of bytes, multiple of 4
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS or HYPERRAM_BAD_PARAM
+*
+*******************************************************************************/
+hyperram_status_t hyperram_dma_fill(void* dst, uint32_t value, uint32_t size)
+{
+    if (0u != (((uintptr_t)dst | size) & 3u))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    for (uint32_t index = 0; index < size; index += sizeof(value))
+    {
+        memcpy((uint8_t*)dst + index, &value, sizeof(value));
+    }
+    hyperram_sim_crypto_transfer(dst, NULL, size);
+    hyperram_sim_inject_fault(dst, size);
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_dma_fill_async
+********************************************************************************
+* Summary:
+*  Performs the fill synchronously and then runs the callback.
+*
+* Parameters:
+*  dst - destination address, word aligned
+*  value - word written to every position
+*  size - number of bytes, multiple of 4
+*  callback - completion callback, may be NULL
+*  arg - argument passed to the callback
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS or HYPERRAM_BAD_PARAM
+*
+*******************************************************************************/
+hyperram_status_t hyperram_dma_fill_async(void* dst, uint32_t value, uint32_t size,
+                                          hyperram_dma_callback_t callback, void* arg)
+{
+    hyperram_status_t status = hyperram_dma_fill(dst, value, size);
+
+    if ((HYPERRAM_SUCCESS == status) && (NULL != callback))
+    {
+        callback(arg);
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_dma_pattern_fill
+********************************************************************************
+* Summary:
+*  Writes the pattern synchronously, word by word, with the same sequence
+*  as the DMA driver.
+*
+* Parameters:
+*  dst - destination address, word aligned
+*  pattern - pattern type
+*  seed - first value or generator seed
+*  size - number of bytes, multiple of 4
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS or HYPERRAM_BAD_PARAM
+*
+*******************************************************************************/
+hyperram_status_t hyperram_dma_pattern_fill(void* dst, hyperram_dma_pattern_t pattern, uint32_t seed, uint32_t size)
+{
+    uint32_t value = ((HYPERRAM_DMA_PATTERN_LFSR == pattern) && (0u == seed)) ? 1u : seed;
+
+    if (HYPERRAM_DMA_PATTERN_CONSTANT == pattern)
+    {
+        return hyperram_dma_fill(dst, seed, size);
+    }
+
+    if ((0u != (((uintptr_t)dst | size) & 3u)) ||
+        ((HYPERRAM_DMA_PATTERN_INCREMENT != pattern) && (HYPERRAM_DMA_PATTERN_LFSR != pattern)))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    for (uint32_t index = 0; index < size; index += sizeof(value))
+    {
+        if (HYPERRAM_DMA_PATTERN_INCREMENT == pattern)
+        {
+            memcpy((uint8_t*)dst + index, &value, sizeof(value));
+            value++;
+        }
+        else
+        {
+            value ^= value << 13;
+            value ^= value >> 17;
+            value ^= value << 5;
+            memcpy((uint8_t*)dst + index, &value, sizeof(value));
+        }
+    }
+    hyperram_sim_crypto_transfer(dst, NULL, size);
+    hyperram_sim_inject_fault(dst, size);
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_dma_pattern_fill_async
+********************************************************************************
+* Summary:
+*  Performs the pattern fill synchronously and then runs the callback.
+*
+* Parameters:
+*  dst - destination address, word aligned
+*  pattern - pattern type
+*  seed - first value or generator seed
+*  size - number of bytes, multiple of 4
+*  callback - completion callback, may be NULL
+*  arg - argument passed to the callback
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS or HYPERRAM_BAD_PARAM
+*
+*******************************************************************************/
+hyperram_status_t hyperram_dma_pattern_fill_async(void* dst, hyperram_dma_pattern_t pattern, uint32_t seed,
+                                                  uint32_t size, hyperram_dma_callback_t callback, void* arg)
+{
+    hyperram_status_t status = hyperram_dma_pattern_fill(dst, pattern, seed, size);
+
+    if ((HYPERRAM_SUCCESS == status) && (NULL != callback))
+    {
+        callback(arg);
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_dma_is_busy
+********************************************************************************
+* Summary:
+*  Simulated copies complete immediately.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - always false
+*
+*******************************************************************************/
+bool hyperram_dma_is_busy(void)
+{
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_dma_wait
+********************************************************************************
+* Summary:
+*  Simulated copies complete immediately.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_dma_wait(void)
+{
+}
+
+/*******************************************************************************
+* Function Name: hyperram_dma_get_result
+********************************************************************************
+* Summary:
+*  Simulated copies always complete.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS
+*
+*******************************************************************************/
+hyperram_status_t hyperram_dma_get_result(void)
+{
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_sim_range_valid
+********************************************************************************
+* Summary:
+*  Checks that a byte range is word aligned and inside the device.
+*
+* Parameters:
+*  address - byte offset in the device
+*  size - number of bytes
+*
+* Return:
+*  bool - true if the range is valid
+*
+*******************************************************************************/
+static bool hyperram_sim_range_valid(uint32_t address, uint32_t size)
+{
+    return (0u == ((address | size) & 1u)) &&
+           (address <= HYPERRAM_SIZE) && (size <= (HYPERRAM_SIZE - address));
+}
+
+/*******************************************************************************
+* Function Name: hyperram_sim_keystream
+********************************************************************************
+* Summary:
+*  XORs the keystream of a device range into a buffer. Each 16-byte block
+*  gets a keystream derived from the key, the nonce and the block address,
+*  standing in for the AES output of the SMIF crypto engine.
+*
+* Parameters:
+*  address - byte offset in the device of the first byte
+*  data - buffer to transform
+*  size - number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void hyperram_sim_keystream(uint32_t address, uint8_t* data, uint32_t size)
+{
+    uint32_t block = UINT32_MAX;
+    uint8_t stream[HYPERRAM_CRYPTO_BLOCK];
+
+    for (uint32_t index = 0; index < size; index++)
+    {
+        uint32_t position = address + index;
+
+        if ((position & ~(HYPERRAM_CRYPTO_BLOCK - 1u)) != block)
+        {
+            block = position & ~(HYPERRAM_CRYPTO_BLOCK - 1u);
+
+            for (uint32_t word = 0; word < HYPERRAM_CRYPTO_KEY_WORDS; word++)
+            {
+                uint32_t x = (block + word) ^ hyperram_sim_crypto_key[word] ^
+                             (hyperram_sim_crypto_nonce[word % HYPERRAM_CRYPTO_NONCE_WORDS] * 0x9E3779B9u);
+
+                x ^= x >> 16;
+                x *= 0x85EBCA6Bu;
+                x ^= x >> 13;
+                x *= 0xC2B2AE35u;
+                x ^= x >> 16;
+                memcpy(&stream[word * sizeof(x)], &x, sizeof(x));
+            }
+        }
+
+        data[index] ^= stream[position & (HYPERRAM_CRYPTO_BLOCK - 1u)];
+    }
+}
+
+/*******************************************************************************
+* Function Name: hyperram_sim_crypto_transfer
+********************************************************************************
+* Summary:
+*  Applies the encryption to a completed DMA transfer while it is on: data
+*  read from the device is decrypted and data written to it is encrypted,
+*  as the SMIF does for XIP accesses.
+*
+* Parameters:
+*  dst - destination of the transfer
+*  src - source of the transfer, or NULL for a fill
+*  size - number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void hyperram_sim_crypto_transfer(void* dst, const void* src, uint32_t size)
+{
+    uintptr_t base = (uintptr_t)hyperram_sim_memory;
+
+    if (!hyperram_sim_crypto_mode)
+    {
+        return;
+    }
+
+    if ((NULL != src) && ((uintptr_t)src >= base) && ((uintptr_t)src < (base + HYPERRAM_SIZE)))
+    {
+        hyperram_sim_keystream((uint32_t)((uintptr_t)src - base), (uint8_t*)dst, size);
+    }
+    if (((uintptr_t)dst >= base) && ((uintptr_t)dst < (base + HYPERRAM_SIZE)))
+    {
+        hyperram_sim_keystream((uint32_t)((uintptr_t)dst - base), (uint8_t*)dst, size);
+    }
+}
+
+/*******************************************************************************
+* Function Name: hyperram_sim_inject_fault
+********************************************************************************
+* Summary:
+*  Flips one random bit of a transfer with the configured probability.
+*
+* Parameters:
+*  data - transferred bytes
+*  size - number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void hyperram_sim_inject_fault(void* data, uint32_t size)
+{
+    uint32_t x = hyperram_sim_fault_state;
+
+    if ((0u == hyperram_sim_fault_one_in) || (0u == size))
+    {
+        return;
+    }
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    hyperram_sim_fault_state = x;
+
+    if (0u == (x % hyperram_sim_fault_one_in))
+    {
+        uint32_t bit = (x >> 8) % (size * 8u);
+
+        ((uint8_t*)data)[bit / 8u] ^= (uint8_t)(1u << (bit % 8u));
+    }
+}
+
+#endif /* HYPERRAM_HOST_SIM */
+
+/* [] END OF FILE */
@@ -0,0 +1,472 @@
+/*******************************************************************************
+* File Name:   hyperram_verify.c
+*
+* Description: Digest based verification of HYPERRAM transfers. On devices with a
+* CRYPTO block the CRC-32 is computed by its CRC unit, which reads memory
+* through its own bus master while the DMA moves the data, so the CPU
+* neither copies nor compares the buffers.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include <stddef.h>
+#include "platform.h"
+#include "hyperram_verify.h"
+#include "hyperram_dma.h"
+#include "dma_buffer.h"
+#include "simd_ops.h"
+#include "crc.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* CRC-32 (IEEE 802.3): reflected in and out, inverted start and result */
+#define VERIFY_CRC_WIDTH                (32u)
+#define VERIFY_CRC_POLYNOMIAL           (0x04C11DB7UL)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+static bool verify_ready;
+
+#if !HYPERRAM_VERIFY_HW
+static uint32_t verify_crc_state;
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void verify_crc_start(void);
+static void verify_crc_update(const void* data, uint32_t size);
+static uint32_t verify_crc_finish(void);
+static bool verify_range_ok(uint32_t address, uint32_t size);
+
+/*******************************************************************************
+* Function Name: hyperram_verify_init
+********************************************************************************
+* Summary:
+*  Enables the CRYPTO block, loads the CRC-32 parameters into its CRC unit
+*  and claims the DMA channel. Later calls return immediately.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS or HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t hyperram_verify_init(void)
+{
+    if (verify_ready)
+    {
+        return HYPERRAM_SUCCESS;
+    }
+
+#if HYPERRAM_VERIFY_HW
+    if (CY_CRYPTO_SUCCESS != Cy_Crypto_Core_Enable(CRYPTO))
+    {
+        return HYPERRAM_ERROR;
+    }
+
+    if (CY_CRYPTO_SUCCESS != Cy_Crypto_Core_Crc_CalcInit(CRYPTO, VERIFY_CRC_WIDTH, VERIFY_CRC_POLYNOMIAL,
+                                                         1u, 0u, 1u, CRC32_FINAL_XOR, CRC32_INIT))
+    {
+        return HYPERRAM_ERROR;
+    }
+#endif
+
+    if (HYPERRAM_SUCCESS != hyperram_dma_init())
+    {
+        return HYPERRAM_ERROR;
+    }
+
+    verify_ready = true;
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_verify_crc32
+********************************************************************************
+* Summary:
+*  Computes the CRC-32 of a buffer, with the same result as crc32_compute().
+*  The buffer may be in SRAM or in the XIP window.
+*
+* Parameters:
+*  data - data to checksum
+*  size - number of bytes in data
+*
+* Return:
+*  uint32_t - CRC-32 of the buffer
+*
+*******************************************************************************/
+uint32_t hyperram_verify_crc32(const void* data, uint32_t size)
+{
+    verify_crc_start();
+    verify_crc_update(data, size);
+
+    return verify_crc_finish();
+}
+
+/*******************************************************************************
+* Function Name: hyperram_verify_write
+********************************************************************************
+* Summary:
+*  Writes a buffer to the device by DMA and computes its CRC-32 while the
+*  transfer runs. The digest is the reference for a later
+*  hyperram_verify_check() or hyperram_verify_read().
+*
+* Parameters:
+*  address - device offset of the first byte
+*  src - data to write
+*  size - number of bytes
+*  crc - receives the CRC-32 of the data
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM for a range
+*                      outside the device, or HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t hyperram_verify_write(uint32_t address, const void* src, uint32_t size, uint32_t* crc)
+{
+    if (!verify_range_ok(address, size) || (NULL == crc))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    if (HYPERRAM_SUCCESS != hyperram_dma_copy_async(hyperram_xip_ptr(address), src, size, NULL, NULL))
+    {
+        return HYPERRAM_ERROR;
+    }
+
+    /* Both masters only read the source, so they can share it */
+    *crc = hyperram_verify_crc32(src, size);
+
+    hyperram_dma_wait();
+
+    return hyperram_dma_get_result();
+}
+
+/*******************************************************************************
+* Function Name: hyperram_verify_read
+********************************************************************************
+* Summary:
+*  Reads a block from the device into SRAM by DMA and computes its CRC-32 as
+*  the chunks arrive: while chunk k is digested, chunk k+1 is in flight, so
+*  the digest costs little more than the transfer itself.
+*
+* Parameters:
+*  dst - destination buffer
+*  address - device offset of the first byte
+*  size - number of bytes
+*  crc - receives the CRC-32 of the data read
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM for a range
+*                      outside the device, or HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t hyperram_verify_read(void* dst, uint32_t address, uint32_t size, uint32_t* crc)
+{
+    uint8_t* out = (uint8_t*)dst;
+    const uint8_t* in;
+    uint32_t done = 0u;
+    uint32_t chunk;
+    hyperram_status_t status;
+
+    if (!verify_range_ok(address, size) || (NULL == crc))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    in = (const uint8_t*)hyperram_xip_ptr(address);
+    verify_crc_start();
+
+    chunk = (size < HYPERRAM_VERIFY_CHUNK) ? size : HYPERRAM_VERIFY_CHUNK;
+    status = hyperram_dma_copy(out, in, chunk);
+
+    while ((HYPERRAM_SUCCESS == status) && (done < size))
+    {
+        uint32_t next = done + chunk;
+        uint32_t next_chunk = ((size - next) < HYPERRAM_VERIFY_CHUNK) ? (size - next) : HYPERRAM_VERIFY_CHUNK;
+
+        if ((0u != next_chunk) &&
+            (HYPERRAM_SUCCESS != hyperram_dma_copy_async(&out[next], &in[next], next_chunk, NULL, NULL)))
+        {
+            status = HYPERRAM_ERROR;
+            break;
+        }
+
+        verify_crc_update(&out[done], chunk);
+
+        hyperram_dma_wait();
+        status = hyperram_dma_get_result();
+
+        done = next;
+        chunk = next_chunk;
+    }
+
+    *crc = verify_crc_finish();
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_verify_check
+********************************************************************************
+* Summary:
+*  Checks a device range against a digest without copying it to SRAM. The
+*  CRC is computed straight over the XIP window; dirty cache lines of the
+*  range are written back first so the device holds what the CPU wrote.
+*
+* Parameters:
+*  address - device offset of the first byte
+*  size - number of bytes
+*  expected - CRC-32 the range should have
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS on a match, HYPERRAM_BAD_PARAM for a
+*                      range outside the device, or HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t hyperram_verify_check(uint32_t address, uint32_t size, uint32_t expected)
+{
+    void* xip;
+
+    if (!verify_range_ok(address, size))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    xip = hyperram_xip_ptr(address);
+    platform_dcache_clean(xip, size);
+
+    return (expected == hyperram_verify_crc32(xip, size)) ? HYPERRAM_SUCCESS : HYPERRAM_ERROR;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_verify_compare
+********************************************************************************
+* Summary:
+*  Compares a device range with a reference copy in SRAM. The range is
+*  streamed into two DMA buffers in chunks; while chunk k is compared, a
+*  line at a time by simd_first_diff(), chunk k+1 is in flight. Stops at the
+*  first mismatch.
+*
+* Parameters:
+*  address - device offset of the first byte
+*  expected - reference data
+*  size - number of bytes
+*  first - receives the offset of the first mismatching byte, or size;
+*          may be NULL
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS on a match, HYPERRAM_BAD_PARAM for a
+*                      range outside the device, or HYPERRAM_ERROR on a
+*                      mismatch, a failed transfer or no free DMA buffer
+*
+*******************************************************************************/
+hyperram_status_t hyperram_verify_compare(uint32_t address, const void* expected, uint32_t size,
+                                          uint32_t* first)
+{
+    const uint8_t* reference = (const uint8_t*)expected;
+    const uint8_t* in;
+    uint8_t* buffers;
+    uint32_t done = 0u;
+    uint32_t chunk;
+    uint32_t mismatch = size;
+    uint32_t slot = 0u;
+    hyperram_status_t status;
+
+    if (!verify_range_ok(address, size) || (NULL == expected))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    buffers = (uint8_t*)dma_buffer_alloc(2u * HYPERRAM_VERIFY_CHUNK);
+    if (NULL == buffers)
+    {
+        return HYPERRAM_ERROR;
+    }
+
+    in = (const uint8_t*)hyperram_xip_ptr(address);
+
+    chunk = (size < HYPERRAM_VERIFY_CHUNK) ? size : HYPERRAM_VERIFY_CHUNK;
+    status = hyperram_dma_copy(buffers, in, chunk);
+
+    while ((HYPERRAM_SUCCESS == status) && (done < size))
+    {
+        uint8_t* current = &buffers[slot * HYPERRAM_VERIFY_CHUNK];
+        uint32_t next = done + chunk;
+        uint32_t next_chunk = ((size - next) < HYPERRAM_VERIFY_CHUNK) ? (size - next) : HYPERRAM_VERIFY_CHUNK;
+        uint32_t offset;
+
+        slot ^= 1u;
+
+        if ((0u != next_chunk) &&
+            (HYPERRAM_SUCCESS != hyperram_dma_copy_async(&buffers[slot * HYPERRAM_VERIFY_CHUNK], &in[next],
+                                                         next_chunk, NULL, NULL)))
+        {
+            status = HYPERRAM_ERROR;
+            break;
+        }
+
+        offset = simd_first_diff(current, &reference[done], chunk);
+
+        if (0u != next_chunk)
+        {
+            hyperram_dma_wait();
+            status = hyperram_dma_get_result();
+        }
+
+        if (offset < chunk)
+        {
+            mismatch = done + offset;
+            break;
+        }
+
+        done = next;
+        chunk = next_chunk;
+    }
+
+    dma_buffer_free(buffers);
+
+    if (NULL != first)
+    {
+        *first = mismatch;
+    }
+
+    return ((HYPERRAM_SUCCESS == status) && (mismatch == size)) ? HYPERRAM_SUCCESS : HYPERRAM_ERROR;
+}
+
+/*******************************************************************************
+* Function Name: verify_crc_start
+********************************************************************************
+* Summary:
+*  Resets the running CRC.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void verify_crc_start(void)
+{
+#if HYPERRAM_VERIFY_HW
+    (void)Cy_Crypto_Core_Crc_CalcStart(CRYPTO, VERIFY_CRC_WIDTH, CRC32_INIT);
+#else
+    verify_crc_state = CRC32_INIT;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: verify_crc_update
+********************************************************************************
+* Summary:
+*  Adds a buffer to the running CRC. The CRYPTO block reads memory behind
+*  the data cache, so the range is cleaned first.
+*
+* Parameters:
+*  data - data to accumulate
+*  size - number of bytes in data
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void verify_crc_update(const void* data, uint32_t size)
+{
+#if HYPERRAM_VERIFY_HW
+    platform_dcache_clean(data, size);
+    (void)Cy_Crypto_Core_Crc_CalcPartial(CRYPTO, data, size);
+#else
+    verify_crc_state = crc32_update(verify_crc_state, data, size);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: verify_crc_finish
+********************************************************************************
+* Summary:
+*  Returns the finished CRC-32 of the data accumulated since the last start.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t - CRC-32
+*
+*******************************************************************************/
+static uint32_t verify_crc_finish(void)
+{
+#if HYPERRAM_VERIFY_HW
+    uint32_t crc = 0u;
+
+    (void)Cy_Crypto_Core_Crc_CalcFinish(CRYPTO, VERIFY_CRC_WIDTH, &crc);
+
+    return crc;
+#else
+    return verify_crc_state ^ CRC32_FINAL_XOR;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: verify_range_ok
+********************************************************************************
+* Summary:
+*  Checks that a range lies inside the device.
+*
+* Parameters:
+*  address - device offset of the first byte
+*  size - number of bytes
+*
+* Return:
+*  bool - true if the range is valid
+*
+*******************************************************************************/
+static bool verify_range_ok(uint32_t address, uint32_t size)
+{
+    return (address < HYPERRAM_SIZE) && (size <= (HYPERRAM_SIZE - address));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,90 @@
+/*******************************************************************************
+* File Name:   hyperram_verify.h
+*
+* Description: Digest based verification of HYPERRAM transfers. The CRC-32 of the data
+* is computed by the CRYPTO block while the DMA moves it, and a read-back
+* check lets the CRYPTO block read the device directly, so only the two
+* digests are compared. Without a CRYPTO block, and on the host, the
+* software CRC-32 from crc.h is used.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HYPERRAM_VERIFY_H
+#define HYPERRAM_VERIFY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "platform.h"
+#include "hyperram.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+#if !defined(HYPERRAM_HOST_SIM) && defined(CY_IP_MXCRYPTO)
+#define HYPERRAM_VERIFY_HW              (1)
+#else
+#define HYPERRAM_VERIFY_HW              (0)
+#endif
+
+/* Read-back pipeline step: the DMA loads one chunk while the previous one
+ * is digested or compared */
+#ifndef HYPERRAM_VERIFY_CHUNK
+#define HYPERRAM_VERIFY_CHUNK           (4096u)
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+hyperram_status_t hyperram_verify_init(void);
+uint32_t hyperram_verify_crc32(const void* data, uint32_t size);
+hyperram_status_t hyperram_verify_write(uint32_t address, const void* src, uint32_t size, uint32_t* crc);
+hyperram_status_t hyperram_verify_read(void* dst, uint32_t address, uint32_t size, uint32_t* crc);
+hyperram_status_t hyperram_verify_check(uint32_t address, uint32_t size, uint32_t expected);
+hyperram_status_t hyperram_verify_compare(uint32_t address, const void* expected, uint32_t size,
+                                          uint32_t* first);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* HYPERRAM_VERIFY_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,860 @@
+/*******************************************************************************
+* File Name:   hyperram_vm.c
+*
+* Description: MPU fault driven access to a HYPERRAM range, see hyperram_vm.h. The
+* fault handler decodes the Thumb instruction at the stacked PC, performs
+* its accesses on the far array pages and writes the results to the
+* stacked or saved registers.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "platform.h"
+#include "hyperram_vm.h"
+#include "hyperram_dma.h"
+#include "far_array.h"
+#include "perf_counter.h"
+#include <string.h>
+
+#if defined(HYPERRAM_VM)
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+#if (HYPERRAM_VM_FAULT_PRIORITY <= HYPERRAM_DMA_ISR_PRIORITY)
+#error "HYPERRAM_VM_FAULT_PRIORITY must be lower (numerically higher) than HYPERRAM_DMA_ISR_PRIORITY"
+#endif
+
+#if ((HYPERRAM_VM_SIZE & (HYPERRAM_VM_SIZE - 1u)) != 0u) || ((HYPERRAM_VM_OFFSET % HYPERRAM_VM_SIZE) != 0u)
+#error "HYPERRAM_VM_SIZE must be a power of two and HYPERRAM_VM_OFFSET a multiple of it"
+#endif
+
+/* MMFSR bits of SCB->CFSR */
+#define VM_MMFSR_IACCVIOL               (1UL << 0)
+#define VM_MMFSR_DACCVIOL               (1UL << 1)
+#define VM_MMFSR_MASK                   (0xFFUL)
+
+/* IT state bits of xPSR */
+#define VM_XPSR_IT_MASK                 (0x0600FC00UL)
+
+#define VM_REG_SP                       (13u)
+#define VM_REG_PC                       (15u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+/* Basic exception frame; an extended frame only adds FP registers after it */
+typedef struct
+{
+    uint32_t r0;
+    uint32_t r1;
+    uint32_t r2;
+    uint32_t r3;
+    uint32_t r12;
+    uint32_t lr;
+    uint32_t pc;
+    uint32_t xpsr;
+} vm_frame_t;
+
+typedef struct
+{
+    vm_frame_t* frame;
+    uint32_t* saved;            /* r4 to r11 pushed by the handler entry */
+} vm_context_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void MemManage_Handler(void);
+void hyperram_vm_fault(vm_frame_t* frame, uint32_t* saved);
+static bool vm_emulate(vm_context_t* context, uint32_t* length);
+static bool vm_single(vm_context_t* context, uint16_t hw1, uint16_t hw2);
+static bool vm_dual(vm_context_t* context, uint16_t hw1, uint16_t hw2);
+static bool vm_multiple(vm_context_t* context, uint32_t rn, uint32_t list, bool load, bool increment,
+                        bool writeback);
+static bool vm_transfer(vm_context_t* context, uint32_t address, uint32_t size, bool load, bool sign,
+                        uint32_t rt);
+static uint32_t* vm_register(vm_context_t* context, uint32_t reg);
+static bool vm_access(uint32_t address, void* data, uint32_t size, bool write);
+static uint32_t vm_it_advance(uint32_t xpsr);
+static void vm_stop(const vm_frame_t* frame, uint32_t address);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+static far_array_t vm_array;
+static hyperram_vm_stats_t vm_stats;
+static uint64_t vm_hit_total_ns;
+static uint64_t vm_miss_total_ns;
+static bool vm_enabled;
+
+/*******************************************************************************
+* Function Name: hyperram_vm_init
+********************************************************************************
+* Summary:
+*  Empties the far array page pool, maps the virtual range onto it and
+*  blocks the range with an MPU region. Call it after hyperram_init(), in
+*  memory mode. Other far arrays share the pool, so create their pages
+*  after this call.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, or the error from the page pool
+*
+*******************************************************************************/
+hyperram_status_t hyperram_vm_init(void)
+{
+    hyperram_status_t status = far_array_pool_init();
+    uint32_t size_field = 0u;
+    uint32_t mpu_ctrl;
+
+    if (HYPERRAM_SUCCESS == status)
+    {
+        status = far_array_init(&vm_array, HYPERRAM_VM_OFFSET, 1u, HYPERRAM_VM_SIZE);
+    }
+
+    if (HYPERRAM_SUCCESS != status)
+    {
+        return status;
+    }
+
+    memset(&vm_stats, 0, sizeof(vm_stats));
+    vm_hit_total_ns = 0u;
+    vm_miss_total_ns = 0u;
+
+    /* Lines cached before the region was blocked would hide DMA write-backs */
+    platform_dcache_clean_invalidate((void*)HYPERRAM_VM_BASE, HYPERRAM_VM_SIZE);
+
+    /* RASR size field: region size is 2^(SIZE + 1) bytes */
+    while ((2UL << size_field) < HYPERRAM_VM_SIZE)
+    {
+        size_field++;
+    }
+
+    NVIC_SetPriority(MemoryManagement_IRQn, HYPERRAM_VM_FAULT_PRIORITY);
+    SCB->SHCSR |= SCB_SHCSR_MEMFAULTENA_Msk;
+
+    /* Keep the BSP MPU settings; the default map stays on for everything else */
+    mpu_ctrl = MPU->CTRL & ~MPU_CTRL_ENABLE_Msk;
+    ARM_MPU_Disable();
+    ARM_MPU_SetRegion(ARM_MPU_RBAR(HYPERRAM_VM_MPU_REGION, HYPERRAM_VM_BASE),
+                      ARM_MPU_RASR(1u, ARM_MPU_AP_NONE, 0u, 0u, 0u, 0u, 0u, size_field));
+    ARM_MPU_Enable(mpu_ctrl | MPU_CTRL_PRIVDEFENA_Msk);
+
+    vm_enabled = true;
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_vm_disable
+********************************************************************************
+* Summary:
+*  Writes the dirty pages back and removes the MPU region, so the range is
+*  accessed directly through the XIP window again.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS or HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t hyperram_vm_disable(void)
+{
+    hyperram_status_t status = far_array_invalidate();
+
+    if (vm_enabled)
+    {
+        uint32_t mpu_ctrl = MPU->CTRL & ~MPU_CTRL_ENABLE_Msk;
+
+        ARM_MPU_Disable();
+        ARM_MPU_ClrRegion(HYPERRAM_VM_MPU_REGION);
+        ARM_MPU_Enable(mpu_ctrl | MPU_CTRL_PRIVDEFENA_Msk);
+        vm_enabled = false;
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_vm_flush
+********************************************************************************
+* Summary:
+*  Writes the dirty pages back to the HYPERRAM.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS or HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t hyperram_vm_flush(void)
+{
+    return far_array_flush();
+}
+
+/*******************************************************************************
+* Function Name: hyperram_vm_get_stats
+********************************************************************************
+* Summary:
+*  Returns the fault counters and latencies.
+*
+* Parameters:
+*  stats - filled with the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_vm_get_stats(hyperram_vm_stats_t* stats)
+{
+    *stats = vm_stats;
+    stats->hit_avg_ns = (0u != vm_stats.hits) ? (uint32_t)(vm_hit_total_ns / vm_stats.hits) : 0u;
+    stats->miss_avg_ns = (0u != vm_stats.misses) ? (uint32_t)(vm_miss_total_ns / vm_stats.misses) : 0u;
+}
+
+/*******************************************************************************
+* Function Name: hyperram_vm_print_stats
+********************************************************************************
+* Summary:
+*  Prints the fault statistics on the console.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_vm_print_stats(void)
+{
+    hyperram_vm_stats_t stats;
+
+    hyperram_vm_get_stats(&stats);
+
+    PLATFORM_PRINTF("VM faults=%lu reads=%lu writes=%lu hits=%lu misses=%lu\r\n",
+                    (unsigned long)stats.faults, (unsigned long)stats.reads, (unsigned long)stats.writes,
+                    (unsigned long)stats.hits, (unsigned long)stats.misses);
+    PLATFORM_PRINTF("VM hit avg=%luns max=%luns miss avg=%luns max=%luns\r\n",
+                    (unsigned long)stats.hit_avg_ns, (unsigned long)stats.hit_max_ns,
+                    (unsigned long)stats.miss_avg_ns, (unsigned long)stats.miss_max_ns);
+    PLATFORM_FLUSH();
+}
+
+/*******************************************************************************
+* Function Name: MemManage_Handler
+********************************************************************************
+* Summary:
+*  Saves r4 to r11 next to the exception frame and calls
+*  hyperram_vm_fault(). The pushes keep the stack 8-byte aligned.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__attribute__((naked)) void MemManage_Handler(void)
+{
+    __asm volatile
+    (
+        "tst    lr, #4              \n"
+        "ite    eq                  \n"
+        "mrseq  r0, msp             \n"
+        "mrsne  r0, psp             \n"
+        "push   {r4-r11}            \n"
+        "mov    r1, sp              \n"
+        "push   {r0, lr}            \n"
+        "bl     hyperram_vm_fault   \n"
+        "pop    {r0, lr}            \n"
+        "pop    {r4-r11}            \n"
+        "bx     lr                  \n"
+    );
+}
+
+/*******************************************************************************
+* Function Name: hyperram_vm_fault
+********************************************************************************
+* Summary:
+*  Services a MemManage fault: emulates the faulting data access if it hit
+*  the virtual range, advances the stacked PC past it and times the fault.
+*  Any other fault stops the program.
+*
+* Parameters:
+*  frame - exception frame of the faulting code
+*  saved - r4 to r11 of the faulting code
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hyperram_vm_fault(vm_frame_t* frame, uint32_t* saved)
+{
+    uint32_t start = perf_counter_now();
+    uint32_t cfsr = SCB->CFSR & VM_MMFSR_MASK;
+    uint32_t address = SCB->MMFAR;
+    uint32_t misses;
+    uint32_t length = 0u;
+    uint32_t elapsed;
+    vm_context_t context = { frame, saved };
+    far_array_stats_t far_stats;
+
+    if (!vm_enabled || (0u != (cfsr & ~(VM_MMFSR_DACCVIOL | SCB_CFSR_MMARVALID_Msk))) ||
+        ((address - HYPERRAM_VM_BASE) >= HYPERRAM_VM_SIZE))
+    {
+        vm_stop(frame, address);
+    }
+
+    /* The DMA channel may be in use by the interrupted code */
+    hyperram_dma_wait();
+
+    far_array_get_stats(&far_stats);
+    misses = far_stats.misses;
+
+    if (!vm_emulate(&context, &length))
+    {
+        vm_stop(frame, address);
+    }
+
+    SCB->CFSR = cfsr;
+    frame->pc += length;
+    frame->xpsr = vm_it_advance(frame->xpsr);
+
+    far_array_get_stats(&far_stats);
+    elapsed = perf_counter_to_ns(perf_counter_now() - start);
+    vm_stats.faults++;
+
+    if (far_stats.misses == misses)
+    {
+        vm_stats.hits++;
+        vm_hit_total_ns += elapsed;
+        vm_stats.hit_max_ns = (elapsed > vm_stats.hit_max_ns) ? elapsed : vm_stats.hit_max_ns;
+    }
+    else
+    {
+        vm_stats.misses++;
+        vm_miss_total_ns += elapsed;
+        vm_stats.miss_max_ns = (elapsed > vm_stats.miss_max_ns) ? elapsed : vm_stats.miss_max_ns;
+    }
+}
+
+/*******************************************************************************
+* Function Name: vm_emulate
+********************************************************************************
+* Summary:
+*  Decodes and performs the load or store at the stacked PC.
+*
+* Parameters:
+*  context - faulting register state
+*  length - set to the instruction length in bytes
+*
+* Return:
+*  bool - false for instructions that are not emulated
+*
+*******************************************************************************/
+static bool vm_emulate(vm_context_t* context, uint32_t* length)
+{
+    const uint16_t* pc = (const uint16_t*)context->frame->pc;
+    uint16_t hw1 = pc[0];
+    uint16_t hw2;
+    uint32_t rt = hw1 & 7u;
+    uint32_t rn = (hw1 >> 3) & 7u;
+    uint32_t* base;
+
+    if ((hw1 >> 11) < 0x1Du)
+    {
+        *length = 2u;
+        base = vm_register(context, rn);
+
+        switch (hw1 >> 12)
+        {
+            case 0x5u:  /* LDR/STR (register): 0101 opB Rm Rn Rt */
+            {
+                static const uint8_t sizes[8] = { 4u, 2u, 1u, 1u, 4u, 2u, 1u, 2u };
+                uint32_t op = (hw1 >> 9) & 7u;
+                uint32_t address = *base + *vm_register(context, (hw1 >> 6) & 7u);
+
+                return vm_transfer(context, address, sizes[op], op >= 3u, (3u == op) || (7u == op), rt);
+            }
+            case 0x6u:  /* LDR/STR (immediate), word */
+            case 0x7u:  /* LDRB/STRB (immediate) */
+            {
+                uint32_t size = (0u != (hw1 & 0x1000u)) ? 1u : 4u;
+
+                return vm_transfer(context, *base + (((hw1 >> 6) & 0x1Fu) * size), size,
+                                   0u != (hw1 & 0x0800u), false, rt);
+            }
+            case 0x8u:  /* LDRH/STRH (immediate) */
+                return vm_transfer(context, *base + (((hw1 >> 6) & 0x1Fu) * 2u), 2u,
+                                   0u != (hw1 & 0x0800u), false, rt);
+            case 0xCu:  /* LDMIA/STMIA: 1100 L Rn list, writes back unless Rn is loaded */
+            {
+                bool load = (0u != (hw1 & 0x0800u));
+
+                rn = (hw1 >> 8) & 7u;
+                return vm_multiple(context, rn, hw1 & 0xFFu, load, true,
+                                   !(load && (0u != (hw1 & (1u << rn)))));
+            }
+            default:
+                return false;
+        }
+    }
+
+    *length = 4u;
+    hw2 = pc[1];
+
+    if ((hw1 & 0xFE00u) == 0xF800u)
+    {
+        return vm_single(context, hw1, hw2);
+    }
+
+    if (((hw1 & 0xFE40u) == 0xE840u) && (0u != (hw1 & 0x0120u)))
+    {
+        return vm_dual(context, hw1, hw2);
+    }
+
+    if ((hw1 & 0xFE40u) == 0xE800u)
+    {
+        uint32_t op = (hw1 >> 7) & 3u;
+
+        if ((1u == op) || (2u == op))
+        {
+            return vm_multiple(context, hw1 & 0xFu, hw2, 0u != (hw1 & 0x0010u), 1u == op,
+                               0u != (hw1 & 0x0020u));
+        }
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: vm_single
+********************************************************************************
+* Summary:
+*  32-bit LDR/STR of a byte, halfword or word with an immediate or register
+*  offset, including pre- and post-indexed forms and LDRT/STRT.
+*
+* Parameters:
+*  context - faulting register state
+*  hw1 - first halfword, 1111 100S xxxL Rn
+*  hw2 - second halfword
+*
+* Return:
+*  bool - false for encodings that are not emulated
+*
+*******************************************************************************/
+static bool vm_single(vm_context_t* context, uint16_t hw1, uint16_t hw2)
+{
+    uint32_t size_field = (hw1 >> 5) & 3u;
+    uint32_t size = 1UL << size_field;
+    bool load = (0u != (hw1 & 0x0010u));
+    bool sign = (0u != (hw1 & 0x0100u));
+    uint32_t rn = hw1 & 0xFu;
+    uint32_t rt = hw2 >> 12;
+    uint32_t* base = vm_register(context, rn);
+    uint32_t address;
+
+    if ((3u == size_field) || (NULL == base) || (sign && (!load || (4u == size))))
+    {
+        return false;
+    }
+
+    if (0u != (hw1 & 0x0080u))
+    {
+        /* imm12 */
+        return vm_transfer(context, *base + (hw2 & 0xFFFu), size, load, sign, rt);
+    }
+
+    if (0u != (hw2 & 0x0800u))
+    {
+        /* imm8 with P, U, W */
+        bool index = (0u != (hw2 & 0x0400u));
+        bool add = (0u != (hw2 & 0x0200u));
+        bool writeback = (0u != (hw2 & 0x0100u));
+        uint32_t offset_address = add ? (*base + (hw2 & 0xFFu)) : (*base - (hw2 & 0xFFu));
+
+        address = index ? offset_address : *base;
+        if (!vm_transfer(context, address, size, load, sign, rt))
+        {
+            return false;
+        }
+        if (writeback)
+        {
+            *base = offset_address;
+        }
+        return true;
+    }
+
+    if (0u == (hw2 & 0x0FC0u))
+    {
+        /* Register offset with LSL #0 to #3 */
+        uint32_t* rm = vm_register(context, hw2 & 0xFu);
+
+        return (NULL != rm) && vm_transfer(context, *base + (*rm << ((hw2 >> 4) & 3u)), size, load, sign, rt);
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: vm_dual
+********************************************************************************
+* Summary:
+*  LDRD/STRD (immediate) in the offset, pre- and post-indexed forms.
+*
+* Parameters:
+*  context - faulting register state
+*  hw1 - first halfword, 1110 100P U1WL Rn
+*  hw2 - second halfword, Rt Rt2 imm8
+*
+* Return:
+*  bool - false for encodings that are not emulated
+*
+*******************************************************************************/
+static bool vm_dual(vm_context_t* context, uint16_t hw1, uint16_t hw2)
+{
+    bool index = (0u != (hw1 & 0x0100u));
+    bool add = (0u != (hw1 & 0x0080u));
+    bool writeback = (0u != (hw1 & 0x0020u));
+    bool load = (0u != (hw1 & 0x0010u));
+    uint32_t* base = vm_register(context, hw1 & 0xFu);
+    uint32_t offset = (hw2 & 0xFFu) << 2;
+    uint32_t offset_address;
+    uint32_t address;
+
+    if (NULL == base)
+    {
+        return false;
+    }
+
+    offset_address = add ? (*base + offset) : (*base - offset);
+    address = index ? offset_address : *base;
+
+    if (!vm_transfer(context, address, 4u, load, false, hw2 >> 12) ||
+        !vm_transfer(context, address + 4u, 4u, load, false, (hw2 >> 8) & 0xFu))
+    {
+        return false;
+    }
+
+    if (writeback)
+    {
+        *base = offset_address;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: vm_multiple
+********************************************************************************
+* Summary:
+*  LDM/STM, increment after or decrement before. Registers are transferred
+*  in ascending order from the lowest address.
+*
+* Parameters:
+*  context - faulting register state
+*  rn - base register
+*  list - register list
+*  load - true for LDM
+*  increment - true for IA, false for DB
+*  writeback - update the base register
+*
+* Return:
+*  bool - false if the list names SP or PC
+*
+*******************************************************************************/
+static bool vm_multiple(vm_context_t* context, uint32_t rn, uint32_t list, bool load, bool increment,
+                        bool writeback)
+{
+    uint32_t* base = vm_register(context, rn);
+    uint32_t count = 0u;
+    uint32_t address;
+    uint32_t final_base;
+
+    if ((NULL == base) || (0u == list) || (0u != (list & ((1UL << VM_REG_SP) | (1UL << VM_REG_PC)))))
+    {
+        return false;
+    }
+
+    for (uint32_t reg = 0; reg < 16u; reg++)
+    {
+        count += (list >> reg) & 1u;
+    }
+
+    /* Taken before the loads, which may overwrite the base register */
+    address = increment ? *base : (*base - (count * 4u));
+    final_base = increment ? (*base + (count * 4u)) : address;
+
+    for (uint32_t reg = 0; reg < 16u; reg++)
+    {
+        if (0u != (list & (1UL << reg)))
+        {
+            if (!vm_transfer(context, address, 4u, load, false, reg))
+            {
+                return false;
+            }
+            address += 4u;
+        }
+    }
+
+    if (writeback)
+    {
+        *base = final_base;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: vm_transfer
+********************************************************************************
+* Summary:
+*  Moves one element between a register and memory.
+*
+* Parameters:
+*  context - faulting register state
+*  address - memory address
+*  size - 1, 2 or 4 bytes
+*  load - true to load into the register
+*  sign - sign extend a loaded byte or halfword
+*  rt - register number
+*
+* Return:
+*  bool - false for SP or PC, or if the page could not be loaded
+*
+*******************************************************************************/
+static bool vm_transfer(vm_context_t* context, uint32_t address, uint32_t size, bool load, bool sign,
+                        uint32_t rt)
+{
+    uint32_t* reg = vm_register(context, rt);
+    uint32_t value = 0u;
+
+    if (NULL == reg)
+    {
+        return false;
+    }
+
+    if (!load)
+    {
+        value = *reg;
+        vm_stats.writes++;
+        return vm_access(address, &value, size, true);
+    }
+
+    vm_stats.reads++;
+    if (!vm_access(address, &value, size, false))
+    {
+        return false;
+    }
+
+    if (sign && (size < 4u))
+    {
+        uint32_t shift = 32u - (size * 8u);
+
+        value = (uint32_t)(((int32_t)(value << shift)) >> shift);
+    }
+    *reg = value;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: vm_register
+********************************************************************************
+* Summary:
+*  Returns where a register of the faulting code is stored.
+*
+* Parameters:
+*  context - faulting register state
+*  reg - register number
+*
+* Return:
+*  uint32_t* - register storage, or NULL for SP and PC
+*
+*******************************************************************************/
+static uint32_t* vm_register(vm_context_t* context, uint32_t reg)
+{
+    if (reg < 4u)
+    {
+        return &(&context->frame->r0)[reg];
+    }
+    if (reg < 12u)
+    {
+        return &context->saved[reg - 4u];
+    }
+    if (12u == reg)
+    {
+        return &context->frame->r12;
+    }
+    if (14u == reg)
+    {
+        return &context->frame->lr;
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: vm_access
+********************************************************************************
+* Summary:
+*  Reads or writes bytes at an address. Bytes in the virtual range go to
+*  the far array pages, other addresses are accessed directly, so an access
+*  that straddles the range boundary still works. Little endian.
+*
+* Parameters:
+*  address - first byte
+*  data - register value, low bytes first
+*  size - number of bytes
+*  write - true to store
+*
+* Return:
+*  bool - false if a page could not be loaded
+*
+*******************************************************************************/
+static bool vm_access(uint32_t address, void* data, uint32_t size, bool write)
+{
+    uint8_t* bytes = (uint8_t*)data;
+
+    while (0u != size)
+    {
+        uint32_t offset = address - HYPERRAM_VM_BASE;
+        uint32_t chunk;
+        uint8_t* target;
+
+        if (offset < HYPERRAM_VM_SIZE)
+        {
+            /* Up to the end of the page */
+            chunk = FAR_ARRAY_PAGE_SIZE - (offset & (FAR_ARRAY_PAGE_SIZE - 1u));
+            target = (uint8_t*)far_array_ref(&vm_array, offset, write);
+            if (NULL == target)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            chunk = 1u;
+            target = (uint8_t*)address;
+        }
+
+        chunk = (chunk < size) ? chunk : size;
+        if (write)
+        {
+            memcpy(target, bytes, chunk);
+        }
+        else
+        {
+            memcpy(bytes, target, chunk);
+        }
+
+        address += chunk;
+        bytes += chunk;
+        size -= chunk;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: vm_it_advance
+********************************************************************************
+* Summary:
+*  Advances the IT state in xPSR past one instruction, as the hardware
+*  would have done had the instruction completed.
+*
+* Parameters:
+*  xpsr - stacked xPSR
+*
+* Return:
+*  uint32_t - updated xPSR
+*
+*******************************************************************************/
+static uint32_t vm_it_advance(uint32_t xpsr)
+{
+    uint32_t it = ((xpsr >> 25) & 0x3u) | ((xpsr >> 8) & 0xFCu);
+
+    if (0u == it)
+    {
+        return xpsr;
+    }
+
+    it = (0u == (it & 0x7u)) ? 0u : ((it & 0xE0u) | ((it << 1) & 0x1Fu));
+
+    return (xpsr & ~VM_XPSR_IT_MASK) | ((it & 0x3u) << 25) | ((it & 0xFCu) << 8);
+}
+
+/*******************************************************************************
+* Function Name: vm_stop
+********************************************************************************
+* Summary:
+*  Records a fault that cannot be serviced and stops.
+*
+* Parameters:
+*  frame - exception frame of the faulting code
+*  address - MMFAR value
+*
+* Return:
+*  void - does not return
+*
+*******************************************************************************/
+static void vm_stop(const vm_frame_t* frame, uint32_t address)
+{
+    vm_stats.unhandled++;
+    vm_stats.last_pc = frame->pc;
+    vm_stats.last_address = address;
+
+    CY_ASSERT(0u);
+    for (;;)
+    {
+    }
+}
+
+#endif /* HYPERRAM_VM */
+
+/* [] END OF FILE */
@@ -0,0 +1,130 @@
+/*******************************************************************************
+* File Name:   hyperram_vm.h
+*
+* Description: Optional fault-driven access to a large HYPERRAM buffer through plain
+* pointers. hyperram_vm_init() makes the XIP range at HYPERRAM_VM_BASE
+* inaccessible with a CM7 MPU region. Every load or store to it then
+* raises a MemManage fault. The handler finds the containing page in an
+* SRAM frame (a far array page, see far_array.h), filling it by DMA on a
+* miss, performs the access on the frame and resumes after the
+* instruction. Stores mark the page dirty, so it is written back when it
+* is replaced or flushed.
+*
+* The CM7 MPU cannot translate addresses, so a page cannot be mapped at
+* its virtual address; each access is emulated. A hit costs a fault, not a
+* cache access, so this suits code that needs the capacity more than the
+* speed. The handler emulates the integer load and store instructions:
+* LDR/STR of bytes, halfwords and words in all addressing modes, LDRD/STRD
+* and LDM/STM. Floating point loads and stores, exclusive accesses,
+* instruction fetches and accesses from interrupt handlers are not
+* supported and stop the program.
+*
+* Built only when HYPERRAM_VM is defined, because it provides the
+* MemManage_Handler.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HYPERRAM_VM_H
+#define HYPERRAM_VM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hyperram.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* Virtual range: one MPU region, so a power of two aligned to its size.
+ * The default is the upper 4 MB, which the heap then leaves alone. */
+#ifndef HYPERRAM_VM_OFFSET
+#define HYPERRAM_VM_OFFSET              (0x00C00000UL)
+#endif
+#ifndef HYPERRAM_VM_SIZE
+#define HYPERRAM_VM_SIZE                (0x00400000UL)
+#endif
+#define HYPERRAM_VM_BASE                (0x60000000UL + HYPERRAM_VM_OFFSET)
+
+/* MPU region number; higher numbers take precedence over the BSP regions */
+#ifndef HYPERRAM_VM_MPU_REGION
+#define HYPERRAM_VM_MPU_REGION          (15u)
+#endif
+
+/* MemManage priority: the lowest level, below the DMA completion interrupt */
+#ifndef HYPERRAM_VM_FAULT_PRIORITY
+#define HYPERRAM_VM_FAULT_PRIORITY      (7u)
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef struct
+{
+    uint32_t faults;            /* emulated instructions */
+    uint32_t reads;             /* element accesses, LDM/LDRD count each word */
+    uint32_t writes;
+    uint32_t hits;              /* faults served without a page fill */
+    uint32_t misses;
+    uint32_t hit_avg_ns;        /* fault entry to return */
+    uint32_t hit_max_ns;
+    uint32_t miss_avg_ns;
+    uint32_t miss_max_ns;
+    uint32_t unhandled;         /* faults that stopped the program */
+    uint32_t last_pc;           /* of the last unhandled fault */
+    uint32_t last_address;
+} hyperram_vm_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+hyperram_status_t hyperram_vm_init(void);
+hyperram_status_t hyperram_vm_disable(void);
+hyperram_status_t hyperram_vm_flush(void);
+void hyperram_vm_get_stats(hyperram_vm_stats_t* stats);
+void hyperram_vm_print_stats(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* HYPERRAM_VM_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,668 @@
+/*******************************************************************************
+* File Name:   kv_store.c
+*
+* Description: Key-value store with an SRAM open addressing index over HYPERRAM records,
+* see kv_store.h. Record i of the device range belongs to index slot i and
+* holds the key followed by the value, so the index can be rebuilt from
+* the device after a reset.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include "platform.h"
+#include "kv_store.h"
+#include "hyperram_dma.h"
+#include "dma_buffer.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+#define KV_SLOT_NONE                    (0xFFFFFFFFUL)
+#define KV_KEY_SIZE                     (sizeof(uint32_t))
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static bool kv_find(kv_store_t* store, uint32_t key, uint32_t* slot);
+static uint32_t kv_batch_find(const kv_store_t* store, uint32_t slot);
+static hyperram_status_t kv_stage(kv_store_t* store, uint32_t slot, uint32_t key, const void* value);
+static void* kv_record_ptr(const kv_store_t* store, uint32_t slot);
+
+/*******************************************************************************
+* Function Name: kv_store_init
+********************************************************************************
+* Summary:
+*  Sets up a store over a device range of kv_store_device_size() bytes.
+*  With format, the store starts empty and the range is cleared by DMA.
+*  Without it, the index is rebuilt from the keys already in the device.
+*  The SMIF must be in memory mode while the store is used.
+*
+* Parameters:
+*  store - store to initialize
+*  offset - device offset of the records, word aligned
+*  capacity - number of slots, a power of two
+*  value_size - bytes per value
+*  index - SRAM array of capacity words for the keys, kept by the caller
+*  format - true to erase the range, false to keep its contents
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM, or
+*                      HYPERRAM_ERROR if the batch buffer or DMA failed
+*
+*******************************************************************************/
+hyperram_status_t kv_store_init(kv_store_t* store, uint32_t offset, uint32_t capacity,
+                                uint32_t value_size, uint32_t* index, bool format)
+{
+    uint32_t record_size = KV_KEY_SIZE + ((value_size + 3u) & ~3u);
+    uint32_t size;
+
+    memset(store, 0, sizeof(*store));
+
+    if ((NULL == index) || (capacity < 2u) || (0u != (capacity & (capacity - 1u))) ||
+        (0u == value_size) || (record_size > KV_STORE_BATCH_SIZE) || (0u != (offset & 3u)) ||
+        (capacity > (HYPERRAM_SIZE / record_size)))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    size = capacity * record_size;
+    if ((offset > HYPERRAM_SIZE) || (size > (HYPERRAM_SIZE - offset)))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    if (HYPERRAM_SUCCESS != hyperram_dma_init())
+    {
+        return HYPERRAM_ERROR;
+    }
+
+    store->batch = (uint8_t*)dma_buffer_alloc(KV_STORE_BATCH_SIZE);
+    if (NULL == store->batch)
+    {
+        return HYPERRAM_ERROR;
+    }
+
+    store->offset = offset;
+    store->capacity = capacity;
+    store->value_size = value_size;
+    store->record_size = record_size;
+    store->index = index;
+    store->batch_limit = KV_STORE_BATCH_SIZE / record_size;
+    if (store->batch_limit > KV_STORE_BATCH_MAX)
+    {
+        store->batch_limit = KV_STORE_BATCH_MAX;
+    }
+
+    if (format)
+    {
+        memset(index, 0, capacity * sizeof(uint32_t));
+
+        return hyperram_dma_fill(hyperram_xip_ptr(offset), KV_STORE_KEY_EMPTY, size);
+    }
+
+    for (uint32_t slot = 0; slot < capacity; slot++)
+    {
+        memcpy(&index[slot], kv_record_ptr(store, slot), KV_KEY_SIZE);
+
+        if (KV_STORE_KEY_DELETED == index[slot])
+        {
+            store->stats.deleted++;
+        }
+        else if (KV_STORE_KEY_EMPTY != index[slot])
+        {
+            store->stats.count++;
+        }
+    }
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: kv_store_deinit
+********************************************************************************
+* Summary:
+*  Writes the batch back and returns its buffer to the pool.
+*
+* Parameters:
+*  store - store to release
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void kv_store_deinit(kv_store_t* store)
+{
+    (void)kv_store_flush(store);
+    dma_buffer_free(store->batch);
+    store->batch = NULL;
+}
+
+/*******************************************************************************
+* Function Name: kv_store_put
+********************************************************************************
+* Summary:
+*  Inserts or replaces a value. The index is updated at once; the record
+*  goes into the write batch, which is written back when it is full or by
+*  kv_store_flush().
+*
+* Parameters:
+*  store - store to update
+*  key - any value except KV_STORE_KEY_EMPTY and KV_STORE_KEY_DELETED
+*  value - value_size bytes
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, HYPERRAM_BAD_PARAM for a reserved
+*                      key, or HYPERRAM_ERROR if the store is full or a
+*                      batch write-back failed
+*
+*******************************************************************************/
+hyperram_status_t kv_store_put(kv_store_t* store, uint32_t key, const void* value)
+{
+    uint32_t slot;
+
+    if ((KV_STORE_KEY_EMPTY == key) || (KV_STORE_KEY_DELETED == key))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    store->stats.puts++;
+
+    if (!kv_find(store, key, &slot))
+    {
+        if (KV_SLOT_NONE == slot)
+        {
+            return HYPERRAM_ERROR;
+        }
+
+        if (KV_STORE_KEY_DELETED == store->index[slot])
+        {
+            store->stats.deleted--;
+        }
+        else if (((store->stats.count + store->stats.deleted + 1u) * 100u) >
+                 (store->capacity * KV_STORE_MAX_LOAD))
+        {
+            return HYPERRAM_ERROR;
+        }
+
+        store->index[slot] = key;
+        store->stats.count++;
+    }
+
+    return kv_stage(store, slot, key, value);
+}
+
+/*******************************************************************************
+* Function Name: kv_store_get
+********************************************************************************
+* Summary:
+*  Looks a key up in the SRAM index and reads its value with one DMA burst,
+*  or copies it from the write batch if it has not been written back yet.
+*
+* Parameters:
+*  store - store to search
+*  key - key to look up
+*  value - receives value_size bytes
+*
+* Return:
+*  bool - true if the key was found and its value read
+*
+*******************************************************************************/
+bool kv_store_get(kv_store_t* store, uint32_t key, void* value)
+{
+    uint32_t slot;
+    uint32_t entry;
+
+    store->stats.gets++;
+
+    if ((KV_STORE_KEY_EMPTY == key) || (KV_STORE_KEY_DELETED == key) || !kv_find(store, key, &slot))
+    {
+        store->stats.get_misses++;
+        return false;
+    }
+
+    entry = kv_batch_find(store, slot);
+    if (KV_SLOT_NONE != entry)
+    {
+        store->stats.batch_hits++;
+        memcpy(value, &store->batch[(entry * store->record_size) + KV_KEY_SIZE], store->value_size);
+        return true;
+    }
+
+    if (HYPERRAM_SUCCESS != hyperram_dma_copy(value, (uint8_t*)kv_record_ptr(store, slot) + KV_KEY_SIZE,
+                                              store->value_size))
+    {
+        store->stats.errors++;
+        return false;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: kv_store_delete
+********************************************************************************
+* Summary:
+*  Removes a key. Its slot is marked deleted, so that later keys in the
+*  same probe sequence stay reachable, and is reused by the next insert
+*  that passes it. A slot followed by an empty one is simply emptied.
+*
+* Parameters:
+*  store - store to update
+*  key - key to remove
+*
+* Return:
+*  bool - true if the key was present
+*
+*******************************************************************************/
+bool kv_store_delete(kv_store_t* store, uint32_t key)
+{
+    uint32_t mask = store->capacity - 1u;
+    uint32_t slot;
+
+    if ((KV_STORE_KEY_EMPTY == key) || (KV_STORE_KEY_DELETED == key) || !kv_find(store, key, &slot))
+    {
+        return false;
+    }
+
+    store->stats.deletes++;
+    store->stats.count--;
+
+    /* At the end of a probe run the slot can become empty again, together
+     * with the deleted slots just before it. Those keep their deleted mark
+     * in the device, which a rebuilt index merely carries over. */
+    if (KV_STORE_KEY_EMPTY == store->index[(slot + 1u) & mask])
+    {
+        uint32_t position = slot;
+
+        store->index[slot] = KV_STORE_KEY_EMPTY;
+        position = (position - 1u) & mask;
+        while ((KV_STORE_KEY_DELETED == store->index[position]) && (position != slot))
+        {
+            store->index[position] = KV_STORE_KEY_EMPTY;
+            store->stats.deleted--;
+            position = (position - 1u) & mask;
+        }
+
+        return (HYPERRAM_SUCCESS == kv_stage(store, slot, KV_STORE_KEY_EMPTY, NULL));
+    }
+
+    store->stats.deleted++;
+    store->index[slot] = KV_STORE_KEY_DELETED;
+
+    return (HYPERRAM_SUCCESS == kv_stage(store, slot, KV_STORE_KEY_DELETED, NULL));
+}
+
+/*******************************************************************************
+* Function Name: kv_store_flush
+********************************************************************************
+* Summary:
+*  Writes the batch back in slot order. Records that are adjacent both in
+*  the batch and in the device go out as one DMA transfer, so a bulk load
+*  of consecutive slots becomes a few long bursts.
+*
+* Parameters:
+*  store - store to flush
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS or HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t kv_store_flush(kv_store_t* store)
+{
+    uint8_t order[KV_STORE_BATCH_MAX];
+    hyperram_status_t status = HYPERRAM_SUCCESS;
+    uint32_t run;
+
+    if (0u == store->batch_count)
+    {
+        return HYPERRAM_SUCCESS;
+    }
+
+    /* Insertion sort of batch positions by slot */
+    for (uint32_t entry = 0; entry < store->batch_count; entry++)
+    {
+        uint32_t position = entry;
+
+        while ((position > 0u) && (store->batch_slots[order[position - 1u]] > store->batch_slots[entry]))
+        {
+            order[position] = order[position - 1u];
+            position--;
+        }
+        order[position] = (uint8_t)entry;
+    }
+
+    for (uint32_t first = 0; first < store->batch_count; first += run)
+    {
+        run = 1u;
+        while (((first + run) < store->batch_count) &&
+               (store->batch_slots[order[first + run]] == (store->batch_slots[order[first]] + run)) &&
+               (order[first + run] == (order[first] + run)))
+        {
+            run++;
+        }
+
+        store->stats.flush_bursts++;
+        if (HYPERRAM_SUCCESS != hyperram_dma_copy(kv_record_ptr(store, store->batch_slots[order[first]]),
+                                                  &store->batch[order[first] * store->record_size],
+                                                  run * store->record_size))
+        {
+            store->stats.errors++;
+            status = HYPERRAM_ERROR;
+        }
+    }
+
+    store->stats.flushes++;
+    store->batch_count = 0u;
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: kv_store_scan
+********************************************************************************
+* Summary:
+*  Finds a key by reading the keys of all records in device order, without
+*  the index. This is the cost of a table with no structure and serves as
+*  the benchmark baseline. The batch is written back first.
+*
+* Parameters:
+*  store - store to search
+*  key - key to look up
+*  value - receives value_size bytes
+*
+* Return:
+*  bool - true if the key was found
+*
+*******************************************************************************/
+bool kv_store_scan(kv_store_t* store, uint32_t key, void* value)
+{
+    if ((HYPERRAM_SUCCESS != kv_store_flush(store)) ||
+        (KV_STORE_KEY_EMPTY == key) || (KV_STORE_KEY_DELETED == key))
+    {
+        return false;
+    }
+
+    for (uint32_t slot = 0; slot < store->capacity; slot++)
+    {
+        const uint8_t* record = (const uint8_t*)kv_record_ptr(store, slot);
+        uint32_t stored;
+
+        memcpy(&stored, record, KV_KEY_SIZE);
+        if (stored == key)
+        {
+            memcpy(value, &record[KV_KEY_SIZE], store->value_size);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: kv_store_device_size
+********************************************************************************
+* Summary:
+*  Returns the device bytes a store occupies.
+*
+* Parameters:
+*  capacity - number of slots
+*  value_size - bytes per value
+*
+* Return:
+*  uint32_t - size of the record range
+*
+*******************************************************************************/
+uint32_t kv_store_device_size(uint32_t capacity, uint32_t value_size)
+{
+    return capacity * (KV_KEY_SIZE + ((value_size + 3u) & ~3u));
+}
+
+/*******************************************************************************
+* Function Name: kv_store_get_stats
+********************************************************************************
+* Summary:
+*  Returns the store counters.
+*
+* Parameters:
+*  store - store to query
+*  stats - filled with the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void kv_store_get_stats(const kv_store_t* store, kv_store_stats_t* stats)
+{
+    *stats = store->stats;
+}
+
+/*******************************************************************************
+* Function Name: kv_store_print_stats
+********************************************************************************
+* Summary:
+*  Prints the store counters.
+*
+* Parameters:
+*  store - store to report
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void kv_store_print_stats(const kv_store_t* store)
+{
+    const kv_store_stats_t* stats = &store->stats;
+    uint32_t lookups = stats->gets + stats->puts + stats->deletes;
+
+    PLATFORM_PRINTF("KV keys=%lu/%lu deleted=%lu gets=%lu misses=%lu batch_hits=%lu puts=%lu deletes=%lu\r\n",
+                    (unsigned long)stats->count, (unsigned long)store->capacity,
+                    (unsigned long)stats->deleted, (unsigned long)stats->gets,
+                    (unsigned long)stats->get_misses, (unsigned long)stats->batch_hits,
+                    (unsigned long)stats->puts, (unsigned long)stats->deletes);
+    PLATFORM_PRINTF("KV flushes=%lu bursts=%lu probes/op=%lu.%02lu max_probe=%lu errors=%lu\r\n",
+                    (unsigned long)stats->flushes, (unsigned long)stats->flush_bursts,
+                    (unsigned long)((0u != lookups) ? (stats->probes / lookups) : 0u),
+                    (unsigned long)((0u != lookups) ? (((stats->probes % lookups) * 100u) / lookups) : 0u),
+                    (unsigned long)stats->max_probe, (unsigned long)stats->errors);
+    PLATFORM_FLUSH();
+}
+
+/*******************************************************************************
+* Function Name: kv_find
+********************************************************************************
+* Summary:
+*  Linear probe for a key, starting at its Fibonacci hash.
+*
+* Parameters:
+*  store - store to search
+*  key - key to look up
+*  slot - the key's slot if found; otherwise the slot an insert would use
+*         (the first deleted slot passed, or the empty slot that ended the
+*         search), or KV_SLOT_NONE if the index has neither
+*
+* Return:
+*  bool - true if the key was found
+*
+*******************************************************************************/
+static bool kv_find(kv_store_t* store, uint32_t key, uint32_t* slot)
+{
+    uint32_t mask = store->capacity - 1u;
+    uint32_t hash = key * 2654435761UL;
+    uint32_t position = (hash ^ (hash >> 16)) & mask;
+    uint32_t insert = KV_SLOT_NONE;
+    uint32_t probe = 0u;
+    bool found = false;
+
+    while (probe < store->capacity)
+    {
+        uint32_t stored = store->index[position];
+
+        probe++;
+
+        if (stored == key)
+        {
+            insert = position;
+            found = true;
+            break;
+        }
+        if (KV_STORE_KEY_EMPTY == stored)
+        {
+            if (KV_SLOT_NONE == insert)
+            {
+                insert = position;
+            }
+            break;
+        }
+        if ((KV_STORE_KEY_DELETED == stored) && (KV_SLOT_NONE == insert))
+        {
+            insert = position;
+        }
+
+        position = (position + 1u) & mask;
+    }
+
+    store->stats.probes += probe;
+    if (probe > store->stats.max_probe)
+    {
+        store->stats.max_probe = probe;
+    }
+
+    *slot = insert;
+
+    return found;
+}
+
+/*******************************************************************************
+* Function Name: kv_batch_find
+********************************************************************************
+* Summary:
+*  Returns the batch position holding a slot.
+*
+* Parameters:
+*  store - store to search
+*  slot - index slot
+*
+* Return:
+*  uint32_t - batch position, or KV_SLOT_NONE
+*
+*******************************************************************************/
+static uint32_t kv_batch_find(const kv_store_t* store, uint32_t slot)
+{
+    for (uint32_t entry = 0; entry < store->batch_count; entry++)
+    {
+        if (store->batch_slots[entry] == slot)
+        {
+            return entry;
+        }
+    }
+
+    return KV_SLOT_NONE;
+}
+
+/*******************************************************************************
+* Function Name: kv_stage
+********************************************************************************
+* Summary:
+*  Puts a record into the write batch, replacing an earlier one for the
+*  same slot. A full batch is written back first.
+*
+* Parameters:
+*  store - store to update
+*  slot - index slot
+*  key - key to store
+*  value - value_size bytes, or NULL for zeros
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, or the write-back error
+*
+*******************************************************************************/
+static hyperram_status_t kv_stage(kv_store_t* store, uint32_t slot, uint32_t key, const void* value)
+{
+    hyperram_status_t status = HYPERRAM_SUCCESS;
+    uint32_t entry = kv_batch_find(store, slot);
+    uint8_t* record;
+
+    if (KV_SLOT_NONE == entry)
+    {
+        if (store->batch_count == store->batch_limit)
+        {
+            status = kv_store_flush(store);
+        }
+
+        entry = store->batch_count;
+        store->batch_slots[entry] = slot;
+        store->batch_count++;
+    }
+
+    record = &store->batch[entry * store->record_size];
+    memcpy(record, &key, KV_KEY_SIZE);
+    if (NULL != value)
+    {
+        memcpy(&record[KV_KEY_SIZE], value, store->value_size);
+    }
+    else
+    {
+        memset(&record[KV_KEY_SIZE], 0, store->value_size);
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: kv_record_ptr
+********************************************************************************
+* Summary:
+*  Returns the XIP address of a slot's record.
+*
+* Parameters:
+*  store - store
+*  slot - index slot
+*
+* Return:
+*  void* - record address
+*
+*******************************************************************************/
+static void* kv_record_ptr(const kv_store_t* store, uint32_t slot)
+{
+    return hyperram_xip_ptr(store->offset + (slot * store->record_size));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,128 @@
+/*******************************************************************************
+* File Name:   kv_store.h
+*
+* Description: Key-value store for fixed-size records in the HYPERRAM. An open
+* addressing index in SRAM holds the keys; the values sit in the device at
+* the position of their key in the index, so a lookup is one burst read.
+* Writes are collected in an SRAM batch and written back in slot order.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef KV_STORE_H
+#define KV_STORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hyperram.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* Reserved keys: an empty slot and a deleted one */
+#define KV_STORE_KEY_EMPTY              (0x00000000UL)
+#define KV_STORE_KEY_DELETED            (0xFFFFFFFFUL)
+
+/* Write batch, taken from the DMA buffer pool */
+#ifndef KV_STORE_BATCH_SIZE
+#define KV_STORE_BATCH_SIZE             (4096u)
+#endif
+#define KV_STORE_BATCH_MAX              (64u)
+
+/* Inserts fail beyond this fill level (keys plus deleted slots), in percent */
+#define KV_STORE_MAX_LOAD               (75u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef struct
+{
+    uint32_t gets;
+    uint32_t get_misses;        /* key not present */
+    uint32_t batch_hits;        /* gets served from the write batch */
+    uint32_t puts;
+    uint32_t deletes;
+    uint32_t flushes;
+    uint32_t flush_bursts;      /* DMA transfers issued by the flushes */
+    uint32_t errors;            /* failed DMA transfers */
+    uint32_t probes;            /* index slots inspected, all operations */
+    uint32_t max_probe;
+    uint32_t count;             /* keys stored */
+    uint32_t deleted;           /* slots holding KV_STORE_KEY_DELETED */
+} kv_store_stats_t;
+
+/* All fields are private */
+typedef struct
+{
+    uint32_t offset;
+    uint32_t capacity;          /* slots, a power of two */
+    uint32_t value_size;
+    uint32_t record_size;       /* key plus value, word aligned */
+    uint32_t* index;            /* capacity keys, owned by the caller */
+    uint8_t* batch;
+    uint32_t batch_slots[KV_STORE_BATCH_MAX];
+    uint32_t batch_count;
+    uint32_t batch_limit;
+    kv_store_stats_t stats;
+} kv_store_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+hyperram_status_t kv_store_init(kv_store_t* store, uint32_t offset, uint32_t capacity,
+                                uint32_t value_size, uint32_t* index, bool format);
+void kv_store_deinit(kv_store_t* store);
+hyperram_status_t kv_store_put(kv_store_t* store, uint32_t key, const void* value);
+bool kv_store_get(kv_store_t* store, uint32_t key, void* value);
+bool kv_store_delete(kv_store_t* store, uint32_t key);
+hyperram_status_t kv_store_flush(kv_store_t* store);
+bool kv_store_scan(kv_store_t* store, uint32_t key, void* value);
+uint32_t kv_store_device_size(uint32_t capacity, uint32_t value_size);
+void kv_store_get_stats(const kv_store_t* store, kv_store_stats_t* stats);
+void kv_store_print_stats(const kv_store_t* store);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* KV_STORE_H */
+
+/* [] END OF FILE */
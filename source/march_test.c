@@ -0,0 +1,739 @@
+/*******************************************************************************
+* File Name:   march_test.c
+*
+* Description: Destructive memory test engine. March elements are applied per
+* MARCH_TEST_CHUNK unit: each unit is read into SRAM by DMA, the DMA
+* fill of the next value is started, and the CPU checks the data read
+* while the fill runs. Address and data line tests use single word
+* accesses through the XIP window.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include "platform.h"
+#include "march_test.h"
+#include "hyperram_dma.h"
+#include "perf_counter.h"
+#include "simd_ops.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+#define MARCH_CHUNK_WORDS               (MARCH_TEST_CHUNK / sizeof(uint32_t))
+
+/* Data backgrounds written as "0" and "1" by the March elements */
+#define MARCH_BACKGROUND_0              (0x00000000UL)
+#define MARCH_BACKGROUND_1              (0xFFFFFFFFUL)
+
+/* Address line test values */
+#define MARCH_ADDR_PATTERN              (0xAAAAAAAAUL)
+#define MARCH_ADDR_ANTIPATTERN          (0x55555555UL)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef enum
+{
+    MARCH_OP_NONE,
+    MARCH_OP_0,
+    MARCH_OP_1,
+} march_op_t;
+
+/* One March element: optional read of the expected value, then optional
+ * write of the new one, applied to every unit in address order */
+typedef struct
+{
+    bool descending;
+    march_op_t read;
+    march_op_t write;
+} march_element_t;
+
+typedef struct
+{
+    const char* name;
+    const march_element_t* elements;
+    uint32_t count;
+} march_algorithm_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static hyperram_status_t march_data_lines(uint32_t offset);
+static hyperram_status_t march_address_lines(uint32_t offset, uint32_t size);
+static hyperram_status_t march_algorithm(const march_algorithm_t* algorithm, uint32_t offset, uint32_t size);
+static hyperram_status_t march_element(const march_element_t* element, uint32_t offset, uint32_t size);
+static hyperram_status_t march_prbs(uint32_t offset, uint32_t size, uint32_t seed);
+static void march_prbs_check(const uint32_t* words, uint32_t address, uint32_t* state);
+static void march_check_value(const uint32_t* words, uint32_t address, uint32_t expected);
+static void march_poke(uint32_t address, uint32_t value);
+static uint32_t march_peek(uint32_t address);
+static void march_fail(uint32_t address, uint32_t expected, uint32_t actual);
+static void march_clock_tick(void);
+static void march_report_test(const char* name, uint64_t ns, uint64_t bytes, uint32_t errors);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+static const march_element_t march_c_minus_elements[] =
+{
+    { false, MARCH_OP_NONE, MARCH_OP_0    },
+    { false, MARCH_OP_0,    MARCH_OP_1    },
+    { false, MARCH_OP_1,    MARCH_OP_0    },
+    { true,  MARCH_OP_0,    MARCH_OP_1    },
+    { true,  MARCH_OP_1,    MARCH_OP_0    },
+    { false, MARCH_OP_0,    MARCH_OP_NONE },
+};
+
+static const march_element_t march_x_elements[] =
+{
+    { false, MARCH_OP_NONE, MARCH_OP_0    },
+    { false, MARCH_OP_0,    MARCH_OP_1    },
+    { true,  MARCH_OP_1,    MARCH_OP_0    },
+    { false, MARCH_OP_0,    MARCH_OP_NONE },
+};
+
+static const march_algorithm_t march_c_minus =
+{
+    "march_c-", march_c_minus_elements, sizeof(march_c_minus_elements) / sizeof(march_c_minus_elements[0])
+};
+
+static const march_algorithm_t march_x =
+{
+    "march_x", march_x_elements, sizeof(march_x_elements) / sizeof(march_x_elements[0])
+};
+
+CY_ALIGN(PLATFORM_CACHE_LINE) static uint32_t march_buffers[2][MARCH_CHUNK_WORDS];
+static march_test_result_t* march_result;
+static const char* march_current;
+static uint32_t march_clock_last;
+static uint64_t march_clock_ns;
+
+/*******************************************************************************
+* Function Name: march_test_run
+********************************************************************************
+* Summary:
+*  Runs the selected tests over a device range and prints one line per
+*  test and a MARCH-RESULT summary. All data in the range is destroyed.
+*  The device is left in memory mode.
+*
+* Parameters:
+*  offset - device offset of the range, a multiple of MARCH_TEST_CHUNK
+*  size - range size, a multiple of MARCH_TEST_CHUNK
+*  tests - MARCH_TEST_* flags
+*  seed - seed of the pseudo-random pattern
+*  result - receives the failures found and the time taken
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS if the range passed,
+*                      HYPERRAM_BAD_PARAM, or HYPERRAM_ERROR if a test
+*                      failed or a DMA transfer did not complete
+*
+*******************************************************************************/
+hyperram_status_t march_test_run(uint32_t offset, uint32_t size, uint32_t tests, uint32_t seed,
+                                 march_test_result_t* result)
+{
+    hyperram_status_t status = HYPERRAM_SUCCESS;
+    uint32_t errors;
+    uint64_t start_ns;
+    uint64_t start_bytes;
+
+    memset(result, 0, sizeof(*result));
+
+    if ((0u == size) || (0u != ((offset | size) % MARCH_TEST_CHUNK)) ||
+        (offset > HYPERRAM_SIZE) || (size > (HYPERRAM_SIZE - offset)))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    perf_counter_init();
+    if (HYPERRAM_SUCCESS != hyperram_dma_init())
+    {
+        return HYPERRAM_ERROR;
+    }
+    hyperram_enter_xip();
+
+    march_result = result;
+    march_clock_ns = 0u;
+    march_clock_last = perf_counter_now();
+
+    PLATFORM_PRINTF("\r\nMARCH range 0x%08lX-0x%08lX (%lu KB)\r\n", (unsigned long)offset,
+                    (unsigned long)(offset + size - 1u), (unsigned long)(size / 1024u));
+
+    for (uint32_t test = MARCH_TEST_DATA_LINES; (0u != (test & MARCH_TEST_ALL)) && (HYPERRAM_SUCCESS == status);
+         test <<= 1)
+    {
+        if (0u == (tests & test))
+        {
+            continue;
+        }
+
+        errors = result->errors;
+        start_ns = march_clock_ns;
+        start_bytes = result->bytes;
+
+        switch (test)
+        {
+            case MARCH_TEST_DATA_LINES:
+                march_current = "data_lines";
+                status = march_data_lines(offset);
+                break;
+
+            case MARCH_TEST_ADDRESS_LINES:
+                march_current = "address_lines";
+                status = march_address_lines(offset, size);
+                break;
+
+            case MARCH_TEST_MARCH_C_MINUS:
+                march_current = march_c_minus.name;
+                status = march_algorithm(&march_c_minus, offset, size);
+                break;
+
+            case MARCH_TEST_MARCH_X:
+                march_current = march_x.name;
+                status = march_algorithm(&march_x, offset, size);
+                break;
+
+            default:
+                march_current = "prbs";
+                status = march_prbs(offset, size, seed);
+                break;
+        }
+
+        march_clock_tick();
+        march_report_test(march_current, march_clock_ns - start_ns, result->bytes - start_bytes,
+                          result->errors - errors);
+    }
+
+    /* Each byte of a word travels over DQ[7:0] */
+    result->data_lines = (result->failed_bits | (result->failed_bits >> 8) |
+                          (result->failed_bits >> 16) | (result->failed_bits >> 24)) & 0xFFu;
+    result->elapsed_ms = (uint32_t)(march_clock_ns / 1000000u);
+
+    if (0u != result->errors)
+    {
+        status = HYPERRAM_ERROR;
+    }
+
+    PLATFORM_PRINTF("MARCH-RESULT %s errors=%lu first=0x%08lX bits=0x%08lX dq=0x%02lX address_lines=0x%08lX "
+                    "time=%lu ms%s\r\n",
+                    (HYPERRAM_SUCCESS == status) ? "PASS" : "FAIL", (unsigned long)result->errors,
+                    (unsigned long)result->first_fail, (unsigned long)result->failed_bits,
+                    (unsigned long)result->data_lines, (unsigned long)result->address_lines,
+                    (unsigned long)result->elapsed_ms,
+                    ((HYPERRAM_SUCCESS != status) && (0u == result->errors)) ? " (DMA failure)" : "");
+    PLATFORM_FLUSH();
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: march_data_lines
+********************************************************************************
+* Summary:
+*  Walks a one and then a zero through a word at the start of the range.
+*  A line that is stuck or shorted to a neighbour shows up in failed_bits.
+*
+* Parameters:
+*  offset - device offset of the test word
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS
+*
+*******************************************************************************/
+static hyperram_status_t march_data_lines(uint32_t offset)
+{
+    for (uint32_t bit = 0; bit < 32u; bit++)
+    {
+        uint32_t ones = 1UL << bit;
+        uint32_t value;
+
+        march_poke(offset, ones);
+        value = march_peek(offset);
+        if (value != ones)
+        {
+            march_fail(offset, ones, value);
+        }
+
+        march_poke(offset, ~ones);
+        value = march_peek(offset);
+        if (value != ~ones)
+        {
+            march_fail(offset, ~ones, value);
+        }
+    }
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: march_address_lines
+********************************************************************************
+* Summary:
+*  Checks each address line above the word boundary for stuck-high,
+*  stuck-low and shorted lines. A pattern is written at every power-of-two
+*  offset; then each of those words in turn is changed and all the others
+*  must keep the pattern. Lines at or above the lowest set bit of offset
+*  are not tested, because the range does not toggle them on its own.
+*
+* Parameters:
+*  offset - device offset of the range
+*  size - range size
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS
+*
+*******************************************************************************/
+static hyperram_status_t march_address_lines(uint32_t offset, uint32_t size)
+{
+    uint32_t limit = size;
+
+    if ((0u != offset) && ((offset & (0u - offset)) < limit))
+    {
+        limit = offset & (0u - offset);
+    }
+
+    for (uint32_t step = sizeof(uint32_t); step < limit; step <<= 1)
+    {
+        march_poke(offset + step, MARCH_ADDR_PATTERN);
+    }
+
+    /* Stuck high: the base write shows up at a power-of-two offset */
+    march_poke(offset, MARCH_ADDR_ANTIPATTERN);
+    for (uint32_t step = sizeof(uint32_t); step < limit; step <<= 1)
+    {
+        uint32_t value = march_peek(offset + step);
+
+        if (MARCH_ADDR_PATTERN != value)
+        {
+            march_result->address_lines |= step;
+            march_fail(offset + step, MARCH_ADDR_PATTERN, value);
+        }
+    }
+    march_poke(offset, MARCH_ADDR_PATTERN);
+
+    /* Stuck low or shorted: a write to one offset shows up at another */
+    for (uint32_t test = sizeof(uint32_t); test < limit; test <<= 1)
+    {
+        uint32_t value;
+
+        march_poke(offset + test, MARCH_ADDR_ANTIPATTERN);
+
+        value = march_peek(offset);
+        if (MARCH_ADDR_PATTERN != value)
+        {
+            march_result->address_lines |= test;
+            march_fail(offset, MARCH_ADDR_PATTERN, value);
+        }
+
+        for (uint32_t step = sizeof(uint32_t); step < limit; step <<= 1)
+        {
+            value = march_peek(offset + step);
+            if ((step != test) && (MARCH_ADDR_PATTERN != value))
+            {
+                march_result->address_lines |= test | step;
+                march_fail(offset + step, MARCH_ADDR_PATTERN, value);
+            }
+        }
+
+        march_poke(offset + test, MARCH_ADDR_PATTERN);
+    }
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: march_algorithm
+********************************************************************************
+* Summary:
+*  Applies the elements of a March algorithm in order.
+*
+* Parameters:
+*  algorithm - March algorithm
+*  offset - device offset of the range
+*  size - range size
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, or HYPERRAM_ERROR if a DMA
+*                      transfer failed
+*
+*******************************************************************************/
+static hyperram_status_t march_algorithm(const march_algorithm_t* algorithm, uint32_t offset, uint32_t size)
+{
+    hyperram_status_t status = HYPERRAM_SUCCESS;
+
+    for (uint32_t index = 0; (index < algorithm->count) && (HYPERRAM_SUCCESS == status); index++)
+    {
+        status = march_element(&algorithm->elements[index], offset, size);
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: march_element
+********************************************************************************
+* Summary:
+*  Applies one March element unit by unit. A unit is read into SRAM, the
+*  fill with the new value is started, and the data read is checked while
+*  the fill runs, so the device sees back-to-back bursts.
+*
+* Parameters:
+*  element - element to apply
+*  offset - device offset of the range
+*  size - range size
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, or HYPERRAM_ERROR if a DMA
+*                      transfer failed
+*
+*******************************************************************************/
+static hyperram_status_t march_element(const march_element_t* element, uint32_t offset, uint32_t size)
+{
+    uint32_t units = size / MARCH_TEST_CHUNK;
+    uint32_t read_value = (MARCH_OP_1 == element->read) ? MARCH_BACKGROUND_1 : MARCH_BACKGROUND_0;
+    uint32_t write_value = (MARCH_OP_1 == element->write) ? MARCH_BACKGROUND_1 : MARCH_BACKGROUND_0;
+
+    for (uint32_t index = 0; index < units; index++)
+    {
+        uint32_t unit = element->descending ? (units - 1u - index) : index;
+        uint32_t address = offset + (unit * MARCH_TEST_CHUNK);
+        void* xip = hyperram_xip_ptr(address);
+
+        if (MARCH_OP_NONE != element->read)
+        {
+            if (HYPERRAM_SUCCESS != hyperram_dma_copy(march_buffers[0], xip, MARCH_TEST_CHUNK))
+            {
+                return HYPERRAM_ERROR;
+            }
+            march_result->bytes += MARCH_TEST_CHUNK;
+        }
+
+        if (MARCH_OP_NONE != element->write)
+        {
+            if (HYPERRAM_SUCCESS != hyperram_dma_fill_async(xip, write_value, MARCH_TEST_CHUNK, NULL, NULL))
+            {
+                return HYPERRAM_ERROR;
+            }
+            march_result->bytes += MARCH_TEST_CHUNK;
+        }
+
+        if (MARCH_OP_NONE != element->read)
+        {
+            march_check_value(march_buffers[0], address, read_value);
+        }
+
+        if (MARCH_OP_NONE != element->write)
+        {
+            hyperram_dma_wait();
+            if (HYPERRAM_SUCCESS != hyperram_dma_get_result())
+            {
+                return HYPERRAM_ERROR;
+            }
+        }
+
+        march_clock_tick();
+    }
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: march_prbs
+********************************************************************************
+* Summary:
+*  Writes a pseudo-random pattern over the range with the DMA pattern fill
+*  and reads it back. Every word differs from its neighbours, which
+*  exercises the data lines with random transitions and catches aliased
+*  addresses. Each unit is checked while the DMA reads the next one.
+*
+* Parameters:
+*  offset - device offset of the range
+*  size - range size
+*  seed - pattern seed
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, or HYPERRAM_ERROR if a DMA
+*                      transfer failed
+*
+*******************************************************************************/
+static hyperram_status_t march_prbs(uint32_t offset, uint32_t size, uint32_t seed)
+{
+    uint32_t units = size / MARCH_TEST_CHUNK;
+    uint32_t state = (0u != seed) ? seed : 1u;
+
+    /* The fill engine generates the same xorshift32 sequence */
+    if (HYPERRAM_SUCCESS != hyperram_dma_pattern_fill(hyperram_xip_ptr(offset), HYPERRAM_DMA_PATTERN_LFSR,
+                                                      state, size))
+    {
+        return HYPERRAM_ERROR;
+    }
+    march_result->bytes += size;
+    march_clock_tick();
+
+    if (HYPERRAM_SUCCESS != hyperram_dma_copy(march_buffers[0], hyperram_xip_ptr(offset), MARCH_TEST_CHUNK))
+    {
+        return HYPERRAM_ERROR;
+    }
+
+    for (uint32_t unit = 0; unit < units; unit++)
+    {
+        uint32_t address = offset + (unit * MARCH_TEST_CHUNK);
+        bool more = ((unit + 1u) < units);
+
+        if (more && (HYPERRAM_SUCCESS != hyperram_dma_copy_async(march_buffers[(unit + 1u) & 1u],
+                                                                 hyperram_xip_ptr(address + MARCH_TEST_CHUNK),
+                                                                 MARCH_TEST_CHUNK, NULL, NULL)))
+        {
+            return HYPERRAM_ERROR;
+        }
+
+        march_prbs_check(march_buffers[unit & 1u], address, &state);
+        march_result->bytes += MARCH_TEST_CHUNK;
+
+        if (more)
+        {
+            hyperram_dma_wait();
+            if (HYPERRAM_SUCCESS != hyperram_dma_get_result())
+            {
+                return HYPERRAM_ERROR;
+            }
+        }
+        march_clock_tick();
+    }
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: march_prbs_check
+********************************************************************************
+* Summary:
+*  Checks one unit against the next words of the xorshift32 pattern.
+*
+* Parameters:
+*  words - data read
+*  address - device offset of the unit
+*  state - generator state, advanced
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void march_prbs_check(const uint32_t* words, uint32_t address, uint32_t* state)
+{
+    uint32_t x = *state;
+
+    for (uint32_t index = 0; index < MARCH_CHUNK_WORDS; index++)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        if (words[index] != x)
+        {
+            march_fail(address + (index * sizeof(uint32_t)), x, words[index]);
+        }
+    }
+
+    *state = x;
+}
+
+/*******************************************************************************
+* Function Name: march_check_value
+********************************************************************************
+* Summary:
+*  Checks that every word of a unit holds the expected value. Matching
+*  lines are skipped a line at a time.
+*
+* Parameters:
+*  words - data read
+*  address - device offset of the unit
+*  expected - expected word
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void march_check_value(const uint32_t* words, uint32_t address, uint32_t expected)
+{
+    uint32_t index = 0u;
+
+    while (index < MARCH_CHUNK_WORDS)
+    {
+        index += simd_first_not(&words[index], (MARCH_CHUNK_WORDS - index) * sizeof(uint32_t),
+                                expected) / sizeof(uint32_t);
+
+        if (index < MARCH_CHUNK_WORDS)
+        {
+            march_fail(address + (index * sizeof(uint32_t)), expected, words[index]);
+            index++;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: march_poke
+********************************************************************************
+* Summary:
+*  Writes one word through the XIP window and pushes it out of the cache.
+*
+* Parameters:
+*  address - device offset, word aligned
+*  value - word to write
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void march_poke(uint32_t address, uint32_t value)
+{
+    volatile uint32_t* word = (volatile uint32_t*)hyperram_xip_ptr(address);
+
+    *word = value;
+    platform_dcache_clean(word, sizeof(uint32_t));
+    march_result->bytes += sizeof(uint32_t);
+}
+
+/*******************************************************************************
+* Function Name: march_peek
+********************************************************************************
+* Summary:
+*  Reads one word from the device, bypassing any cached copy.
+*
+* Parameters:
+*  address - device offset, word aligned
+*
+* Return:
+*  uint32_t - word read
+*
+*******************************************************************************/
+static uint32_t march_peek(uint32_t address)
+{
+    volatile uint32_t* word = (volatile uint32_t*)hyperram_xip_ptr(address);
+
+    platform_dcache_invalidate(word, sizeof(uint32_t));
+    march_result->bytes += sizeof(uint32_t);
+
+    return *word;
+}
+
+/*******************************************************************************
+* Function Name: march_fail
+********************************************************************************
+* Summary:
+*  Records a failing word and prints the first MARCH_TEST_MAX_LOGGED.
+*
+* Parameters:
+*  address - device offset of the word
+*  expected - value written
+*  actual - value read
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void march_fail(uint32_t address, uint32_t expected, uint32_t actual)
+{
+    if (0u == march_result->errors)
+    {
+        march_result->first_fail = address;
+    }
+
+    march_result->errors++;
+    march_result->failed_bits |= expected ^ actual;
+
+    if (march_result->errors <= MARCH_TEST_MAX_LOGGED)
+    {
+        PLATFORM_PRINTF("MARCH %s fail at 0x%08lX: expected 0x%08lX read 0x%08lX\r\n", march_current,
+                        (unsigned long)address, (unsigned long)expected, (unsigned long)actual);
+    }
+}
+
+/*******************************************************************************
+* Function Name: march_clock_tick
+********************************************************************************
+* Summary:
+*  Adds the time since the last tick to the run time. Called once per unit,
+*  so the 32-bit counter never wraps between two ticks.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void march_clock_tick(void)
+{
+    uint32_t now = perf_counter_now();
+
+    march_clock_ns += perf_counter_to_ns(now - march_clock_last);
+    march_clock_last = now;
+}
+
+/*******************************************************************************
+* Function Name: march_report_test
+********************************************************************************
+* Summary:
+*  Prints the time, throughput and failures of one test.
+*
+* Parameters:
+*  name - test name
+*  ns - time taken
+*  bytes - bytes moved to and from the device
+*  errors - failing words found
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void march_report_test(const char* name, uint64_t ns, uint64_t bytes, uint32_t errors)
+{
+    uint32_t mbps = (0u != ns) ? (uint32_t)((bytes * 1000u) / ns) : 0u;
+
+    PLATFORM_PRINTF("MARCH %-14s %7lu.%03lu ms %6lu MB/s errors=%lu\r\n", name,
+                    (unsigned long)(ns / 1000000u), (unsigned long)((ns / 1000u) % 1000u),
+                    (unsigned long)mbps, (unsigned long)errors);
+    PLATFORM_FLUSH();
+}
+
+/* [] END OF FILE */
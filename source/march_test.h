@@ -0,0 +1,102 @@
+/*******************************************************************************
+* File Name:   march_test.h
+*
+* Description: Destructive full-device memory test for board bring-up and production:
+* walking-ones data and address line tests, March C- and March X, and a
+* pseudo-random pattern pass. The March and pattern passes move the data
+* by DMA in large bursts and check it while the next transfer runs.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef MARCH_TEST_H
+#define MARCH_TEST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hyperram.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* Tests selected by march_test_run() */
+#define MARCH_TEST_DATA_LINES           (1UL << 0)
+#define MARCH_TEST_ADDRESS_LINES        (1UL << 1)
+#define MARCH_TEST_MARCH_C_MINUS        (1UL << 2)
+#define MARCH_TEST_MARCH_X              (1UL << 3)
+#define MARCH_TEST_PRBS                 (1UL << 4)
+#define MARCH_TEST_ALL                  (0x1FUL)
+
+/* Transfer unit of the March elements; address order is applied per unit */
+#ifndef MARCH_TEST_CHUNK
+#define MARCH_TEST_CHUNK                (16384u)
+#endif
+
+/* Failing words printed before only the counters are updated */
+#define MARCH_TEST_MAX_LOGGED           (16u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef struct
+{
+    uint32_t errors;            /* failing words, all tests */
+    uint32_t first_fail;        /* device offset of the first one */
+    uint32_t failed_bits;       /* OR of expected ^ read over all failures */
+    uint32_t data_lines;        /* failing DQ lines, bit n for DQn */
+    uint32_t address_lines;     /* failing byte address bits */
+    uint64_t bytes;             /* moved to and from the device */
+    uint32_t elapsed_ms;
+} march_test_result_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+hyperram_status_t march_test_run(uint32_t offset, uint32_t size, uint32_t tests, uint32_t seed,
+                                 march_test_result_t* result);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* MARCH_TEST_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,298 @@
+/*******************************************************************************
+* File Name:   mpu_bench.c
+*
+* Description: Times word loads and stores to the HYPERRAM benchmark region under each
+* MPU cache policy. Results are named mpu:<policy>/<pattern>/<cold|warm>.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "platform.h"
+#include "mpu_bench.h"
+#include "hyperram_mpu.h"
+#include "benchmark.h"
+#include "hyperram.h"
+#include <stdio.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* One MPU region over the largest benchmark size */
+#define MPU_BENCH_SLOT                  (0u)
+#define MPU_BENCH_REGION_SIZE           (BENCH_MAX_SIZE)
+#define MPU_BENCH_NAME_SIZE             (48u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef struct
+{
+    const char* name;
+    bench_op_t op;
+} mpu_bench_pattern_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static bool mpu_bench_prepare(uint32_t size);
+static bool mpu_bench_seq_read(uint32_t size);
+static bool mpu_bench_seq_write(uint32_t size);
+static bool mpu_bench_rand_read(uint32_t size);
+static bool mpu_bench_rand_write(uint32_t size);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+static const mpu_bench_pattern_t mpu_bench_patterns[] =
+{
+    { "seq_read",   mpu_bench_seq_read   },
+    { "seq_write",  mpu_bench_seq_write  },
+    { "rand_read",  mpu_bench_rand_read  },
+    { "rand_write", mpu_bench_rand_write },
+};
+
+/* 4 KB fits in the D-cache, 64 KB does not */
+static const uint32_t mpu_bench_sizes[] = { 4096u, 65536u };
+
+static volatile uint32_t mpu_bench_sink;
+static const mpu_bench_pattern_t* mpu_bench_pattern;
+static bool mpu_bench_warm;
+
+/*******************************************************************************
+* Function Name: mpu_bench_suite
+********************************************************************************
+* Summary:
+*  Applies each cache policy to the benchmark region and times every access
+*  pattern cold (region dropped from the D-cache before each run) and warm
+*  (pattern run once untimed before each run). The region returns to the
+*  default memory map afterwards.
+*
+* Parameters:
+*  iterations - timed iterations per result
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void mpu_bench_suite(uint32_t iterations)
+{
+    char name[MPU_BENCH_NAME_SIZE];
+    bench_case_t bench_case = { NULL, mpu_bench_prepare, NULL };
+    bench_result_t result;
+
+    hyperram_enter_xip();
+
+    for (uint32_t policy = 0; policy < (uint32_t)HYPERRAM_MPU_POLICIES; policy++)
+    {
+        if (HYPERRAM_SUCCESS != hyperram_mpu_set_region(MPU_BENCH_SLOT, BENCH_DEVICE_OFFSET,
+                                                        MPU_BENCH_REGION_SIZE,
+                                                        (hyperram_mpu_policy_t)policy))
+        {
+            continue;
+        }
+
+        for (uint32_t pattern = 0; pattern < (sizeof(mpu_bench_patterns) / sizeof(mpu_bench_patterns[0])); pattern++)
+        {
+            mpu_bench_pattern = &mpu_bench_patterns[pattern];
+            bench_case.op = mpu_bench_pattern->op;
+
+            for (uint32_t warm = 0; warm < 2u; warm++)
+            {
+                mpu_bench_warm = (0u != warm);
+                (void)snprintf(name, sizeof(name), "mpu:%s/%s/%s",
+                               hyperram_mpu_policy_name((hyperram_mpu_policy_t)policy),
+                               mpu_bench_pattern->name, mpu_bench_warm ? "warm" : "cold");
+                bench_case.name = name;
+
+                for (uint32_t size = 0; size < (sizeof(mpu_bench_sizes) / sizeof(mpu_bench_sizes[0])); size++)
+                {
+                    (void)benchmark_measure(&bench_case, mpu_bench_sizes[size], iterations, &result);
+                    benchmark_report_result(&result);
+                }
+            }
+        }
+    }
+
+    hyperram_mpu_clear_region(MPU_BENCH_SLOT);
+}
+
+/*******************************************************************************
+* Function Name: mpu_bench_prepare
+********************************************************************************
+* Summary:
+*  Drops the region from the D-cache, then for the warm runs executes the
+*  pattern once so the timed run starts with whatever the policy kept.
+*
+* Parameters:
+*  size - bytes the next iteration touches
+*
+* Return:
+*  bool - result of the warm-up run, or true
+*
+*******************************************************************************/
+static bool mpu_bench_prepare(uint32_t size)
+{
+    platform_dcache_clean_invalidate(hyperram_xip_ptr(BENCH_DEVICE_OFFSET), MPU_BENCH_REGION_SIZE);
+
+    return mpu_bench_warm ? mpu_bench_pattern->op(size) : true;
+}
+
+/*******************************************************************************
+* Function Name: mpu_bench_seq_read
+********************************************************************************
+* Summary:
+*  Loads every word of the range in address order.
+*
+* Parameters:
+*  size - bytes to read
+*
+* Return:
+*  bool - true
+*
+*******************************************************************************/
+static bool mpu_bench_seq_read(uint32_t size)
+{
+    const volatile uint32_t* words = (const volatile uint32_t*)hyperram_xip_ptr(BENCH_DEVICE_OFFSET);
+    uint32_t sum = 0u;
+
+    for (uint32_t index = 0; index < (size / sizeof(uint32_t)); index++)
+    {
+        sum += words[index];
+    }
+    mpu_bench_sink = sum;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: mpu_bench_seq_write
+********************************************************************************
+* Summary:
+*  Stores every word of the range in address order. The D-cache is cleaned
+*  so the data reaches the device inside the timed region.
+*
+* Parameters:
+*  size - bytes to write
+*
+* Return:
+*  bool - true
+*
+*******************************************************************************/
+static bool mpu_bench_seq_write(uint32_t size)
+{
+    volatile uint32_t* words = (volatile uint32_t*)hyperram_xip_ptr(BENCH_DEVICE_OFFSET);
+
+    for (uint32_t index = 0; index < (size / sizeof(uint32_t)); index++)
+    {
+        words[index] = index;
+    }
+
+    platform_dcache_clean(hyperram_xip_ptr(BENCH_DEVICE_OFFSET), size);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: mpu_bench_rand_read
+********************************************************************************
+* Summary:
+*  Loads size / 4 words at pseudo-random positions inside the range. Every
+*  run uses the same sequence.
+*
+* Parameters:
+*  size - range in bytes, a power of two
+*
+* Return:
+*  bool - true
+*
+*******************************************************************************/
+static bool mpu_bench_rand_read(uint32_t size)
+{
+    const volatile uint32_t* words = (const volatile uint32_t*)hyperram_xip_ptr(BENCH_DEVICE_OFFSET);
+    uint32_t mask = (size / sizeof(uint32_t)) - 1u;
+    uint32_t state = 0x2545F491UL;
+    uint32_t sum = 0u;
+
+    for (uint32_t count = 0; count <= mask; count++)
+    {
+        state = (state * 1664525UL) + 1013904223UL;
+        sum += words[(state >> 8) & mask];
+    }
+    mpu_bench_sink = sum;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: mpu_bench_rand_write
+********************************************************************************
+* Summary:
+*  Stores size / 4 words at pseudo-random positions inside the range, then
+*  cleans the D-cache so the data reaches the device inside the timed
+*  region.
+*
+* Parameters:
+*  size - range in bytes, a power of two
+*
+* Return:
+*  bool - true
+*
+*******************************************************************************/
+static bool mpu_bench_rand_write(uint32_t size)
+{
+    volatile uint32_t* words = (volatile uint32_t*)hyperram_xip_ptr(BENCH_DEVICE_OFFSET);
+    uint32_t mask = (size / sizeof(uint32_t)) - 1u;
+    uint32_t state = 0x2545F491UL;
+
+    for (uint32_t count = 0; count <= mask; count++)
+    {
+        state = (state * 1664525UL) + 1013904223UL;
+        words[(state >> 8) & mask] = count;
+    }
+
+    platform_dcache_clean(hyperram_xip_ptr(BENCH_DEVICE_OFFSET), size);
+
+    return true;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,391 @@
+/*******************************************************************************
+* File Name:   overlay.c
+*
+* Description: Overlay manager, see overlay.h. Slot ownership and LRU stamps are kept
+* in SRAM; a load is one DMA copy from the linked image in the HYPERRAM
+* to the slot through the system bus view of the ITCM.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "platform.h"
+#include "overlay.h"
+#include "hyperram_dma.h"
+#include "perf_counter.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+#define OVERLAY_WINDOW_SIZE             (OVERLAY_SLOTS * OVERLAY_SLOT_SIZE)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef struct
+{
+    overlay_group_t* owner;     /* NULL when free */
+} overlay_slot_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static int32_t overlay_pick_slot(void);
+static void overlay_load(overlay_group_t* group, int32_t slot);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+/* Reserving the window inside .cy_itcm lets the linker keep the BSP ITCM
+ * code out of it */
+CY_SECTION(".cy_itcm") CY_ALIGN(32) static uint8_t overlay_window[OVERLAY_WINDOW_SIZE];
+
+static overlay_slot_t overlay_slots[OVERLAY_SLOTS];
+static overlay_stats_t overlay_stats;
+static uint64_t overlay_load_total_ns;
+static uint32_t overlay_clock;
+static bool overlay_dma_ok;
+
+/*******************************************************************************
+* Function Name: overlay_init
+********************************************************************************
+* Summary:
+*  Empties every slot and sets up the DMA channel used for loads. Call it
+*  after hyperram_init() and before the first stub call.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS, or HYPERRAM_BAD_PARAM if the slot
+*                      size is not a multiple of 32 bytes
+*
+*******************************************************************************/
+hyperram_status_t overlay_init(void)
+{
+    if ((0u == OVERLAY_SLOT_SIZE) || (0u != (OVERLAY_SLOT_SIZE % 32u)))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    overlay_flush();
+    memset(&overlay_stats, 0, sizeof(overlay_stats));
+    overlay_load_total_ns = 0u;
+    overlay_clock = 0u;
+
+    perf_counter_init();
+    overlay_dma_ok = (OVERLAY_LOAD_DMA != 0) && (HYPERRAM_SUCCESS == hyperram_dma_init());
+
+    return HYPERRAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: overlay_enter
+********************************************************************************
+* Summary:
+*  Called by a stub before it calls into its group. Loads the group if it is
+*  not in a slot, pins it and translates the linked function address to the
+*  copy in ITCM. The least recently used unpinned slot is replaced when no
+*  slot is free.
+*
+* Parameters:
+*  group - group the function belongs to
+*  function - linked address of the overlay function
+*
+* Return:
+*  const void* - address to call: the ITCM copy, or the function itself when
+*                the group runs in place
+*
+*******************************************************************************/
+const void* overlay_enter(overlay_group_t* group, const void* function)
+{
+    uint32_t size = (uint32_t)(group->end - group->start);
+    int32_t slot = group->slot;
+
+    overlay_stats.calls++;
+    group->calls++;
+    group->active++;
+    group->last_use = ++overlay_clock;
+
+    if (slot >= 0)
+    {
+        overlay_stats.hits++;
+    }
+    else if ((NULL != group->start) && (0u != size) && (size <= OVERLAY_SLOT_SIZE))
+    {
+        slot = overlay_pick_slot();
+
+        if (slot >= 0)
+        {
+            overlay_load(group, slot);
+        }
+    }
+
+    if (slot < 0)
+    {
+        overlay_stats.in_place++;
+        return function;
+    }
+
+    return (const void*)((uint32_t)&overlay_window[(uint32_t)slot * OVERLAY_SLOT_SIZE] +
+                         ((uint32_t)function - (uint32_t)group->start));
+}
+
+/*******************************************************************************
+* Function Name: overlay_leave
+********************************************************************************
+* Summary:
+*  Called by a stub when the overlay function has returned. Unpins the group.
+*
+* Parameters:
+*  group - group passed to overlay_enter()
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void overlay_leave(overlay_group_t* group)
+{
+    if (0u != group->active)
+    {
+        group->active--;
+    }
+}
+
+/*******************************************************************************
+* Function Name: overlay_flush
+********************************************************************************
+* Summary:
+*  Drops every unpinned group from the window, so that the next call of
+*  each group loads it again.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void overlay_flush(void)
+{
+    for (uint32_t slot = 0; slot < OVERLAY_SLOTS; slot++)
+    {
+        overlay_group_t* owner = overlay_slots[slot].owner;
+
+        if ((NULL != owner) && (0u == owner->active))
+        {
+            owner->slot = -1;
+            overlay_slots[slot].owner = NULL;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: overlay_get_stats
+********************************************************************************
+* Summary:
+*  Returns the overlay counters and load times.
+*
+* Parameters:
+*  stats - filled with the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void overlay_get_stats(overlay_stats_t* stats)
+{
+    *stats = overlay_stats;
+    stats->load_avg_ns = (0u != overlay_stats.loads) ?
+        (uint32_t)(overlay_load_total_ns / overlay_stats.loads) : 0u;
+}
+
+/*******************************************************************************
+* Function Name: overlay_print_stats
+********************************************************************************
+* Summary:
+*  Prints the overlay statistics and the current slot owners on the console.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void overlay_print_stats(void)
+{
+    overlay_stats_t stats;
+
+    overlay_get_stats(&stats);
+
+    PLATFORM_PRINTF("OVERLAY calls=%lu hits=%lu loads=%lu evictions=%lu in_place=%lu dma_fallbacks=%lu\r\n",
+                    (unsigned long)stats.calls, (unsigned long)stats.hits, (unsigned long)stats.loads,
+                    (unsigned long)stats.evictions, (unsigned long)stats.in_place,
+                    (unsigned long)stats.dma_fallbacks);
+    PLATFORM_PRINTF("OVERLAY loaded=%lu bytes load avg=%luns max=%luns\r\n",
+                    (unsigned long)stats.load_bytes, (unsigned long)stats.load_avg_ns,
+                    (unsigned long)stats.load_max_ns);
+
+    for (uint32_t slot = 0; slot < OVERLAY_SLOTS; slot++)
+    {
+        const overlay_group_t* owner = overlay_slots[slot].owner;
+
+        if (NULL != owner)
+        {
+            PLATFORM_PRINTF("OVERLAY slot %lu: %s (%lu bytes, %lu loads, %lu calls)\r\n",
+                            (unsigned long)slot, owner->name,
+                            (unsigned long)(owner->end - owner->start),
+                            (unsigned long)owner->loads, (unsigned long)owner->calls);
+        }
+    }
+    PLATFORM_FLUSH();
+}
+
+/*******************************************************************************
+* Function Name: overlay_pick_slot
+********************************************************************************
+* Summary:
+*  Returns a free slot, or evicts the least recently used unpinned group.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  int32_t - slot index, or -1 if every slot is pinned
+*
+*******************************************************************************/
+static int32_t overlay_pick_slot(void)
+{
+    int32_t victim = -1;
+    uint32_t oldest = 0u;
+
+    for (uint32_t slot = 0; slot < OVERLAY_SLOTS; slot++)
+    {
+        const overlay_group_t* owner = overlay_slots[slot].owner;
+
+        if (NULL == owner)
+        {
+            return (int32_t)slot;
+        }
+
+        /* Stamps wrap, so compare ages rather than stamps */
+        if ((0u == owner->active) && ((victim < 0) || ((overlay_clock - owner->last_use) > oldest)))
+        {
+            victim = (int32_t)slot;
+            oldest = overlay_clock - owner->last_use;
+        }
+    }
+
+    if (victim >= 0)
+    {
+        overlay_slots[victim].owner->slot = -1;
+        overlay_slots[victim].owner = NULL;
+        overlay_stats.evictions++;
+    }
+
+    return victim;
+}
+
+/*******************************************************************************
+* Function Name: overlay_load
+********************************************************************************
+* Summary:
+*  Copies a group into a slot. The DMA writes the ITCM through its system
+*  bus address; if the DMA fails, or the copy does not read back, the CPU
+*  copies the group and later loads use the CPU as well.
+*
+* Parameters:
+*  group - group to load
+*  slot - free slot
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void overlay_load(overlay_group_t* group, int32_t slot)
+{
+    uint8_t* dst = &overlay_window[(uint32_t)slot * OVERLAY_SLOT_SIZE];
+    uint32_t size = (uint32_t)(group->end - group->start);
+    uint32_t start = perf_counter_now();
+    uint32_t elapsed;
+    bool copied = false;
+
+    if (overlay_dma_ok)
+    {
+        copied = (HYPERRAM_SUCCESS == hyperram_dma_copy((void*)(OVERLAY_ITCM_DMA_BASE + (uint32_t)dst),
+                                                        group->start, size)) &&
+                 (0 == memcmp(dst, group->start, sizeof(uint32_t))) &&
+                 (0 == memcmp(dst + size - sizeof(uint32_t), group->start + size - sizeof(uint32_t),
+                              sizeof(uint32_t)));
+        if (!copied)
+        {
+            overlay_dma_ok = false;
+            overlay_stats.dma_fallbacks++;
+        }
+    }
+
+    if (!copied)
+    {
+        memcpy(dst, group->start, size);
+    }
+
+    /* Make the new instructions visible to the fetch unit */
+    __DSB();
+    __ISB();
+
+    elapsed = perf_counter_to_ns(perf_counter_now() - start);
+    overlay_load_total_ns += elapsed;
+    if (elapsed > overlay_stats.load_max_ns)
+    {
+        overlay_stats.load_max_ns = elapsed;
+    }
+
+    overlay_stats.loads++;
+    overlay_stats.load_bytes += size;
+    group->loads++;
+    group->slot = slot;
+    overlay_slots[slot].owner = group;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,199 @@
+/*******************************************************************************
+* File Name:   overlay.h
+*
+* Description: Code overlays: groups of functions kept in the HYPERRAM and paged into a
+* window of ITCM slots on demand. Each group is linked once, into the
+* .hyperram_overlay section, and is called only through resident stubs.
+* A stub loads its group into a free or least recently used slot by DMA
+* and calls the copy in ITCM. A group stays pinned while any of its
+* functions is running, so nested calls across groups are safe.
+*
+* Overlay code is copied without relocation, so it must be position
+* independent apart from absolute references to resident code and data:
+* - define OVERLAY_SOURCE_FILE and include overlay.h before any other
+*   header, so that calls to resident functions become long calls
+* - avoid code that the compiler turns into library calls, such as 64-bit
+*   division or large structure copies
+* - functions of one group may call each other directly; calls to other
+*   groups go through their stubs
+* - keep overlay code out of interrupt handlers
+*
+* A group that is larger than a slot, or that finds every slot pinned,
+* runs in place from the HYPERRAM. The SMIF must be in memory mode
+* whenever a stub is called. Without HYPERRAM_SECTIONS (the default, and
+* toolchains other than GCC_ARM) overlay code is ordinary flash code and the
+* stubs call it directly.
+*
+* Usage, in one source file per group:
+*
+*   #define OVERLAY_SOURCE_FILE
+*   #include "overlay.h"
+*
+*   OVERLAY_GROUP(fft);
+*   OVERLAY_CODE(fft) uint32_t fft_run_overlay(int16_t* data, uint32_t n) { ... }
+*   OVERLAY_STUB(fft, uint32_t, fft_run, (int16_t* data, uint32_t n), (data, n))
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef OVERLAY_H
+#define OVERLAY_H
+
+/* Must come before the first declaration of any resident function */
+#if defined(OVERLAY_SOURCE_FILE) && defined(HYPERRAM_SECTIONS)
+#pragma long_calls
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hyperram.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* ITCM window, reserved in the BSP .cy_itcm section */
+#ifndef OVERLAY_SLOTS
+#define OVERLAY_SLOTS                   (4u)
+#endif
+#ifndef OVERLAY_SLOT_SIZE
+#define OVERLAY_SLOT_SIZE               (4096u)
+#endif
+
+/* System bus address of CM7_0 ITCM offset 0, used as the DMA destination */
+#ifndef OVERLAY_ITCM_DMA_BASE
+#define OVERLAY_ITCM_DMA_BASE           (0xA0000000UL)
+#endif
+
+/* Set to 0 to load with the CPU instead of the DMA */
+#ifndef OVERLAY_LOAD_DMA
+#define OVERLAY_LOAD_DMA                (1)
+#endif
+
+#if defined(HYPERRAM_SECTIONS)
+#define OVERLAY_CODE(group)             __attribute__((section(".overlay." #group ".1"), noinline))
+#define OVERLAY_MARKER(group, part)     __attribute__((section(".overlay." #group "." part), aligned(32), used))
+#else
+#define OVERLAY_CODE(group)             __attribute__((noinline))
+#endif
+
+#define OVERLAY_GROUP_OBJECT(group)     group##_overlay_group
+
+/* Declares a group defined in another file */
+#define OVERLAY_GROUP_DECLARE(group)    extern overlay_group_t OVERLAY_GROUP_OBJECT(group)
+
+/* Defines a group; the start and end markers bracket its code in the image */
+#if defined(HYPERRAM_SECTIONS)
+#define OVERLAY_GROUP(group)                                                                \
+    static const uint32_t group##_overlay_start[1] OVERLAY_MARKER(group, "0") = { 0u };     \
+    static const uint32_t group##_overlay_end[1] OVERLAY_MARKER(group, "2") = { 0u };       \
+    overlay_group_t OVERLAY_GROUP_OBJECT(group) =                                           \
+        { #group, (const uint8_t*)group##_overlay_start, (const uint8_t*)group##_overlay_end, \
+          -1, 0u, 0u, 0u, 0u }
+#else
+#define OVERLAY_GROUP(group)                                                                \
+    overlay_group_t OVERLAY_GROUP_OBJECT(group) = { #group, NULL, NULL, -1, 0u, 0u, 0u, 0u }
+#endif
+
+/* Defines the resident stub "name" for the overlay function name##_overlay */
+#define OVERLAY_STUB(group, type, name, params, args)                                       \
+    type name params                                                                        \
+    {                                                                                       \
+        type (*overlay_function) params = (type (*) params)                                 \
+            overlay_enter(&OVERLAY_GROUP_OBJECT(group), (const void*)name##_overlay);       \
+        type overlay_result = overlay_function args;                                        \
+        overlay_leave(&OVERLAY_GROUP_OBJECT(group));                                        \
+        return overlay_result;                                                              \
+    }
+
+#define OVERLAY_STUB_VOID(group, name, params, args)                                        \
+    void name params                                                                        \
+    {                                                                                       \
+        void (*overlay_function) params = (void (*) params)                                 \
+            overlay_enter(&OVERLAY_GROUP_OBJECT(group), (const void*)name##_overlay);       \
+        overlay_function args;                                                              \
+        overlay_leave(&OVERLAY_GROUP_OBJECT(group));                                        \
+    }
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef struct
+{
+    const char* name;
+    const uint8_t* start;       /* linked image in the HYPERRAM */
+    const uint8_t* end;
+    int32_t slot;               /* -1 when not loaded */
+    uint32_t active;            /* calls in progress, pins the slot */
+    uint32_t last_use;          /* LRU stamp */
+    uint32_t loads;
+    uint32_t calls;
+} overlay_group_t;
+
+typedef struct
+{
+    uint32_t calls;
+    uint32_t hits;              /* group already in a slot */
+    uint32_t loads;
+    uint32_t evictions;
+    uint32_t in_place;          /* calls run from the HYPERRAM */
+    uint32_t dma_fallbacks;     /* loads done by the CPU after a DMA failure */
+    uint32_t load_bytes;
+    uint32_t load_avg_ns;
+    uint32_t load_max_ns;
+} overlay_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+hyperram_status_t overlay_init(void);
+const void* overlay_enter(overlay_group_t* group, const void* function);
+void overlay_leave(overlay_group_t* group);
+void overlay_flush(void);
+void overlay_get_stats(overlay_stats_t* stats);
+void overlay_print_stats(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* OVERLAY_H */
+
+/* [] END OF FILE */
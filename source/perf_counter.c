@@ -0,0 +1,190 @@
+/*******************************************************************************
+* File Name:   perf_counter.c
+*
+* Description: Cycle counter access. Intervals are measured as unsigned 32-bit
+* differences and must be shorter than one counter wrap (about 12 s at
+* 350 MHz).
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#if defined(HYPERRAM_HOST_SIM)
+#include <time.h>
+#else
+#include "cy_pdl.h"
+#endif
+#include "perf_counter.h"
+#include <stdbool.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+#define PERF_COUNTER_NS_PER_S           (1000000000ULL)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+static bool perf_counter_started;
+static uint32_t perf_counter_origin;
+
+/*******************************************************************************
+* Function Name: perf_counter_init
+********************************************************************************
+* Summary:
+*  Enables the DWT cycle counter. Calling it again leaves a running counter
+*  untouched, so that modules can call it from their own init. The first
+*  call is the origin of perf_counter_since_init(); main() and the HYPERRAM
+*  section startup make it first thing after reset.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void perf_counter_init(void)
+{
+#if !defined(HYPERRAM_HOST_SIM)
+    if (0u == (DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk))
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0u;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+#endif
+
+    /* A debugger may have left the counter running, so keep an origin */
+    if (!perf_counter_started)
+    {
+        perf_counter_origin = perf_counter_now();
+        perf_counter_started = true;
+    }
+}
+
+/*******************************************************************************
+* Function Name: perf_counter_since_init
+********************************************************************************
+* Summary:
+*  Returns the time since the first perf_counter_init() call, used as the
+*  boot time stamp. Wraps after 2^32 ticks.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t - counter ticks
+*
+*******************************************************************************/
+uint32_t perf_counter_since_init(void)
+{
+    return perf_counter_now() - perf_counter_origin;
+}
+
+/*******************************************************************************
+* Function Name: perf_counter_now
+********************************************************************************
+* Summary:
+*  Returns the current counter value.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t - counter ticks
+*
+*******************************************************************************/
+uint32_t perf_counter_now(void)
+{
+#if defined(HYPERRAM_HOST_SIM)
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint32_t)(((uint64_t)now.tv_sec * PERF_COUNTER_NS_PER_S) + (uint64_t)now.tv_nsec);
+#else
+    return DWT->CYCCNT;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: perf_counter_hz
+********************************************************************************
+* Summary:
+*  Returns the counter frequency.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t - ticks per second
+*
+*******************************************************************************/
+uint32_t perf_counter_hz(void)
+{
+#if defined(HYPERRAM_HOST_SIM)
+    return (uint32_t)PERF_COUNTER_NS_PER_S;
+#else
+    return SystemCoreClock;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: perf_counter_to_ns
+********************************************************************************
+* Summary:
+*  Converts a tick interval to nanoseconds.
+*
+* Parameters:
+*  ticks - interval in counter ticks
+*
+* Return:
+*  uint32_t - interval in nanoseconds, saturated at UINT32_MAX
+*
+*******************************************************************************/
+uint32_t perf_counter_to_ns(uint32_t ticks)
+{
+    uint64_t ns = ((uint64_t)ticks * PERF_COUNTER_NS_PER_S) / perf_counter_hz();
+
+    return (ns > UINT32_MAX) ? UINT32_MAX : (uint32_t)ns;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,300 @@
+/*******************************************************************************
+* File Name:   platform.h
+*
+* Description: Small portability layer for modules that also run in the host
+* simulator build (HYPERRAM_HOST_SIM): console output, alignment and CM7
+* D-cache maintenance, which compiles to nothing on the host.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+#include <stdint.h>
+
+#if defined(HYPERRAM_HOST_SIM)
+#include <stdio.h>
+#else
+#include "cy_pdl.h"
+#include "console.h"
+#endif
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+#define PLATFORM_CACHE_LINE             (32u)
+
+#if defined(HYPERRAM_HOST_SIM)
+#define PLATFORM_NAME                   "host-sim"
+#define PLATFORM_PRINTF                 printf
+#define PLATFORM_FLUSH()                ((void)fflush(stdout))
+#define CY_ALIGN(align)                 __attribute__((aligned(align)))
+#else
+#define PLATFORM_NAME                   "hardware"
+#define PLATFORM_PRINTF                 console_printf
+#define PLATFORM_FLUSH()                console_flush()
+#endif
+
+#if !defined(HYPERRAM_HOST_SIM) && defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+#define PLATFORM_HAS_DCACHE             (1)
+#else
+#define PLATFORM_HAS_DCACHE             (0)
+#endif
+
+/*******************************************************************************
+* Function Name: platform_dcache_clean
+********************************************************************************
+* Summary:
+*  Writes back the D-cache lines covering a range.
+*
+* Parameters:
+*  address - start of the range
+*  size - length of the range in bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static inline void platform_dcache_clean(const volatile void* address, uint32_t size)
+{
+#if (PLATFORM_HAS_DCACHE)
+    uint32_t start = (uint32_t)address & ~(PLATFORM_CACHE_LINE - 1u);
+
+    SCB_CleanDCache_by_Addr((uint32_t*)start, (int32_t)(((uint32_t)address + size) - start));
+#else
+    (void)address;
+    (void)size;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: platform_dcache_invalidate
+********************************************************************************
+* Summary:
+*  Discards the D-cache lines covering a range.
+*
+* Parameters:
+*  address - start of the range
+*  size - length of the range in bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static inline void platform_dcache_invalidate(const volatile void* address, uint32_t size)
+{
+#if (PLATFORM_HAS_DCACHE)
+    uint32_t start = (uint32_t)address & ~(PLATFORM_CACHE_LINE - 1u);
+
+    SCB_InvalidateDCache_by_Addr((uint32_t*)start, (int32_t)(((uint32_t)address + size) - start));
+#else
+    (void)address;
+    (void)size;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: platform_dcache_clean_invalidate
+********************************************************************************
+* Summary:
+*  Writes back and then discards the D-cache lines covering a range.
+*
+* Parameters:
+*  address - start of the range
+*  size - length of the range in bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static inline void platform_dcache_clean_invalidate(const volatile void* address, uint32_t size)
+{
+#if (PLATFORM_HAS_DCACHE)
+    uint32_t start = (uint32_t)address & ~(PLATFORM_CACHE_LINE - 1u);
+
+    SCB_CleanInvalidateDCache_by_Addr((uint32_t*)start, (int32_t)(((uint32_t)address + size) - start));
+#else
+    (void)address;
+    (void)size;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: platform_dcache_clean_all
+********************************************************************************
+* Summary:
+*  Writes back every dirty D-cache line, for changes of the memory map that
+*  a later eviction must not cross.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static inline void platform_dcache_clean_all(void)
+{
+#if (PLATFORM_HAS_DCACHE)
+    SCB_CleanDCache();
+#endif
+}
+
+/*******************************************************************************
+* Function Name: platform_dcache_discard
+********************************************************************************
+* Summary:
+*  Prepares a range that a DMA transfer is about to overwrite. Lines that lie
+*  entirely inside the range are invalidated without a write-back. A line
+*  that the range only partly covers is cleaned and invalidated, so that
+*  the data it shares with neighbouring objects is kept.
+*
+* Parameters:
+*  address - start of the range
+*  size - length of the range in bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static inline void platform_dcache_discard(const volatile void* address, uint32_t size)
+{
+#if (PLATFORM_HAS_DCACHE)
+    uint32_t start = (uint32_t)address;
+    uint32_t end = start + size;
+    uint32_t inner_start = (start + (PLATFORM_CACHE_LINE - 1u)) & ~(PLATFORM_CACHE_LINE - 1u);
+    uint32_t inner_end = end & ~(PLATFORM_CACHE_LINE - 1u);
+
+    if (inner_start >= inner_end)
+    {
+        platform_dcache_clean_invalidate(address, size);
+        return;
+    }
+
+    if (start != inner_start)
+    {
+        SCB_CleanInvalidateDCache_by_Addr((uint32_t*)(inner_start - PLATFORM_CACHE_LINE),
+                                          (int32_t)PLATFORM_CACHE_LINE);
+    }
+    if (end != inner_end)
+    {
+        SCB_CleanInvalidateDCache_by_Addr((uint32_t*)inner_end, (int32_t)PLATFORM_CACHE_LINE);
+    }
+    SCB_InvalidateDCache_by_Addr((uint32_t*)inner_start, (int32_t)(inner_end - inner_start));
+#else
+    (void)address;
+    (void)size;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: platform_enter_critical
+********************************************************************************
+* Summary:
+*  Masks interrupts, for state shared with DMA completion callbacks.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t - previous interrupt state for platform_exit_critical()
+*
+*******************************************************************************/
+static inline uint32_t platform_enter_critical(void)
+{
+#if defined(HYPERRAM_HOST_SIM)
+    return 0u;
+#else
+    return Cy_SysLib_EnterCriticalSection();
+#endif
+}
+
+/*******************************************************************************
+* Function Name: platform_exit_critical
+********************************************************************************
+* Summary:
+*  Restores the interrupt state saved by platform_enter_critical().
+*
+* Parameters:
+*  state - value returned by platform_enter_critical()
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static inline void platform_exit_critical(uint32_t state)
+{
+#if defined(HYPERRAM_HOST_SIM)
+    (void)state;
+#else
+    Cy_SysLib_ExitCriticalSection(state);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: platform_ctz
+********************************************************************************
+* Summary:
+*  Counts the trailing zero bits of a non-zero value.
+*
+* Parameters:
+*  value - value to scan, must not be 0
+*
+* Return:
+*  uint32_t - index of the lowest set bit
+*
+*******************************************************************************/
+static inline uint32_t platform_ctz(uint32_t value)
+{
+#if defined(HYPERRAM_HOST_SIM)
+    return (uint32_t)__builtin_ctz(value);
+#else
+    return (uint32_t)__CLZ(__RBIT(value));
+#endif
+}
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* PLATFORM_H */
+
+/* [] END OF FILE */
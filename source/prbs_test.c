@@ -0,0 +1,334 @@
+/*******************************************************************************
+* File Name:   prbs_test.c
+*
+* Description: PRBS signal-integrity exerciser. The serial PRBS is packed LSB first into
+* bytes, so DQn carries every eighth bit of the sequence; as 8 and the
+* sequence period are coprime, each line sees the full PRBS at its own
+* phase. The pattern is generated once; the rounds then only move and
+* compare data, so the bus runs at the rate of the command-mode path.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include "platform.h"
+#include "prbs_test.h"
+#include "perf_counter.h"
+#include <string.h>
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef struct
+{
+    const char* name;
+    uint8_t length;             /* register length, the highest exponent */
+    uint8_t tap;                /* the other feedback exponent */
+} prbs_polynomial_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void prbs_generate(const prbs_polynomial_t* polynomial, uint8_t* buffer, uint32_t size);
+static void prbs_check(const uint32_t* expected, const uint32_t* actual, prbs_test_result_t* result);
+static void prbs_print_ratio(uint64_t numerator, uint64_t denominator);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+static const prbs_polynomial_t prbs_polynomials[PRBS_TEST_PATTERNS] =
+{
+    { "PRBS7",   7u,  6u },
+    { "PRBS15", 15u, 14u },
+    { "PRBS31", 31u, 28u },
+};
+
+CY_ALIGN(PLATFORM_CACHE_LINE) static uint32_t prbs_pattern[PRBS_TEST_BUFFER_SIZE / sizeof(uint32_t)];
+CY_ALIGN(PLATFORM_CACHE_LINE) static uint32_t prbs_readback[PRBS_TEST_BUFFER_SIZE / sizeof(uint32_t)];
+
+/*******************************************************************************
+* Function Name: prbs_test_run
+********************************************************************************
+* Summary:
+*  Writes the PRBS to successive PRBS_TEST_BUFFER_SIZE blocks of the range
+*  and reads each one back until the duration has passed, counting bit
+*  errors per data line. Data in the range is destroyed.
+*
+* Parameters:
+*  config - pattern, device range and run time
+*  result - receives the error counts and throughput
+*
+* Return:
+*  hyperram_status_t - HYPERRAM_SUCCESS if no error was seen,
+*                      HYPERRAM_BAD_PARAM, or HYPERRAM_ERROR
+*
+*******************************************************************************/
+hyperram_status_t prbs_test_run(const prbs_test_config_t* config, prbs_test_result_t* result)
+{
+    uint64_t elapsed_ns = 0u;
+    uint64_t limit_ns = (uint64_t)config->duration_ms * 1000000u;
+    uint32_t address = 0u;
+    uint32_t last;
+    uint32_t errors = 0u;
+
+    memset(result, 0, sizeof(*result));
+
+    if ((config->pattern >= PRBS_TEST_PATTERNS) || (config->size < PRBS_TEST_BUFFER_SIZE) ||
+        (0u != (config->size % PRBS_TEST_BUFFER_SIZE)) || (0u != (config->offset & 1u)) ||
+        (config->offset > HYPERRAM_SIZE) || (config->size > (HYPERRAM_SIZE - config->offset)))
+    {
+        return HYPERRAM_BAD_PARAM;
+    }
+
+    perf_counter_init();
+    prbs_generate(&prbs_polynomials[config->pattern], (uint8_t*)prbs_pattern, PRBS_TEST_BUFFER_SIZE);
+
+    last = perf_counter_now();
+
+    do
+    {
+        uint32_t now;
+
+        if ((HYPERRAM_SUCCESS != hyperram_write(config->offset + address, prbs_pattern, PRBS_TEST_BUFFER_SIZE)) ||
+            (HYPERRAM_SUCCESS != hyperram_read(config->offset + address, prbs_readback, PRBS_TEST_BUFFER_SIZE)))
+        {
+            result->transfer_errors++;
+        }
+        else
+        {
+            prbs_check(prbs_pattern, prbs_readback, result);
+        }
+
+        /* Time the bus and the check; the 32-bit counter is read every round */
+        now = perf_counter_now();
+        elapsed_ns += perf_counter_to_ns(now - last);
+        last = now;
+
+        address += PRBS_TEST_BUFFER_SIZE;
+        if (address == config->size)
+        {
+            address = 0u;
+        }
+    } while ((0u != address) || (elapsed_ns < limit_ns));
+
+    result->elapsed_ms = (uint32_t)(elapsed_ns / 1000000u);
+    result->mbps = (0u != elapsed_ns) ? (uint32_t)((result->bytes * 2000u) / elapsed_ns) : 0u;
+
+    for (uint32_t line = 0; line < PRBS_TEST_LINES; line++)
+    {
+        errors += (0u != result->line_errors[line]) ? 1u : 0u;
+    }
+
+    return ((0u == errors) && (0u == result->transfer_errors)) ? HYPERRAM_SUCCESS : HYPERRAM_ERROR;
+}
+
+/*******************************************************************************
+* Function Name: prbs_test_print
+********************************************************************************
+* Summary:
+*  Prints the bit-error rate of every data line. A line without errors is
+*  given the 95% confidence upper bound 3 / bits instead.
+*
+* Parameters:
+*  config - configuration of the run
+*  result - result of the run
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void prbs_test_print(const prbs_test_config_t* config, const prbs_test_result_t* result)
+{
+    bool pass = (0u == result->transfer_errors);
+
+    PLATFORM_PRINTF("\r\nPRBS %s 0x%08lX-0x%08lX: %lu MB checked in %lu ms, %lu MB/s, transfer errors=%lu\r\n",
+                    prbs_test_pattern_name(config->pattern), (unsigned long)config->offset,
+                    (unsigned long)(config->offset + config->size - 1u),
+                    (unsigned long)(result->bytes >> 20), (unsigned long)result->elapsed_ms,
+                    (unsigned long)result->mbps, (unsigned long)result->transfer_errors);
+
+    for (uint32_t line = 0; line < PRBS_TEST_LINES; line++)
+    {
+        PLATFORM_PRINTF("PRBS DQ%lu errors=%lu ber=", (unsigned long)line,
+                        (unsigned long)result->line_errors[line]);
+
+        if (0u == result->line_errors[line])
+        {
+            PLATFORM_PRINTF("<");
+            prbs_print_ratio(3u, result->bytes);
+        }
+        else
+        {
+            pass = false;
+            prbs_print_ratio(result->line_errors[line], result->bytes);
+        }
+        PLATFORM_PRINTF("\r\n");
+    }
+
+    PLATFORM_PRINTF("PRBS-RESULT %s\r\n", pass ? "PASS" : "FAIL");
+    PLATFORM_FLUSH();
+}
+
+/*******************************************************************************
+* Function Name: prbs_test_pattern_name
+********************************************************************************
+* Summary:
+*  Returns the name of a pattern.
+*
+* Parameters:
+*  pattern - pattern
+*
+* Return:
+*  const char* - name, or "?" for an invalid pattern
+*
+*******************************************************************************/
+const char* prbs_test_pattern_name(prbs_test_pattern_t pattern)
+{
+    return (pattern < PRBS_TEST_PATTERNS) ? prbs_polynomials[pattern].name : "?";
+}
+
+/*******************************************************************************
+* Function Name: prbs_generate
+********************************************************************************
+* Summary:
+*  Fills a buffer with the serial output of a Fibonacci LFSR started from
+*  all ones, eight bits per byte, LSB first.
+*
+* Parameters:
+*  polynomial - feedback polynomial
+*  buffer - buffer to fill
+*  size - number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void prbs_generate(const prbs_polynomial_t* polynomial, uint8_t* buffer, uint32_t size)
+{
+    uint32_t mask = (1UL << polynomial->length) - 1u;
+    uint32_t state = mask;
+
+    for (uint32_t index = 0; index < size; index++)
+    {
+        uint8_t byte = 0u;
+
+        for (uint32_t bit = 0; bit < 8u; bit++)
+        {
+            uint32_t feedback = ((state >> (polynomial->length - 1u)) ^ (state >> (polynomial->tap - 1u))) & 1u;
+
+            state = ((state << 1) | feedback) & mask;
+            byte |= (uint8_t)(feedback << bit);
+        }
+
+        buffer[index] = byte;
+    }
+}
+
+/*******************************************************************************
+* Function Name: prbs_check
+********************************************************************************
+* Summary:
+*  Compares a block read back with the pattern and adds the wrong bits to
+*  the count of the line that carried them. Byte n of a word went over
+*  DQ[7:0] like every other byte, so bit b of the difference is line b % 8.
+*
+* Parameters:
+*  expected - pattern written
+*  actual - data read
+*  result - counts to update
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void prbs_check(const uint32_t* expected, const uint32_t* actual, prbs_test_result_t* result)
+{
+    for (uint32_t index = 0; index < (PRBS_TEST_BUFFER_SIZE / sizeof(uint32_t)); index++)
+    {
+        uint32_t diff = expected[index] ^ actual[index];
+
+        while (0u != diff)
+        {
+            result->line_errors[platform_ctz(diff) & 7u]++;
+            diff &= diff - 1u;
+        }
+    }
+
+    result->bytes += PRBS_TEST_BUFFER_SIZE;
+}
+
+/*******************************************************************************
+* Function Name: prbs_print_ratio
+********************************************************************************
+* Summary:
+*  Prints a ratio below one in the form 1.23e-09, without floating point.
+*
+* Parameters:
+*  numerator - numerator, at most the denominator
+*  denominator - denominator
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void prbs_print_ratio(uint64_t numerator, uint64_t denominator)
+{
+    uint32_t exponent = 0u;
+    uint32_t mantissa;
+
+    if ((0u == numerator) || (0u == denominator))
+    {
+        PLATFORM_PRINTF("0");
+        return;
+    }
+
+    while (numerator < denominator)
+    {
+        numerator *= 10u;
+        exponent++;
+    }
+
+    mantissa = (uint32_t)((numerator * 100u) / denominator);
+
+    PLATFORM_PRINTF("%lu.%02lue-%02lu", (unsigned long)(mantissa / 100u), (unsigned long)(mantissa % 100u),
+                    (unsigned long)exponent);
+}
+
+/* [] END OF FILE */
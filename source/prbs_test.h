@@ -0,0 +1,109 @@
+/*******************************************************************************
+* File Name:   prbs_test.h
+*
+* Description: PRBS signal-integrity exerciser. PRBS7, PRBS15 or PRBS31 data is streamed
+* to the device and back with command-mode continuous bursts, and every
+* bit error is attributed to the HyperBus data line that carried it, so
+* boards can be margined line by line, for example at raised SMIF clocks.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PRBS_TEST_H
+#define PRBS_TEST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hyperram.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* HyperBus DQ[7:0] */
+#define PRBS_TEST_LINES                 (8u)
+
+/* Bytes per write/read round trip */
+#ifndef PRBS_TEST_BUFFER_SIZE
+#define PRBS_TEST_BUFFER_SIZE           (16384u)
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef enum
+{
+    PRBS_TEST_PRBS7,            /* x^7 + x^6 + 1 */
+    PRBS_TEST_PRBS15,           /* x^15 + x^14 + 1 */
+    PRBS_TEST_PRBS31,           /* x^31 + x^28 + 1 */
+    PRBS_TEST_PATTERNS
+} prbs_test_pattern_t;
+
+typedef struct
+{
+    prbs_test_pattern_t pattern;
+    uint32_t offset;            /* device range the rounds cycle through */
+    uint32_t size;
+    uint32_t duration_ms;       /* run time; at least one pass over the range */
+} prbs_test_config_t;
+
+typedef struct
+{
+    uint64_t bytes;             /* bytes checked, which is the bits per line */
+    uint64_t line_errors[PRBS_TEST_LINES];
+    uint32_t transfer_errors;   /* failed SMIF transfers */
+    uint32_t mbps;              /* write plus read throughput */
+    uint32_t elapsed_ms;
+} prbs_test_result_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+hyperram_status_t prbs_test_run(const prbs_test_config_t* config, prbs_test_result_t* result);
+void prbs_test_print(const prbs_test_config_t* config, const prbs_test_result_t* result);
+const char* prbs_test_pattern_name(prbs_test_pattern_t pattern);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* PRBS_TEST_H */
+
+/* [] END OF FILE */
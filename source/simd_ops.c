@@ -0,0 +1,482 @@
+/*******************************************************************************
+* File Name:   simd_ops.c
+*
+* Description: Word-parallel compare, search and checksum kernels. See simd_ops.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include <string.h>
+#include "simd_ops.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+#define SIMD_WORD                       (sizeof(uint32_t))
+#define SIMD_BYTES_01                   (0x01010101UL)
+#define SIMD_BYTES_80                   (0x80808080UL)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static inline uint32_t simd_load(const uint8_t* address);
+static inline uint32_t simd_block_diff(const uint8_t* a, const uint8_t* b);
+static inline uint32_t simd_block_diff_value(const uint8_t* data, uint32_t pattern);
+static inline uint32_t simd_zero_bytes(uint32_t value);
+static inline uint32_t simd_byte_sum(uint32_t value, uint32_t sum);
+
+/*******************************************************************************
+* Function Name: simd_equal
+********************************************************************************
+* Summary:
+*  Checks two buffers for equality, a line at a time.
+*
+* Parameters:
+*  a - first buffer
+*  b - second buffer
+*  size - number of bytes
+*
+* Return:
+*  bool - true if the buffers match
+*
+*******************************************************************************/
+bool simd_equal(const void* a, const void* b, uint32_t size)
+{
+    return (size == simd_first_diff(a, b, size));
+}
+
+/*******************************************************************************
+* Function Name: simd_first_diff
+********************************************************************************
+* Summary:
+*  Finds the first byte at which two buffers differ. Whole lines are
+*  XOR-folded into one word and only a line that differs is searched.
+*
+* Parameters:
+*  a - first buffer
+*  b - second buffer
+*  size - number of bytes
+*
+* Return:
+*  uint32_t - offset of the first differing byte, or size if none
+*
+*******************************************************************************/
+uint32_t simd_first_diff(const void* a, const void* b, uint32_t size)
+{
+    const uint8_t* x = (const uint8_t*)a;
+    const uint8_t* y = (const uint8_t*)b;
+    uint32_t offset = 0u;
+
+    while (((size - offset) >= SIMD_OPS_BLOCK) && (0u == simd_block_diff(&x[offset], &y[offset])))
+    {
+        offset += SIMD_OPS_BLOCK;
+    }
+
+    for (; (size - offset) >= SIMD_WORD; offset += SIMD_WORD)
+    {
+        uint32_t diff = simd_load(&x[offset]) ^ simd_load(&y[offset]);
+
+        if (0u != diff)
+        {
+            /* Little endian: the lowest set bit is in the lowest address */
+            return offset + (platform_ctz(diff) / 8u);
+        }
+    }
+
+    for (; offset < size; offset++)
+    {
+        if (x[offset] != y[offset])
+        {
+            break;
+        }
+    }
+
+    return offset;
+}
+
+/*******************************************************************************
+* Function Name: simd_first_not
+********************************************************************************
+* Summary:
+*  Finds the first byte that breaks a repeated 32-bit pattern, such as the
+*  background of a fill. Byte n of the buffer is expected to hold byte
+*  (n % 4) of the little-endian pattern.
+*
+* Parameters:
+*  data - buffer to check
+*  size - number of bytes
+*  pattern - repeated word
+*
+* Return:
+*  uint32_t - offset of the first mismatching byte, or size if none
+*
+*******************************************************************************/
+uint32_t simd_first_not(const void* data, uint32_t size, uint32_t pattern)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint32_t offset = 0u;
+
+    while (((size - offset) >= SIMD_OPS_BLOCK) && (0u == simd_block_diff_value(&bytes[offset], pattern)))
+    {
+        offset += SIMD_OPS_BLOCK;
+    }
+
+    for (; (size - offset) >= SIMD_WORD; offset += SIMD_WORD)
+    {
+        uint32_t diff = simd_load(&bytes[offset]) ^ pattern;
+
+        if (0u != diff)
+        {
+            return offset + (platform_ctz(diff) / 8u);
+        }
+    }
+
+    for (; offset < size; offset++)
+    {
+        if (bytes[offset] != (uint8_t)(pattern >> ((offset % SIMD_WORD) * 8u)))
+        {
+            break;
+        }
+    }
+
+    return offset;
+}
+
+/*******************************************************************************
+* Function Name: simd_find_word
+********************************************************************************
+* Summary:
+*  Finds a 32-bit word, such as a record marker, at word offsets from the
+*  start of a buffer.
+*
+* Parameters:
+*  data - buffer to search
+*  size - number of bytes; a trailing partial word is not searched
+*  word - value to find
+*
+* Return:
+*  uint32_t - offset of the first match, or size if none
+*
+*******************************************************************************/
+uint32_t simd_find_word(const void* data, uint32_t size, uint32_t word)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint32_t offset = 0u;
+
+    for (; (size - offset) >= SIMD_OPS_BLOCK; offset += SIMD_OPS_BLOCK)
+    {
+        uint32_t hit = 0u;
+
+        for (uint32_t index = 0; index < SIMD_OPS_BLOCK; index += SIMD_WORD)
+        {
+            hit |= (simd_load(&bytes[offset + index]) == word) ? 1u : 0u;
+        }
+
+        /* The word loop below locates the match within the line */
+        if (0u != hit)
+        {
+            break;
+        }
+    }
+
+    for (; (size - offset) >= SIMD_WORD; offset += SIMD_WORD)
+    {
+        if (simd_load(&bytes[offset]) == word)
+        {
+            return offset;
+        }
+    }
+
+    return size;
+}
+
+/*******************************************************************************
+* Function Name: simd_find_byte
+********************************************************************************
+* Summary:
+*  Finds a byte value at any offset, four bytes per compare.
+*
+* Parameters:
+*  data - buffer to search
+*  size - number of bytes
+*  value - byte to find
+*
+* Return:
+*  uint32_t - offset of the first match, or size if none
+*
+*******************************************************************************/
+uint32_t simd_find_byte(const void* data, uint32_t size, uint8_t value)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint32_t repeated = SIMD_BYTES_01 * value;
+    uint32_t offset = 0u;
+
+    for (; (size - offset) >= SIMD_WORD; offset += SIMD_WORD)
+    {
+        uint32_t zero = simd_zero_bytes(simd_load(&bytes[offset]) ^ repeated);
+
+        if (0u != zero)
+        {
+            return offset + (platform_ctz(zero) / 8u);
+        }
+    }
+
+    for (; offset < size; offset++)
+    {
+        if (bytes[offset] == value)
+        {
+            break;
+        }
+    }
+
+    return offset;
+}
+
+/*******************************************************************************
+* Function Name: simd_checksum_init
+********************************************************************************
+* Summary:
+*  Starts a running checksum.
+*
+* Parameters:
+*  checksum - checksum to reset
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void simd_checksum_init(simd_checksum_t* checksum)
+{
+    checksum->sum = 0u;
+    checksum->xor_word = 0u;
+    checksum->position = 0u;
+}
+
+/*******************************************************************************
+* Function Name: simd_checksum_update
+********************************************************************************
+* Summary:
+*  Adds a block to a running checksum. Blocks may have any size; the result
+*  depends only on the concatenated bytes.
+*
+* Parameters:
+*  checksum - running checksum
+*  data - next block of the stream
+*  size - number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void simd_checksum_update(simd_checksum_t* checksum, const void* data, uint32_t size)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint32_t sum = checksum->sum;
+    uint32_t xor_word = checksum->xor_word;
+    uint32_t lane = checksum->position % SIMD_WORD;
+    uint32_t offset = 0u;
+
+    checksum->position += size;
+
+    /* Finish the word a previous block left open */
+    for (; (0u != lane) && (offset < size); offset++)
+    {
+        sum += bytes[offset];
+        xor_word ^= (uint32_t)bytes[offset] << (lane * 8u);
+        lane = (lane + 1u) % SIMD_WORD;
+    }
+
+    for (; (size - offset) >= SIMD_OPS_BLOCK; offset += SIMD_OPS_BLOCK)
+    {
+        for (uint32_t index = 0; index < SIMD_OPS_BLOCK; index += SIMD_WORD)
+        {
+            uint32_t word = simd_load(&bytes[offset + index]);
+
+            sum = simd_byte_sum(word, sum);
+            xor_word ^= word;
+        }
+    }
+
+    for (; (size - offset) >= SIMD_WORD; offset += SIMD_WORD)
+    {
+        uint32_t word = simd_load(&bytes[offset]);
+
+        sum = simd_byte_sum(word, sum);
+        xor_word ^= word;
+    }
+
+    for (lane = 0u; offset < size; offset++, lane++)
+    {
+        sum += bytes[offset];
+        xor_word ^= (uint32_t)bytes[offset] << (lane * 8u);
+    }
+
+    checksum->sum = sum;
+    checksum->xor_word = xor_word;
+}
+
+/*******************************************************************************
+* Function Name: simd_load
+********************************************************************************
+* Summary:
+*  32-bit load from an address of any alignment. The CM7 performs unaligned
+*  word loads in normal memory, so this is a single LDR.
+*
+* Parameters:
+*  address - address to load from
+*
+* Return:
+*  uint32_t - value
+*
+*******************************************************************************/
+static inline uint32_t simd_load(const uint8_t* address)
+{
+    uint32_t value;
+
+    memcpy(&value, address, sizeof(value));
+
+    return value;
+}
+
+/*******************************************************************************
+* Function Name: simd_block_diff
+********************************************************************************
+* Summary:
+*  ORs together the XOR of the eight words of two lines.
+*
+* Parameters:
+*  a - first line
+*  b - second line
+*
+* Return:
+*  uint32_t - zero if the lines match
+*
+*******************************************************************************/
+static inline uint32_t simd_block_diff(const uint8_t* a, const uint8_t* b)
+{
+    uint32_t diff = 0u;
+
+    for (uint32_t index = 0; index < SIMD_OPS_BLOCK; index += SIMD_WORD)
+    {
+        diff |= simd_load(&a[index]) ^ simd_load(&b[index]);
+    }
+
+    return diff;
+}
+
+/*******************************************************************************
+* Function Name: simd_block_diff_value
+********************************************************************************
+* Summary:
+*  ORs together the XOR of the eight words of a line with a pattern.
+*
+* Parameters:
+*  data - line to check
+*  pattern - expected word
+*
+* Return:
+*  uint32_t - zero if every word holds the pattern
+*
+*******************************************************************************/
+static inline uint32_t simd_block_diff_value(const uint8_t* data, uint32_t pattern)
+{
+    uint32_t diff = 0u;
+
+    for (uint32_t index = 0; index < SIMD_OPS_BLOCK; index += SIMD_WORD)
+    {
+        diff |= simd_load(&data[index]) ^ pattern;
+    }
+
+    return diff;
+}
+
+/*******************************************************************************
+* Function Name: simd_zero_bytes
+********************************************************************************
+* Summary:
+*  Marks the zero bytes of a word. USUB8 sets the GE flag of every non-zero
+*  byte and SEL turns the clear flags into 0xFF bytes. The portable form may
+*  also mark a 0x01 byte above a zero byte, which leaves the lowest mark,
+*  and whether any is set, unchanged.
+*
+* Parameters:
+*  value - word to inspect
+*
+* Return:
+*  uint32_t - non-zero bits in the zero bytes, lowest address lowest
+*
+*******************************************************************************/
+static inline uint32_t simd_zero_bytes(uint32_t value)
+{
+#if SIMD_OPS_DSP
+    (void)__USUB8(value, SIMD_BYTES_01);
+
+    return __SEL(0u, 0xFFFFFFFFUL);
+#else
+    return (value - SIMD_BYTES_01) & ~value & SIMD_BYTES_80;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: simd_byte_sum
+********************************************************************************
+* Summary:
+*  Adds the four bytes of a word to a sum (USADA8 against zero).
+*
+* Parameters:
+*  value - word whose bytes are added
+*  sum - running sum
+*
+* Return:
+*  uint32_t - new sum
+*
+*******************************************************************************/
+static inline uint32_t simd_byte_sum(uint32_t value, uint32_t sum)
+{
+#if SIMD_OPS_DSP
+    return __USADA8(value, 0u, sum);
+#else
+    value = (value & 0x00FF00FFUL) + ((value >> 8) & 0x00FF00FFUL);
+
+    return sum + (value & 0xFFFFu) + (value >> 16);
+#endif
+}
+
+/* [] END OF FILE */
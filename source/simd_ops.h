@@ -0,0 +1,99 @@
+/*******************************************************************************
+* File Name:   simd_ops.h
+*
+* Description: Word-parallel compare, search and checksum kernels for buffers read from
+* the HYPERRAM. Each loop step covers one 32-byte D-cache line. The CM7
+* build uses the DSP extension (USADA8, USUB8/SEL); host builds use
+* portable C with the same results.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SIMD_OPS_H
+#define SIMD_OPS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "platform.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+#if !defined(HYPERRAM_HOST_SIM) && defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#define SIMD_OPS_DSP                    (1)
+#else
+#define SIMD_OPS_DSP                    (0)
+#endif
+
+/* Bytes handled per unrolled loop step */
+#define SIMD_OPS_BLOCK                  (32u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+/* Running checksum of a byte stream fed in blocks of any size. sum is the
+ * sum of all bytes; xor_word is the XOR of the stream taken as little-endian
+ * words from its first byte. */
+typedef struct
+{
+    uint32_t sum;
+    uint32_t xor_word;
+    uint32_t position;          /* bytes fed so far */
+} simd_checksum_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool simd_equal(const void* a, const void* b, uint32_t size);
+uint32_t simd_first_diff(const void* a, const void* b, uint32_t size);
+uint32_t simd_first_not(const void* data, uint32_t size, uint32_t pattern);
+uint32_t simd_find_word(const void* data, uint32_t size, uint32_t word);
+uint32_t simd_find_byte(const void* data, uint32_t size, uint8_t value);
+void simd_checksum_init(simd_checksum_t* checksum);
+void simd_checksum_update(simd_checksum_t* checksum, const void* data, uint32_t size);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* SIMD_OPS_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,1175 @@
+/*******************************************************************************
+* File Name:   stress.c
+*
+* Description: Randomized HYPERRAM stress and soak test, see stress.h. Expected data is a
+* hash of the device address and the generation stamp of its shadow cell, so
+* the whole 14 MB region is checked with a few KB of SRAM and any aliasing
+* between addresses shows up as a mismatch.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include "platform.h"
+#include "stress.h"
+#include "perf_counter.h"
+#include "hyperram.h"
+#include "hyperram_dma.h"
+#include "simd_ops.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+#define STRESS_CELL_COUNT               (STRESS_REGION_SIZE / STRESS_CELL_SIZE)
+#define STRESS_REGION_END               (STRESS_REGION_OFFSET + STRESS_REGION_SIZE)
+
+/* Largest transfer is 2 << STRESS_SIZE_CLASSES bytes */
+#define STRESS_SIZE_CLASSES             (13u)
+
+/* Upper bound on single-word reads issued by one line fill operation */
+#define STRESS_MAX_LINE_READS           (64u)
+
+#define STRESS_DEFAULT_SEED             (0x2545F491UL)
+#define STRESS_NS_PER_S                 (1000000000ULL)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef enum
+{
+    STRESS_OP_CMD_WRITE = 0,
+    STRESS_OP_CMD_READ,
+    STRESS_OP_XIP_WRITE,
+    STRESS_OP_XIP_READ,
+    STRESS_OP_XIP_LINE,         /* scattered single-word reads, one line fill each */
+    STRESS_OP_CMD_WRAP,         /* command-mode wrapped bursts */
+    STRESS_OP_DMA_WRITE,
+    STRESS_OP_DMA_READ,
+    STRESS_OP_CONCURRENT,       /* DMA write of one range while the CPU reads another */
+    STRESS_OP_SWEEP,            /* final read-back of the whole region */
+    STRESS_OP_COUNT
+} stress_op_t;
+
+typedef struct
+{
+    uint32_t ops;
+    uint32_t errors;            /* operations that failed or returned bad data */
+    uint32_t bit_errors;
+    uint64_t bytes;
+    uint64_t ns;                /* time spent in the transfers only */
+} stress_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint32_t stress_random(void);
+static stress_op_t stress_pick_op(void);
+static uint32_t stress_pick_size(void);
+static uint32_t stress_pick_address(uint32_t size);
+static uint32_t stress_pattern_word(uint32_t address, uint32_t stamp);
+static void stress_pattern_fill(uint8_t* buf, uint32_t address, uint32_t size);
+static void stress_advance_stamps(uint32_t address, uint32_t size);
+static bool stress_ranges_disjoint(uint32_t address_a, uint32_t size_a,
+                                   uint32_t address_b, uint32_t size_b);
+static void stress_write(stress_op_t op, uint32_t address, uint32_t size);
+static void stress_read(stress_op_t op, uint32_t address, uint32_t size);
+static void stress_line_reads(uint32_t address, uint32_t size);
+static void stress_wrapped_reads(uint32_t address, uint32_t size);
+static void stress_concurrent(uint32_t address, uint32_t size);
+static bool stress_fill_region(void);
+static void stress_sweep(void);
+static bool stress_check(stress_op_t op, uint32_t address, const uint8_t* expected,
+                         const uint8_t* actual, uint32_t size);
+static void stress_fail(stress_op_t op, uint32_t address, uint32_t size);
+static void stress_repair(uint32_t address, uint32_t size);
+static void stress_account(stress_op_t op, uint32_t bytes, uint32_t start);
+static void stress_report_progress(uint32_t ops, uint64_t elapsed_ns);
+static void stress_report_final(uint32_t seed, uint32_t ops, uint64_t elapsed_ns);
+static uint32_t stress_mbps_milli(uint64_t bytes, uint64_t ns);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+static uint16_t stress_stamps[STRESS_CELL_COUNT];
+
+CY_ALIGN(PLATFORM_CACHE_LINE) static uint8_t stress_expected[STRESS_MAX_TRANSFER];
+CY_ALIGN(PLATFORM_CACHE_LINE) static uint8_t stress_actual[STRESS_MAX_TRANSFER];
+CY_ALIGN(PLATFORM_CACHE_LINE) static uint8_t stress_background[STRESS_MAX_TRANSFER];
+
+static uint32_t stress_state;
+static uint32_t stress_salt;
+static uint32_t stress_logged;
+static stress_stats_t stress_stats[STRESS_OP_COUNT];
+
+static const char* const stress_op_names[STRESS_OP_COUNT] =
+{
+    "cmd_write", "cmd_read", "xip_write", "xip_read", "xip_line", "cmd_wrap",
+    "dma_write", "dma_read", "concurrent", "sweep",
+};
+
+/* Relative frequency of each operation; reads also follow half of the writes */
+static const uint8_t stress_op_weights[STRESS_OP_COUNT] =
+{
+    3u, 3u, 3u, 4u, 2u, 2u, 3u, 4u, 2u, 0u,
+};
+
+/*******************************************************************************
+* Function Name: stress_run
+********************************************************************************
+* Summary:
+*  Fills the stress region with the initial pattern, runs random operations
+*  until the configured duration or operation count is reached and finally
+*  reads back the whole region. With neither limit set the test runs until
+*  reset, printing a progress line every STRESS_REPORT_INTERVAL_S seconds.
+*  The HYPERRAM must be initialized.
+*
+* Parameters:
+*  config - seed and stop conditions
+*
+* Return:
+*  bool - true if no error was found
+*
+*******************************************************************************/
+bool stress_run(const stress_config_t* config)
+{
+    uint64_t elapsed_ns = 0u;
+    uint64_t next_report_ns = (uint64_t)STRESS_REPORT_INTERVAL_S * STRESS_NS_PER_S;
+    uint64_t limit_ns = (uint64_t)config->duration_s * STRESS_NS_PER_S;
+    uint32_t seed = (0u != config->seed) ? config->seed : STRESS_DEFAULT_SEED;
+    uint32_t ops = 0u;
+    uint32_t last;
+
+    perf_counter_init();
+    (void)hyperram_dma_init();
+
+    stress_state = seed;
+    stress_salt = stress_random();
+    stress_logged = 0u;
+    memset(stress_stats, 0, sizeof(stress_stats));
+
+    PLATFORM_PRINTF("\r\nSTRESS seed=0x%08lX region=0x%08lX+0x%08lX duration=%lus ops=%lu\r\n",
+                    (unsigned long)seed, (unsigned long)STRESS_REGION_OFFSET,
+                    (unsigned long)STRESS_REGION_SIZE, (unsigned long)config->duration_s,
+                    (unsigned long)config->max_ops);
+    PLATFORM_FLUSH();
+
+    if (!stress_fill_region())
+    {
+        PLATFORM_PRINTF("STRESS-RESULT FAIL initial fill\r\n");
+        PLATFORM_FLUSH();
+        return false;
+    }
+
+    last = perf_counter_now();
+
+    while (((0u == config->max_ops) || (ops < config->max_ops)) &&
+           ((0u == limit_ns) || (elapsed_ns < limit_ns)))
+    {
+        uint32_t size = stress_pick_size();
+        uint32_t address = stress_pick_address(size);
+        stress_op_t op = stress_pick_op();
+        uint32_t now;
+
+        switch (op)
+        {
+            case STRESS_OP_CMD_WRITE:
+            case STRESS_OP_XIP_WRITE:
+            case STRESS_OP_DMA_WRITE:
+                stress_write(op, address, size);
+                if (0u != (stress_random() & 1u))
+                {
+                    /* Read back through a randomly chosen path */
+                    static const stress_op_t read_ops[] =
+                        { STRESS_OP_CMD_READ, STRESS_OP_XIP_READ, STRESS_OP_DMA_READ };
+
+                    stress_read(read_ops[stress_random() % 3u], address, size);
+                }
+                break;
+
+            case STRESS_OP_CMD_READ:
+            case STRESS_OP_XIP_READ:
+            case STRESS_OP_DMA_READ:
+                stress_read(op, address, size);
+                break;
+
+            case STRESS_OP_XIP_LINE:
+                stress_line_reads(address, size);
+                break;
+
+            case STRESS_OP_CMD_WRAP:
+                stress_wrapped_reads(address, size);
+                break;
+
+            default:
+                stress_concurrent(address, size);
+                break;
+        }
+
+        ops++;
+        now = perf_counter_now();
+        elapsed_ns += perf_counter_to_ns(now - last);
+        last = now;
+
+        if (elapsed_ns >= next_report_ns)
+        {
+            stress_report_progress(ops, elapsed_ns);
+            next_report_ns += (uint64_t)STRESS_REPORT_INTERVAL_S * STRESS_NS_PER_S;
+        }
+    }
+
+    stress_sweep();
+    stress_report_final(seed, ops, elapsed_ns);
+
+    for (uint32_t index = 0; index < STRESS_OP_COUNT; index++)
+    {
+        if (0u != stress_stats[index].errors)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: stress_random
+********************************************************************************
+* Summary:
+*  xorshift32 generator. The sequence depends only on the seed, so a failing
+*  run can be repeated.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t - next random value
+*
+*******************************************************************************/
+static uint32_t stress_random(void)
+{
+    uint32_t x = stress_state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    stress_state = x;
+
+    return x;
+}
+
+/*******************************************************************************
+* Function Name: stress_pick_op
+********************************************************************************
+* Summary:
+*  Picks an operation according to stress_op_weights.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  stress_op_t - operation to run
+*
+*******************************************************************************/
+static stress_op_t stress_pick_op(void)
+{
+    uint32_t total = 0u;
+    uint32_t pick;
+
+    for (uint32_t index = 0; index < STRESS_OP_COUNT; index++)
+    {
+        total += stress_op_weights[index];
+    }
+
+    pick = stress_random() % total;
+
+    for (uint32_t index = 0; index < STRESS_OP_COUNT; index++)
+    {
+        if (pick < stress_op_weights[index])
+        {
+            return (stress_op_t)index;
+        }
+        pick -= stress_op_weights[index];
+    }
+
+    return STRESS_OP_CMD_READ;
+}
+
+/*******************************************************************************
+* Function Name: stress_pick_size
+********************************************************************************
+* Summary:
+*  Picks an even transfer size, spread evenly over powers of two so that
+*  short and long bursts are equally common. A quarter of the sizes are
+*  exact powers of two.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t - size in bytes, 2 to STRESS_MAX_TRANSFER
+*
+*******************************************************************************/
+static uint32_t stress_pick_size(void)
+{
+    uint32_t limit = 2u << (stress_random() % (STRESS_SIZE_CLASSES + 1u));
+    uint32_t size;
+
+    if (0u == (stress_random() & 3u))
+    {
+        return limit;
+    }
+
+    size = (stress_random() % limit) & ~1u;
+
+    return (0u != size) ? size : 2u;
+}
+
+/*******************************************************************************
+* Function Name: stress_pick_address
+********************************************************************************
+* Summary:
+*  Picks an even device address so that the transfer fits in the stress
+*  region. Some transfers are cache line aligned and some straddle the
+*  boundary between the two dies.
+*
+* Parameters:
+*  size - transfer size in bytes
+*
+* Return:
+*  uint32_t - device byte address
+*
+*******************************************************************************/
+static uint32_t stress_pick_address(uint32_t size)
+{
+    uint32_t selector = stress_random() & 15u;
+    uint32_t address;
+
+    if ((0u == selector) && (size > 2u))
+    {
+        address = HYPERRAM_DIE_SIZE - (((stress_random() % (size - 2u)) + 2u) & ~1u);
+    }
+    else
+    {
+        address = STRESS_REGION_OFFSET + ((stress_random() % (STRESS_REGION_SIZE - size + 1u)) & ~1u);
+
+        if (selector < 4u)
+        {
+            address &= ~(PLATFORM_CACHE_LINE - 1u);
+        }
+    }
+
+    return address;
+}
+
+/*******************************************************************************
+* Function Name: stress_pattern_word
+********************************************************************************
+* Summary:
+*  Expected contents of one 32-bit word.
+*
+* Parameters:
+*  address - word aligned device address
+*  stamp - generation stamp of the cell holding the word
+*
+* Return:
+*  uint32_t - expected word
+*
+*******************************************************************************/
+static uint32_t stress_pattern_word(uint32_t address, uint32_t stamp)
+{
+    uint32_t x = ((address >> 2) * 0x9E3779B1UL) + (stamp * 0x85EBCA77UL) + stress_salt;
+
+    x ^= x >> 16;
+    x *= 0x7FEB352DUL;
+    x ^= x >> 15;
+    x *= 0x846CA68BUL;
+    x ^= x >> 16;
+
+    return x;
+}
+
+/*******************************************************************************
+* Function Name: stress_pattern_fill
+********************************************************************************
+* Summary:
+*  Generates the expected contents of a device range from the shadow table.
+*
+* Parameters:
+*  buf - destination buffer
+*  address - device byte address inside the stress region
+*  size - number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void stress_pattern_fill(uint8_t* buf, uint32_t address, uint32_t size)
+{
+    uint32_t index = 0u;
+
+    while (index < size)
+    {
+        uint32_t current = address + index;
+        uint32_t word = stress_pattern_word(current & ~3u,
+            stress_stamps[(current - STRESS_REGION_OFFSET) / STRESS_CELL_SIZE]);
+
+        for (uint32_t lane = current & 3u; (lane < 4u) && (index < size); lane++)
+        {
+            buf[index++] = (uint8_t)(word >> (lane * 8u));
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: stress_advance_stamps
+********************************************************************************
+* Summary:
+*  Moves every cell completely covered by a write to a new generation. Cells
+*  only partly covered keep their stamp, so the write stores the same bytes
+*  there and the rest of the cell stays valid.
+*
+* Parameters:
+*  address - device byte address
+*  size - number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void stress_advance_stamps(uint32_t address, uint32_t size)
+{
+    uint32_t first = ((address - STRESS_REGION_OFFSET) + STRESS_CELL_SIZE - 1u) / STRESS_CELL_SIZE;
+    uint32_t end = ((address - STRESS_REGION_OFFSET) + size) / STRESS_CELL_SIZE;
+
+    for (uint32_t cell = first; cell < end; cell++)
+    {
+        stress_stamps[cell]++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: stress_ranges_disjoint
+********************************************************************************
+* Summary:
+*  Checks that two ranges share no shadow cell. Cells are whole cache lines,
+*  so disjoint ranges also never share a D-cache line.
+*
+* Parameters:
+*  address_a, size_a - first range
+*  address_b, size_b - second range
+*
+* Return:
+*  bool - true if no cell is shared
+*
+*******************************************************************************/
+static bool stress_ranges_disjoint(uint32_t address_a, uint32_t size_a,
+                                   uint32_t address_b, uint32_t size_b)
+{
+    uint32_t first_a = (address_a - STRESS_REGION_OFFSET) / STRESS_CELL_SIZE;
+    uint32_t last_a = ((address_a - STRESS_REGION_OFFSET) + size_a - 1u) / STRESS_CELL_SIZE;
+    uint32_t first_b = (address_b - STRESS_REGION_OFFSET) / STRESS_CELL_SIZE;
+    uint32_t last_b = ((address_b - STRESS_REGION_OFFSET) + size_b - 1u) / STRESS_CELL_SIZE;
+
+    return (last_a < first_b) || (last_b < first_a);
+}
+
+/*******************************************************************************
+* Function Name: stress_write
+********************************************************************************
+* Summary:
+*  Writes a new generation of the pattern through one access path. Command
+*  writes start from a random SMIF mode so that both the mode switch and the
+*  restore are exercised. CPU writes through the XIP window are cleaned from
+*  the D-cache as part of the timed operation.
+*
+* Parameters:
+*  op - STRESS_OP_CMD_WRITE, STRESS_OP_XIP_WRITE or STRESS_OP_DMA_WRITE
+*  address - device byte address
+*  size - number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void stress_write(stress_op_t op, uint32_t address, uint32_t size)
+{
+    uint8_t* xip = (uint8_t*)hyperram_xip_ptr(address);
+    bool success = true;
+    uint32_t start;
+
+    stress_advance_stamps(address, size);
+    stress_pattern_fill(stress_expected, address, size);
+
+    if ((STRESS_OP_CMD_WRITE != op) || (0u != (stress_random() & 1u)))
+    {
+        hyperram_enter_xip();
+    }
+    else
+    {
+        hyperram_enter_command();
+    }
+
+    start = perf_counter_now();
+
+    if (STRESS_OP_CMD_WRITE == op)
+    {
+        success = (HYPERRAM_SUCCESS == hyperram_write(address, stress_expected, size));
+    }
+    else if (STRESS_OP_XIP_WRITE == op)
+    {
+        memcpy(xip, stress_expected, size);
+        platform_dcache_clean(xip, size);
+    }
+    else
+    {
+        success = (HYPERRAM_SUCCESS == hyperram_dma_copy(xip, stress_expected, size));
+    }
+
+    stress_account(op, size, start);
+
+    /* Command writes bypass the D-cache, drop any stale lines */
+    if (STRESS_OP_CMD_WRITE == op)
+    {
+        platform_dcache_invalidate(xip, size);
+    }
+
+    if (!success)
+    {
+        stress_fail(op, address, size);
+    }
+}
+
+/*******************************************************************************
+* Function Name: stress_read
+********************************************************************************
+* Summary:
+*  Reads a range through one access path and checks it. Half of the CPU reads
+*  through the XIP window invalidate the range first; the others may be served
+*  partly from the D-cache, which checks that earlier maintenance was right.
+*
+* Parameters:
+*  op - STRESS_OP_CMD_READ, STRESS_OP_XIP_READ or STRESS_OP_DMA_READ
+*  address - device byte address
+*  size - number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void stress_read(stress_op_t op, uint32_t address, uint32_t size)
+{
+    const uint8_t* xip = (const uint8_t*)hyperram_xip_ptr(address);
+    bool success = true;
+    uint32_t start;
+
+    stress_pattern_fill(stress_expected, address, size);
+
+    if ((STRESS_OP_CMD_READ != op) || (0u != (stress_random() & 1u)))
+    {
+        hyperram_enter_xip();
+    }
+    else
+    {
+        hyperram_enter_command();
+    }
+
+    if ((STRESS_OP_XIP_READ == op) && (0u != (stress_random() & 1u)))
+    {
+        platform_dcache_invalidate(xip, size);
+    }
+
+    start = perf_counter_now();
+
+    if (STRESS_OP_CMD_READ == op)
+    {
+        success = (HYPERRAM_SUCCESS == hyperram_read(address, stress_actual, size));
+    }
+    else if (STRESS_OP_XIP_READ == op)
+    {
+        memcpy(stress_actual, xip, size);
+    }
+    else
+    {
+        success = (HYPERRAM_SUCCESS == hyperram_dma_copy(stress_actual, xip, size));
+    }
+
+    stress_account(op, size, start);
+
+    if (!success)
+    {
+        stress_fail(op, address, size);
+    }
+    else
+    {
+        (void)stress_check(op, address, stress_expected, stress_actual, size);
+    }
+}
+
+/*******************************************************************************
+* Function Name: stress_line_reads
+********************************************************************************
+* Summary:
+*  Issues scattered 32-bit reads inside a range, each to a freshly
+*  invalidated line, so that every read is a critical-word-first line fill
+*  from the device.
+*
+* Parameters:
+*  address - device byte address
+*  size - range in bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void stress_line_reads(uint32_t address, uint32_t size)
+{
+    uint32_t words = size / 4u;
+    uint32_t count = (size / PLATFORM_CACHE_LINE) + 1u;
+    uint32_t start;
+
+    if (0u == words)
+    {
+        return;
+    }
+
+    if (count > STRESS_MAX_LINE_READS)
+    {
+        count = STRESS_MAX_LINE_READS;
+    }
+
+    hyperram_enter_xip();
+
+    for (uint32_t index = 0; index < count; index++)
+    {
+        uint32_t word_address = ((address + 3u) & ~3u) + ((stress_random() % words) * 4u);
+        volatile uint32_t* xip;
+        uint32_t value;
+
+        if ((word_address + 4u) > (address + size))
+        {
+            word_address -= 4u;
+        }
+
+        xip = (volatile uint32_t*)hyperram_xip_ptr(word_address);
+        stress_pattern_fill(&stress_expected[index * 4u], word_address, 4u);
+        platform_dcache_invalidate(xip, 4u);
+
+        start = perf_counter_now();
+        value = *xip;
+        stress_account(STRESS_OP_XIP_LINE, 4u, start);
+
+        memcpy(&stress_actual[index * 4u], &value, 4u);
+
+        if (!stress_check(STRESS_OP_XIP_LINE, word_address, &stress_expected[index * 4u],
+                          &stress_actual[index * 4u], 4u))
+        {
+            break;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: stress_wrapped_reads
+********************************************************************************
+* Summary:
+*  Issues command-mode wrapped bursts at random even offsets of the
+*  HYPERRAM_WRAP_SIZE groups that a range touches, with random lengths, so
+*  that bursts wrap at the group end. The expected data is the group
+*  pattern rotated to the start offset.
+*
+* Parameters:
+*  address - device byte address
+*  size - range in bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void stress_wrapped_reads(uint32_t address, uint32_t size)
+{
+    uint32_t count = (size / HYPERRAM_WRAP_SIZE) + 1u;
+    uint8_t* group_data = &stress_expected[STRESS_MAX_TRANSFER - HYPERRAM_WRAP_SIZE];
+    uint32_t start;
+
+    if (count > STRESS_MAX_LINE_READS)
+    {
+        count = STRESS_MAX_LINE_READS;
+    }
+
+    for (uint32_t index = 0; index < count; index++)
+    {
+        uint32_t group = (address + (stress_random() % size)) & ~(HYPERRAM_WRAP_SIZE - 1u);
+        uint32_t first = (stress_random() % HYPERRAM_WRAP_SIZE) & ~1u;
+        uint32_t length = ((stress_random() % (HYPERRAM_WRAP_SIZE / 2u)) + 1u) * 2u;
+        hyperram_status_t status;
+
+        /* A burst may run into the next group's range on repair; stay in the region */
+        if (group > (STRESS_REGION_END - (2u * HYPERRAM_WRAP_SIZE)))
+        {
+            group = STRESS_REGION_END - (2u * HYPERRAM_WRAP_SIZE);
+        }
+
+        stress_pattern_fill(group_data, group, HYPERRAM_WRAP_SIZE);
+        for (uint32_t byte = 0; byte < length; byte++)
+        {
+            stress_expected[byte] = group_data[(first + byte) & (HYPERRAM_WRAP_SIZE - 1u)];
+        }
+
+        start = perf_counter_now();
+        status = hyperram_read_wrapped(group + first, stress_actual, length);
+        stress_account(STRESS_OP_CMD_WRAP, length, start);
+
+        if (HYPERRAM_SUCCESS != status)
+        {
+            stress_fail(STRESS_OP_CMD_WRAP, group + first, length);
+            break;
+        }
+
+        if (!stress_check(STRESS_OP_CMD_WRAP, group + first, stress_expected, stress_actual, length))
+        {
+            break;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: stress_concurrent
+********************************************************************************
+* Summary:
+*  Starts a DMA write of one range and, while it runs, reads a second,
+*  disjoint range with the CPU through the XIP window. Both ranges are checked
+*  afterwards; the written range is read back in command mode. A DMA error is
+*  counted as a failed write. If no disjoint range is found, only the write
+*  runs.
+*
+* Parameters:
+*  address - device byte address of the DMA write
+*  size - number of bytes written
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void stress_concurrent(uint32_t address, uint32_t size)
+{
+    uint32_t read_size = stress_pick_size();
+    uint32_t read_address = stress_pick_address(read_size);
+    const uint8_t* read_xip;
+    bool started;
+    uint32_t start;
+
+    for (uint32_t attempt = 0; (attempt < 8u) &&
+         !stress_ranges_disjoint(address, size, read_address, read_size); attempt++)
+    {
+        read_address = stress_pick_address(read_size);
+    }
+
+    if (!stress_ranges_disjoint(address, size, read_address, read_size))
+    {
+        read_size = 0u;
+    }
+
+    read_xip = (const uint8_t*)hyperram_xip_ptr(read_address);
+
+    stress_advance_stamps(address, size);
+    stress_pattern_fill(stress_background, address, size);
+    stress_pattern_fill(stress_expected, read_address, read_size);
+
+    hyperram_enter_xip();
+    if (0u != read_size)
+    {
+        platform_dcache_invalidate(read_xip, read_size);
+    }
+
+    start = perf_counter_now();
+    started = (HYPERRAM_SUCCESS == hyperram_dma_copy_async(hyperram_xip_ptr(address),
+                                                           stress_background, size, NULL, NULL));
+    if (0u != read_size)
+    {
+        memcpy(stress_actual, read_xip, read_size);
+    }
+    if (started)
+    {
+        hyperram_dma_wait();
+        started = (HYPERRAM_SUCCESS == hyperram_dma_get_result());
+    }
+    stress_account(STRESS_OP_CONCURRENT, size + read_size, start);
+
+    /* Check both ranges; a bad read does not excuse the write */
+    if (0u != read_size)
+    {
+        (void)stress_check(STRESS_OP_CONCURRENT, read_address, stress_expected, stress_actual, read_size);
+    }
+
+    if (!started || (HYPERRAM_SUCCESS != hyperram_read(address, stress_actual, size)))
+    {
+        stress_fail(STRESS_OP_CONCURRENT, address, size);
+    }
+    else
+    {
+        (void)stress_check(STRESS_OP_CONCURRENT, address, stress_background, stress_actual, size);
+    }
+}
+
+/*******************************************************************************
+* Function Name: stress_fill_region
+********************************************************************************
+* Summary:
+*  Writes generation 0 of the pattern to the whole stress region by DMA.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true on success
+*
+*******************************************************************************/
+static bool stress_fill_region(void)
+{
+    memset(stress_stamps, 0, sizeof(stress_stamps));
+    hyperram_enter_xip();
+
+    for (uint32_t address = STRESS_REGION_OFFSET; address < STRESS_REGION_END;
+         address += STRESS_MAX_TRANSFER)
+    {
+        stress_pattern_fill(stress_expected, address, STRESS_MAX_TRANSFER);
+
+        if (HYPERRAM_SUCCESS != hyperram_dma_copy(hyperram_xip_ptr(address), stress_expected,
+                                                  STRESS_MAX_TRANSFER))
+        {
+            return false;
+        }
+    }
+
+    platform_dcache_invalidate(hyperram_xip_ptr(STRESS_REGION_OFFSET), STRESS_REGION_SIZE);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: stress_sweep
+********************************************************************************
+* Summary:
+*  Reads back the whole stress region by DMA and checks it, so that writes
+*  that were never read back during the run are verified too.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void stress_sweep(void)
+{
+    hyperram_enter_xip();
+
+    for (uint32_t address = STRESS_REGION_OFFSET; address < STRESS_REGION_END;
+         address += STRESS_MAX_TRANSFER)
+    {
+        uint32_t start;
+        bool success;
+
+        stress_pattern_fill(stress_expected, address, STRESS_MAX_TRANSFER);
+
+        start = perf_counter_now();
+        success = (HYPERRAM_SUCCESS == hyperram_dma_copy(stress_actual, hyperram_xip_ptr(address),
+                                                         STRESS_MAX_TRANSFER));
+        stress_account(STRESS_OP_SWEEP, STRESS_MAX_TRANSFER, start);
+
+        if (!success)
+        {
+            stress_fail(STRESS_OP_SWEEP, address, STRESS_MAX_TRANSFER);
+        }
+        else
+        {
+            (void)stress_check(STRESS_OP_SWEEP, address, stress_expected, stress_actual,
+                               STRESS_MAX_TRANSFER);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: stress_check
+********************************************************************************
+* Summary:
+*  Compares read data with the expected pattern. A mismatch is counted, the
+*  first STRESS_MAX_LOGGED_ERRORS are printed and the range is rewritten so
+*  that one bad write is not reported again by every later read.
+*
+* Parameters:
+*  op - operation the data was read by
+*  address - device byte address of the data
+*  expected - expected bytes
+*  actual - bytes read
+*  size - number of bytes
+*
+* Return:
+*  bool - true if the data matched
+*
+*******************************************************************************/
+static bool stress_check(stress_op_t op, uint32_t address, const uint8_t* expected,
+                         const uint8_t* actual, uint32_t size)
+{
+    uint32_t bad_bytes = 0u;
+    uint32_t bad_bits = 0u;
+    uint32_t first = simd_first_diff(expected, actual, size);
+
+    if (first == size)
+    {
+        return true;
+    }
+
+    for (uint32_t index = first; index < size; index++)
+    {
+        uint32_t diff = (uint32_t)(expected[index] ^ actual[index]);
+
+        if (0u != diff)
+        {
+            bad_bytes++;
+
+            while (0u != diff)
+            {
+                diff &= diff - 1u;
+                bad_bits++;
+            }
+        }
+    }
+
+    stress_stats[op].errors++;
+    stress_stats[op].bit_errors += bad_bits;
+
+    if (stress_logged < STRESS_MAX_LOGGED_ERRORS)
+    {
+        stress_logged++;
+        PLATFORM_PRINTF("STRESS-ERR op=%s addr=0x%08lX size=%lu first=0x%08lX "
+                        "expected=0x%02X got=0x%02X bytes=%lu bits=%lu\r\n",
+                        stress_op_names[op], (unsigned long)address, (unsigned long)size,
+                        (unsigned long)(address + first), (unsigned int)expected[first],
+                        (unsigned int)actual[first], (unsigned long)bad_bytes,
+                        (unsigned long)bad_bits);
+    }
+
+    stress_repair(address, size);
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: stress_fail
+********************************************************************************
+* Summary:
+*  Counts a transfer that reported an error and restores the range.
+*
+* Parameters:
+*  op - failed operation
+*  address - device byte address
+*  size - number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void stress_fail(stress_op_t op, uint32_t address, uint32_t size)
+{
+    stress_stats[op].errors++;
+
+    if (stress_logged < STRESS_MAX_LOGGED_ERRORS)
+    {
+        stress_logged++;
+        PLATFORM_PRINTF("STRESS-ERR op=%s addr=0x%08lX size=%lu transfer failed\r\n",
+                        stress_op_names[op], (unsigned long)address, (unsigned long)size);
+    }
+
+    stress_repair(address, size);
+}
+
+/*******************************************************************************
+* Function Name: stress_repair
+********************************************************************************
+* Summary:
+*  Rewrites a range with its expected contents in command mode.
+*
+* Parameters:
+*  address - device byte address
+*  size - number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void stress_repair(uint32_t address, uint32_t size)
+{
+    void* xip = hyperram_xip_ptr(address);
+
+    stress_pattern_fill(stress_actual, address, size);
+    (void)hyperram_write(address, stress_actual, size);
+    platform_dcache_invalidate(xip, size);
+}
+
+/*******************************************************************************
+* Function Name: stress_account
+********************************************************************************
+* Summary:
+*  Adds one timed transfer to the statistics of an operation.
+*
+* Parameters:
+*  op - operation
+*  bytes - bytes moved
+*  start - cycle counter value at the start of the transfer
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void stress_account(stress_op_t op, uint32_t bytes, uint32_t start)
+{
+    stress_stats[op].ns += perf_counter_to_ns(perf_counter_now() - start);
+    stress_stats[op].bytes += bytes;
+    stress_stats[op].ops++;
+}
+
+/*******************************************************************************
+* Function Name: stress_report_progress
+********************************************************************************
+* Summary:
+*  Prints one progress line with the totals over all operations.
+*
+* Parameters:
+*  ops - random operations run so far
+*  elapsed_ns - run time so far
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void stress_report_progress(uint32_t ops, uint64_t elapsed_ns)
+{
+    uint64_t bytes = 0u;
+    uint32_t errors = 0u;
+    uint32_t bit_errors = 0u;
+    uint32_t mbps;
+
+    for (uint32_t index = 0; index < STRESS_OP_COUNT; index++)
+    {
+        bytes += stress_stats[index].bytes;
+        errors += stress_stats[index].errors;
+        bit_errors += stress_stats[index].bit_errors;
+    }
+
+    mbps = stress_mbps_milli(bytes, elapsed_ns);
+
+    PLATFORM_PRINTF("STRESS t=%lus ops=%lu MB=%lu errors=%lu bit_errors=%lu %lu.%03lu MB/s\r\n",
+                    (unsigned long)(elapsed_ns / STRESS_NS_PER_S), (unsigned long)ops,
+                    (unsigned long)(bytes / 1000000u), (unsigned long)errors,
+                    (unsigned long)bit_errors, (unsigned long)(mbps / 1000u),
+                    (unsigned long)(mbps % 1000u));
+    PLATFORM_FLUSH();
+}
+
+/*******************************************************************************
+* Function Name: stress_report_final
+********************************************************************************
+* Summary:
+*  Prints the per-operation statistics and the overall result. The error
+*  rate is given in failed operations per million; for xip_line every
+*  single-word read counts as one operation.
+*
+* Parameters:
+*  seed - seed of the run
+*  ops - random operations run
+*  elapsed_ns - total run time
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void stress_report_final(uint32_t seed, uint32_t ops, uint64_t elapsed_ns)
+{
+    uint32_t errors = 0u;
+
+    stress_report_progress(ops, elapsed_ns);
+
+    for (uint32_t index = 0; index < STRESS_OP_COUNT; index++)
+    {
+        const stress_stats_t* stats = &stress_stats[index];
+        uint32_t mbps = stress_mbps_milli(stats->bytes, stats->ns);
+        uint32_t ppm = (0u != stats->ops) ?
+            (uint32_t)(((uint64_t)stats->errors * 1000000u) / stats->ops) : 0u;
+
+        PLATFORM_PRINTF("  %-10s ops=%-9lu MB=%-7lu errors=%-5lu ppm=%-7lu bit_errors=%-5lu %lu.%03lu MB/s\r\n",
+                        stress_op_names[index], (unsigned long)stats->ops,
+                        (unsigned long)(stats->bytes / 1000000u), (unsigned long)stats->errors,
+                        (unsigned long)ppm, (unsigned long)stats->bit_errors,
+                        (unsigned long)(mbps / 1000u), (unsigned long)(mbps % 1000u));
+        errors += stats->errors;
+    }
+
+    PLATFORM_PRINTF("STRESS-RESULT %s seed=0x%08lX errors=%lu\r\n",
+                    (0u == errors) ? "PASS" : "FAIL",
+                    (unsigned long)seed, (unsigned long)errors);
+    PLATFORM_FLUSH();
+}
+
+/*******************************************************************************
+* Function Name: stress_mbps_milli
+********************************************************************************
+* Summary:
+*  Throughput in thousandths of MB/s (1 MB = 10^6 bytes), for printing
+*  without floating point support.
+*
+* Parameters:
+*  bytes - bytes moved
+*  ns - time taken
+*
+* Return:
+*  uint32_t - MB/s * 1000
+*
+*******************************************************************************/
+static uint32_t stress_mbps_milli(uint64_t bytes, uint64_t ns)
+{
+    uint64_t us = ns / 1000u;
+
+    return (0u != us) ? (uint32_t)((bytes * 1000u) / us) : 0u;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,105 @@
+/*******************************************************************************
+* File Name:   stress.h
+*
+* Description: Randomized stress and soak test for the HYPERRAM. A seeded generator issues
+* a mix of command-mode, XIP and DMA transfers of random size and address,
+* interleaves SMIF mode switches and D-cache line fills, and verifies every
+* read against data regenerated from a small SRAM shadow table. Progress, error
+* rate and throughput are reported on the console.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef STRESS_H
+#define STRESS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* Device region exercised by the stress test; it spans the die boundary */
+#define STRESS_REGION_OFFSET            (0x00200000UL)
+#define STRESS_REGION_SIZE              (0x00E00000UL)
+
+/* The region covers the linker section range (0x400000 - 0x7FFFFF) */
+#if defined(ENABLE_STRESS) && defined(HYPERRAM_SECTIONS)
+#error "ENABLE_STRESS overwrites the HYPERRAM sections; build without HYPERRAM_SECTIONS=1"
+#endif
+
+/* Granularity of the shadow table. Each cell records a 16-bit generation
+ * stamp from which its expected contents are regenerated. */
+#define STRESS_CELL_SIZE                (1024u)
+
+/* Largest single transfer */
+#define STRESS_MAX_TRANSFER             (16384u)
+
+/* Seconds between progress lines */
+#ifndef STRESS_REPORT_INTERVAL_S
+#define STRESS_REPORT_INTERVAL_S        (60u)
+#endif
+
+/* Detailed error lines printed before only the counters are updated */
+#define STRESS_MAX_LOGGED_ERRORS        (32u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef struct
+{
+    uint32_t seed;              /* generator seed, printed for reproduction    */
+    uint32_t duration_s;        /* stop after this many seconds, 0 = no limit  */
+    uint32_t max_ops;           /* stop after this many operations, 0 = no limit */
+} stress_config_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool stress_run(const stress_config_t* config);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* STRESS_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,299 @@
+/*******************************************************************************
+* File Name:   telemetry.c
+*
+* Description: Binary telemetry framing for memory dumps, counters and trace
+* events. Payloads are sent as raw bytes; all formatting happens on the host.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include "cyhal.h"
+#include "cy_retarget_io.h"
+#include "telemetry.h"
+#include "console.h"
+#include "crc.h"
+#include <string.h>
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+static uint8_t telemetry_seq;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void telemetry_write(const void* data, uint32_t size);
+
+/*******************************************************************************
+* Function Name: telemetry_init
+********************************************************************************
+* Summary:
+*  Prepares the telemetry channel on the retarget-io UART. Optionally raises
+*  the baud rate; the host decoder must be opened at the same rate.
+*
+* Parameters:
+*  baudrate - new UART baud rate, or 0 to keep the current rate
+*
+* Return:
+*  bool - true if the UART accepted the requested rate
+*
+*******************************************************************************/
+bool telemetry_init(uint32_t baudrate)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t actual_baud = 0u;
+
+    telemetry_seq = 0u;
+
+    if (0u != baudrate)
+    {
+        result = cyhal_uart_set_baud(&cy_retarget_io_uart_obj, baudrate, &actual_baud);
+    }
+
+    return (CY_RSLT_SUCCESS == result);
+}
+
+/*******************************************************************************
+* Function Name: telemetry_send_frame
+********************************************************************************
+* Summary:
+*  Sends one frame carrying an opaque payload.
+*
+* Parameters:
+*  type - frame type
+*  payload - payload bytes
+*  size - payload size, at most TELEMETRY_MAX_PAYLOAD
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void telemetry_send_frame(telemetry_type_t type, const void* payload, uint16_t size)
+{
+    CY_ASSERT(size <= TELEMETRY_MAX_PAYLOAD);
+
+    telemetry_send_parts(type, payload, size, NULL, 0u);
+}
+
+/*******************************************************************************
+* Function Name: telemetry_send_dump
+********************************************************************************
+* Summary:
+*  Sends a memory region as a sequence of DUMP frames. Each frame carries the
+*  address of its first byte so the host can reassemble the image and detect
+*  dropped frames.
+*
+* Parameters:
+*  address - address reported for the first byte of data
+*  data - memory to dump
+*  size - number of bytes to dump
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void telemetry_send_dump(uint32_t address, const void* data, uint32_t size)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+
+    while (size > 0u)
+    {
+        uint16_t chunk = (size > TELEMETRY_DUMP_CHUNK) ? (uint16_t)TELEMETRY_DUMP_CHUNK : (uint16_t)size;
+
+        telemetry_send_parts(TELEMETRY_TYPE_DUMP, &address, TELEMETRY_DUMP_ADDR_SIZE, bytes, chunk);
+
+        address += chunk;
+        bytes   += chunk;
+        size    -= chunk;
+    }
+}
+
+/*******************************************************************************
+* Function Name: telemetry_send_counter
+********************************************************************************
+* Summary:
+*  Sends the current value of a numbered counter.
+*
+* Parameters:
+*  id - counter identifier
+*  value - counter value
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void telemetry_send_counter(uint16_t id, uint32_t value)
+{
+    uint8_t payload[6];
+
+    memcpy(&payload[0], &id, sizeof(id));
+    memcpy(&payload[2], &value, sizeof(value));
+
+    telemetry_send_parts(TELEMETRY_TYPE_COUNTER, payload, sizeof(payload), NULL, 0u);
+}
+
+/*******************************************************************************
+* Function Name: telemetry_send_trace
+********************************************************************************
+* Summary:
+*  Sends a timestamped trace event.
+*
+* Parameters:
+*  timestamp - event time in caller defined ticks
+*  event - event identifier
+*  arg - event argument
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void telemetry_send_trace(uint32_t timestamp, uint16_t event, uint32_t arg)
+{
+    uint8_t payload[10];
+
+    memcpy(&payload[0], &timestamp, sizeof(timestamp));
+    memcpy(&payload[4], &event, sizeof(event));
+    memcpy(&payload[6], &arg, sizeof(arg));
+
+    telemetry_send_parts(TELEMETRY_TYPE_TRACE, payload, sizeof(payload), NULL, 0u);
+}
+
+/*******************************************************************************
+* Function Name: telemetry_send_marker
+********************************************************************************
+* Summary:
+*  Sends a labelled marker, used by the host decoder to name the dump and
+*  counter frames that follow it.
+*
+* Parameters:
+*  id - marker identifier
+*  label - NUL terminated label text
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void telemetry_send_marker(uint16_t id, const char* label)
+{
+    size_t length = strlen(label);
+
+    if (length > (TELEMETRY_MAX_PAYLOAD - sizeof(id)))
+    {
+        length = TELEMETRY_MAX_PAYLOAD - sizeof(id);
+    }
+
+    telemetry_send_parts(TELEMETRY_TYPE_MARKER, &id, sizeof(id), label, (uint16_t)length);
+}
+
+/*******************************************************************************
+* Function Name: telemetry_send_parts
+********************************************************************************
+* Summary:
+*  Frames a payload made of two consecutive parts and writes it to the UART
+*  without copying the parts into an intermediate buffer. The combined size
+*  must not exceed TELEMETRY_MAX_PAYLOAD.
+*
+* Parameters:
+*  type - frame type
+*  head - first payload part
+*  head_size - size of the first part
+*  body - second payload part, may be NULL
+*  body_size - size of the second part
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void telemetry_send_parts(telemetry_type_t type, const void* head, uint16_t head_size,
+                          const void* body, uint16_t body_size)
+{
+    uint8_t header[TELEMETRY_HEADER_SIZE];
+    uint8_t trailer[TELEMETRY_CRC_SIZE];
+    uint16_t length = (uint16_t)(head_size + body_size);
+    uint16_t crc;
+
+    header[0] = TELEMETRY_SOF0;
+    header[1] = TELEMETRY_SOF1;
+    header[2] = (uint8_t)type;
+    header[3] = telemetry_seq++;
+    header[4] = (uint8_t)(length & 0xFFu);
+    header[5] = (uint8_t)(length >> 8);
+
+    crc = crc16_ccitt_update(CRC16_CCITT_INIT, &header[2], TELEMETRY_HEADER_SIZE - 2u);
+    crc = crc16_ccitt_update(crc, head, head_size);
+    crc = crc16_ccitt_update(crc, body, body_size);
+
+    trailer[0] = (uint8_t)(crc & 0xFFu);
+    trailer[1] = (uint8_t)(crc >> 8);
+
+    /* Frames that do not fit in the console ring are dropped whole; the host
+     * sees the gap in the sequence numbers. */
+    if (!console_reserve(TELEMETRY_HEADER_SIZE + length + TELEMETRY_CRC_SIZE))
+    {
+        return;
+    }
+
+    telemetry_write(header, sizeof(header));
+    telemetry_write(head, head_size);
+    telemetry_write(body, body_size);
+    telemetry_write(trailer, sizeof(trailer));
+}
+
+/*******************************************************************************
+* Function Name: telemetry_write
+********************************************************************************
+* Summary:
+*  Pushes raw bytes to the console, which queues them for DMA once
+*  console_init() has run and writes them blocking before that.
+*
+* Parameters:
+*  data - bytes to send
+*  size - number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void telemetry_write(const void* data, uint32_t size)
+{
+    (void)console_write(data, size);
+}
+
+/* [] END OF FILE */
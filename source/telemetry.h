@@ -0,0 +1,108 @@
+/*******************************************************************************
+* File Name:   telemetry.h
+*
+* Description: Framed, CRC protected binary telemetry channel carried on the debug
+* UART. Frames can be interleaved with plain console text; the host decoder
+* (tools/telemetry_decode.py) resynchronizes on the start-of-frame marker.
+*
+* Frame layout (all multi-byte fields are little endian):
+*   SOF0 (0xA5) | SOF1 (0x5A) | type | seq | length (2) | payload | CRC16 (2)
+* The CRC-16/CCITT-FALSE covers type, seq, length and payload.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+#define TELEMETRY_SOF0                  (0xA5u)
+#define TELEMETRY_SOF1                  (0x5Au)
+#define TELEMETRY_HEADER_SIZE           (6u)
+#define TELEMETRY_CRC_SIZE              (2u)
+
+/* Largest payload carried by a single frame. Longer dumps are split. */
+#define TELEMETRY_MAX_PAYLOAD           (1024u)
+
+/* Bytes of a DUMP payload taken by the address field */
+#define TELEMETRY_DUMP_ADDR_SIZE        (4u)
+#define TELEMETRY_DUMP_CHUNK            (TELEMETRY_MAX_PAYLOAD - TELEMETRY_DUMP_ADDR_SIZE)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef enum
+{
+    TELEMETRY_TYPE_DUMP    = 0x01u, /* u32 address, raw bytes                */
+    TELEMETRY_TYPE_COUNTER = 0x02u, /* u16 id, u32 value                     */
+    TELEMETRY_TYPE_TRACE   = 0x03u, /* u32 timestamp, u16 event, u32 arg     */
+    TELEMETRY_TYPE_MARKER  = 0x04u, /* u16 id, NUL-free label bytes          */
+
+    /* Memory transfer service, see xfer_server.h */
+    TELEMETRY_TYPE_XFER_DATA   = 0x10u, /* u32 offset, u32 CRC-32, data      */
+    TELEMETRY_TYPE_XFER_ACK    = 0x11u, /* u32 next expected offset          */
+    TELEMETRY_TYPE_XFER_STATUS = 0x12u, /* u32 code, u32 value0, u32 value1  */
+} telemetry_type_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool telemetry_init(uint32_t baudrate);
+void telemetry_send_frame(telemetry_type_t type, const void* payload, uint16_t size);
+void telemetry_send_parts(telemetry_type_t type, const void* head, uint16_t head_size,
+                          const void* body, uint16_t body_size);
+void telemetry_send_dump(uint32_t address, const void* data, uint32_t size);
+void telemetry_send_counter(uint16_t id, uint32_t value);
+void telemetry_send_trace(uint32_t timestamp, uint16_t event, uint32_t arg);
+void telemetry_send_marker(uint16_t id, const char* label);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* TELEMETRY_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,743 @@
+/*******************************************************************************
+* File Name:   xfer_server.c
+*
+* Description: HYPERRAM dump/upload command handler. Device data is staged in
+* SRAM in XFER_CHUNK_SIZE pieces by DMA through the XIP window and sent to
+* the host as windowed DATA frames through the DMA-driven console ring.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include "cyhal.h"
+#include "cy_retarget_io.h"
+#include "platform.h"
+#include "xfer_server.h"
+#include "telemetry.h"
+#include "console.h"
+#include "hyperram.h"
+#include "hyperram_dma.h"
+#include "crc.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+#define XFER_DATA_HEADER_SIZE           (8u)
+#define XFER_FRAME_MAX                  (TELEMETRY_HEADER_SIZE + TELEMETRY_MAX_PAYLOAD + TELEMETRY_CRC_SIZE)
+#define XFER_RX_BURST                   (64u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+typedef enum
+{
+    XFER_STATE_IDLE,
+    XFER_STATE_READING,
+    XFER_STATE_WRITING,
+} xfer_state_t;
+
+typedef struct
+{
+    xfer_state_t state;
+    uint32_t end;           /* one past the last device byte of the transfer  */
+    uint32_t next;          /* read: next block to send, write: next expected */
+    uint32_t acked;         /* read: everything below is confirmed by host    */
+    uint32_t crc;           /* write: running CRC-32 of the accepted image    */
+    uint32_t length;        /* write: total length for the DONE report        */
+    uint32_t stage_addr;    /* device address of xfer_stage[0]                */
+    uint32_t stage_fill;    /* valid bytes in xfer_stage                      */
+} xfer_session_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+
+CY_ALIGN(PLATFORM_CACHE_LINE) static uint8_t xfer_stage[XFER_CHUNK_SIZE];
+static uint8_t xfer_rx_frame[XFER_FRAME_MAX];
+static uint32_t xfer_rx_count;
+static xfer_session_t xfer_session;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void xfer_rx_byte(uint8_t byte);
+static void xfer_dispatch(uint8_t type, const uint8_t* payload, uint16_t length);
+static void xfer_start_read(uint32_t address, uint32_t length);
+static void xfer_start_write(uint32_t address, uint32_t length);
+static void xfer_handle_data(const uint8_t* payload, uint16_t length);
+static void xfer_handle_ack(uint32_t offset);
+static void xfer_handle_baud(uint32_t baudrate);
+static void xfer_pump(void);
+static void xfer_close_session(void);
+static bool xfer_stage_flush(void);
+static void xfer_send_ack(uint32_t offset);
+static void xfer_send_status(xfer_status_code_t code, uint32_t value0, uint32_t value1);
+static uint32_t xfer_get_u32(const uint8_t* bytes);
+
+/*******************************************************************************
+* Function Name: xfer_server_init
+********************************************************************************
+* Summary:
+*  Prepares the DMA channel and switches the HYPERRAM to memory mode. The
+*  HYPERRAM and the console must already be initialized.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true if the service is ready
+*
+*******************************************************************************/
+bool xfer_server_init(void)
+{
+    memset(&xfer_session, 0, sizeof(xfer_session));
+    xfer_rx_count = 0u;
+
+    if (HYPERRAM_SUCCESS != hyperram_dma_init())
+    {
+        return false;
+    }
+
+    hyperram_enter_xip();
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: xfer_server_poll
+********************************************************************************
+* Summary:
+*  Consumes received bytes, executes complete commands and queues as many
+*  read blocks as the window and the console ring allow.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void xfer_server_poll(void)
+{
+    uint8_t rx_buf[XFER_RX_BURST];
+    uint32_t available = cyhal_uart_readable(&cy_retarget_io_uart_obj);
+
+    while (available > 0u)
+    {
+        size_t length = (available > sizeof(rx_buf)) ? sizeof(rx_buf) : available;
+
+        if (CY_RSLT_SUCCESS != cyhal_uart_read(&cy_retarget_io_uart_obj, rx_buf, &length))
+        {
+            break;
+        }
+
+        for (uint32_t index = 0; index < length; index++)
+        {
+            xfer_rx_byte(rx_buf[index]);
+        }
+
+        available -= length;
+    }
+
+    xfer_pump();
+}
+
+/*******************************************************************************
+* Function Name: xfer_server_run
+********************************************************************************
+* Summary:
+*  Serves transfer requests forever.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void xfer_server_run(void)
+{
+    for (;;)
+    {
+        xfer_server_poll();
+    }
+}
+
+/*******************************************************************************
+* Function Name: xfer_rx_byte
+********************************************************************************
+* Summary:
+*  Frame parser. Hunts for the start-of-frame marker, collects the frame and
+*  dispatches it if the CRC-16 matches. Anything else is discarded.
+*
+* Parameters:
+*  byte - received byte
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void xfer_rx_byte(uint8_t byte)
+{
+    uint16_t length;
+    uint16_t crc;
+
+    if ((0u == xfer_rx_count) && (TELEMETRY_SOF0 != byte))
+    {
+        return;
+    }
+
+    if ((1u == xfer_rx_count) && (TELEMETRY_SOF1 != byte))
+    {
+        xfer_rx_count = (TELEMETRY_SOF0 == byte) ? 1u : 0u;
+        return;
+    }
+
+    xfer_rx_frame[xfer_rx_count++] = byte;
+
+    if (xfer_rx_count < TELEMETRY_HEADER_SIZE)
+    {
+        return;
+    }
+
+    length = (uint16_t)(xfer_rx_frame[4] | ((uint16_t)xfer_rx_frame[5] << 8));
+
+    if (length > TELEMETRY_MAX_PAYLOAD)
+    {
+        xfer_rx_count = 0u;
+        return;
+    }
+
+    if (xfer_rx_count < (TELEMETRY_HEADER_SIZE + length + TELEMETRY_CRC_SIZE))
+    {
+        return;
+    }
+
+    xfer_rx_count = 0u;
+
+    crc = crc16_ccitt_update(CRC16_CCITT_INIT, &xfer_rx_frame[2], (TELEMETRY_HEADER_SIZE - 2u) + length);
+
+    if ((xfer_rx_frame[TELEMETRY_HEADER_SIZE + length] == (uint8_t)(crc & 0xFFu)) &&
+        (xfer_rx_frame[TELEMETRY_HEADER_SIZE + length + 1u] == (uint8_t)(crc >> 8)))
+    {
+        xfer_dispatch(xfer_rx_frame[2], &xfer_rx_frame[TELEMETRY_HEADER_SIZE], length);
+    }
+}
+
+/*******************************************************************************
+* Function Name: xfer_dispatch
+********************************************************************************
+* Summary:
+*  Executes one host command.
+*
+* Parameters:
+*  type - frame type (xfer_cmd_t)
+*  payload - frame payload
+*  length - payload length
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void xfer_dispatch(uint8_t type, const uint8_t* payload, uint16_t length)
+{
+    switch (type)
+    {
+        case XFER_CMD_INFO:
+            xfer_send_status(XFER_STATUS_INFO, HYPERRAM_SIZE,
+                             (XFER_WINDOW_BLOCKS << 16) | XFER_BLOCK_SIZE);
+            break;
+
+        case XFER_CMD_READ:
+        case XFER_CMD_WRITE:
+            if (8u != length)
+            {
+                xfer_send_status(XFER_STATUS_ERROR, XFER_ERROR_COMMAND, type);
+                break;
+            }
+
+            /* There is one host; a new command means it gave up the old session */
+            xfer_close_session();
+
+            if (XFER_CMD_READ == type)
+            {
+                xfer_start_read(xfer_get_u32(&payload[0]), xfer_get_u32(&payload[4]));
+            }
+            else
+            {
+                xfer_start_write(xfer_get_u32(&payload[0]), xfer_get_u32(&payload[4]));
+            }
+            break;
+
+        case XFER_CMD_DATA:
+            xfer_handle_data(payload, length);
+            break;
+
+        case XFER_CMD_ACK:
+            if (4u == length)
+            {
+                xfer_handle_ack(xfer_get_u32(payload));
+            }
+            break;
+
+        case XFER_CMD_BAUD:
+            if (4u == length)
+            {
+                xfer_handle_baud(xfer_get_u32(payload));
+            }
+            break;
+
+        case XFER_CMD_ABORT:
+            xfer_close_session();
+            xfer_send_status(XFER_STATUS_ERROR, XFER_ERROR_ABORTED, 0u);
+            break;
+
+        default:
+            xfer_send_status(XFER_STATUS_ERROR, XFER_ERROR_COMMAND, type);
+            break;
+    }
+}
+
+/*******************************************************************************
+* Function Name: xfer_start_read
+********************************************************************************
+* Summary:
+*  Starts streaming a device range to the host. A host resuming an earlier
+*  transfer simply issues a new READ from the first missing byte. An empty
+*  range is answered with DONE at once.
+*
+* Parameters:
+*  address - first device byte
+*  length - number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void xfer_start_read(uint32_t address, uint32_t length)
+{
+    if ((address > HYPERRAM_SIZE) || (length > (HYPERRAM_SIZE - address)))
+    {
+        xfer_send_status(XFER_STATUS_ERROR, XFER_ERROR_RANGE, address);
+        return;
+    }
+
+    /* Nothing to stream, and no acknowledgement will ever complete it */
+    if (0u == length)
+    {
+        xfer_send_status(XFER_STATUS_DONE, 0u, 0u);
+        return;
+    }
+
+    xfer_session.state      = XFER_STATE_READING;
+    xfer_session.end        = address + length;
+    xfer_session.next       = address;
+    xfer_session.acked      = address;
+    xfer_session.stage_addr = address;
+    xfer_session.stage_fill = 0u;
+}
+
+/*******************************************************************************
+* Function Name: xfer_start_write
+********************************************************************************
+* Summary:
+*  Starts accepting an image from the host and acknowledges the start
+*  offset so the host can begin sending.
+*
+* Parameters:
+*  address - first device byte
+*  length - number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void xfer_start_write(uint32_t address, uint32_t length)
+{
+    if ((address > HYPERRAM_SIZE) || (length > (HYPERRAM_SIZE - address)))
+    {
+        xfer_send_status(XFER_STATUS_ERROR, XFER_ERROR_RANGE, address);
+        return;
+    }
+
+    xfer_session.state      = XFER_STATE_WRITING;
+    xfer_session.end        = address + length;
+    xfer_session.next       = address;
+    xfer_session.crc        = CRC32_INIT;
+    xfer_session.length     = length;
+    xfer_session.stage_addr = address;
+    xfer_session.stage_fill = 0u;
+
+    xfer_send_ack(address);
+}
+
+/*******************************************************************************
+* Function Name: xfer_handle_data
+********************************************************************************
+* Summary:
+*  Accepts the next in-order block of an upload. Blocks that are out of order
+*  or fail their CRC-32 are discarded and answered with a repeated ACK of the
+*  expected offset, which makes the host go back to that block.
+*
+* Parameters:
+*  payload - u32 offset, u32 CRC-32, data
+*  length - payload length
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void xfer_handle_data(const uint8_t* payload, uint16_t length)
+{
+    xfer_session_t* session = &xfer_session;
+    uint32_t offset;
+    uint32_t size;
+
+    if ((XFER_STATE_WRITING != session->state) || (length <= XFER_DATA_HEADER_SIZE))
+    {
+        return;
+    }
+
+    offset = xfer_get_u32(&payload[0]);
+    size   = (uint32_t)length - XFER_DATA_HEADER_SIZE;
+
+    if ((offset != session->next) || (size > XFER_BLOCK_SIZE) || (size > (session->end - offset)) ||
+        (xfer_get_u32(&payload[4]) != crc32_compute(&payload[XFER_DATA_HEADER_SIZE], size)))
+    {
+        xfer_send_ack(session->next);
+        return;
+    }
+
+    if ((session->stage_fill + size) > XFER_CHUNK_SIZE)
+    {
+        if (!xfer_stage_flush())
+        {
+            return;
+        }
+    }
+
+    memcpy(&xfer_stage[session->stage_fill], &payload[XFER_DATA_HEADER_SIZE], size);
+    session->stage_fill += size;
+    session->next       += size;
+    session->crc         = crc32_update(session->crc, &payload[XFER_DATA_HEADER_SIZE], size);
+
+    if ((session->next == session->end) && !xfer_stage_flush())
+    {
+        return;
+    }
+
+    xfer_send_ack(session->next);
+
+    if (session->next == session->end)
+    {
+        session->state = XFER_STATE_IDLE;
+        xfer_send_status(XFER_STATUS_DONE, session->length, session->crc ^ CRC32_FINAL_XOR);
+    }
+}
+
+/*******************************************************************************
+* Function Name: xfer_handle_ack
+********************************************************************************
+* Summary:
+*  Advances the read window on a new acknowledgement. A repeat of the last
+*  acknowledged offset means the host lost a block (or timed out) and the
+*  stream restarts from that offset.
+*
+* Parameters:
+*  offset - next offset the host expects
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void xfer_handle_ack(uint32_t offset)
+{
+    xfer_session_t* session = &xfer_session;
+
+    if (XFER_STATE_READING != session->state)
+    {
+        return;
+    }
+
+    if ((offset > session->acked) && (offset <= session->next))
+    {
+        session->acked = offset;
+    }
+    else if (offset == session->acked)
+    {
+        session->next = offset;
+    }
+    else
+    {
+        /* Stale acknowledgement */
+    }
+
+    if (session->acked == session->end)
+    {
+        session->state = XFER_STATE_IDLE;
+        xfer_send_status(XFER_STATUS_DONE, 0u, 0u);
+    }
+}
+
+/*******************************************************************************
+* Function Name: xfer_handle_baud
+********************************************************************************
+* Summary:
+*  Confirms the new baud rate at the current rate, waits for the confirmation
+*  to leave the UART and then switches. Flow control stays enabled. A session
+*  left open by an interrupted host run is closed first.
+*
+* Parameters:
+*  baudrate - requested baud rate
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void xfer_handle_baud(uint32_t baudrate)
+{
+    uint32_t actual_baud = 0u;
+
+    xfer_close_session();
+
+    xfer_send_status(XFER_STATUS_BAUD, baudrate, 0u);
+    console_flush();
+
+    while (cyhal_uart_is_tx_active(&cy_retarget_io_uart_obj))
+    {
+    }
+
+    if (CY_RSLT_SUCCESS != cyhal_uart_set_baud(&cy_retarget_io_uart_obj, baudrate, &actual_baud))
+    {
+        xfer_send_status(XFER_STATUS_ERROR, XFER_ERROR_BAUD, baudrate);
+    }
+}
+
+/*******************************************************************************
+* Function Name: xfer_pump
+********************************************************************************
+* Summary:
+*  Queues read blocks while the window is open and the console ring has room
+*  for a whole frame. The staging buffer is refilled by DMA whenever the next
+*  block is not in it.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void xfer_pump(void)
+{
+    xfer_session_t* session = &xfer_session;
+
+    while ((XFER_STATE_READING == session->state) &&
+           (session->next < session->end) &&
+           ((session->next - session->acked) < (XFER_WINDOW_BLOCKS * XFER_BLOCK_SIZE)))
+    {
+        uint8_t header[XFER_DATA_HEADER_SIZE];
+        uint32_t size = session->end - session->next;
+        uint32_t offset;
+        uint32_t crc;
+
+        if (size > XFER_BLOCK_SIZE)
+        {
+            size = XFER_BLOCK_SIZE;
+        }
+
+        if (console_free() < (TELEMETRY_HEADER_SIZE + XFER_DATA_HEADER_SIZE + size + TELEMETRY_CRC_SIZE))
+        {
+            break;
+        }
+
+        if ((session->next < session->stage_addr) ||
+            ((session->next + size) > (session->stage_addr + session->stage_fill)))
+        {
+            uint32_t chunk = session->end - session->next;
+
+            if (chunk > XFER_CHUNK_SIZE)
+            {
+                chunk = XFER_CHUNK_SIZE;
+            }
+
+            if (HYPERRAM_SUCCESS != hyperram_dma_copy(xfer_stage, hyperram_xip_ptr(session->next), chunk))
+            {
+                session->state = XFER_STATE_IDLE;
+                xfer_send_status(XFER_STATUS_ERROR, XFER_ERROR_MEMORY, session->next);
+                break;
+            }
+
+            session->stage_addr = session->next;
+            session->stage_fill = chunk;
+        }
+
+        offset = session->next - session->stage_addr;
+        crc = crc32_compute(&xfer_stage[offset], size);
+
+        memcpy(&header[0], &session->next, sizeof(uint32_t));
+        memcpy(&header[4], &crc, sizeof(uint32_t));
+
+        telemetry_send_parts(TELEMETRY_TYPE_XFER_DATA, header, sizeof(header),
+                             &xfer_stage[offset], (uint16_t)size);
+
+        session->next += size;
+    }
+}
+
+/*******************************************************************************
+* Function Name: xfer_stage_flush
+********************************************************************************
+* Summary:
+*  Writes the staged upload data to the HYPERRAM by DMA through the XIP
+*  window.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true on success; on failure the session is aborted
+*
+*******************************************************************************/
+static bool xfer_stage_flush(void)
+{
+    xfer_session_t* session = &xfer_session;
+
+    if (0u != session->stage_fill)
+    {
+        if (HYPERRAM_SUCCESS != hyperram_dma_copy(hyperram_xip_ptr(session->stage_addr),
+                                                  xfer_stage, session->stage_fill))
+        {
+            session->state = XFER_STATE_IDLE;
+            xfer_send_status(XFER_STATUS_ERROR, XFER_ERROR_MEMORY, session->stage_addr);
+            return false;
+        }
+    }
+
+    session->stage_addr += session->stage_fill;
+    session->stage_fill = 0u;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: xfer_close_session
+********************************************************************************
+* Summary:
+*  Ends the current session, if any. Staged write data is flushed to the
+*  device first, so an upload continued with --skip finds it in place.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void xfer_close_session(void)
+{
+    if (XFER_STATE_WRITING == xfer_session.state)
+    {
+        (void)xfer_stage_flush();
+    }
+    xfer_session.state = XFER_STATE_IDLE;
+}
+
+/*******************************************************************************
+* Function Name: xfer_send_ack
+********************************************************************************
+* Summary:
+*  Reports the next offset the target expects during an upload.
+*
+* Parameters:
+*  offset - next expected device offset
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void xfer_send_ack(uint32_t offset)
+{
+    telemetry_send_frame(TELEMETRY_TYPE_XFER_ACK, &offset, sizeof(offset));
+}
+
+/*******************************************************************************
+* Function Name: xfer_send_status
+********************************************************************************
+* Summary:
+*  Sends a status frame.
+*
+* Parameters:
+*  code - status code
+*  value0 - first code specific value
+*  value1 - second code specific value
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void xfer_send_status(xfer_status_code_t code, uint32_t value0, uint32_t value1)
+{
+    uint32_t payload[3] = { (uint32_t)code, value0, value1 };
+
+    telemetry_send_frame(TELEMETRY_TYPE_XFER_STATUS, payload, sizeof(payload));
+}
+
+/*******************************************************************************
+* Function Name: xfer_get_u32
+********************************************************************************
+* Summary:
+*  Reads an unaligned little endian 32-bit value.
+*
+* Parameters:
+*  bytes - first byte of the value
+*
+* Return:
+*  uint32_t - decoded value
+*
+*******************************************************************************/
+static uint32_t xfer_get_u32(const uint8_t* bytes)
+{
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) |
+           ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,115 @@
+/*******************************************************************************
+* File Name:   xfer_server.h
+*
+* Description: Target side of the HYPERRAM dump/upload service used by
+* tools/hyperram_xfer.py. Commands arrive as telemetry-format frames on the
+* debug UART; data moves in CRC-32 protected blocks with a sliding window of
+* unacknowledged blocks and go-back-N recovery.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef XFER_SERVER_H
+#define XFER_SERVER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* Data bytes per DATA frame */
+#define XFER_BLOCK_SIZE                 (512u)
+
+/* Blocks the target may send ahead of the last acknowledgement */
+#define XFER_WINDOW_BLOCKS              (8u)
+
+/* HYPERRAM bytes moved per DMA copy between the device and SRAM staging */
+#define XFER_CHUNK_SIZE                 (4096u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+
+/* Host to target frame types */
+typedef enum
+{
+    XFER_CMD_INFO  = 0x20u, /* no payload                                    */
+    XFER_CMD_READ  = 0x21u, /* u32 address, u32 length                       */
+    XFER_CMD_WRITE = 0x22u, /* u32 address, u32 length                       */
+    XFER_CMD_DATA  = 0x23u, /* u32 offset, u32 CRC-32, data                  */
+    XFER_CMD_ACK   = 0x24u, /* u32 next expected offset; a repeat rewinds    */
+    XFER_CMD_BAUD  = 0x25u, /* u32 baud rate                                 */
+    XFER_CMD_ABORT = 0x26u, /* no payload                                    */
+} xfer_cmd_t;
+
+/* Codes carried by TELEMETRY_TYPE_XFER_STATUS frames */
+typedef enum
+{
+    XFER_STATUS_INFO  = 0u, /* value0 = device size, value1 = window << 16 | block */
+    XFER_STATUS_DONE  = 1u, /* value0 = length, value1 = CRC-32 of written image   */
+    XFER_STATUS_ERROR = 2u, /* value0 = xfer_error_t                               */
+    XFER_STATUS_BAUD  = 3u, /* value0 = baud rate used after this frame            */
+} xfer_status_code_t;
+
+typedef enum
+{
+    XFER_ERROR_RANGE   = 1u,
+    XFER_ERROR_BUSY    = 2u,    /* reserved */
+    XFER_ERROR_MEMORY  = 3u,
+    XFER_ERROR_BAUD    = 4u,
+    XFER_ERROR_COMMAND = 5u,
+    XFER_ERROR_ABORTED = 6u,
+} xfer_error_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool xfer_server_init(void);
+void xfer_server_poll(void);
+void xfer_server_run(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* XFER_SERVER_H */
+
+/* [] END OF FILE */
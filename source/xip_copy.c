@@ -0,0 +1,404 @@
+/*******************************************************************************
+* File Name:   xip_copy.c
+*
+* Description: Copy kernels for the HYPERRAM XIP window. See xip_copy.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include <string.h>
+#include "platform.h"
+#include "xip_copy.h"
+#include "hyperram_dma.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* Alignment kept on the device side of a copy: one LDRD/STRD */
+#define XIP_COPY_ALIGN                  (8u)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static bool xip_copy_is_xip(const void* address);
+static bool xip_copy_dma(void* dst, const void* src, uint32_t size);
+static void xip_copy_forward(uint8_t* dst, const uint8_t* src, uint32_t size, bool align_dst);
+static void xip_copy_backward(uint8_t* dst, const uint8_t* src, uint32_t size, bool align_dst);
+static inline uint64_t xip_copy_load(const uint8_t* address);
+static inline void xip_copy_store(uint8_t* address, uint64_t value);
+
+/*******************************************************************************
+* Function Name: xip_memcpy
+********************************************************************************
+* Summary:
+*  memcpy() replacement for copies from, to or within the XIP window. Large
+*  word-aligned copies use the DMA; everything else, and any copy made while
+*  the DMA is busy, uses the CPU kernel. The regions must not overlap.
+*
+*  The DMA path blocks until the transfer completes and must not be used
+*  from an interrupt handler that preempts the DMA completion interrupt.
+*
+* Parameters:
+*  dst - destination
+*  src - source
+*  size - number of bytes to copy
+*
+* Return:
+*  void* - dst
+*
+*******************************************************************************/
+void* xip_memcpy(void* dst, const void* src, uint32_t size)
+{
+    if (!xip_copy_dma(dst, src, size))
+    {
+        xip_memcpy_cpu(dst, src, size);
+    }
+
+    return dst;
+}
+
+/*******************************************************************************
+* Function Name: xip_memmove
+********************************************************************************
+* Summary:
+*  memmove() replacement for the XIP window. Overlapping regions are copied
+*  by the CPU kernel in the safe direction; the others as by xip_memcpy().
+*
+* Parameters:
+*  dst - destination
+*  src - source
+*  size - number of bytes to copy
+*
+* Return:
+*  void* - dst
+*
+*******************************************************************************/
+void* xip_memmove(void* dst, const void* src, uint32_t size)
+{
+    uintptr_t to = (uintptr_t)dst;
+    uintptr_t from = (uintptr_t)src;
+
+    if ((to == from) || (0u == size))
+    {
+        return dst;
+    }
+
+    if ((to >= (from + size)) || (from >= (to + size)))
+    {
+        return xip_memcpy(dst, src, size);
+    }
+
+    /* Keep the accesses on the device side aligned, as xip_memcpy_cpu() */
+    bool align_dst = xip_copy_is_xip(dst) && !xip_copy_is_xip(src);
+
+    if (to < from)
+    {
+        xip_copy_forward((uint8_t*)dst, (const uint8_t*)src, size, align_dst);
+    }
+    else
+    {
+        xip_copy_backward((uint8_t*)dst, (const uint8_t*)src, size, align_dst);
+    }
+
+    return dst;
+}
+
+/*******************************************************************************
+* Function Name: xip_memcpy_cpu
+********************************************************************************
+* Summary:
+*  CPU copy kernel. The side in the XIP window (the source when both are) is
+*  brought to 8-byte alignment with byte copies, then 32 bytes are moved per
+*  iteration as four 64-bit loads followed by four stores, so an uncached
+*  read issues back-to-back LDRDs and a cached one touches each line once.
+*  The other side may be unaligned; it must be normal memory (SRAM), where
+*  the CM7 handles unaligned word accesses.
+*
+* Parameters:
+*  dst - destination
+*  src - source
+*  size - number of bytes to copy
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void xip_memcpy_cpu(void* dst, const void* src, uint32_t size)
+{
+    bool align_dst = xip_copy_is_xip(dst) && !xip_copy_is_xip(src);
+
+    xip_copy_forward((uint8_t*)dst, (const uint8_t*)src, size, align_dst);
+}
+
+/*******************************************************************************
+* Function Name: xip_copy_is_xip
+********************************************************************************
+* Summary:
+*  Checks whether an address is in the HYPERRAM XIP window.
+*
+* Parameters:
+*  address - address to check
+*
+* Return:
+*  bool - true if it is
+*
+*******************************************************************************/
+static bool xip_copy_is_xip(const void* address)
+{
+    return (((uintptr_t)address - (uintptr_t)hyperram_xip_ptr(0u)) < HYPERRAM_SIZE);
+}
+
+/*******************************************************************************
+* Function Name: xip_copy_dma
+********************************************************************************
+* Summary:
+*  Runs a copy on the DMA if it is large enough, word aligned and the channel
+*  is idle. Byte-wide DMA transfers are slower than the CPU kernel, so
+*  unaligned copies are left to the CPU.
+*
+* Parameters:
+*  dst - destination
+*  src - source
+*  size - number of bytes to copy
+*
+* Return:
+*  bool - true if the DMA made the copy
+*
+*******************************************************************************/
+static bool xip_copy_dma(void* dst, const void* src, uint32_t size)
+{
+    if ((0u == XIP_COPY_DMA_THRESHOLD) || (size < XIP_COPY_DMA_THRESHOLD))
+    {
+        return false;
+    }
+
+    if (0u != (((uintptr_t)dst | (uintptr_t)src | size) & 3u))
+    {
+        return false;
+    }
+
+    if ((HYPERRAM_SUCCESS != hyperram_dma_init()) || hyperram_dma_is_busy())
+    {
+        return false;
+    }
+
+    return (HYPERRAM_SUCCESS == hyperram_dma_copy(dst, src, size));
+}
+
+/*******************************************************************************
+* Function Name: xip_copy_forward
+********************************************************************************
+* Summary:
+*  Copies in ascending address order. See xip_memcpy_cpu().
+*
+* Parameters:
+*  dst - destination
+*  src - source
+*  size - number of bytes to copy
+*  align_dst - align the destination instead of the source
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void xip_copy_forward(uint8_t* dst, const uint8_t* src, uint32_t size, bool align_dst)
+{
+    uintptr_t side = align_dst ? (uintptr_t)dst : (uintptr_t)src;
+    uint32_t head = (uint32_t)((0u - side) & (XIP_COPY_ALIGN - 1u));
+
+    if (head > size)
+    {
+        head = size;
+    }
+
+    size -= head;
+
+    while (0u != head--)
+    {
+        *dst++ = *src++;
+    }
+
+    if (align_dst)
+    {
+        for (; size >= XIP_COPY_BLOCK; size -= XIP_COPY_BLOCK)
+        {
+            uint64_t* to = (uint64_t*)(void*)dst;
+            uint64_t a = xip_copy_load(&src[0]);
+            uint64_t b = xip_copy_load(&src[8]);
+            uint64_t c = xip_copy_load(&src[16]);
+            uint64_t d = xip_copy_load(&src[24]);
+
+            to[0] = a;
+            to[1] = b;
+            to[2] = c;
+            to[3] = d;
+            dst += XIP_COPY_BLOCK;
+            src += XIP_COPY_BLOCK;
+        }
+    }
+    else
+    {
+        for (; size >= XIP_COPY_BLOCK; size -= XIP_COPY_BLOCK)
+        {
+            const uint64_t* from = (const uint64_t*)(const void*)src;
+            uint64_t a = from[0];
+            uint64_t b = from[1];
+            uint64_t c = from[2];
+            uint64_t d = from[3];
+
+            xip_copy_store(&dst[0], a);
+            xip_copy_store(&dst[8], b);
+            xip_copy_store(&dst[16], c);
+            xip_copy_store(&dst[24], d);
+            dst += XIP_COPY_BLOCK;
+            src += XIP_COPY_BLOCK;
+        }
+    }
+
+    while (0u != size--)
+    {
+        *dst++ = *src++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: xip_copy_backward
+********************************************************************************
+* Summary:
+*  Copies in descending address order, for a destination that overlaps the
+*  end of the source. The end of the aligned side is brought to 8-byte
+*  alignment first.
+*
+* Parameters:
+*  dst - destination
+*  src - source
+*  size - number of bytes to copy
+*  align_dst - align the destination instead of the source
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void xip_copy_backward(uint8_t* dst, const uint8_t* src, uint32_t size, bool align_dst)
+{
+    dst += size;
+    src += size;
+
+    uintptr_t side = align_dst ? (uintptr_t)dst : (uintptr_t)src;
+    uint32_t tail = (uint32_t)(side & (XIP_COPY_ALIGN - 1u));
+
+    if (tail > size)
+    {
+        tail = size;
+    }
+
+    size -= tail;
+
+    while (0u != tail--)
+    {
+        *--dst = *--src;
+    }
+
+    for (; size >= XIP_COPY_BLOCK; size -= XIP_COPY_BLOCK)
+    {
+        dst -= XIP_COPY_BLOCK;
+        src -= XIP_COPY_BLOCK;
+
+        /* All loads before the first store: the block may overlap itself */
+        uint64_t a = xip_copy_load(&src[0]);
+        uint64_t b = xip_copy_load(&src[8]);
+        uint64_t c = xip_copy_load(&src[16]);
+        uint64_t d = xip_copy_load(&src[24]);
+
+        xip_copy_store(&dst[24], d);
+        xip_copy_store(&dst[16], c);
+        xip_copy_store(&dst[8], b);
+        xip_copy_store(&dst[0], a);
+    }
+
+    while (0u != size--)
+    {
+        *--dst = *--src;
+    }
+}
+
+/*******************************************************************************
+* Function Name: xip_copy_load
+********************************************************************************
+* Summary:
+*  64-bit load from an address of any alignment. The compiler emits an LDRD
+*  when the address is known to be aligned and two LDRs otherwise.
+*
+* Parameters:
+*  address - address to load from
+*
+* Return:
+*  uint64_t - value
+*
+*******************************************************************************/
+static inline uint64_t xip_copy_load(const uint8_t* address)
+{
+    uint64_t value;
+
+    memcpy(&value, address, sizeof(value));
+
+    return value;
+}
+
+/*******************************************************************************
+* Function Name: xip_copy_store
+********************************************************************************
+* Summary:
+*  64-bit store to an address of any alignment.
+*
+* Parameters:
+*  address - address to store to
+*  value - value to store
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static inline void xip_copy_store(uint8_t* address, uint64_t value)
+{
+    memcpy(address, &value, sizeof(value));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,82 @@
+/*******************************************************************************
+* File Name:   xip_copy.h
+*
+* Description: Copy kernels for the HYPERRAM XIP window. The CPU kernel keeps every
+* access on the device side 8-byte aligned and moves one 32-byte D-cache
+* line (one SMIF burst) per loop iteration; large word-aligned copies are
+* handed to the DMA.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef XIP_COPY_H
+#define XIP_COPY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hyperram.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/* Bytes moved per kernel iteration: one D-cache line, which the SMIF fetches
+ * as a single burst */
+#define XIP_COPY_BLOCK                  (32u)
+
+/* Copies of at least this many bytes go to the DMA when source, destination
+ * and size are word aligned and the channel is idle. 0 disables the DMA. */
+#ifndef XIP_COPY_DMA_THRESHOLD
+#define XIP_COPY_DMA_THRESHOLD          (2048u)
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void* xip_memcpy(void* dst, const void* src, uint32_t size);
+void* xip_memmove(void* dst, const void* src, uint32_t size);
+void xip_memcpy_cpu(void* dst, const void* src, uint32_t size);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* XIP_COPY_H */
+
+/* [] END OF FILE */
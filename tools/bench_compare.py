@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+"""Extract and compare HyperRAM benchmark results (source/benchmark.c).
+
+  bench_compare.py extract capture.txt -o run.json [--design-dir DIR]
+  bench_compare.py compare baseline.json run.json [--threshold 5]
+
+'extract' pulls the JSON report between BENCH-JSON-BEGIN and BENCH-JSON-END
+out of a console capture (or host simulator output). It adds the memory
+slot and SMIF settings from design.cyqspi/design.modus. 'compare' matches
+results by name and size and exits with status 1 if throughput drops or
+p99 latency rises by more than the threshold.
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+import xml.etree.ElementTree as ElementTree
+
+BEGIN = "BENCH-JSON-BEGIN"
+END = "BENCH-JSON-END"
+
+
+def local(tag):
+    return tag.rsplit("}", 1)[-1]
+
+
+def read_design(design_dir):
+    """Collects the settings that affect HyperRAM performance."""
+    design = {}
+    cyqspi = os.path.join(design_dir, "design.cyqspi")
+    if os.path.exists(cyqspi):
+        root = ElementTree.parse(cyqspi).getroot()
+        for slot in root.iter():
+            if local(slot.tag) != "SlotConfig":
+                continue
+            fields = {local(child.tag): (child.text or "").strip() for child in slot}
+            if fields.get("SlaveSlot") == "0":
+                for key in ("MemoryId", "StartAddress", "Size", "Encrypt", "DataSelect", "MergeTimeout"):
+                    design["slot0_" + key] = fields.get(key)
+    modus = os.path.join(design_dir, "design.modus")
+    if os.path.exists(modus):
+        root = ElementTree.parse(modus).getroot()
+        for personality in root.iter():
+            if local(personality.tag) != "Personality":
+                continue
+            template = personality.get("template", "")
+            params = {p.get("id"): p.get("value") for p in personality.iter() if local(p.tag) == "Param"}
+            if template.startswith("mxs40smif"):
+                for key, value in params.items():
+                    design["smif_" + key] = value
+            elif template in ("pll", "mxs40pll400", "fll"):
+                block = next((b.get("location") for b in personality.iter() if local(b.tag) == "Block"), template)
+                if "desiredFrequency" in params:
+                    design[block + "_mhz"] = params["desiredFrequency"]
+    return design
+
+
+def extract(args):
+    with open(args.capture, "r", errors="replace") as handle:
+        text = handle.read()
+    match = re.search(re.escape(BEGIN) + r"(.*?)" + re.escape(END), text, re.S)
+    if not match:
+        sys.stderr.write("no %s ... %s block found\n" % (BEGIN, END))
+        return 1
+    report = json.loads(match.group(1))
+    if args.design_dir:
+        report["design"] = read_design(args.design_dir)
+    output = json.dumps(report, indent=1)
+    if args.output:
+        with open(args.output, "w") as handle:
+            handle.write(output + "\n")
+    else:
+        print(output)
+    return 0
+
+
+def compare(args):
+    with open(args.baseline) as handle:
+        baseline = json.load(handle)
+    with open(args.current) as handle:
+        current = json.load(handle)
+
+    for section in ("build", "memory", "design"):
+        old = baseline.get(section, {})
+        new = current.get(section, {})
+        for key in sorted(set(old) | set(new)):
+            if old.get(key) != new.get(key):
+                print("note: %s.%s changed: %s -> %s" % (section, key, old.get(key), new.get(key)))
+
+    old_results = {(r["name"], r["size"]): r for r in baseline.get("results", [])}
+    regressions = 0
+    print("%-24s %8s %12s %12s %8s %12s %12s %8s" %
+          ("case", "size", "base MB/s", "new MB/s", "delta", "base p99", "new p99", "delta"))
+    for result in current.get("results", []):
+        key = (result["name"], result["size"])
+        old = old_results.pop(key, None)
+        if old is None:
+            print("%-24s %8u %12s %12.3f   (new)" % (key[0], key[1], "-", result["mbps"]))
+            continue
+        mbps_delta = 100.0 * (result["mbps"] - old["mbps"]) / old["mbps"] if old["mbps"] else 0.0
+        p99_delta = 100.0 * (result["p99_ns"] - old["p99_ns"]) / old["p99_ns"] if old["p99_ns"] else 0.0
+        flag = ""
+        if mbps_delta < -args.threshold or p99_delta > args.threshold or result.get("errors", 0) > old.get("errors", 0):
+            flag = "  REGRESSION"
+            regressions += 1
+        print("%-24s %8u %12.3f %12.3f %+7.1f%% %12u %12u %+7.1f%%%s" %
+              (key[0], key[1], old["mbps"], result["mbps"], mbps_delta,
+               old["p99_ns"], result["p99_ns"], p99_delta, flag))
+    for key in old_results:
+        print("%-24s %8u   (missing from current run)" % key)
+
+    print("\n%u regression(s) above %.1f%%" % (regressions, args.threshold))
+    return 1 if regressions else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    sub = parser.add_subparsers(dest="command", required=True)
+    ext = sub.add_parser("extract", help="pull the JSON report out of a capture")
+    ext.add_argument("capture")
+    ext.add_argument("-o", "--output")
+    ext.add_argument("--design-dir", help="directory holding design.cyqspi and design.modus")
+    cmp_ = sub.add_parser("compare", help="compare two extracted reports")
+    cmp_.add_argument("baseline")
+    cmp_.add_argument("current")
+    cmp_.add_argument("--threshold", type=float, default=5.0, help="percent change treated as regression")
+    args = parser.parse_args()
+    return extract(args) if args.command == "extract" else compare(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+"""Suggest flash/ITCM/HYPERRAM placement from code benchmark results.
+
+  code_placement.py report.json [--config smif_on/warm]
+  code_placement.py report.json --profile profile.csv [--elf app.elf]
+                    [--nm arm-none-eabi-nm] [--itcm-budget 16384]
+
+The report is a benchmark capture or the output of 'bench_compare.py
+extract'. Its "code:<kernel>/<location>/<config>" results give the cost of
+running each kernel from each location relative to code flash.
+
+The profile is a CSV file with a header line and the columns
+function,calls[,ns][,kernel]: how often a function is called over the
+profiled period, its time per call when run from flash, and the benchmark
+kernel it resembles most (crc32, fir16, copy or interp). Without a kernel
+the mean ratio of all kernels is used; without a time the function size
+from the ELF file stands in for it. Functions are then moved to ITCM in
+order of time saved per byte until the budget is used up, and the rest go
+to whichever of flash or HYPERRAM is cheaper.
+"""
+
+import argparse
+import csv
+import json
+import re
+import subprocess
+import sys
+
+BEGIN = "BENCH-JSON-BEGIN"
+END = "BENCH-JSON-END"
+LOCATIONS = ("flash", "itcm", "hyperram")
+
+
+def load_report(path):
+    with open(path, "r", errors="replace") as handle:
+        text = handle.read()
+    match = re.search(re.escape(BEGIN) + r"(.*?)" + re.escape(END), text, re.S)
+    return json.loads(match.group(1) if match else text)
+
+
+def kernel_ratios(report, config):
+    """Returns {kernel: {location: cost relative to flash}}."""
+    times = {}
+    for result in report.get("results", []):
+        parts = result["name"].split(":", 1)
+        if parts[0] != "code" or len(parts) < 2:
+            continue
+        fields = parts[1].split("/", 2)
+        if len(fields) != 3 or fields[2] != config:
+            continue
+        kernel, location = fields[0], fields[1]
+        if result.get("errors", 0):
+            sys.stderr.write("warning: %s has %u errors\n" % (result["name"], result["errors"]))
+        entry = times.setdefault(kernel, {})
+        if location in entry:
+            # Two variants linked to the same place, e.g. no HYPERRAM_SECTIONS
+            sys.stderr.write("warning: %s/%s measured twice, check the placement\n" % (kernel, location))
+            continue
+        entry[location] = result["p50_ns"]
+
+    ratios = {}
+    for kernel, entry in times.items():
+        if not entry.get("flash"):
+            continue
+        ratios[kernel] = {location: float(entry[location]) / entry["flash"]
+                          for location in LOCATIONS if location in entry}
+    return ratios
+
+
+def function_sizes(elf, nm):
+    sizes = {}
+    output = subprocess.run([nm, "--print-size", "--defined-only", elf],
+                            check=True, stdout=subprocess.PIPE, universal_newlines=True).stdout
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) == 4 and fields[2] in ("t", "T"):
+            sizes[fields[3]] = int(fields[1], 16)
+    return sizes
+
+
+def print_ratios(ratios, config):
+    print("Cost relative to flash (%s):" % config)
+    print("%-10s %10s %10s %10s" % (("kernel",) + LOCATIONS))
+    for kernel in sorted(ratios):
+        print("%-10s %s" % (kernel, " ".join("%10s" % ("%.2f" % ratios[kernel][location]
+                                                      if location in ratios[kernel] else "-")
+                                             for location in LOCATIONS)))
+
+
+def plan(args, ratios):
+    mean = {location: sum(r[location] for r in ratios.values() if location in r) /
+            max(1, sum(1 for r in ratios.values() if location in r)) for location in LOCATIONS}
+    sizes = function_sizes(args.elf, args.nm) if args.elf else {}
+
+    functions = []
+    with open(args.profile, newline="") as handle:
+        for row in csv.DictReader(handle):
+            name = row["function"].strip()
+            size = sizes.get(name, 0)
+            ns = float(row.get("ns") or size or 1)
+            kernel = (row.get("kernel") or "").strip()
+            if kernel and kernel not in ratios:
+                sys.stderr.write("warning: unknown kernel %s for %s\n" % (kernel, name))
+            ratio = ratios.get(kernel, mean)
+            base = int(row["calls"]) * ns
+            cost = {location: base * ratio.get(location, float("inf")) for location in LOCATIONS}
+            functions.append({"name": name, "size": size, "cost": cost})
+
+    # ITCM first, by time saved per byte; unknown sizes count as one byte
+    budget = args.itcm_budget
+    def saving(function):
+        return (min(function["cost"]["flash"], function["cost"]["hyperram"]) -
+                function["cost"]["itcm"]) / max(1, function["size"])
+    for function in sorted(functions, key=saving, reverse=True):
+        charge = max(1, function["size"])
+        if saving(function) > 0 and charge <= budget:
+            function["where"] = "itcm"
+            budget -= charge
+        else:
+            function["where"] = min(("flash", "hyperram"), key=lambda location: function["cost"][location])
+
+    print("\n%-32s %8s %-9s %14s %14s %14s" % ("function", "size", "place", "flash", "itcm", "hyperram"))
+    total = {location: 0.0 for location in LOCATIONS}
+    planned = 0.0
+    for function in functions:
+        cost = function["cost"]
+        for location in LOCATIONS:
+            total[location] += cost[location]
+        planned += cost[function["where"]]
+        print("%-32s %8u %-9s %14.0f %14.0f %14.0f" %
+              (function["name"], function["size"], function["where"],
+               cost["flash"], cost["itcm"], cost["hyperram"]))
+
+    print("\nITCM used %u of %u bytes" % (args.itcm_budget - budget, args.itcm_budget))
+    print("Estimated time: all flash %.0f, plan %.0f (%.1f%%)" %
+          (total["flash"], planned, 100.0 * planned / total["flash"] if total["flash"] else 0.0))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("report", help="benchmark capture or extracted JSON report")
+    parser.add_argument("--config", default="smif_on/warm", help="cache configuration to plan for")
+    parser.add_argument("--profile", help="CSV file: function,calls[,ns][,kernel]")
+    parser.add_argument("--elf", help="ELF file to read function sizes from")
+    parser.add_argument("--nm", default="arm-none-eabi-nm")
+    parser.add_argument("--itcm-budget", type=int, default=16384, help="ITCM bytes available for code")
+    args = parser.parse_args()
+
+    ratios = kernel_ratios(load_report(args.report), args.config)
+    if not ratios:
+        sys.stderr.write("no code:*/*/%s results in %s\n" % (args.config, args.report))
+        return 1
+    print_ratios(ratios, args.config)
+    if args.profile:
+        plan(args, ratios)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
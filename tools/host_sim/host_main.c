@@ -0,0 +1,1229 @@
+/*******************************************************************************
+* File Name:   host_main.c
+*
+* Description: Entry point of the host simulator build. Runs the portable parts
+* of the application against the simulated HYPERRAM in source/hyperram_sim.c.
+*
+* Usage: hyperram_sim bench [iterations]
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+#include "hyperram.h"
+#include "benchmark.h"
+#include "stress.h"
+#include "hyperram_heap.h"
+#include "far_array.h"
+#include "hyperram_ring.h"
+#include "kv_store.h"
+#include "hyperram_protect.h"
+#include "march_test.h"
+#include "prbs_test.h"
+#include "hyperram_lz.h"
+#include "hyperram_crypt.h"
+#include "hyperram_dma.h"
+#include "perf_counter.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+#define HOST_HEAP_SLOTS                 (256u)
+
+/* Far array test: 4 MB of words in the stress region */
+#define HOST_FAR_OFFSET                 (0x00200000UL)
+#define HOST_FAR_COUNT                  (0x00100000UL)
+
+/* Ring test: 256 KB of 16-byte samples in the stress region */
+#define HOST_RING_OFFSET                (0x00200000UL)
+#define HOST_RING_SIZE                  (0x00040000UL)
+#define HOST_RING_SAMPLE_WORDS          (4u)
+#define HOST_RING_SAMPLE_SIZE           (HOST_RING_SAMPLE_WORDS * sizeof(uint32_t))
+#define HOST_RING_MAX_READ              (512u)
+
+/* Key-value test: 64 K slots of 60-byte values (4 MB) in the stress region */
+#define HOST_KV_OFFSET                  (0x00200000UL)
+#define HOST_KV_CAPACITY                (65536u)
+#define HOST_KV_VALUE_WORDS             (15u)
+#define HOST_KV_KEYS                    (40000u)
+#define HOST_KV_SCANS                   (200u)
+
+/* Protected region test: 1 MB of 1 KB blocks in the stress region */
+#define HOST_PROTECT_OFFSET             (0x00200000UL)
+#define HOST_PROTECT_SIZE               (0x00100000UL)
+#define HOST_PROTECT_BLOCK              (1024u)
+#define HOST_PROTECT_BLOCKS             (HOST_PROTECT_SIZE / HOST_PROTECT_BLOCK)
+#define HOST_PROTECT_MAX_IO             (8192u)
+
+/* Compressed store test: 1 MB of 4 KB blocks in the stress region */
+#define HOST_LZ_OFFSET                  (0x00200000UL)
+#define HOST_LZ_SIZE                    (0x00100000UL)
+#define HOST_LZ_BLOCK                   (4096u)
+#define HOST_LZ_BLOCKS                  (HOST_LZ_SIZE / HOST_LZ_BLOCK)
+
+/* Encryption test: 1 MB in the stress region, partly encrypted */
+#define HOST_CRYPT_OFFSET               (0x00200000UL)
+#define HOST_CRYPT_SIZE                 (0x00100000UL)
+#define HOST_CRYPT_MAX_IO               (8192u)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static int usage(const char* program);
+static int host_heap_churn(uint32_t ops, uint32_t seed);
+static int host_far_array(uint32_t ops, uint32_t seed);
+static uint32_t host_far_phase(far_array_t* array, uint32_t* shadow, uint32_t span, uint32_t ops,
+                               uint32_t* state);
+static int host_ring(uint32_t samples, uint32_t seed);
+static uint32_t host_ring_drain(hyperram_ring_t* ring, uint32_t max_size, const uint8_t* dropped,
+                                uint32_t* next_seq);
+static void host_ring_sample(uint32_t seq, uint32_t* sample);
+static int host_kv(uint32_t ops, uint32_t seed);
+static uint32_t host_kv_check(kv_store_t* store, const uint32_t* keys, const uint32_t* versions);
+static void host_kv_value(uint32_t key, uint32_t version, uint32_t* value);
+static int host_protect(uint32_t ops, uint32_t seed);
+static int host_lz(uint32_t ops, uint32_t seed);
+static void host_lz_block(uint32_t block, uint32_t version, uint8_t* data);
+static int host_crypt(uint32_t ops, uint32_t seed);
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Dispatches the command given on the command line.
+*
+* Parameters:
+*  argc - argument count
+*  argv - arguments
+*
+* Return:
+*  int - 0 on success
+*
+*******************************************************************************/
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        return usage(argv[0]);
+    }
+
+    if (HYPERRAM_SUCCESS != hyperram_init())
+    {
+        fprintf(stderr, "hyperram_init failed\n");
+        return 1;
+    }
+
+    if (0 == strcmp(argv[1], "bench"))
+    {
+        uint32_t iterations = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : BENCH_DEFAULT_ITERATIONS;
+
+        benchmark_run(iterations);
+        return 0;
+    }
+
+    if (0 == strcmp(argv[1], "stress"))
+    {
+        stress_config_t config = { 0u, 0u, 100000u };
+
+        config.seed = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 0u;
+        config.max_ops = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : config.max_ops;
+        config.duration_s = (argc > 5) ? (uint32_t)strtoul(argv[5], NULL, 0) : 0u;
+
+        if (argc > 4)
+        {
+            hyperram_sim_set_fault_rate((uint32_t)strtoul(argv[4], NULL, 0), config.seed);
+        }
+
+        return stress_run(&config) ? 0 : 1;
+    }
+
+    if (0 == strcmp(argv[1], "heap"))
+    {
+        uint32_t ops = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 100000u;
+        uint32_t seed = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : 1u;
+
+        return host_heap_churn(ops, seed);
+    }
+
+    if (0 == strcmp(argv[1], "far"))
+    {
+        uint32_t ops = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 1000000u;
+        uint32_t seed = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : 1u;
+
+        return host_far_array(ops, seed);
+    }
+
+    if (0 == strcmp(argv[1], "ring"))
+    {
+        uint32_t samples = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 1000000u;
+        uint32_t seed = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : 1u;
+
+        return host_ring(samples, seed);
+    }
+
+    if (0 == strcmp(argv[1], "kv"))
+    {
+        uint32_t ops = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 1000000u;
+        uint32_t seed = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : 1u;
+
+        return host_kv(ops, seed);
+    }
+
+    if (0 == strcmp(argv[1], "protect"))
+    {
+        uint32_t ops = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 100000u;
+        uint32_t seed = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : 1u;
+
+        return host_protect(ops, seed);
+    }
+
+    if (0 == strcmp(argv[1], "lz"))
+    {
+        uint32_t ops = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 10000u;
+        uint32_t seed = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : 1u;
+
+        return host_lz(ops, seed);
+    }
+
+    if (0 == strcmp(argv[1], "crypt"))
+    {
+        uint32_t ops = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 10000u;
+        uint32_t seed = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : 1u;
+
+        return host_crypt(ops, seed);
+    }
+
+    if (0 == strcmp(argv[1], "march"))
+    {
+        march_test_result_t result;
+        uint32_t seed = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 1u;
+
+        if (argc > 3)
+        {
+            hyperram_sim_set_fault_rate((uint32_t)strtoul(argv[3], NULL, 0), seed);
+        }
+
+        return (HYPERRAM_SUCCESS == march_test_run(0u, HYPERRAM_SIZE, MARCH_TEST_ALL, seed, &result)) ? 0 : 1;
+    }
+
+    if (0 == strcmp(argv[1], "prbs"))
+    {
+        prbs_test_config_t config = { PRBS_TEST_PRBS31, 0x00200000UL, 0x00100000UL, 1000u };
+        prbs_test_result_t result;
+        hyperram_status_t status;
+
+        config.pattern = (argc > 2) ? (prbs_test_pattern_t)strtoul(argv[2], NULL, 0) : config.pattern;
+        config.duration_ms = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : config.duration_ms;
+
+        if (argc > 4)
+        {
+            hyperram_sim_set_fault_rate((uint32_t)strtoul(argv[4], NULL, 0), 1u);
+        }
+
+        status = prbs_test_run(&config, &result);
+        prbs_test_print(&config, &result);
+
+        return (HYPERRAM_SUCCESS == status) ? 0 : 1;
+    }
+
+    return usage(argv[0]);
+}
+
+/*******************************************************************************
+* Function Name: usage
+********************************************************************************
+* Summary:
+*  Prints the command line help.
+*
+* Parameters:
+*  program - program name
+*
+* Return:
+*  int - exit code 2
+*
+*******************************************************************************/
+static int usage(const char* program)
+{
+    fprintf(stderr, "usage: %s bench [iterations]\n"
+                    "       %s stress [seed] [ops] [fault_one_in] [seconds]\n"
+                    "       %s heap [ops] [seed]\n"
+                    "       %s far [ops] [seed]\n"
+                    "       %s ring [samples] [seed]\n"
+                    "       %s kv [ops] [seed]\n"
+                    "       %s protect [ops] [seed]\n"
+                    "       %s lz [ops] [seed]\n"
+                    "       %s crypt [ops] [seed]\n"
+                    "       %s march [seed] [fault_one_in]\n"
+                    "       %s prbs [0=PRBS7|1=PRBS15|2=PRBS31] [ms] [fault_one_in]\n",
+            program, program, program, program, program, program, program, program, program, program,
+            program);
+
+    return 2;
+}
+
+/*******************************************************************************
+* Function Name: host_heap_churn
+********************************************************************************
+* Summary:
+*  Random allocate/free sequence over the HYPERRAM heap. Each buffer is
+*  filled with its slot number and checked when freed, so overlapping
+*  allocations are detected.
+*
+* Parameters:
+*  ops - number of allocate or free calls
+*  seed - random seed
+*
+* Return:
+*  int - 0 if no overlap was found
+*
+*******************************************************************************/
+static int host_heap_churn(uint32_t ops, uint32_t seed)
+{
+    static uint8_t* buffers[HOST_HEAP_SLOTS];
+    static uint32_t sizes[HOST_HEAP_SLOTS];
+    uint32_t state = (0u != seed) ? seed : 1u;
+    uint32_t corrupt = 0u;
+
+    if (HYPERRAM_SUCCESS != hyperram_heap_init())
+    {
+        fprintf(stderr, "hyperram_heap_init failed\n");
+        return 1;
+    }
+
+    for (uint32_t op = 0; op < ops; op++)
+    {
+        uint32_t slot;
+
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        slot = state % HOST_HEAP_SLOTS;
+
+        if (NULL != buffers[slot])
+        {
+            if ((buffers[slot][0] != (uint8_t)slot) || (buffers[slot][sizes[slot] - 1u] != (uint8_t)slot))
+            {
+                corrupt++;
+            }
+            hyperram_heap_free(buffers[slot]);
+            buffers[slot] = NULL;
+        }
+        else
+        {
+            /* Mostly small objects, with the occasional multi-megabyte buffer */
+            uint32_t limit = 1u << ((state >> 8) % 22u);
+
+            sizes[slot] = ((state >> 4) % limit) + 1u;
+            buffers[slot] = (uint8_t*)hyperram_heap_alloc(sizes[slot]);
+
+            if (NULL != buffers[slot])
+            {
+                memset(buffers[slot], (int)slot, sizes[slot]);
+            }
+        }
+    }
+
+    hyperram_heap_print_stats();
+
+    for (uint32_t slot = 0; slot < HOST_HEAP_SLOTS; slot++)
+    {
+        hyperram_heap_free(buffers[slot]);
+        buffers[slot] = NULL;
+    }
+
+    hyperram_heap_print_stats();
+    printf("HEAP-RESULT %s corrupt=%lu\n", (0u == corrupt) ? "PASS" : "FAIL", (unsigned long)corrupt);
+
+    return (0u == corrupt) ? 0 : 1;
+}
+
+/*******************************************************************************
+* Function Name: host_far_array
+********************************************************************************
+* Summary:
+*  Random reads and writes of a 4 MB far array, checked against a shadow
+*  copy. The first phase stays within a working set that fits in the page
+*  pool, the second spans the whole array. At the end the pool is flushed
+*  and the HYPERRAM contents are compared with the shadow.
+*
+* Parameters:
+*  ops - accesses per phase
+*  seed - random seed
+*
+* Return:
+*  int - 0 if every read and the final contents matched
+*
+*******************************************************************************/
+static int host_far_array(uint32_t ops, uint32_t seed)
+{
+    static const uint32_t spans[] = { (FAR_ARRAY_PAGES * FAR_ARRAY_PAGE_SIZE) / sizeof(uint32_t), HOST_FAR_COUNT };
+    far_array_t array;
+    uint32_t* shadow = (uint32_t*)malloc(HOST_FAR_COUNT * sizeof(uint32_t));
+    uint32_t state = (0u != seed) ? seed : 1u;
+    uint32_t errors = 0u;
+
+    if ((NULL == shadow) || (HYPERRAM_SUCCESS != far_array_pool_init()) ||
+        (HYPERRAM_SUCCESS != far_array_init(&array, HOST_FAR_OFFSET, sizeof(uint32_t), HOST_FAR_COUNT)))
+    {
+        fprintf(stderr, "far array setup failed\n");
+        free(shadow);
+        return 1;
+    }
+
+    memcpy(shadow, hyperram_xip_ptr(HOST_FAR_OFFSET), HOST_FAR_COUNT * sizeof(uint32_t));
+
+    for (uint32_t phase = 0; phase < (sizeof(spans) / sizeof(spans[0])); phase++)
+    {
+        uint32_t start = perf_counter_now();
+        uint32_t elapsed;
+
+        errors += host_far_phase(&array, shadow, spans[phase], ops, &state);
+        elapsed = perf_counter_to_ns(perf_counter_now() - start);
+
+        printf("FAR phase %lu: %lu accesses over %lu KB, %lu ns per access\n", (unsigned long)phase,
+               (unsigned long)ops, (unsigned long)((spans[phase] * sizeof(uint32_t)) / 1024u),
+               (unsigned long)((0u != ops) ? (elapsed / ops) : 0u));
+        far_array_print_stats();
+    }
+
+    if ((HYPERRAM_SUCCESS != far_array_flush()) ||
+        (0 != memcmp(shadow, hyperram_xip_ptr(HOST_FAR_OFFSET), HOST_FAR_COUNT * sizeof(uint32_t))))
+    {
+        errors++;
+    }
+
+    free(shadow);
+    printf("FAR-RESULT %s errors=%lu\n", (0u == errors) ? "PASS" : "FAIL", (unsigned long)errors);
+
+    return (0u == errors) ? 0 : 1;
+}
+
+/*******************************************************************************
+* Function Name: host_far_phase
+********************************************************************************
+* Summary:
+*  One phase of the far array test: a quarter of the accesses are writes,
+*  every read is compared with the shadow copy.
+*
+* Parameters:
+*  array - far array under test
+*  shadow - expected contents
+*  span - accesses go to elements 0 to span - 1
+*  ops - number of accesses
+*  state - random generator state
+*
+* Return:
+*  uint32_t - number of mismatches
+*
+*******************************************************************************/
+static uint32_t host_far_phase(far_array_t* array, uint32_t* shadow, uint32_t span, uint32_t ops,
+                               uint32_t* state)
+{
+    uint32_t errors = 0u;
+
+    for (uint32_t op = 0; op < ops; op++)
+    {
+        uint32_t index;
+        uint32_t value;
+
+        *state ^= *state << 13;
+        *state ^= *state >> 17;
+        *state ^= *state << 5;
+        index = *state % span;
+
+        if (0u == (*state >> 30))
+        {
+            shadow[index] = *state;
+            errors += (HYPERRAM_SUCCESS == far_array_write(array, index, state)) ? 0u : 1u;
+        }
+        else if ((HYPERRAM_SUCCESS != far_array_read(array, index, &value)) || (value != shadow[index]))
+        {
+            errors++;
+        }
+    }
+
+    return errors;
+}
+
+/*******************************************************************************
+* Function Name: host_ring
+********************************************************************************
+* Summary:
+*  Logs numbered 16-byte samples through a HYPERRAM ring while a consumer
+*  reads random amounts at random times. Now and then the consumer pauses
+*  long enough for the ring to fill, so that dropping is exercised too.
+*  Every sample read must be intact, and no accepted sample may be missing.
+*
+* Parameters:
+*  samples - number of samples produced
+*  seed - random seed
+*
+* Return:
+*  int - 0 if the consumer saw exactly the accepted samples
+*
+*******************************************************************************/
+static int host_ring(uint32_t samples, uint32_t seed)
+{
+    static hyperram_ring_t ring;
+    uint8_t* dropped = (uint8_t*)calloc((0u != samples) ? samples : 1u, 1u);
+    uint32_t sample[HOST_RING_SAMPLE_WORDS];
+    uint32_t state = (0u != seed) ? seed : 1u;
+    uint32_t pause = 0u;
+    uint32_t next_seq = 0u;
+    uint32_t errors = 0u;
+    hyperram_ring_stats_t stats;
+
+    if ((NULL == dropped) ||
+        (HYPERRAM_SUCCESS != hyperram_ring_init(&ring, HOST_RING_OFFSET, HOST_RING_SIZE)))
+    {
+        fprintf(stderr, "ring setup failed\n");
+        free(dropped);
+        return 1;
+    }
+
+    for (uint32_t seq = 0; seq < samples; seq++)
+    {
+        host_ring_sample(seq, sample);
+        if (0u == hyperram_ring_write(&ring, sample, HOST_RING_SAMPLE_SIZE))
+        {
+            dropped[seq] = 1u;
+        }
+
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+
+        if (0u != pause)
+        {
+            pause--;
+        }
+        else if (0u == (state % 100000u))
+        {
+            /* Long enough to overrun the ring */
+            pause = (2u * HOST_RING_SIZE) / HOST_RING_SAMPLE_SIZE;
+        }
+        else if (0u == (state % 3u))
+        {
+            errors += host_ring_drain(&ring, ((state >> 8) % HOST_RING_MAX_READ) + 1u, dropped, &next_seq);
+        }
+    }
+
+    /* The padding reads back as samples numbered 0xFFFFFFFF */
+    errors += (HYPERRAM_SUCCESS == hyperram_ring_flush(&ring, 0xFFu)) ? 0u : 1u;
+    while (0u != hyperram_ring_available(&ring))
+    {
+        errors += host_ring_drain(&ring, HOST_RING_MAX_READ, dropped, &next_seq);
+    }
+    while (next_seq < samples)
+    {
+        errors += (0u != dropped[next_seq]) ? 0u : 1u;
+        next_seq++;
+    }
+
+    hyperram_ring_get_stats(&ring, &stats);
+    hyperram_ring_print_stats(&ring);
+    printf("RING %lu samples, %lu ns per sample on the producer side\n", (unsigned long)samples,
+           (unsigned long)stats.producer_avg_ns);
+
+    hyperram_ring_deinit(&ring);
+    free(dropped);
+    printf("RING-RESULT %s errors=%lu\n", (0u == errors) ? "PASS" : "FAIL", (unsigned long)errors);
+
+    return (0u == errors) ? 0 : 1;
+}
+
+/*******************************************************************************
+* Function Name: host_ring_drain
+********************************************************************************
+* Summary:
+*  Reads up to max_size bytes from the ring and checks the whole samples
+*  among them. A read that ends inside a sample is completed before the
+*  check, as a logger that parses fixed-size records would do.
+*
+* Parameters:
+*  ring - ring under test
+*  max_size - bytes to read in the first call
+*  dropped - per sample, nonzero if the producer's write was rejected
+*  next_seq - first sample number not yet seen, updated
+*
+* Return:
+*  uint32_t - number of errors found
+*
+*******************************************************************************/
+static uint32_t host_ring_drain(hyperram_ring_t* ring, uint32_t max_size, const uint8_t* dropped,
+                                uint32_t* next_seq)
+{
+    uint8_t bytes[HOST_RING_MAX_READ + HOST_RING_SAMPLE_SIZE];
+    uint32_t size = hyperram_ring_read(ring, bytes, max_size);
+    uint32_t errors = 0u;
+
+    /* Whole samples only, the ring always holds whole ones */
+    if (0u != (size % HOST_RING_SAMPLE_SIZE))
+    {
+        uint32_t rest = HOST_RING_SAMPLE_SIZE - (size % HOST_RING_SAMPLE_SIZE);
+
+        errors += (rest == hyperram_ring_read(ring, &bytes[size], rest)) ? 0u : 1u;
+        size += rest;
+    }
+
+    for (uint32_t offset = 0; offset < size; offset += HOST_RING_SAMPLE_SIZE)
+    {
+        uint32_t sample[HOST_RING_SAMPLE_WORDS];
+        uint32_t expected[HOST_RING_SAMPLE_WORDS];
+
+        memcpy(sample, &bytes[offset], sizeof(sample));
+        if (UINT32_MAX == sample[0])
+        {
+            continue;
+        }
+
+        /* Every sample skipped over must have been dropped by the producer */
+        while ((*next_seq < sample[0]) && (0u != dropped[*next_seq]))
+        {
+            (*next_seq)++;
+        }
+
+        host_ring_sample(sample[0], expected);
+        if ((*next_seq != sample[0]) || (0 != memcmp(sample, expected, sizeof(sample))))
+        {
+            errors++;
+        }
+        *next_seq = sample[0] + 1u;
+    }
+
+    return errors;
+}
+
+/*******************************************************************************
+* Function Name: host_ring_sample
+********************************************************************************
+* Summary:
+*  Builds the contents of a numbered sample.
+*
+* Parameters:
+*  seq - sample number
+*  sample - filled with HOST_RING_SAMPLE_WORDS words
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void host_ring_sample(uint32_t seq, uint32_t* sample)
+{
+    sample[0] = seq;
+    sample[1] = seq * 2654435761UL;
+    sample[2] = ~seq;
+    sample[3] = seq ^ 0xA5A5A5A5UL;
+}
+
+/*******************************************************************************
+* Function Name: host_kv
+********************************************************************************
+* Summary:
+*  Random puts, gets and deletes over a fixed set of keys, checked against
+*  a shadow copy. The store is then reopened without formatting, so the
+*  index is rebuilt from the device, and checked again. Finally indexed
+*  lookups are timed against linear scans of the records.
+*
+* Parameters:
+*  ops - number of random operations
+*  seed - random seed
+*
+* Return:
+*  int - 0 if every lookup returned the expected value
+*
+*******************************************************************************/
+static int host_kv(uint32_t ops, uint32_t seed)
+{
+    static uint32_t index[HOST_KV_CAPACITY];
+    static uint32_t keys[HOST_KV_KEYS];
+    static uint32_t versions[HOST_KV_KEYS];     /* 0 when absent */
+    static kv_store_t store;
+    uint32_t value[HOST_KV_VALUE_WORDS];
+    uint32_t state = (0u != seed) ? seed : 1u;
+    uint32_t errors = 0u;
+    uint32_t start;
+    uint32_t get_ns;
+    uint32_t scan_ns;
+
+    for (uint32_t entry = 0; entry < HOST_KV_KEYS; entry++)
+    {
+        /* Distinct keys, never one of the reserved values */
+        keys[entry] = (entry * 2654435761UL) | 1u;
+        versions[entry] = 0u;
+    }
+
+    if (HYPERRAM_SUCCESS != kv_store_init(&store, HOST_KV_OFFSET, HOST_KV_CAPACITY, sizeof(value), index, true))
+    {
+        fprintf(stderr, "kv store setup failed\n");
+        return 1;
+    }
+
+    for (uint32_t op = 0; op < ops; op++)
+    {
+        uint32_t entry;
+        uint32_t action;
+
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        entry = state % HOST_KV_KEYS;
+        action = (state >> 24) % 20u;
+
+        if (action < 7u)
+        {
+            versions[entry]++;
+            host_kv_value(keys[entry], versions[entry], value);
+            errors += (HYPERRAM_SUCCESS == kv_store_put(&store, keys[entry], value)) ? 0u : 1u;
+        }
+        else if (action < 10u)
+        {
+            errors += (kv_store_delete(&store, keys[entry]) == (0u != versions[entry])) ? 0u : 1u;
+            versions[entry] = 0u;
+        }
+        else
+        {
+            uint32_t expected[HOST_KV_VALUE_WORDS];
+            bool found = kv_store_get(&store, keys[entry], value);
+
+            host_kv_value(keys[entry], versions[entry], expected);
+            if ((found != (0u != versions[entry])) ||
+                (found && (0 != memcmp(value, expected, sizeof(value)))))
+            {
+                errors++;
+            }
+        }
+    }
+
+    kv_store_print_stats(&store);
+    errors += host_kv_check(&store, keys, versions);
+    kv_store_deinit(&store);
+
+    /* Reopen: the index comes back from the keys in the device */
+    if (HYPERRAM_SUCCESS != kv_store_init(&store, HOST_KV_OFFSET, HOST_KV_CAPACITY, sizeof(value), index, false))
+    {
+        errors++;
+    }
+    errors += host_kv_check(&store, keys, versions);
+
+    start = perf_counter_now();
+    for (uint32_t entry = 0; entry < HOST_KV_KEYS; entry++)
+    {
+        (void)kv_store_get(&store, keys[entry], value);
+    }
+    get_ns = perf_counter_to_ns(perf_counter_now() - start) / HOST_KV_KEYS;
+
+    start = perf_counter_now();
+    for (uint32_t entry = 0; entry < HOST_KV_SCANS; entry++)
+    {
+        (void)kv_store_scan(&store, keys[(entry * 199u) % HOST_KV_KEYS], value);
+    }
+    scan_ns = perf_counter_to_ns(perf_counter_now() - start) / HOST_KV_SCANS;
+
+    printf("KV lookup %lu ns (%lu ops/s), linear scan %lu ns (%lu ops/s)\n",
+           (unsigned long)get_ns, (unsigned long)(1000000000UL / ((0u != get_ns) ? get_ns : 1u)),
+           (unsigned long)scan_ns, (unsigned long)(1000000000UL / ((0u != scan_ns) ? scan_ns : 1u)));
+
+    kv_store_deinit(&store);
+    printf("KV-RESULT %s errors=%lu\n", (0u == errors) ? "PASS" : "FAIL", (unsigned long)errors);
+
+    return (0u == errors) ? 0 : 1;
+}
+
+/*******************************************************************************
+* Function Name: host_kv_check
+********************************************************************************
+* Summary:
+*  Looks every key up, with the index and by scanning, and compares the
+*  result with the shadow copy.
+*
+* Parameters:
+*  store - store under test
+*  keys - test keys
+*  versions - current version of each key, 0 when absent
+*
+* Return:
+*  uint32_t - number of mismatches
+*
+*******************************************************************************/
+static uint32_t host_kv_check(kv_store_t* store, const uint32_t* keys, const uint32_t* versions)
+{
+    uint32_t errors = 0u;
+
+    for (uint32_t entry = 0; entry < HOST_KV_KEYS; entry++)
+    {
+        uint32_t value[HOST_KV_VALUE_WORDS];
+        uint32_t expected[HOST_KV_VALUE_WORDS];
+        bool found = kv_store_get(store, keys[entry], value);
+
+        host_kv_value(keys[entry], versions[entry], expected);
+        if ((found != (0u != versions[entry])) || (found && (0 != memcmp(value, expected, sizeof(value)))))
+        {
+            errors++;
+        }
+
+        /* The scan is slow, so only check a sample of the keys with it */
+        if ((0u == (entry % 997u)) &&
+            (kv_store_scan(store, keys[entry], value) != (0u != versions[entry])))
+        {
+            errors++;
+        }
+    }
+
+    return errors;
+}
+
+/*******************************************************************************
+* Function Name: host_kv_value
+********************************************************************************
+* Summary:
+*  Builds the value stored for a key at a given version.
+*
+* Parameters:
+*  key - key
+*  version - number of puts so far
+*  value - filled with HOST_KV_VALUE_WORDS words
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void host_kv_value(uint32_t key, uint32_t version, uint32_t* value)
+{
+    for (uint32_t word = 0; word < HOST_KV_VALUE_WORDS; word++)
+    {
+        value[word] = (key ^ (version * 0x9E3779B9UL)) + word;
+    }
+}
+
+/*******************************************************************************
+* Function Name: host_protect
+********************************************************************************
+* Summary:
+*  Random reads and writes of random alignment on a protected region,
+*  checked against a shadow copy. Then single bits are flipped in the
+*  device behind the region's back: the scrubber and a read must both
+*  find each one, and rewriting the block must repair it.
+*
+* Parameters:
+*  ops - number of read or write calls
+*  seed - random seed
+*
+* Return:
+*  int - 0 if all data matched and every corruption was found
+*
+*******************************************************************************/
+static int host_protect(uint32_t ops, uint32_t seed)
+{
+    static uint32_t table[HYPERRAM_PROTECT_TABLE_WORDS(HOST_PROTECT_BLOCKS)];
+    static uint8_t shadow[HOST_PROTECT_SIZE];
+    static uint8_t buffer[HOST_PROTECT_MAX_IO];
+    static hyperram_protect_t region;
+    uint32_t state = (0u != seed) ? seed : 1u;
+    uint32_t errors = 0u;
+    uint32_t start;
+    uint32_t dma_ns;
+    uint32_t protect_ns;
+
+    if (HYPERRAM_SUCCESS != hyperram_protect_init(&region, HOST_PROTECT_OFFSET, HOST_PROTECT_SIZE,
+                                                  HOST_PROTECT_BLOCK, table, true))
+    {
+        fprintf(stderr, "protected region setup failed\n");
+        return 1;
+    }
+    memset(shadow, 0, sizeof(shadow));
+
+    for (uint32_t op = 0; op < ops; op++)
+    {
+        uint32_t address;
+        uint32_t size;
+
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        address = state % HOST_PROTECT_SIZE;
+        size = 1u + ((state >> 7) % HOST_PROTECT_MAX_IO);
+        if (size > (HOST_PROTECT_SIZE - address))
+        {
+            size = HOST_PROTECT_SIZE - address;
+        }
+
+        if (0u != (state & 0x80000000UL))
+        {
+            for (uint32_t index = 0; index < size; index++)
+            {
+                buffer[index] = (uint8_t)(op + index);
+            }
+            memcpy(&shadow[address], buffer, size);
+            errors += (HYPERRAM_SUCCESS == hyperram_protect_write(&region, address, buffer, size)) ? 0u : 1u;
+        }
+        else
+        {
+            errors += (HYPERRAM_SUCCESS == hyperram_protect_read(&region, buffer, address, size)) ? 0u : 1u;
+            errors += (0 == memcmp(buffer, &shadow[address], size)) ? 0u : 1u;
+        }
+
+        /* Idle-time scrubbing between operations */
+        errors += hyperram_protect_scrub(&region, 4u);
+    }
+
+    for (uint32_t fault = 0; fault < 16u; fault++)
+    {
+        uint32_t block;
+        uint8_t* device;
+
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        block = state % HOST_PROTECT_BLOCKS;
+        device = (uint8_t*)hyperram_xip_ptr(HOST_PROTECT_OFFSET + (block * HOST_PROTECT_BLOCK));
+        device[(state >> 10) % HOST_PROTECT_BLOCK] ^= (uint8_t)(1u << ((state >> 20) % 8u));
+
+        errors += (1u == hyperram_protect_scrub(&region, HOST_PROTECT_BLOCKS)) ? 0u : 1u;
+        errors += (block == region.stats.bad_block) ? 0u : 1u;
+        errors += (HYPERRAM_ERROR == hyperram_protect_read(&region, buffer, block * HOST_PROTECT_BLOCK, 16u)) ? 0u : 1u;
+        errors += (HYPERRAM_SUCCESS == hyperram_protect_write(&region, block * HOST_PROTECT_BLOCK,
+                                                              &shadow[block * HOST_PROTECT_BLOCK],
+                                                              HOST_PROTECT_BLOCK)) ? 0u : 1u;
+        errors += (0u == hyperram_protect_scrub(&region, HOST_PROTECT_BLOCKS)) ? 0u : 1u;
+    }
+
+    hyperram_protect_print_stats(&region);
+
+    start = perf_counter_now();
+    for (uint32_t offset = 0; offset < HOST_PROTECT_SIZE; offset += HOST_PROTECT_MAX_IO)
+    {
+        (void)hyperram_dma_copy(buffer, hyperram_xip_ptr(HOST_PROTECT_OFFSET + offset), HOST_PROTECT_MAX_IO);
+    }
+    dma_ns = perf_counter_to_ns(perf_counter_now() - start);
+
+    start = perf_counter_now();
+    for (uint32_t offset = 0; offset < HOST_PROTECT_SIZE; offset += HOST_PROTECT_MAX_IO)
+    {
+        errors += (HYPERRAM_SUCCESS == hyperram_protect_read(&region, buffer, offset, HOST_PROTECT_MAX_IO)) ? 0u : 1u;
+    }
+    protect_ns = perf_counter_to_ns(perf_counter_now() - start);
+
+    printf("PROTECT 1 MB read: plain %lu us, checked %lu us\n",
+           (unsigned long)(dma_ns / 1000u), (unsigned long)(protect_ns / 1000u));
+
+    hyperram_protect_deinit(&region);
+    printf("PROTECT-RESULT %s errors=%lu\n", (0u == errors) ? "PASS" : "FAIL", (unsigned long)errors);
+
+    return (0u == errors) ? 0 : 1;
+}
+
+/*******************************************************************************
+* Function Name: host_lz
+********************************************************************************
+* Summary:
+*  Random block writes and reads on a compressed store, checked against the
+*  generator, followed by a timed pass over the whole store next to plain
+*  DMA. The block contents are a mix of sensor-like samples, zeros and
+*  random bytes.
+*
+* Parameters:
+*  ops - number of read or write calls
+*  seed - random seed
+*
+* Return:
+*  int - 0 if all data matched
+*
+*******************************************************************************/
+static int host_lz(uint32_t ops, uint32_t seed)
+{
+    static uint16_t index[HOST_LZ_BLOCKS];
+    static uint32_t versions[HOST_LZ_BLOCKS];
+    static uint8_t expected[HOST_LZ_BLOCK];
+    static uint8_t buffer[HOST_LZ_BLOCK];
+    static hyperram_lz_t store;
+    uint32_t state = (0u != seed) ? seed : 1u;
+    uint32_t errors = 0u;
+    uint32_t start;
+    uint32_t dma_ns;
+    uint32_t lz_ns;
+
+    hyperram_enter_xip();
+
+    if (HYPERRAM_SUCCESS != hyperram_lz_init(&store, HOST_LZ_OFFSET, HOST_LZ_SIZE, HOST_LZ_BLOCK, index))
+    {
+        fprintf(stderr, "compressed store setup failed\n");
+        return 1;
+    }
+    memset(versions, 0, sizeof(versions));
+
+    for (uint32_t op = 0; op < ops; op++)
+    {
+        uint32_t block;
+
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        block = state % HOST_LZ_BLOCKS;
+
+        if (0u != (state & 0x80000000UL))
+        {
+            versions[block] = op + 1u;
+            host_lz_block(block, versions[block], buffer);
+            errors += (HYPERRAM_SUCCESS == hyperram_lz_write(&store, block, buffer)) ? 0u : 1u;
+        }
+        else
+        {
+            host_lz_block(block, versions[block], expected);
+            errors += (HYPERRAM_SUCCESS == hyperram_lz_read(&store, block, buffer)) ? 0u : 1u;
+            errors += (0 == memcmp(buffer, expected, HOST_LZ_BLOCK)) ? 0u : 1u;
+        }
+    }
+
+    for (uint32_t block = 0; block < HOST_LZ_BLOCKS; block++)
+    {
+        versions[block] = ops + block + 1u;
+        host_lz_block(block, versions[block], buffer);
+        errors += (HYPERRAM_SUCCESS == hyperram_lz_write(&store, block, buffer)) ? 0u : 1u;
+    }
+    errors += (HYPERRAM_SUCCESS == hyperram_lz_flush(&store)) ? 0u : 1u;
+
+    start = perf_counter_now();
+    for (uint32_t offset = 0; offset < HOST_LZ_SIZE; offset += HOST_LZ_BLOCK)
+    {
+        (void)hyperram_dma_copy(buffer, hyperram_xip_ptr(HOST_LZ_OFFSET + offset), HOST_LZ_BLOCK);
+    }
+    dma_ns = perf_counter_to_ns(perf_counter_now() - start);
+
+    start = perf_counter_now();
+    for (uint32_t block = 0; block < HOST_LZ_BLOCKS; block++)
+    {
+        errors += (HYPERRAM_SUCCESS == hyperram_lz_read(&store, block, buffer)) ? 0u : 1u;
+    }
+    lz_ns = perf_counter_to_ns(perf_counter_now() - start);
+
+    hyperram_lz_print_stats(&store);
+    printf("LZ 1 MB read: plain %lu us, compressed %lu us\n",
+           (unsigned long)(dma_ns / 1000u), (unsigned long)(lz_ns / 1000u));
+
+    hyperram_lz_deinit(&store);
+    printf("LZ-RESULT %s errors=%lu\n", (0u == errors) ? "PASS" : "FAIL", (unsigned long)errors);
+
+    return (0u == errors) ? 0 : 1;
+}
+
+/*******************************************************************************
+* Function Name: host_lz_block
+********************************************************************************
+* Summary:
+*  Generates the contents of a block version. Version 0 is the never-written
+*  block (zeros). Of the others, one in eight is random and the rest are
+*  16-bit samples of a slow ramp with noise in the two low bits.
+*
+* Parameters:
+*  block - block number
+*  version - block version
+*  data - receives HOST_LZ_BLOCK bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void host_lz_block(uint32_t block, uint32_t version, uint8_t* data)
+{
+    uint32_t state = (block * 2654435761u) ^ version;
+
+    if (0u == version)
+    {
+        memset(data, 0, HOST_LZ_BLOCK);
+        return;
+    }
+
+    state = (0u != state) ? state : 1u;
+
+    for (uint32_t offset = 0; offset < HOST_LZ_BLOCK; offset += 2u)
+    {
+        uint32_t sample;
+
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+
+        sample = (0u == (version % 8u)) ? state : (((offset / 64u) + version) << 2) | (state & 3u);
+        data[offset] = (uint8_t)sample;
+        data[offset + 1u] = (uint8_t)(sample >> 8);
+    }
+}
+
+/*******************************************************************************
+* Function Name: host_crypt
+********************************************************************************
+* Summary:
+*  Random reads and writes over a range holding two encrypted regions, with
+*  both the XIP DMA and the command-mode paths, checked against a shadow
+*  copy. The device contents are then checked to be cipher text inside the
+*  regions and plain text outside, and unreadable under a new key.
+*
+* Parameters:
+*  ops - number of read or write calls
+*  seed - random seed
+*
+* Return:
+*  int - 0 if all checks passed
+*
+*******************************************************************************/
+static int host_crypt(uint32_t ops, uint32_t seed)
+{
+    static const uint32_t regions[][2] =
+    {
+        { 0x00010000UL, 0x00040000UL },
+        { 0x00080000UL, 0x00020000UL },
+    };
+    static uint8_t shadow[HOST_CRYPT_SIZE];
+    static uint8_t buffer[HOST_CRYPT_MAX_IO];
+    uint32_t state = (0u != seed) ? seed : 1u;
+    uint32_t errors = 0u;
+    uint32_t start;
+    uint32_t dma_ns;
+    uint32_t crypt_ns;
+
+    hyperram_enter_xip();
+
+    if (HYPERRAM_SUCCESS != hyperram_crypt_init(NULL, NULL))
+    {
+        fprintf(stderr, "encryption setup failed\n");
+        return 1;
+    }
+
+    for (uint32_t region = 0; region < (sizeof(regions) / sizeof(regions[0])); region++)
+    {
+        errors += (HYPERRAM_SUCCESS == hyperram_crypt_add_region(HOST_CRYPT_OFFSET + regions[region][0],
+                                                                 regions[region][1])) ? 0u : 1u;
+    }
+    errors += (HYPERRAM_BAD_PARAM == hyperram_crypt_add_region(HOST_CRYPT_OFFSET + 0x00048000UL, 0x1000u)) ? 0u : 1u;
+
+    memset(shadow, 0, sizeof(shadow));
+    errors += (HYPERRAM_SUCCESS == hyperram_crypt_write(HOST_CRYPT_OFFSET, shadow, HOST_CRYPT_SIZE)) ? 0u : 1u;
+
+    for (uint32_t op = 0; op < ops; op++)
+    {
+        bool command;
+        uint32_t address;
+        uint32_t size;
+
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        command = (0u != (state & 0x40000000UL));
+        address = state % HOST_CRYPT_SIZE;
+        size = 1u + ((state >> 7) % HOST_CRYPT_MAX_IO);
+        if (command)
+        {
+            address &= ~(HYPERRAM_CRYPTO_BLOCK - 1u);
+            size = (size + (HYPERRAM_CRYPTO_BLOCK - 1u)) & ~(HYPERRAM_CRYPTO_BLOCK - 1u);
+        }
+        if (size > (HOST_CRYPT_SIZE - address))
+        {
+            size = HOST_CRYPT_SIZE - address;
+        }
+
+        if (0u != (state & 0x80000000UL))
+        {
+            for (uint32_t index = 0; index < size; index++)
+            {
+                buffer[index] = (uint8_t)(op + index);
+            }
+            memcpy(&shadow[address], buffer, size);
+            errors += (HYPERRAM_SUCCESS == (command ?
+                       hyperram_crypt_write_command(HOST_CRYPT_OFFSET + address, buffer, size) :
+                       hyperram_crypt_write(HOST_CRYPT_OFFSET + address, buffer, size))) ? 0u : 1u;
+        }
+        else
+        {
+            errors += (HYPERRAM_SUCCESS == (command ?
+                       hyperram_crypt_read_command(buffer, HOST_CRYPT_OFFSET + address, size) :
+                       hyperram_crypt_read(buffer, HOST_CRYPT_OFFSET + address, size))) ? 0u : 1u;
+            errors += (0 == memcmp(buffer, &shadow[address], size)) ? 0u : 1u;
+        }
+    }
+
+    /* At rest: plain text outside the regions, cipher text inside */
+    for (uint32_t offset = 0; offset < HOST_CRYPT_SIZE; offset += HYPERRAM_CRYPTO_BLOCK)
+    {
+        bool same = (0 == memcmp(hyperram_xip_ptr(HOST_CRYPT_OFFSET + offset), &shadow[offset],
+                                 HYPERRAM_CRYPTO_BLOCK));
+
+        errors += (same != hyperram_crypt_is_encrypted(HOST_CRYPT_OFFSET + offset)) ? 0u : 1u;
+    }
+
+    hyperram_crypt_print_stats();
+
+    start = perf_counter_now();
+    for (uint32_t offset = 0; offset < HOST_CRYPT_SIZE; offset += HOST_CRYPT_MAX_IO)
+    {
+        (void)hyperram_dma_copy(buffer, hyperram_xip_ptr(HOST_CRYPT_OFFSET + offset), HOST_CRYPT_MAX_IO);
+    }
+    dma_ns = perf_counter_to_ns(perf_counter_now() - start);
+
+    start = perf_counter_now();
+    for (uint32_t offset = regions[0][0]; offset < (regions[0][0] + regions[0][1]); offset += HOST_CRYPT_MAX_IO)
+    {
+        errors += (HYPERRAM_SUCCESS == hyperram_crypt_read(buffer, HOST_CRYPT_OFFSET + offset,
+                                                           HOST_CRYPT_MAX_IO)) ? 0u : 1u;
+        errors += (0 == memcmp(buffer, &shadow[offset], HOST_CRYPT_MAX_IO)) ? 0u : 1u;
+    }
+    crypt_ns = perf_counter_to_ns(perf_counter_now() - start);
+
+    printf("CRYPT 1 MB read: plain %lu us, 256 KB encrypted %lu us\n",
+           (unsigned long)(dma_ns / 1000u), (unsigned long)(crypt_ns / 1000u));
+
+    /* A new key leaves the plain text readable and the regions garbage */
+    hyperram_crypt_deinit();
+    errors += (HYPERRAM_SUCCESS == hyperram_crypt_init(NULL, NULL)) ? 0u : 1u;
+    errors += (HYPERRAM_SUCCESS == hyperram_crypt_add_region(HOST_CRYPT_OFFSET + regions[1][0],
+                                                             regions[1][1])) ? 0u : 1u;
+    errors += (HYPERRAM_SUCCESS == hyperram_crypt_read(buffer, HOST_CRYPT_OFFSET + regions[1][0],
+                                                       HOST_CRYPT_MAX_IO)) ? 0u : 1u;
+    errors += (0 != memcmp(buffer, &shadow[regions[1][0]], HOST_CRYPT_MAX_IO)) ? 0u : 1u;
+    hyperram_crypt_deinit();
+
+    printf("CRYPT-RESULT %s errors=%lu\n", (0u == errors) ? "PASS" : "FAIL", (unsigned long)errors);
+
+    return (0u == errors) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,326 @@
+#!/usr/bin/env python3
+"""Host side of the HyperRAM dump/upload service (source/xfer_server.c).
+
+Build the application with ENABLE_XFER_SERVER defined, then:
+
+  hyperram_xfer.py --port COM5 info
+  hyperram_xfer.py --port COM5 read 0x0 0x1000000 image.bin [--resume]
+  hyperram_xfer.py --port COM5 write 0x40000 image.bin [--skip N]
+
+Data moves in CRC-32 protected blocks. The receiver acknowledges every
+in-order block; repeating the last acknowledgement makes the sender go back
+to that block, which is also how a stalled transfer is restarted.
+"""
+
+import argparse
+import os
+import struct
+import sys
+import time
+import zlib
+
+from telemetry_decode import FrameDecoder, crc16_ccitt
+
+# Target to host frame types (telemetry.h)
+TYPE_XFER_DATA = 0x10
+TYPE_XFER_ACK = 0x11
+TYPE_XFER_STATUS = 0x12
+
+# Host to target frame types (xfer_server.h)
+CMD_INFO = 0x20
+CMD_READ = 0x21
+CMD_WRITE = 0x22
+CMD_DATA = 0x23
+CMD_ACK = 0x24
+CMD_BAUD = 0x25
+CMD_ABORT = 0x26
+
+STATUS_INFO = 0
+STATUS_DONE = 1
+STATUS_ERROR = 2
+STATUS_BAUD = 3
+
+ERROR_ABORTED = 6
+ERRORS = {1: "range", 2: "busy", 3: "memory", 4: "baud", 5: "command", ERROR_ABORTED: "aborted"}
+
+DEFAULT_BLOCK = 512
+DEFAULT_WINDOW = 8
+
+# Retries after --timeout without progress before a write gives up
+MAX_STALLS = 8
+
+
+class XferError(Exception):
+    pass
+
+
+class Link:
+    """Framed command/response link over the debug UART."""
+
+    def __init__(self, port, baud, timeout):
+        import serial  # pyserial
+        self.serial = serial.Serial(port, baud, timeout=0.02, rtscts=True)
+        self.decoder = FrameDecoder()
+        self.timeout = timeout
+        self.seq = 0
+        self.pending = []
+
+    def send(self, ftype, payload=b""):
+        body = struct.pack("<BBH", ftype, self.seq, len(payload)) + payload
+        self.seq = (self.seq + 1) & 0xFF
+        self.serial.write(b"\xA5\x5A" + body + struct.pack("<H", crc16_ccitt(body)))
+
+    def frames(self):
+        """Returns the frames received so far, reading whatever is pending."""
+        data = self.serial.read(max(1, self.serial.in_waiting))
+        for item in self.decoder.feed(data):
+            if item[0] == "frame":
+                self.pending.append((item[1], item[3]))
+        frames, self.pending = self.pending, []
+        return frames
+
+    def wait_status(self, code, aborted_ok=False):
+        """Waits for a status frame; aborted_ok skips the answer to an ABORT."""
+        deadline = time.time() + self.timeout
+        while time.time() < deadline:
+            for ftype, payload in self.frames():
+                if ftype != TYPE_XFER_STATUS:
+                    continue
+                status, value0, value1 = struct.unpack("<III", payload)
+                if status == STATUS_ERROR and value0 == ERROR_ABORTED and aborted_ok:
+                    aborted_ok = False
+                    continue
+                if status == STATUS_ERROR:
+                    raise XferError("target error: %s (0x%X)" % (ERRORS.get(value0, value0), value1))
+                if status == code:
+                    return value0, value1
+        raise XferError("timeout waiting for status %u" % code)
+
+    def abort(self):
+        """Closes any session an interrupted earlier run left open on the target."""
+        self.send(CMD_ABORT)
+        deadline = time.time() + self.timeout
+        while time.time() < deadline:
+            for ftype, payload in self.frames():
+                if ftype != TYPE_XFER_STATUS:
+                    continue
+                status, value0, _ = struct.unpack("<III", payload)
+                if status == STATUS_ERROR and value0 == ERROR_ABORTED:
+                    return
+        raise XferError("no response to ABORT; if an earlier run left the target at the fast rate, "
+                        "pass it as --baud")
+
+    def set_baud(self, baud):
+        self.send(CMD_BAUD, struct.pack("<I", baud))
+        self.wait_status(STATUS_BAUD)
+        time.sleep(0.05)
+        self.serial.baudrate = baud
+        self.serial.reset_input_buffer()
+        self.decoder = FrameDecoder()
+
+    def close(self):
+        self.serial.close()
+
+
+def progress(done, total, started):
+    elapsed = max(time.time() - started, 1e-6)
+    sys.stderr.write("\r%10u / %u bytes  %8.1f KB/s" % (done, total, done / elapsed / 1024.0))
+    sys.stderr.flush()
+
+
+def query_info(link):
+    """Returns the device size, block size and window the target reports."""
+    link.send(CMD_INFO)
+    size, geometry = link.wait_status(STATUS_INFO)
+    return size, geometry & 0xFFFF, geometry >> 16
+
+
+def do_info(link, args):
+    size, block, window = query_info(link)
+    print("device size : 0x%X bytes" % size)
+    print("block size  : %u bytes" % block)
+    print("window      : %u blocks" % window)
+
+
+def do_read(link, args):
+    start = args.address
+    end = args.address + args.length
+    mode = "ab" if args.resume and os.path.exists(args.output) else "wb"
+    expected = start + (os.path.getsize(args.output) if mode == "ab" else 0)
+    started = time.time()
+    counted_from = expected
+
+    with open(args.output, mode) as out:
+        link.send(CMD_READ, struct.pack("<II", expected, end - expected))
+        last_rx = time.time()
+        rewind_pending = False
+        aborting = False
+        stalls = 0
+        while expected < end:
+            for ftype, payload in link.frames():
+                if ftype == TYPE_XFER_STATUS:
+                    status, value0, value1 = struct.unpack("<III", payload)
+                    if status == STATUS_ERROR and value0 == ERROR_ABORTED and aborting:
+                        # Answer to our own ABORT; the new READ follows it
+                        aborting = False
+                    elif status == STATUS_ERROR:
+                        raise XferError("target error: %s at 0x%X" % (ERRORS.get(value0, value0), value1))
+                    continue
+                if ftype != TYPE_XFER_DATA:
+                    continue
+                offset, crc = struct.unpack_from("<II", payload)
+                data = payload[8:]
+                if offset == expected and zlib.crc32(data) == crc:
+                    out.write(data)
+                    expected += len(data)
+                    link.send(CMD_ACK, struct.pack("<I", expected))
+                    rewind_pending = False
+                    last_rx = time.time()
+                    stalls = 0
+                elif offset >= expected and not rewind_pending:
+                    # Lost or corrupted block: repeat the acknowledgement
+                    link.send(CMD_ACK, struct.pack("<I", expected))
+                    rewind_pending = True
+            if time.time() - last_rx > args.timeout:
+                stalls += 1
+                if stalls > 3:
+                    # The target may have lost the session; restart it here
+                    link.send(CMD_ABORT)
+                    link.send(CMD_READ, struct.pack("<II", expected, end - expected))
+                    aborting = True
+                    stalls = 0
+                else:
+                    link.send(CMD_ACK, struct.pack("<I", expected))
+                rewind_pending = True
+                last_rx = time.time()
+            progress(expected - counted_from, end - counted_from, started)
+    sys.stderr.write("\n")
+    # The target closes the session once the last block is acknowledged
+    link.wait_status(STATUS_DONE, aborted_ok=aborting)
+
+
+def do_write(link, args):
+    with open(args.input, "rb") as handle:
+        image = handle.read()
+    image = image[args.skip:]
+    if len(image) & 1:
+        image += b"\xFF"
+    start = args.address + args.skip
+    end = start + len(image)
+    block = args.block
+    window = args.window * block
+    _, target_block, _ = query_info(link)
+    if block <= 0 or block > target_block or block & 1:
+        raise XferError("--block %u: must be even and at most the target block size %u" % (block, target_block))
+    started = time.time()
+
+    link.send(CMD_WRITE, struct.pack("<II", start, len(image)))
+    acked = None
+    deadline = time.time() + args.timeout
+    while acked is None:
+        for ftype, payload in link.frames():
+            if ftype == TYPE_XFER_ACK:
+                (acked,) = struct.unpack("<I", payload)
+            elif ftype == TYPE_XFER_STATUS:
+                status, value0, value1 = struct.unpack("<III", payload)
+                if status == STATUS_ERROR:
+                    raise XferError("target error: %s" % ERRORS.get(value0, value0))
+        if time.time() > deadline:
+            raise XferError("no response to WRITE")
+
+    send_pos = acked
+    rewound = False
+    done = None
+    stalls = 0
+    last_rx = time.time()
+    try:
+        while acked < end:
+            while send_pos < end and send_pos - acked < window:
+                data = image[send_pos - start:send_pos - start + block]
+                link.send(CMD_DATA, struct.pack("<II", send_pos, zlib.crc32(data)) + data)
+                send_pos += len(data)
+            for ftype, payload in link.frames():
+                if ftype == TYPE_XFER_ACK:
+                    (offset,) = struct.unpack("<I", payload)
+                    if offset > acked:
+                        acked = offset
+                        rewound = False
+                        last_rx = time.time()
+                        stalls = 0
+                    elif offset == acked and send_pos > acked and not rewound:
+                        send_pos = acked
+                        rewound = True
+                elif ftype == TYPE_XFER_STATUS:
+                    status, value0, value1 = struct.unpack("<III", payload)
+                    if status == STATUS_ERROR:
+                        raise XferError("target error: %s at 0x%X" % (ERRORS.get(value0, value0), value1))
+                    if status == STATUS_DONE:
+                        done = (value0, value1)
+                        if value0 == len(image):
+                            # The final ACK may be lost; DONE also covers it
+                            acked = end
+            if acked < end and time.time() - last_rx > args.timeout:
+                stalls += 1
+                if stalls > MAX_STALLS:
+                    raise XferError("no progress at 0x%X" % acked)
+                send_pos = acked
+                last_rx = time.time()
+            progress(acked - start, len(image), started)
+    except (XferError, KeyboardInterrupt):
+        sys.stderr.write("\nresume with: --skip %u\n" % (args.skip + acked - start))
+        raise
+    sys.stderr.write("\n")
+
+    length, crc = done if done is not None else link.wait_status(STATUS_DONE)
+    if crc != zlib.crc32(image):
+        raise XferError("image CRC mismatch: target 0x%08X, host 0x%08X" % (crc, zlib.crc32(image)))
+    print("verified %u bytes, CRC-32 0x%08X" % (length, crc))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--port", required=True, help="serial port of the KitProg3 UART")
+    parser.add_argument("--baud", type=int, default=115200, help="current target baud rate")
+    parser.add_argument("--fast-baud", type=int, default=3000000,
+                        help="baud rate used for the transfer, 0 to keep --baud")
+    parser.add_argument("--timeout", type=float, default=1.0, help="seconds without progress before a retry")
+    parser.add_argument("--block", type=int, default=DEFAULT_BLOCK)
+    parser.add_argument("--window", type=int, default=DEFAULT_WINDOW)
+    sub = parser.add_subparsers(dest="command", required=True)
+    sub.add_parser("info")
+    read = sub.add_parser("read")
+    read.add_argument("address", type=lambda v: int(v, 0))
+    read.add_argument("length", type=lambda v: int(v, 0))
+    read.add_argument("output")
+    read.add_argument("--resume", action="store_true", help="continue after the bytes already in output")
+    write = sub.add_parser("write")
+    write.add_argument("address", type=lambda v: int(v, 0))
+    write.add_argument("input")
+    write.add_argument("--skip", type=lambda v: int(v, 0), default=0,
+                       help="bytes of the image already written by an earlier run")
+    args = parser.parse_args()
+
+    link = Link(args.port, args.baud, args.timeout)
+    switched = False
+    try:
+        # Close a session an interrupted run may have left open
+        link.abort()
+        if args.fast_baud and args.fast_baud != args.baud:
+            link.set_baud(args.fast_baud)
+            switched = True
+        {"info": do_info, "read": do_read, "write": do_write}[args.command](link, args)
+    except XferError as error:
+        sys.stderr.write("error: %s\n" % error)
+        return 1
+    finally:
+        if switched:
+            try:
+                link.set_baud(args.baud)
+            except XferError as error:
+                sys.stderr.write("could not restore baud rate: %s\n" % error)
+        link.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+"""Decoder for the binary telemetry frames emitted by source/telemetry.c.
+
+Reads from a serial port (requires pyserial) or a capture file, passes plain
+console text through to stdout and decodes telemetry frames:
+
+  SOF0 (0xA5) | SOF1 (0x5A) | type | seq | length (2) | payload | CRC16 (2)
+
+Dump frames are reassembled per marker label and written to --dump-dir as
+raw binary images.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+SOF = b"\xA5\x5A"
+HEADER_SIZE = 6
+CRC_SIZE = 2
+MAX_PAYLOAD = 1024
+
+TYPE_DUMP = 0x01
+TYPE_COUNTER = 0x02
+TYPE_TRACE = 0x03
+TYPE_MARKER = 0x04
+
+
+def crc16_ccitt(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE, matching crc16_ccitt_update() on the target."""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+class FrameDecoder:
+    """Incremental stream decoder; feed() yields ('text', bytes) or ('frame', ...)."""
+
+    def __init__(self):
+        self.buf = bytearray()
+        self.crc_errors = 0
+        self.lost_frames = 0
+        self.expected_seq = None
+
+    def feed(self, data):
+        self.buf.extend(data)
+        while True:
+            start = self.buf.find(SOF)
+            if start < 0:
+                # Keep a trailing SOF0 in case the marker is split across reads
+                keep = 1 if self.buf[-1:] == SOF[:1] else 0
+                text = bytes(self.buf[:len(self.buf) - keep])
+                del self.buf[:len(self.buf) - keep]
+                if text:
+                    yield ("text", text)
+                return
+            if start > 0:
+                yield ("text", bytes(self.buf[:start]))
+                del self.buf[:start]
+            if len(self.buf) < HEADER_SIZE:
+                return
+            ftype, seq, length = struct.unpack_from("<BBH", self.buf, 2)
+            if length > MAX_PAYLOAD:
+                # Not a real frame: emit the marker byte as text and resync
+                yield ("text", bytes(self.buf[:1]))
+                del self.buf[:1]
+                continue
+            total = HEADER_SIZE + length + CRC_SIZE
+            if len(self.buf) < total:
+                return
+            payload = bytes(self.buf[HEADER_SIZE:HEADER_SIZE + length])
+            (crc,) = struct.unpack_from("<H", self.buf, HEADER_SIZE + length)
+            if crc != crc16_ccitt(self.buf[2:HEADER_SIZE + length]):
+                self.crc_errors += 1
+                yield ("text", bytes(self.buf[:1]))
+                del self.buf[:1]
+                continue
+            del self.buf[:total]
+            if self.expected_seq is not None and seq != self.expected_seq:
+                self.lost_frames += (seq - self.expected_seq) & 0xFF
+            self.expected_seq = (seq + 1) & 0xFF
+            yield ("frame", ftype, seq, payload)
+
+
+def open_source(args):
+    if args.input:
+        return open(args.input, "rb")
+    import serial  # pyserial
+    return serial.Serial(args.port, args.baud, timeout=0.1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    src = parser.add_mutually_exclusive_group(required=True)
+    src.add_argument("--port", help="serial port of the KitProg3 UART")
+    src.add_argument("--input", help="raw capture file to decode")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--dump-dir", default="dumps",
+                        help="directory for reassembled dump images")
+    parser.add_argument("--hex", action="store_true",
+                        help="also print dump frames as hex on stdout")
+    args = parser.parse_args()
+
+    decoder = FrameDecoder()
+    labels = {}
+    label = "dump"
+    images = {}
+    out = sys.stdout
+
+    source = open_source(args)
+    try:
+        while True:
+            data = source.read(4096)
+            if not data:
+                if args.input:
+                    break
+                continue
+            for item in decoder.feed(data):
+                if item[0] == "text":
+                    out.write(item[1].decode("ascii", errors="replace"))
+                    continue
+                _, ftype, seq, payload = item
+                if ftype == TYPE_MARKER:
+                    (marker_id,) = struct.unpack_from("<H", payload)
+                    label = payload[2:].decode("ascii", errors="replace")
+                    labels[marker_id] = label
+                    out.write("\n[marker %u] %s\n" % (marker_id, label))
+                elif ftype == TYPE_DUMP:
+                    (address,) = struct.unpack_from("<I", payload)
+                    data_bytes = payload[4:]
+                    images.setdefault(label, {})[address] = data_bytes
+                    if args.hex:
+                        for off in range(0, len(data_bytes), 16):
+                            line = data_bytes[off:off + 16]
+                            out.write("%08X: %s\n" % (address + off, " ".join("%02X" % b for b in line)))
+                elif ftype == TYPE_COUNTER:
+                    counter_id, value = struct.unpack_from("<HI", payload)
+                    name = labels.get(counter_id, "counter")
+                    out.write("[counter %u %s] %u\n" % (counter_id, name, value))
+                elif ftype == TYPE_TRACE:
+                    timestamp, event, arg = struct.unpack_from("<IHI", payload)
+                    out.write("[trace %10u] event=0x%04X arg=0x%08X\n" % (timestamp, event, arg))
+                else:
+                    out.write("[frame type 0x%02X seq %u, %u bytes]\n" % (ftype, seq, len(payload)))
+            out.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        source.close()
+
+    if images:
+        os.makedirs(args.dump_dir, exist_ok=True)
+        for name, chunks in images.items():
+            base = min(chunks)
+            end = max(addr + len(chunk) for addr, chunk in chunks.items())
+            image = bytearray(end - base)
+            for addr, chunk in chunks.items():
+                image[addr - base:addr - base + len(chunk)] = chunk
+            path = os.path.join(args.dump_dir, "%s_0x%08X.bin" % (name.replace(" ", "_"), base))
+            with open(path, "wb") as handle:
+                handle.write(image)
+            sys.stderr.write("wrote %s (%u bytes)\n" % (path, len(image)))
+    sys.stderr.write("crc errors: %u, lost frames: %u\n" % (decoder.crc_errors, decoder.lost_frames))
+
+
+if __name__ == "__main__":
+    main()